@@ -437,9 +437,9 @@ public:
 		}
 	}
 
-	QList< ScreenInfo > * screensWithWidgets(QList< ScreenInfo > * result, const QList<GrabWidget *> &grabWidgets)
+	QList< ScreenInfo > * screensWithWidgets(QList< ScreenInfo > * result, const QList<GrabbedArea> &grabAreas)
 	{
-		Q_UNUSED(grabWidgets);
+		Q_UNUSED(grabAreas);
 
 		result->clear();
 		return result;
@@ -692,12 +692,12 @@ void D3D10Grabber::setGrabInterval(int msec) {
  * Just stub, we don't need to reallocate anything, and we suppose fullscreen application
  * runs on primary screen \see D3D10Grabber#init()
  * \param result
- * \param grabWidgets
+ * \param grabAreas
  * \return
  */
-QList< ScreenInfo > * D3D10Grabber::screensWithWidgets(QList< ScreenInfo > * result, const QList<GrabWidget *> &grabWidgets)
+QList< ScreenInfo > * D3D10Grabber::screensWithWidgets(QList< ScreenInfo > * result, const QList<GrabbedArea> &grabAreas)
 {
-	Q_UNUSED(grabWidgets);
+	Q_UNUSED(grabAreas);
 
 	DEBUG_HIGH_LEVEL << Q_FUNC_INFO << this->metaObject()->className();
 	return result;
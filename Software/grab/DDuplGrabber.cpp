@@ -220,11 +220,12 @@ bool DDuplGrabber::runThreadCommand(DWORD timeout) {
 	}
 }
 
-bool anyWidgetOnThisMonitor(HMONITOR monitor, const QList<GrabWidget *> &grabWidgets)
+bool anyWidgetOnThisMonitor(HMONITOR monitor, const QList<GrabbedArea> &grabAreas)
 {
-	for (GrabWidget* widget : grabWidgets)
+	for (const GrabbedArea &area : grabAreas)
 	{
-		HMONITOR widgetMonitor = MonitorFromWindow(reinterpret_cast<HWND>(widget->winId()), MONITOR_DEFAULTTONULL);
+		const RECT rect = { area.rect.left(), area.rect.top(), area.rect.right() + 1, area.rect.bottom() + 1 };
+		HMONITOR widgetMonitor = MonitorFromRect(&rect, MONITOR_DEFAULTTONULL);
 		if (widgetMonitor == monitor)
 		{
 			return true;
@@ -234,12 +235,12 @@ bool anyWidgetOnThisMonitor(HMONITOR monitor, const QList<GrabWidget *> &grabWid
 	return false;
 }
 
-QList< ScreenInfo > * DDuplGrabber::screensWithWidgets(QList< ScreenInfo > * result, const QList<GrabWidget *> &grabWidgets)
+QList< ScreenInfo > * DDuplGrabber::screensWithWidgets(QList< ScreenInfo > * result, const QList<GrabbedArea> &grabAreas)
 {
-	return __screensWithWidgets(result, grabWidgets);
+	return __screensWithWidgets(result, grabAreas);
 }
 
-QList< ScreenInfo > * DDuplGrabber::__screensWithWidgets(QList< ScreenInfo > * result, const QList<GrabWidget *> &grabWidgets, bool noRecursion)
+QList< ScreenInfo > * DDuplGrabber::__screensWithWidgets(QList< ScreenInfo > * result, const QList<GrabbedArea> &grabAreas, bool noRecursion)
 {
 	result->clear();
 
@@ -260,14 +261,14 @@ QList< ScreenInfo > * DDuplGrabber::__screensWithWidgets(QList< ScreenInfo > * r
 				if (!noRecursion) {
 					qWarning() << Q_FUNC_INFO << "Found a monitor with NULL handle. Recreating adapters";
 					recreateAdapters();
-					return __screensWithWidgets(result, grabWidgets, true);
+					return __screensWithWidgets(result, grabAreas, true);
 				} else {
 					qWarning() << Q_FUNC_INFO << "Found a monitor with NULL handle (after recreation)";
 					continue;
 				}
 			}
 
-			if (anyWidgetOnThisMonitor(outputDesc.Monitor, grabWidgets))
+			if (anyWidgetOnThisMonitor(outputDesc.Monitor, grabAreas))
 			{
 				ScreenInfo screenInfo;
 				screenInfo.rect = QRect(
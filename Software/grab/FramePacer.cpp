@@ -0,0 +1,169 @@
+/*
+ * FramePacer.cpp
+ *
+ *	Created on: 18.10.2026
+ *		Project: Prismatik
+ *
+ *	Prismatik is a free, open-source software: you can redistribute it and/or
+ *	modify it under the terms of the GNU General Public License as published
+ *	by the Free Software Foundation, either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	Prismatik and Lightpack files is distributed in the hope that it will be
+ *	useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.	See the GNU
+ *	General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with this program.	If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "FramePacer.hpp"
+#include <algorithm>
+#include <cmath>
+
+using namespace std::chrono;
+
+namespace
+{
+	// frames have to fit into the interval with some headroom left for the event loop
+	constexpr const double LatencyHeadroom = 1.25;
+	constexpr const double LatencyAvgWeight = 0.1;
+	constexpr const microseconds MinInterval = microseconds(1000);
+}
+
+namespace Grab
+{
+	FramePacer::FramePacer()
+		: m_targetInterval(50000)
+		, m_interval(50000)
+		, m_refreshPeriod(0)
+		, m_isAlignToDisplayRefresh(false)
+		, m_isFrameStarted(false)
+		, m_hasPreviousFrame(false)
+		, m_latencyAvgUs(0.0)
+		, m_frameTimeSumUs(0.0)
+		, m_latencySumUs(0.0)
+		, m_jitterSumUs(0.0)
+		, m_frameTimesCount(0)
+		, m_framesCount(0)
+		, m_deadlineMisses(0)
+	{
+		m_deadline = Clock::now();
+		m_previousFrameStart = m_deadline;
+	}
+
+	void FramePacer::setTargetInterval(microseconds interval)
+	{
+		m_targetInterval = std::max(interval, MinInterval);
+		updateInterval();
+	}
+
+	void FramePacer::setDisplayRefreshRate(double hz)
+	{
+		m_refreshPeriod = (hz > 0.0) ? microseconds(static_cast<microseconds::rep>(std::round(1000000.0 / hz))) : microseconds(0);
+		updateInterval();
+	}
+
+	void FramePacer::setAlignToDisplayRefresh(bool isEnabled)
+	{
+		m_isAlignToDisplayRefresh = isEnabled;
+		updateInterval();
+	}
+
+	void FramePacer::reset(Clock::time_point now)
+	{
+		m_deadline = now;
+		m_previousFrameStart = now;
+		m_isFrameStarted = false;
+		m_hasPreviousFrame = false;
+	}
+
+	void FramePacer::frameStarted(Clock::time_point now)
+	{
+		if (m_hasPreviousFrame) {
+			m_frameTimeSumUs += duration_cast<microseconds>(now - m_previousFrameStart).count();
+			++m_frameTimesCount;
+		}
+		m_jitterSumUs += std::abs(duration_cast<microseconds>(now - m_deadline).count());
+		m_previousFrameStart = now;
+		m_frameStart = now;
+		m_isFrameStarted = true;
+		m_hasPreviousFrame = true;
+	}
+
+	void FramePacer::frameFinished(Clock::time_point now)
+	{
+		if (!m_isFrameStarted)
+			return;
+		m_isFrameStarted = false;
+
+		const double latencyUs = duration_cast<microseconds>(now - m_frameStart).count();
+		m_latencySumUs += latencyUs;
+		++m_framesCount;
+		m_latencyAvgUs = (m_latencyAvgUs == 0.0) ? latencyUs : m_latencyAvgUs + LatencyAvgWeight * (latencyUs - m_latencyAvgUs);
+		updateInterval();
+
+		m_deadline += m_interval;
+		if (now > m_deadline) {
+			// keep the phase, skip the deadlines which have already passed
+			const auto missed = (now - m_deadline) / m_interval + 1;
+			m_deadline += missed * m_interval;
+			m_deadlineMisses += static_cast<int>(missed);
+		}
+	}
+
+	void FramePacer::skipFrame(Clock::time_point now)
+	{
+		m_isFrameStarted = false;
+		// the time until the next real frame isn't a frame time
+		m_hasPreviousFrame = false;
+
+		m_deadline += m_interval;
+		if (now > m_deadline)
+			m_deadline += ((now - m_deadline) / m_interval + 1) * m_interval;
+	}
+
+	FramePacingStats FramePacer::takeStats()
+	{
+		FramePacingStats stats;
+		stats.intervalMs = m_interval.count() / 1000.0;
+		stats.framesCount = m_framesCount;
+		stats.deadlineMisses = m_deadlineMisses;
+		if (m_frameTimesCount > 0)
+			stats.frameTimeMs = m_frameTimeSumUs / m_frameTimesCount / 1000.0;
+		if (m_framesCount > 0) {
+			stats.latencyMs = m_latencySumUs / m_framesCount / 1000.0;
+			stats.jitterMs = m_jitterSumUs / m_framesCount / 1000.0;
+		}
+
+		m_frameTimeSumUs = 0.0;
+		m_latencySumUs = 0.0;
+		m_jitterSumUs = 0.0;
+		m_frameTimesCount = 0;
+		m_framesCount = 0;
+		m_deadlineMisses = 0;
+		return stats;
+	}
+
+	void FramePacer::updateInterval()
+	{
+		microseconds interval = m_targetInterval;
+		const microseconds sustainable(static_cast<microseconds::rep>(m_latencyAvgUs * LatencyHeadroom));
+		if (sustainable > interval)
+			interval = sustainable;
+
+		if (m_isAlignToDisplayRefresh && m_refreshPeriod.count() > 0) {
+			// nearest multiple of the refresh period for the target, never below what the frames need
+			auto periods = (interval + m_refreshPeriod / 2) / m_refreshPeriod;
+			if (periods < 1)
+				periods = 1;
+			if (periods * m_refreshPeriod < sustainable)
+				++periods;
+			interval = periods * m_refreshPeriod;
+		}
+
+		m_interval = std::max(interval, MinInterval);
+	}
+}
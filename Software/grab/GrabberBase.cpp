@@ -24,9 +24,10 @@
  */
 
 #include "GrabberContext.hpp"
-#include "GrabWidget.hpp"
 #include "GrabberBase.hpp"
 #include "src/debug.h"
+#include <QThread>
+#include <QRunnable>
 #include <cmath>
 
 namespace
@@ -52,55 +53,184 @@ inline QRect & getValidRect(QRect & rect)
 
 } // anonymous namespace
 
+// spreading zones over threads costs more than it saves below these
+static const int ParallelZonesMin = 64;
+static const int ZonesPerBatchMin = 16;
+
+/*!
+	Contiguous range of zones evaluated on a worker thread. Neighbouring widgets usually
+	cover neighbouring screen areas so keeping them together keeps the caches warm.
+*/
+class GrabZonesBatch : public QRunnable
+{
+public:
+	GrabZonesBatch(const GrabberBase *grabber, int from, int to, QRgb *colors)
+		: _grabber(grabber)
+		, _from(from)
+		, _to(to)
+		, _colors(colors)
+	{}
+
+	void run() override
+	{
+		_grabber->evaluateZones(_from, _to, _colors);
+	}
+
+private:
+	const GrabberBase *_grabber;
+	int _from;
+	int _to;
+	QRgb *_colors;
+};
+
 
 GrabberBase::GrabberBase(QObject *parent, GrabberContext *grabberContext) : QObject(parent)
 {
 	_context = grabberContext;
+	m_isIntegralImageEnabled = false;
+	m_samplingStride = 1;
+	m_isDownscaleOnCaptureEnabled = false;
+	m_isGrabbingStarted = false;
+	// the grabbing thread evaluates one batch itself
+	m_zonesThreadPool.setMaxThreadCount(QThread::idealThreadCount() - 1);
 	if (m_timer && m_timer->isActive())
 		m_timer->stop();
 	m_timer.reset(new QTimer(this));
 	m_timer->setTimerType(Qt::PreciseTimer);
-	connect(m_timer.data(), &QTimer::timeout, this, &GrabberBase::grab);
+	m_timer->setSingleShot(true);
+	connect(m_timer.data(), &QTimer::timeout, this, &GrabberBase::onGrabTimeout);
 }
 
 void GrabberBase::setGrabInterval(int msec)
 {
 	DEBUG_LOW_LEVEL << Q_FUNC_INFO <<	this->metaObject()->className();
-	m_timer->setInterval(msec);
+	QMutexLocker locker(&m_framePacerMutex);
+	m_framePacer.setTargetInterval(std::chrono::milliseconds(msec));
+}
+
+void GrabberBase::setDisplayRefreshRate(double hz)
+{
+	DEBUG_LOW_LEVEL << Q_FUNC_INFO << this->metaObject()->className() << hz;
+	QMutexLocker locker(&m_framePacerMutex);
+	m_framePacer.setDisplayRefreshRate(hz);
+}
+
+void GrabberBase::setAlignToDisplayRefreshEnabled(bool isEnabled)
+{
+	DEBUG_LOW_LEVEL << Q_FUNC_INFO << this->metaObject()->className() << isEnabled;
+	QMutexLocker locker(&m_framePacerMutex);
+	m_framePacer.setAlignToDisplayRefresh(isEnabled);
+}
+
+int GrabberBase::grabInterval() const
+{
+	QMutexLocker locker(&m_framePacerMutex);
+	return std::chrono::duration_cast<std::chrono::milliseconds>(m_framePacer.targetInterval()).count();
+}
+
+Grab::FramePacingStats GrabberBase::takeFramePacingStats()
+{
+	QMutexLocker locker(&m_framePacerMutex);
+	return m_framePacer.takeStats();
+}
+
+void GrabberBase::setIntegralImageEnabled(bool isEnabled)
+{
+	DEBUG_LOW_LEVEL << Q_FUNC_INFO << this->metaObject()->className() << isEnabled;
+	m_isIntegralImageEnabled = isEnabled;
+	if (!isEnabled)
+		_integralImages.clear();
+}
+
+void GrabberBase::setSamplingStride(int samplingStride)
+{
+	DEBUG_LOW_LEVEL << Q_FUNC_INFO << this->metaObject()->className() << samplingStride;
+	m_samplingStride = samplingStride;
+}
+
+void GrabberBase::setDownscaleOnCaptureEnabled(bool isEnabled)
+{
+	DEBUG_LOW_LEVEL << Q_FUNC_INFO << this->metaObject()->className() << isEnabled;
+	m_isDownscaleOnCaptureEnabled = isEnabled;
 }
 
 void GrabberBase::startGrabbing()
 {
 	DEBUG_LOW_LEVEL << Q_FUNC_INFO << this->metaObject()->className();
 	grabScreensCount = 0;
-	m_timer->start();
+	m_isGrabbingStarted = true;
+	{
+		QMutexLocker locker(&m_framePacerMutex);
+		m_framePacer.reset(Grab::FramePacer::Clock::now());
+	}
+	scheduleNextGrab();
 }
 
 void GrabberBase::stopGrabbing()
 {
 	DEBUG_LOW_LEVEL << Q_FUNC_INFO << this->metaObject()->className();
 	DEBUG_MID_LEVEL << "grabbed" << grabScreensCount << "frames";
+	m_isGrabbingStarted = false;
 	m_timer->stop();
 }
 
 bool GrabberBase::isGrabbingStarted() const
 {
 	DEBUG_LOW_LEVEL << Q_FUNC_INFO << this->metaObject()->className();
-	return m_timer->isActive();
+	return m_isGrabbingStarted;
 }
 
-const GrabbedScreen * GrabberBase::screenOfRect(const QRect &rect) const
+/*!
+	Arms the timer for the next deadline of the frame pacer. QTimer has millisecond
+	resolution, the delay is rounded to the nearest millisecond.
+*/
+void GrabberBase::scheduleNextGrab()
 {
-	QPoint center = rect.center();
-	for (int i = 0; i < _screensWithWidgets.size(); ++i) {
-		if (_screensWithWidgets[i].screenInfo.rect.contains(center))
-			return &_screensWithWidgets[i];
+	Grab::FramePacer::Clock::time_point deadline;
+	{
+		QMutexLocker locker(&m_framePacerMutex);
+		deadline = m_framePacer.nextDeadline();
 	}
+	const auto delay = std::chrono::duration_cast<std::chrono::milliseconds>(
+		deadline - Grab::FramePacer::Clock::now() + std::chrono::microseconds(500));
+	m_timer->start(qMax(0, static_cast<int>(delay.count())));
+}
+
+void GrabberBase::onGrabTimeout()
+{
+	if (!m_isGrabbingStarted)
+		return;
+	grab();
+	if (m_isGrabbingStarted)
+		scheduleNextGrab();
+}
+
+const GrabbedScreen * GrabberBase::screenOfRect(const QRect &rect) const
+{
+	const int screenIndex = screenIndexOfRect(rect);
+	if (screenIndex < 0)
+		return NULL;
+	return &_screensWithWidgets[screenIndex];
+}
+
+/*!
+	Grabbed screen which covers the biggest part of \a rect. For a rect split between two
+	monitors that's the one containing its center. Grabbers capturing sub-regions of a monitor
+	get the region which contains the whole rect if there is one.
+*/
+int GrabberBase::screenIndexOfRect(const QRect &rect) const
+{
+	int result = -1;
+	qint64 maxArea = 0;
 	for (int i = 0; i < _screensWithWidgets.size(); ++i) {
-		if (_screensWithWidgets[i].screenInfo.rect.intersects(rect))
-			return &_screensWithWidgets[i];
+		const QRect intersected = _screensWithWidgets[i].screenInfo.rect.intersected(rect);
+		const qint64 area = static_cast<qint64>(intersected.width()) * intersected.height();
+		if (!intersected.isEmpty() && area > maxArea) {
+			maxArea = area;
+			result = i;
+		}
 	}
-	return NULL;
+	return result;
 }
 
 bool GrabberBase::isReallocationNeeded(const QList< ScreenInfo > &screensWithWidgets) const
@@ -115,12 +245,183 @@ bool GrabberBase::isReallocationNeeded(const QList< ScreenInfo > &screensWithWid
 	return false;
 }
 
+void GrabberBase::prepareZone(const GrabbedArea &area, GrabbedZone &zone) const
+{
+	zone.screenIndex = -1;
+	zone.fallbackColor = qRgb(0,0,0);
+
+	if (!area.isEnabled)
+		return;
+
+	QRect widgetRect = area.rect;
+	getValidRect(widgetRect);
+
+	const int screenIndex = screenIndexOfRect(widgetRect);
+	if (screenIndex < 0) {
+		DEBUG_HIGH_LEVEL << Q_FUNC_INFO << " widget is out of screen " << Debug::toString(widgetRect);
+		zone.fallbackColor = 0;
+		return;
+	}
+	const GrabbedScreen *grabbedScreen = &_screensWithWidgets[screenIndex];
+	DEBUG_HIGH_LEVEL << Q_FUNC_INFO << Debug::toString(widgetRect);
+	QRect monitorRect = grabbedScreen->screenInfo.rect;
+
+	QRect clippedRect = monitorRect.intersected(widgetRect);
+
+	// Checking for the 'grabme' widget position inside the monitor that is used to capture color
+	if( !clippedRect.isValid() ){
+
+		DEBUG_HIGH_LEVEL << "Widget 'grabme' is out of screen:" << Debug::toString(clippedRect);
+		return;
+	}
+
+	// Convert coordinates from "Main" desktop coord-system to capture-monitor coord-system
+	QRect preparedRect = clippedRect.translated(-monitorRect.x(), -monitorRect.y());
+
+	// grabbed screen is rotated => rotate the widget
+	if (grabbedScreen->rotation != 0) {
+		if (grabbedScreen->rotation % 4 == 1) { // rotated 90
+			preparedRect.setCoords(
+				monitorRect.height() - preparedRect.bottom(),
+				preparedRect.left(),
+				monitorRect.height() - preparedRect.top(),
+				preparedRect.right()
+			);
+		} else if (grabbedScreen->rotation % 4 == 2) { // rotated 180
+			preparedRect.setCoords(
+				monitorRect.width() - preparedRect.right(),
+				monitorRect.height() - preparedRect.bottom(),
+				monitorRect.width() - preparedRect.left(),
+				monitorRect.height() - preparedRect.top()
+			);
+		} else if (grabbedScreen->rotation % 4 == 3) { // rotated 270
+			preparedRect.setCoords(
+				preparedRect.top(),
+				monitorRect.width() - preparedRect.right(),
+				preparedRect.bottom(),
+				monitorRect.width() - preparedRect.left()
+			);
+		}
+	}
+
+	// grabbed screen was scaled => scale the widget
+	if (grabbedScreen->scale != 1.0)
+		preparedRect.setCoords(
+			std::ceil(grabbedScreen->scale * preparedRect.left()),
+			std::ceil(grabbedScreen->scale * preparedRect.top()),
+			std::floor(grabbedScreen->scale * preparedRect.right()),
+			std::floor(grabbedScreen->scale * preparedRect.bottom())
+		);
+
+	if( !preparedRect.isValid() ){
+		qWarning() << Q_FUNC_INFO << " preparedRect is not valid:" << Debug::toString(preparedRect);
+		// width and height can't be negative
+		return;
+	}
+
+	zone.screenIndex = screenIndex;
+	zone.rect = preparedRect;
+}
+
+/*!
+	Builds one summed-area table per grabbed screen, covering the bounding rect of all zones
+	on that screen. Building is proportional to the screen area, after that every zone
+	average is a four-corner lookup regardless of its size.
+*/
+void GrabberBase::updateIntegralImages()
+{
+	_integralImages.resize(_screensWithWidgets.size());
+
+	QVector<QRect> boundingRects(_screensWithWidgets.size());
+	for (const GrabbedZone &zone : _zones) {
+		if (zone.screenIndex >= 0)
+			boundingRects[zone.screenIndex] = boundingRects[zone.screenIndex].united(zone.rect);
+	}
+
+	const int bytesPerPixel = 4;
+	for (int i = 0; i < _screensWithWidgets.size(); ++i) {
+		const GrabbedScreen &grabbedScreen = _screensWithWidgets[i];
+		if (boundingRects[i].isEmpty()) {
+			_integralImages[i].rect = QRect();
+			continue;
+		}
+		Q_ASSERT(grabbedScreen.imgData);
+		Grab::Calculations::calculateIntegralImage(
+			grabbedScreen.imgData, grabbedScreen.imgFormat,
+			grabbedScreen.bytesPerRow > 0 ? grabbedScreen.bytesPerRow : grabbedScreen.screenInfo.rect.width() * bytesPerPixel,
+			boundingRects[i], _integralImages[i]);
+	}
+}
+
+QRgb GrabberBase::evaluateZone(const GrabbedZone &zone) const
+{
+	if (zone.screenIndex < 0)
+		return zone.fallbackColor;
+
+	if (m_isIntegralImageEnabled
+		&& (size_t)zone.rect.width() * zone.rect.height() <= Grab::Calculations::IntegralImageMaxArea
+		&& _integralImages[zone.screenIndex].rect.contains(zone.rect))
+	{
+		return Grab::Calculations::calculateAvgColor(_integralImages[zone.screenIndex], zone.rect);
+	}
+
+	const int bytesPerPixel = 4;
+	const GrabbedScreen *grabbedScreen = &_screensWithWidgets[zone.screenIndex];
+	Q_ASSERT(grabbedScreen->imgData);
+	return Grab::Calculations::calculateAvgColor(
+		grabbedScreen->imgData, grabbedScreen->imgFormat,
+		grabbedScreen->bytesPerRow > 0 ? grabbedScreen->bytesPerRow : grabbedScreen->screenInfo.rect.width() * bytesPerPixel,
+		zone.rect, m_samplingStride);
+}
+
+void GrabberBase::evaluateZones(int from, int to, QRgb *colors) const
+{
+	for (int i = from; i < to; ++i)
+		colors[i] = evaluateZone(_zones[i]);
+}
+
+void GrabberBase::evaluateAllZones()
+{
+	const int zonesCount = _zones.size();
+	_zoneColors.resize(zonesCount);
+
+	// preallocated, each batch writes only to its own range
+	QRgb * const colors = _zoneColors.data();
+
+	const int workersCount = m_zonesThreadPool.maxThreadCount();
+	if (zonesCount < ParallelZonesMin || workersCount < 1) {
+		evaluateZones(0, zonesCount, colors);
+		return;
+	}
+
+	const int batchesCount = qMin(workersCount + 1, zonesCount / ZonesPerBatchMin);
+	const int batchSize = (zonesCount + batchesCount - 1) / batchesCount;
+
+	for (int from = batchSize; from < zonesCount; from += batchSize)
+		m_zonesThreadPool.start(new GrabZonesBatch(this, from, qMin(from + batchSize, zonesCount), colors));
+	evaluateZones(0, batchSize, colors);
+	m_zonesThreadPool.waitForDone();
+}
+
 void GrabberBase::grab()
 {
 	DEBUG_HIGH_LEVEL << Q_FUNC_INFO << this->metaObject()->className();
+	{
+		QMutexLocker locker(&m_framePacerMutex);
+		m_framePacer.frameStarted(Grab::FramePacer::Clock::now());
+	}
+	grabFrame();
+	// processing of the frame is connected directly and is measured as well
+	QMutexLocker locker(&m_framePacerMutex);
+	m_framePacer.frameFinished(Grab::FramePacer::Clock::now());
+}
+
+void GrabberBase::grabFrame()
+{
 	QList< ScreenInfo > screens2Grab;
 	screens2Grab.reserve(5);
-	screensWithWidgets(&screens2Grab, *_context->grabWidgets);
+	_grabAreas = _context->grabAreas();
+	screensWithWidgets(&screens2Grab, _grabAreas);
 	if (screens2Grab.empty()) {
 		qCritical() << Q_FUNC_INFO << "No screens with widgets found";
 		emit frameGrabAttempted(GrabResultError);
@@ -134,95 +435,30 @@ void GrabberBase::grab()
 			return;
 		}
 	}
+	const auto grabStarted = std::chrono::steady_clock::now();
 	_lastGrabResult = grabScreens();
 
 	if (_lastGrabResult == GrabResultOk) {
+		_context->grabStarted = grabStarted;
+		_context->grabFinished = std::chrono::steady_clock::now();
 		++grabScreensCount;
 		_context->grabResult->clear();
 
-		for (int i = 0; i < _context->grabWidgets->size(); ++i) {
-			if (!_context->grabWidgets->at(i)->isAreaEnabled()) {
-				_context->grabResult->append(qRgb(0,0,0));
-				continue;
-			}
-			QRect widgetRect = _context->grabWidgets->at(i)->frameGeometry();
-			getValidRect(widgetRect);
-
-			const GrabbedScreen *grabbedScreen = screenOfRect(widgetRect);
-			if (grabbedScreen == NULL) {
-				DEBUG_HIGH_LEVEL << Q_FUNC_INFO << " widget is out of screen " << Debug::toString(widgetRect);
-				_context->grabResult->append(0);
-				continue;
-			}
-			DEBUG_HIGH_LEVEL << Q_FUNC_INFO << Debug::toString(widgetRect);
-			QRect monitorRect = grabbedScreen->screenInfo.rect;
-
-			QRect clippedRect = monitorRect.intersected(widgetRect);
-
-			// Checking for the 'grabme' widget position inside the monitor that is used to capture color
-			if( !clippedRect.isValid() ){
-
-				DEBUG_HIGH_LEVEL << "Widget 'grabme' is out of screen:" << Debug::toString(clippedRect);
-
-				_context->grabResult->append(qRgb(0,0,0));
-				continue;
-			}
-
-			// Convert coordinates from "Main" desktop coord-system to capture-monitor coord-system
-			QRect preparedRect = clippedRect.translated(-monitorRect.x(), -monitorRect.y());
-
-			// grabbed screen is rotated => rotate the widget
-			if (grabbedScreen->rotation != 0) {
-				if (grabbedScreen->rotation % 4 == 1) { // rotated 90
-					preparedRect.setCoords(
-						monitorRect.height() - preparedRect.bottom(),
-						preparedRect.left(),
-						monitorRect.height() - preparedRect.top(),
-						preparedRect.right()
-					);
-				} else if (grabbedScreen->rotation % 4 == 2) { // rotated 180
-					preparedRect.setCoords(
-						monitorRect.width() - preparedRect.right(),
-						monitorRect.height() - preparedRect.bottom(),
-						monitorRect.width() - preparedRect.left(),
-						monitorRect.height() - preparedRect.top()
-					);
-				} else if (grabbedScreen->rotation % 4 == 3) { // rotated 270
-					preparedRect.setCoords(
-						preparedRect.top(),
-						monitorRect.width() - preparedRect.right(),
-						preparedRect.bottom(),
-						monitorRect.width() - preparedRect.left()
-					);
-				}
-			}
-
-			// grabbed screen was scaled => scale the widget
-			if (grabbedScreen->scale != 1.0)
-				preparedRect.setCoords(
-					std::ceil(grabbedScreen->scale * preparedRect.left()),
-					std::ceil(grabbedScreen->scale * preparedRect.top()),
-					std::floor(grabbedScreen->scale * preparedRect.right()),
-					std::floor(grabbedScreen->scale * preparedRect.bottom())
-				);
-
-			if( !preparedRect.isValid() ){
-				qWarning() << Q_FUNC_INFO << " preparedRect is not valid:" << Debug::toString(preparedRect);
-				// width and height can't be negative
-
-				_context->grabResult->append(qRgb(0,0,0));
-				continue;
-			}
-
-			const int bytesPerPixel = 4;
-			Q_ASSERT(grabbedScreen->imgData);
-			QRgb avgColor = Grab::Calculations::calculateAvgColor(
-				grabbedScreen->imgData, grabbedScreen->imgFormat,
-				grabbedScreen->bytesPerRow > 0 ? grabbedScreen->bytesPerRow : grabbedScreen->screenInfo.rect.width() * bytesPerPixel,
-				preparedRect);
-			_context->grabResult->append(avgColor);
-		}
+		_zones.resize(_grabAreas.size());
+		for (int i = 0; i < _grabAreas.size(); ++i)
+			prepareZone(_grabAreas[i], _zones[i]);
+
+		if (m_isIntegralImageEnabled)
+			updateIntegralImages();
 
+		evaluateAllZones();
+	}
+	releaseScreens();
+
+	if (_lastGrabResult == GrabResultOk) {
+		_context->grabResult->reserve(_zoneColors.size());
+		for (const QRgb color : _zoneColors)
+			_context->grabResult->append(color);
 	}
 	emit frameGrabAttempted(_lastGrabResult);
 }
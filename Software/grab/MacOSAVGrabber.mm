@@ -371,7 +371,7 @@ MacOSAVGrabber::~MacOSAVGrabber()
 void MacOSAVGrabber::setGrabInterval(int msec)
 {
 	DEBUG_LOW_LEVEL << Q_FUNC_INFO <<	this->metaObject()->className();
-	m_timer->setInterval(msec);
+	GrabberBase::setGrabInterval(msec);
 
 	double framerate = 1000.0 / msec;
 	foreach (MacOSNativeAVCapture* capture, _captures)
@@ -389,7 +389,7 @@ void MacOSAVGrabber::startGrabbing()
 	if (_screensWithWidgets.empty())
 	{
 		QList<ScreenInfo> screens2Grab;
-		screensWithWidgets(&screens2Grab, *_context->grabWidgets);
+		screensWithWidgets(&screens2Grab, _context->grabAreas());
 		reallocate(screens2Grab);
 	}
 
@@ -404,20 +404,19 @@ void MacOSAVGrabber::startGrabbing()
 		CGDirectDisplayID display = static_cast<CGDirectDisplayID>(reinterpret_cast<intptr_t>(grabScreen.screenInfo.handle));
 		MacOSNativeAVCapture* capture = [[MacOSNativeAVCapture alloc] initWithDisplay:display];
 		if ([capture createCaptureSession]) {
-			[capture setMaximumScreenInputFramerate:(m_timer->interval() > 0 ? 1000.0f / m_timer->interval() : 1.0f)];
+			[capture setMaximumScreenInputFramerate:(grabInterval() > 0 ? 1000.0f / grabInterval() : 1.0f)];
 			_captures.insert(display, capture);
 			[capture start];
 		}
 	}
 
-	m_timer->start();
+	GrabberBase::startGrabbing();
 }
 
 void MacOSAVGrabber::stopGrabbing()
 {
 	DEBUG_LOW_LEVEL << Q_FUNC_INFO << this->metaObject()->className();
-	DEBUG_MID_LEVEL << "grabbed" << grabScreensCount << "frames";
-	m_timer->stop();
+	GrabberBase::stopGrabbing();
 
 	foreach (MacOSNativeAVCapture* capture, _captures) {
 		[capture stop];
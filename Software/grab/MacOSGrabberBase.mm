@@ -72,12 +72,12 @@ bool MacOSGrabberBase::allocateScreenBuffer(const ScreenInfo& screen,
 }
 
 bool MacOSGrabberBase::getScreenInfoFromRect(const CGDirectDisplayID display,
-						   const QList<GrabWidget *>& grabWidgets,
+						   const QList<GrabbedArea>& grabAreas,
 						   ScreenInfo& screenInfo)
 {
 	const CGRect displayRect = CGDisplayBounds(display);
-	for (const GrabWidget* grabWidget : grabWidgets) {
-		if (CGRectContainsPoint(displayRect, grabWidget->geometry().center().toCGPoint())) {
+	for (const GrabbedArea& grabArea : grabAreas) {
+		if (CGRectContainsPoint(displayRect, grabArea.rect.center().toCGPoint())) {
 			const int x1 = displayRect.origin.x;
 			const int y1 = displayRect.origin.y;
 			const int x2 = displayRect.size.width  + x1 - 1;
@@ -115,7 +115,7 @@ double MacOSGrabberBase::getDisplayRefreshRate(const CGDirectDisplayID display)
 
 QList<ScreenInfo>* MacOSGrabberBase::screensWithWidgets(
 	QList<ScreenInfo>* result,
-	const QList<GrabWidget *> &grabWidgets)
+	const QList<GrabbedArea> &grabAreas)
 {
 	CGDirectDisplayID displays[kMaxDisplaysCount];
 	uint32_t displayCount = 0;
@@ -126,7 +126,7 @@ QList<ScreenInfo>* MacOSGrabberBase::screensWithWidgets(
 	if (err == kCGErrorSuccess) {
 		for (unsigned int i = 0; i < displayCount; ++i) {
 			ScreenInfo screenInfo;
-			if (getScreenInfoFromRect(displays[i], grabWidgets, screenInfo))
+			if (getScreenInfoFromRect(displays[i], grabAreas, screenInfo))
 				result->append(screenInfo);
 		}
 
@@ -164,7 +164,7 @@ GrabResult MacOSGrabberBase::grabScreens()
 {
 #ifdef SAVE_FRAME_TO_FILE
 	static unsigned long _count = 0;
-	_count += m_timer->interval();
+	_count += grabInterval();
 #endif // SAVE_FRAME_TO_FILE
 
 	for (GrabbedScreen& grabScreen : _screensWithWidgets)
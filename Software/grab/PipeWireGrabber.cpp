@@ -0,0 +1,651 @@
+/*
+ * PipeWireGrabber.cpp
+ *
+ *	Created on: 18.10.2026
+ *		Project: Prismatik
+ *
+ *	Prismatik is a free, open-source software: you can redistribute it and/or
+ *	modify it under the terms of the GNU General Public License as published
+ *	by the Free Software Foundation, either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	Prismatik and Lightpack files is distributed in the hope that it will be
+ *	useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.	See the GNU
+ *	General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with this program.	If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "PipeWireGrabber.hpp"
+
+#ifdef PIPEWIRE_GRAB_SUPPORT
+
+#include <QGuiApplication>
+#include <QScreen>
+#include <QDBusConnection>
+#include <QDBusMessage>
+#include <QDBusArgument>
+#include <QDBusObjectPath>
+#include <QDBusVariant>
+#include <QDBusUnixFileDescriptor>
+#include <cmath>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <linux/dma-buf.h>
+
+#include <pipewire/pipewire.h>
+#include <spa/param/video/format-utils.h>
+#include <spa/param/buffers.h>
+
+#include "../src/debug.h"
+
+struct PipeWireStream
+{
+	PipeWireStream()
+	{
+		spa_zero(listener);
+		spa_zero(format);
+	}
+
+	pw_stream *stream = nullptr;
+	spa_hook listener;
+	uint32_t nodeId = 0;
+	QRect rect; // desktop area the stream shows
+	spa_video_info_raw format;
+	bool isFormatValid = false;
+	pw_buffer *pending = nullptr; // latest frame, not taken by the grabber yet
+	pw_buffer *current = nullptr; // frame the grabber reads, goes back to the stream once the next one is taken
+};
+
+namespace
+{
+	const QString PortalService = QStringLiteral("org.freedesktop.portal.Desktop");
+	const QString PortalPath = QStringLiteral("/org/freedesktop/portal/desktop");
+	const QString ScreenCastInterface = QStringLiteral("org.freedesktop.portal.ScreenCast");
+	const QString RequestInterface = QStringLiteral("org.freedesktop.portal.Request");
+	const QString SessionInterface = QStringLiteral("org.freedesktop.portal.Session");
+
+	const uint SourceTypeMonitor = 1;
+	const uint CursorModeHidden = 1;
+	const uint PersistModeApplication = 1;
+
+	// size asked from the compositor, the grab zones are averages anyway
+	constexpr const double PreferredScale = 0.25;
+	constexpr const int BytesPerPixel = 4;
+
+	bool isFrameBuffer(const pw_buffer *buffer)
+	{
+		const spa_data &data = buffer->buffer->datas[0];
+		return data.data != nullptr
+			&& data.chunk->size > 0
+			&& (data.chunk->flags & SPA_CHUNK_FLAG_CORRUPTED) == 0;
+	}
+
+	void syncDmaBuf(const pw_buffer *buffer, uint64_t flags)
+	{
+		const spa_data &data = buffer->buffer->datas[0];
+		if (data.type != SPA_DATA_DmaBuf)
+			return;
+		struct dma_buf_sync sync;
+		sync.flags = flags | DMA_BUF_SYNC_READ;
+		ioctl(data.fd, DMA_BUF_IOCTL_SYNC, &sync);
+	}
+
+	void releaseBuffer(PipeWireStream *s, pw_buffer *buffer)
+	{
+		syncDmaBuf(buffer, DMA_BUF_SYNC_END);
+		pw_stream_queue_buffer(s->stream, buffer);
+	}
+
+	// stream callbacks run in the PipeWire loop thread with the loop locked
+
+	void onStreamStateChanged(void *data, pw_stream_state old, pw_stream_state state, const char *error)
+	{
+		Q_UNUSED(old);
+		PipeWireStream *s = static_cast<PipeWireStream *>(data);
+		DEBUG_LOW_LEVEL << Q_FUNC_INFO << s->nodeId << pw_stream_state_as_string(state);
+		if (state == PW_STREAM_STATE_ERROR)
+			qWarning() << Q_FUNC_INFO << "stream of node" << s->nodeId << "failed:" << error;
+	}
+
+	void onStreamParamChanged(void *data, uint32_t id, const spa_pod *param)
+	{
+		PipeWireStream *s = static_cast<PipeWireStream *>(data);
+		if (param == nullptr || id != SPA_PARAM_Format)
+			return;
+
+		uint32_t mediaType, mediaSubtype;
+		s->isFormatValid = false;
+		if (spa_format_parse(param, &mediaType, &mediaSubtype) < 0
+			|| mediaType != SPA_MEDIA_TYPE_video || mediaSubtype != SPA_MEDIA_SUBTYPE_raw
+			|| spa_format_video_raw_parse(param, &s->format) < 0)
+			return;
+
+		switch (s->format.format) {
+		case SPA_VIDEO_FORMAT_BGRx:
+		case SPA_VIDEO_FORMAT_BGRA:
+		case SPA_VIDEO_FORMAT_RGBx:
+		case SPA_VIDEO_FORMAT_RGBA:
+			s->isFormatValid = s->format.size.width > 0 && s->format.size.height > 0;
+			break;
+		default:
+			qWarning() << Q_FUNC_INFO << "unsupported video format" << s->format.format;
+			return;
+		}
+		DEBUG_LOW_LEVEL << Q_FUNC_INFO << s->nodeId << "negotiated" << s->format.size.width << "x" << s->format.size.height;
+
+		// one buffer is held by the grabber, one is pending, the rest are for the producer
+		uint8_t buffer[256];
+		spa_pod_builder builder = SPA_POD_BUILDER_INIT(buffer, sizeof(buffer));
+		const spa_pod *params[] = {
+			static_cast<const spa_pod *>(spa_pod_builder_add_object(&builder,
+				SPA_TYPE_OBJECT_ParamBuffers, SPA_PARAM_Buffers,
+				SPA_PARAM_BUFFERS_buffers, SPA_POD_CHOICE_RANGE_Int(4, 3, 8),
+				SPA_PARAM_BUFFERS_dataType, SPA_POD_CHOICE_FLAGS_Int((1 << SPA_DATA_MemPtr) | (1 << SPA_DATA_MemFd) | (1 << SPA_DATA_DmaBuf))))
+		};
+		pw_stream_update_params(s->stream, params, 1);
+	}
+
+	void onStreamRemoveBuffer(void *data, pw_buffer *buffer)
+	{
+		PipeWireStream *s = static_cast<PipeWireStream *>(data);
+		if (s->pending == buffer)
+			s->pending = nullptr;
+		if (s->current == buffer) {
+			syncDmaBuf(buffer, DMA_BUF_SYNC_END);
+			s->current = nullptr;
+		}
+	}
+
+	void onStreamProcess(void *data)
+	{
+		PipeWireStream *s = static_cast<PipeWireStream *>(data);
+
+		// only the latest frame matters, give the older ones straight back
+		pw_buffer *latest = nullptr;
+		while (pw_buffer *buffer = pw_stream_dequeue_buffer(s->stream)) {
+			if (!isFrameBuffer(buffer)) {
+				pw_stream_queue_buffer(s->stream, buffer);
+				continue;
+			}
+			if (latest)
+				pw_stream_queue_buffer(s->stream, latest);
+			latest = buffer;
+		}
+		if (latest == nullptr)
+			return;
+
+		if (s->pending)
+			pw_stream_queue_buffer(s->stream, s->pending);
+		s->pending = latest;
+	}
+
+	const pw_stream_events * streamEvents()
+	{
+		static const pw_stream_events events = []() {
+			pw_stream_events result;
+			spa_zero(result);
+			result.version = PW_VERSION_STREAM_EVENTS;
+			result.state_changed = onStreamStateChanged;
+			result.param_changed = onStreamParamChanged;
+			result.remove_buffer = onStreamRemoveBuffer;
+			result.process = onStreamProcess;
+			return result;
+		}();
+		return &events;
+	}
+
+	QString objectPathOrString(const QVariant &value)
+	{
+		if (value.userType() == qMetaTypeId<QDBusObjectPath>())
+			return value.value<QDBusObjectPath>().path();
+		return value.toString();
+	}
+
+	bool readIntPair(const QVariant &value, int &first, int &second)
+	{
+		if (value.userType() != qMetaTypeId<QDBusArgument>())
+			return false;
+		const QDBusArgument argument = value.value<QDBusArgument>();
+		argument.beginStructure();
+		argument >> first >> second;
+		argument.endStructure();
+		return true;
+	}
+}
+
+PipeWireGrabber::PipeWireGrabber(QObject *parent, GrabberContext *context)
+	: GrabberBase(parent, context)
+	, m_portalState(PortalStateIdle)
+	, m_portalVersion(0)
+	, m_handleTokenCounter(0)
+	, m_loop(nullptr)
+	, m_context(nullptr)
+	, m_core(nullptr)
+{
+	// created in the GUI thread, the screens are needed for nodes without a position
+	for (const QScreen *screen : QGuiApplication::screens())
+		m_desktopScreens.append(screen->geometry());
+	if (m_desktopScreens.isEmpty())
+		m_desktopScreens.append(QRect(0, 0, 1920, 1080));
+
+	pw_init(nullptr, nullptr);
+	m_loop = pw_thread_loop_new("prismatik-screencast", nullptr);
+	if (m_loop) {
+		m_context = pw_context_new(pw_thread_loop_get_loop(m_loop), nullptr, 0);
+		pw_thread_loop_start(m_loop);
+	}
+	if (m_context == nullptr)
+		qCritical() << Q_FUNC_INFO << "couldn't create PipeWire context";
+}
+
+PipeWireGrabber::~PipeWireGrabber()
+{
+	_screensWithWidgets.clear();
+	destroyStreams();
+	if (m_loop)
+		pw_thread_loop_stop(m_loop);
+	if (m_context)
+		pw_context_destroy(m_context);
+	if (m_loop)
+		pw_thread_loop_destroy(m_loop);
+	closeSession();
+}
+
+void PipeWireGrabber::startGrabbing()
+{
+	DEBUG_LOW_LEVEL << Q_FUNC_INFO << this->metaObject()->className();
+
+	if (m_portalState == PortalStateIdle || m_portalState == PortalStateFailed)
+		startScreenCast();
+	else if (m_portalState == PortalStateStarted)
+		setStreamsActive(true);
+
+	GrabberBase::startGrabbing();
+}
+
+void PipeWireGrabber::stopGrabbing()
+{
+	DEBUG_LOW_LEVEL << Q_FUNC_INFO << this->metaObject()->className();
+
+	GrabberBase::stopGrabbing();
+
+	// the session stays open, so resuming doesn't ask the user again
+	if (m_portalState == PortalStateStarted)
+		setStreamsActive(false);
+}
+
+void PipeWireGrabber::grab()
+{
+	if (m_portalState != PortalStateStarted) {
+		{
+			// keep the schedule, or the timer would fire right away while the portal dialog is open
+			QMutexLocker locker(&m_framePacerMutex);
+			m_framePacer.skipFrame(Grab::FramePacer::Clock::now());
+		}
+		emit frameGrabAttempted(m_portalState == PortalStateFailed ? GrabResultError : GrabResultFrameNotReady);
+		return;
+	}
+
+	GrabberBase::grab();
+}
+
+QList<ScreenInfo> * PipeWireGrabber::screensWithWidgets(QList<ScreenInfo> *result, const QList<GrabbedArea> &grabAreas)
+{
+	result->clear();
+
+	for (int i = 0; i < m_streams.size(); ++i) {
+		ScreenInfo screen;
+		intptr_t handle = i;
+		screen.handle = reinterpret_cast<void *>(handle);
+		screen.rect = m_streams[i]->rect;
+		for (const GrabbedArea &area : grabAreas) {
+			if (screen.rect.intersects(area.rect)) {
+				result->append(screen);
+				break;
+			}
+		}
+	}
+
+	return result;
+}
+
+bool PipeWireGrabber::reallocate(const QList<ScreenInfo> &screens)
+{
+	_screensWithWidgets.clear();
+
+	for (const ScreenInfo &screen : screens) {
+		GrabbedScreen grabScreen;
+		grabScreen.screenInfo = screen;
+		grabScreen.associatedData = m_streams.value(reinterpret_cast<intptr_t>(screen.handle));
+		if (grabScreen.associatedData == nullptr)
+			return false;
+		_screensWithWidgets.append(grabScreen);
+	}
+
+	return true;
+}
+
+/*!
+	The held buffers are read in place, the loop stays locked from here to \a releaseScreens()
+	so the streams can't remove them meanwhile.
+*/
+GrabResult PipeWireGrabber::grabScreens()
+{
+	pw_thread_loop_lock(m_loop);
+
+	bool isUpdated = false;
+	for (GrabbedScreen &screen : _screensWithWidgets) {
+		PipeWireStream *s = static_cast<PipeWireStream *>(screen.associatedData);
+
+		if (s->pending) {
+			if (s->current)
+				releaseBuffer(s, s->current);
+			s->current = s->pending;
+			s->pending = nullptr;
+			syncDmaBuf(s->current, DMA_BUF_SYNC_START);
+			isUpdated = true;
+		}
+
+		if (s->current == nullptr || !s->isFormatValid)
+			return GrabResultFrameNotReady;
+
+		const spa_data &data = s->current->buffer->datas[0];
+		screen.imgData = static_cast<const unsigned char *>(data.data) + data.chunk->offset;
+		screen.imgDataSize = data.chunk->size;
+		screen.bytesPerRow = data.chunk->stride > 0 ? data.chunk->stride : s->format.size.width * BytesPerPixel;
+		screen.imgFormat = (s->format.format == SPA_VIDEO_FORMAT_BGRx || s->format.format == SPA_VIDEO_FORMAT_BGRA)
+			? BufferFormatArgb : BufferFormatAbgr;
+		screen.scale = static_cast<double>(s->format.size.width) / screen.screenInfo.rect.width();
+	}
+
+	return isUpdated ? GrabResultOk : GrabResultFrameNotReady;
+}
+
+void PipeWireGrabber::releaseScreens()
+{
+	pw_thread_loop_unlock(m_loop);
+}
+
+void PipeWireGrabber::startScreenCast()
+{
+	DEBUG_LOW_LEVEL << Q_FUNC_INFO;
+
+	const QByteArray testNodes = qgetenv("PRISMATIK_PIPEWIRE_NODE");
+	if (!testNodes.isEmpty()) {
+		QList< QPair<uint, QRect> > nodes;
+		const QList<QByteArray> ids = testNodes.split(',');
+		for (int i = 0; i < ids.size(); ++i) {
+			bool ok = false;
+			const uint nodeId = ids[i].trimmed().toUInt(&ok);
+			if (ok)
+				nodes.append(qMakePair(nodeId, m_desktopScreens.value(i, m_desktopScreens.first())));
+		}
+		m_portalState = connectStreams(-1, nodes) ? PortalStateStarted : PortalStateFailed;
+		return;
+	}
+
+	m_portalVersion = portalProperty(QStringLiteral("version")).toUInt();
+	if (m_portalVersion == 0) {
+		qWarning() << Q_FUNC_INFO << "xdg-desktop-portal ScreenCast interface is not available";
+		m_portalState = PortalStateFailed;
+		return;
+	}
+
+	QVariantMap options;
+	options.insert(QStringLiteral("session_handle_token"), newHandleToken());
+	callPortal(QStringLiteral("CreateSession"), QVariantList(), options, PortalStateCreatingSession);
+}
+
+/*!
+	Calls a ScreenCast method which answers through a Request object. The response is
+	subscribed before the call, the path of the request is known from the handle token.
+*/
+bool PipeWireGrabber::callPortal(const QString &method, const QVariantList &arguments, QVariantMap options, PortalState nextState)
+{
+	QDBusConnection bus = QDBusConnection::sessionBus();
+
+	const QString token = newHandleToken();
+	options.insert(QStringLiteral("handle_token"), token);
+	const QString sender = bus.baseService().mid(1).replace(QLatin1Char('.'), QLatin1Char('_'));
+	m_requestPath = QStringLiteral("/org/freedesktop/portal/desktop/request/%1/%2").arg(sender, token);
+	bus.connect(PortalService, m_requestPath, RequestInterface, QStringLiteral("Response"),
+				this, SLOT(onPortalResponse(uint, QVariantMap)));
+
+	QDBusMessage message = QDBusMessage::createMethodCall(PortalService, PortalPath, ScreenCastInterface, method);
+	message.setArguments(QVariantList(arguments) << options);
+	const QDBusMessage reply = bus.call(message);
+	if (reply.type() == QDBusMessage::ErrorMessage) {
+		qWarning() << Q_FUNC_INFO << method << "failed:" << reply.errorMessage();
+		bus.disconnect(PortalService, m_requestPath, RequestInterface, QStringLiteral("Response"),
+					   this, SLOT(onPortalResponse(uint, QVariantMap)));
+		m_portalState = PortalStateFailed;
+		return false;
+	}
+
+	m_portalState = nextState;
+	return true;
+}
+
+QVariant PipeWireGrabber::portalProperty(const QString &name) const
+{
+	QDBusMessage message = QDBusMessage::createMethodCall(PortalService, PortalPath,
+		QStringLiteral("org.freedesktop.DBus.Properties"), QStringLiteral("Get"));
+	message << ScreenCastInterface << name;
+	const QDBusMessage reply = QDBusConnection::sessionBus().call(message);
+	if (reply.type() != QDBusMessage::ReplyMessage || reply.arguments().isEmpty())
+		return QVariant();
+	return reply.arguments().first().value<QDBusVariant>().variant();
+}
+
+QString PipeWireGrabber::newHandleToken()
+{
+	return QStringLiteral("prismatik%1").arg(++m_handleTokenCounter);
+}
+
+void PipeWireGrabber::onPortalResponse(uint response, const QVariantMap &results)
+{
+	DEBUG_LOW_LEVEL << Q_FUNC_INFO << m_portalState << response;
+
+	QDBusConnection::sessionBus().disconnect(PortalService, m_requestPath, RequestInterface, QStringLiteral("Response"),
+											 this, SLOT(onPortalResponse(uint, QVariantMap)));
+
+	if (response != 0) {
+		qWarning() << Q_FUNC_INFO << "screen cast was cancelled or failed at step" << m_portalState << ", response" << response;
+		m_portalState = PortalStateFailed;
+		closeSession();
+		return;
+	}
+
+	switch (m_portalState) {
+	case PortalStateCreatingSession: {
+		m_sessionHandle = objectPathOrString(results.value(QStringLiteral("session_handle")));
+
+		QVariantMap options;
+		options.insert(QStringLiteral("types"), SourceTypeMonitor);
+		options.insert(QStringLiteral("multiple"), true);
+		if (portalProperty(QStringLiteral("AvailableCursorModes")).toUInt() & CursorModeHidden)
+			options.insert(QStringLiteral("cursor_mode"), CursorModeHidden);
+		if (m_portalVersion >= 4) {
+			options.insert(QStringLiteral("persist_mode"), PersistModeApplication);
+			if (!m_restoreToken.isEmpty())
+				options.insert(QStringLiteral("restore_token"), m_restoreToken);
+		}
+		callPortal(QStringLiteral("SelectSources"), QVariantList() << QVariant::fromValue(QDBusObjectPath(m_sessionHandle)),
+				   options, PortalStateSelectingSources);
+		break;
+	}
+	case PortalStateSelectingSources:
+		callPortal(QStringLiteral("Start"), QVariantList() << QVariant::fromValue(QDBusObjectPath(m_sessionHandle)) << QString(),
+				   QVariantMap(), PortalStateStarting);
+		break;
+	case PortalStateStarting:
+		openPipeWireRemote(results);
+		break;
+	default:
+		qWarning() << Q_FUNC_INFO << "unexpected response in state" << m_portalState;
+		break;
+	}
+}
+
+void PipeWireGrabber::openPipeWireRemote(const QVariantMap &results)
+{
+	m_restoreToken = results.value(QStringLiteral("restore_token"), m_restoreToken).toString();
+
+	QList< QPair<uint, QRect> > nodes;
+	const QDBusArgument streams = results.value(QStringLiteral("streams")).value<QDBusArgument>();
+	streams.beginArray();
+	while (!streams.atEnd()) {
+		uint nodeId = 0;
+		QVariantMap properties;
+		streams.beginStructure();
+		streams >> nodeId >> properties;
+		streams.endStructure();
+
+		QRect rect = m_desktopScreens.value(nodes.size(), m_desktopScreens.first());
+		int x, y, width, height;
+		if (readIntPair(properties.value(QStringLiteral("position")), x, y)
+			&& readIntPair(properties.value(QStringLiteral("size")), width, height))
+			rect = QRect(x, y, width, height);
+		DEBUG_LOW_LEVEL << Q_FUNC_INFO << "node" << nodeId << rect;
+		nodes.append(qMakePair(nodeId, rect));
+	}
+	streams.endArray();
+
+	QDBusMessage message = QDBusMessage::createMethodCall(PortalService, PortalPath, ScreenCastInterface, QStringLiteral("OpenPipeWireRemote"));
+	message << QVariant::fromValue(QDBusObjectPath(m_sessionHandle)) << QVariantMap();
+	const QDBusMessage reply = QDBusConnection::sessionBus().call(message);
+	const QDBusUnixFileDescriptor fd = reply.arguments().value(0).value<QDBusUnixFileDescriptor>();
+	if (reply.type() != QDBusMessage::ReplyMessage || !fd.isValid()) {
+		qWarning() << Q_FUNC_INFO << "OpenPipeWireRemote failed:" << reply.errorMessage();
+		m_portalState = PortalStateFailed;
+		closeSession();
+		return;
+	}
+
+	// PipeWire takes ownership of the descriptor, QDBusUnixFileDescriptor closes its own
+	m_portalState = connectStreams(dup(fd.fileDescriptor()), nodes) ? PortalStateStarted : PortalStateFailed;
+	if (m_portalState == PortalStateStarted && !isGrabbingStarted())
+		setStreamsActive(false);
+}
+
+void PipeWireGrabber::closeSession()
+{
+	if (m_sessionHandle.isEmpty())
+		return;
+	QDBusConnection::sessionBus().call(
+		QDBusMessage::createMethodCall(PortalService, m_sessionHandle, SessionInterface, QStringLiteral("Close")),
+		QDBus::NoBlock);
+	m_sessionHandle.clear();
+}
+
+bool PipeWireGrabber::connectStreams(int fd, const QList< QPair<uint, QRect> > &nodes)
+{
+	// grabbed screens point to the streams
+	_screensWithWidgets.clear();
+	destroyStreams();
+	if (m_context == nullptr || nodes.isEmpty()) {
+		if (fd >= 0)
+			close(fd);
+		return false;
+	}
+
+	pw_thread_loop_lock(m_loop);
+
+	m_core = (fd >= 0) ? pw_context_connect_fd(m_context, fd, nullptr, 0) : pw_context_connect(m_context, nullptr, 0);
+	if (m_core == nullptr) {
+		pw_thread_loop_unlock(m_loop);
+		qWarning() << Q_FUNC_INFO << "couldn't connect to PipeWire";
+		return false;
+	}
+
+	const int fps = grabInterval() > 0 ? qMax(1, 1000 / grabInterval()) : 30;
+	for (const auto &node : nodes) {
+		PipeWireStream *s = new PipeWireStream();
+		s->nodeId = node.first;
+		s->rect = node.second;
+		s->stream = pw_stream_new(m_core, "Prismatik screen capture", pw_properties_new(
+			PW_KEY_MEDIA_TYPE, "Video",
+			PW_KEY_MEDIA_CATEGORY, "Capture",
+			PW_KEY_MEDIA_ROLE, "Screen",
+			nullptr));
+		if (s->stream == nullptr) {
+			delete s;
+			continue;
+		}
+		pw_stream_add_listener(s->stream, &s->listener, streamEvents(), s);
+
+		// the compositor may ignore the preferred size, whatever is negotiated ends up in GrabbedScreen::scale
+		spa_rectangle preferredSize = SPA_RECTANGLE(
+			static_cast<uint32_t>(qMax(1, static_cast<int>(std::lround(s->rect.width() * PreferredScale)))),
+			static_cast<uint32_t>(qMax(1, static_cast<int>(std::lround(s->rect.height() * PreferredScale)))));
+		spa_rectangle minSize = SPA_RECTANGLE(1, 1);
+		spa_rectangle maxSize = SPA_RECTANGLE(16384, 16384);
+		spa_fraction framerate = SPA_FRACTION(0, 1);
+		spa_fraction preferredMaxFramerate = SPA_FRACTION(static_cast<uint32_t>(fps), 1);
+		spa_fraction minMaxFramerate = SPA_FRACTION(1, 1);
+		spa_fraction maxMaxFramerate = SPA_FRACTION(360, 1);
+
+		uint8_t buffer[1024];
+		spa_pod_builder builder = SPA_POD_BUILDER_INIT(buffer, sizeof(buffer));
+		const spa_pod *params[] = {
+			static_cast<const spa_pod *>(spa_pod_builder_add_object(&builder,
+				SPA_TYPE_OBJECT_Format, SPA_PARAM_EnumFormat,
+				SPA_FORMAT_mediaType, SPA_POD_Id(SPA_MEDIA_TYPE_video),
+				SPA_FORMAT_mediaSubtype, SPA_POD_Id(SPA_MEDIA_SUBTYPE_raw),
+				SPA_FORMAT_VIDEO_format, SPA_POD_CHOICE_ENUM_Id(5,
+					SPA_VIDEO_FORMAT_BGRx, SPA_VIDEO_FORMAT_BGRx, SPA_VIDEO_FORMAT_BGRA,
+					SPA_VIDEO_FORMAT_RGBx, SPA_VIDEO_FORMAT_RGBA),
+				SPA_FORMAT_VIDEO_size, SPA_POD_CHOICE_RANGE_Rectangle(&preferredSize, &minSize, &maxSize),
+				SPA_FORMAT_VIDEO_framerate, SPA_POD_Fraction(&framerate),
+				SPA_FORMAT_VIDEO_maxFramerate, SPA_POD_CHOICE_RANGE_Fraction(&preferredMaxFramerate, &minMaxFramerate, &maxMaxFramerate)))
+		};
+
+		if (pw_stream_connect(s->stream, PW_DIRECTION_INPUT, s->nodeId,
+							  static_cast<pw_stream_flags>(PW_STREAM_FLAG_AUTOCONNECT | PW_STREAM_FLAG_MAP_BUFFERS),
+							  params, 1) < 0) {
+			qWarning() << Q_FUNC_INFO << "couldn't connect to node" << s->nodeId;
+			pw_stream_destroy(s->stream);
+			delete s;
+			continue;
+		}
+		m_streams.append(s);
+	}
+
+	pw_thread_loop_unlock(m_loop);
+
+	return !m_streams.isEmpty();
+}
+
+void PipeWireGrabber::destroyStreams()
+{
+	if (m_loop == nullptr)
+		return;
+
+	pw_thread_loop_lock(m_loop);
+	for (PipeWireStream *s : m_streams) {
+		if (s->current)
+			syncDmaBuf(s->current, DMA_BUF_SYNC_END);
+		pw_stream_destroy(s->stream);
+		delete s;
+	}
+	m_streams.clear();
+	if (m_core) {
+		pw_core_disconnect(m_core);
+		m_core = nullptr;
+	}
+	pw_thread_loop_unlock(m_loop);
+}
+
+void PipeWireGrabber::setStreamsActive(bool isActive)
+{
+	pw_thread_loop_lock(m_loop);
+	for (PipeWireStream *s : m_streams)
+		pw_stream_set_active(s->stream, isActive);
+	pw_thread_loop_unlock(m_loop);
+}
+
+#endif // PIPEWIRE_GRAB_SUPPORT
@@ -0,0 +1,254 @@
+/*
+ * SyntheticGrabber.cpp
+ *
+ *	Created on: 18.10.2026
+ *		Project: Prismatik
+ *
+ *	Prismatik is a free, open-source software: you can redistribute it and/or
+ *	modify it under the terms of the GNU General Public License as published
+ *	by the Free Software Foundation, either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	Prismatik and Lightpack files is distributed in the hope that it will be
+ *	useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.	See the GNU
+ *	General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with this program.	If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "SyntheticGrabber.hpp"
+
+#ifdef SYNTHETIC_GRAB_SUPPORT
+
+#include <QColor>
+#include <algorithm>
+#include "../src/debug.h"
+
+namespace
+{
+	enum Pattern {
+		PatternGradient, // hue gradient scrolling to the left
+		PatternBars, // static color bars, colors never change
+		PatternNoise, // random pixels, every zone changes every frame
+		PatternFlash // whole frame alternates between black and white
+	};
+
+	// animated patterns loop over that many frames at most
+	const int PatternFramesMax = 16;
+	const qint64 PatternBytesMax = 64 * 1024 * 1024;
+
+	const QRgb BarColors[] = {
+		qRgb(191, 191, 191), qRgb(191, 191, 0), qRgb(0, 191, 191), qRgb(0, 191, 0),
+		qRgb(191, 0, 191), qRgb(191, 0, 0), qRgb(0, 0, 191), qRgb(0, 0, 0)
+	};
+	const int BarsCount = sizeof(BarColors) / sizeof(BarColors[0]);
+}
+
+SyntheticGrabber::SyntheticGrabber(QObject *parent, GrabberContext *context)
+	: GrabberBase(parent, context)
+	, m_source(patterns().first())
+	, m_resolution(640, 360)
+	, m_frameRate(0)
+	, m_grabIntervalMs(0)
+	, m_isSourceChanged(true)
+	, m_fileData(NULL)
+	, m_framesCount(0)
+	, m_frameIndex(0)
+{
+}
+
+SyntheticGrabber::~SyntheticGrabber()
+{
+}
+
+const QStringList & SyntheticGrabber::patterns()
+{
+	// in the order of Pattern
+	static const QStringList names = QStringList()
+		<< QStringLiteral("gradient")
+		<< QStringLiteral("bars")
+		<< QStringLiteral("noise")
+		<< QStringLiteral("flash");
+	return names;
+}
+
+void SyntheticGrabber::setGrabInterval(int msec)
+{
+	DEBUG_LOW_LEVEL << Q_FUNC_INFO << msec;
+	m_grabIntervalMs = msec;
+	applyGrabInterval();
+}
+
+void SyntheticGrabber::setSource(const QString &source, const QSize &resolution, int frameRate, const QRect &desktopRect)
+{
+	DEBUG_LOW_LEVEL << Q_FUNC_INFO << source << resolution << frameRate << desktopRect;
+	if (source != m_source || resolution != m_resolution || desktopRect != m_desktopRect)
+		m_isSourceChanged = true;
+	m_source = source;
+	m_resolution = resolution;
+	m_desktopRect = desktopRect;
+	m_frameRate = frameRate;
+	applyGrabInterval();
+}
+
+void SyntheticGrabber::applyGrabInterval()
+{
+	QMutexLocker locker(&m_framePacerMutex);
+	if (m_frameRate > 0)
+		m_framePacer.setTargetInterval(std::chrono::microseconds(1000000 / m_frameRate));
+	else
+		m_framePacer.setTargetInterval(std::chrono::milliseconds(m_grabIntervalMs));
+}
+
+QList<ScreenInfo> * SyntheticGrabber::screensWithWidgets(QList<ScreenInfo> *result, const QList<GrabbedArea> &grabAreas)
+{
+	Q_UNUSED(grabAreas);
+	result->clear();
+
+	ScreenInfo screen;
+	screen.rect = m_desktopRect.isEmpty() ? QRect(QPoint(0, 0), m_resolution) : m_desktopRect;
+	result->append(screen);
+	return result;
+}
+
+bool SyntheticGrabber::isReallocationNeeded(const QList<ScreenInfo> &screens) const
+{
+	return m_isSourceChanged || GrabberBase::isReallocationNeeded(screens);
+}
+
+bool SyntheticGrabber::reallocate(const QList<ScreenInfo> &screens)
+{
+	// report a broken source once, not on every frame
+	const bool isReported = !m_isSourceChanged;
+	m_isSourceChanged = false;
+
+	_screensWithWidgets.clear();
+	m_frames.clear();
+	if (m_fileData) {
+		m_file.unmap(const_cast<uchar *>(m_fileData));
+		m_fileData = NULL;
+	}
+	m_file.close();
+
+	if (m_resolution.isEmpty()) {
+		if (!isReported)
+			qCritical() << Q_FUNC_INFO << "invalid resolution" << m_resolution;
+		return false;
+	}
+
+	const qint64 pixelsCount = static_cast<qint64>(m_resolution.width()) * m_resolution.height();
+	const qint64 frameBytes = pixelsCount * sizeof(quint32);
+	const uchar *data = NULL;
+
+	const int pattern = patterns().indexOf(m_source);
+	if (pattern >= 0) {
+		if (pattern == PatternBars)
+			m_framesCount = 1;
+		else if (pattern == PatternFlash)
+			m_framesCount = 2;
+		else
+			m_framesCount = qBound<qint64>(2, PatternBytesMax / frameBytes, PatternFramesMax);
+
+		m_frames.resize(m_framesCount * pixelsCount);
+		for (int i = 0; i < m_framesCount; ++i)
+			renderPattern(pattern, i, m_framesCount, m_frames.data() + i * pixelsCount);
+		data = reinterpret_cast<const uchar *>(m_frames.constData());
+	} else {
+		m_file.setFileName(m_source);
+		if (!m_file.open(QIODevice::ReadOnly)) {
+			if (!isReported)
+				qCritical() << Q_FUNC_INFO << "couldn't open" << m_source << m_file.errorString();
+			return false;
+		}
+		m_framesCount = m_file.size() / frameBytes;
+		if (m_framesCount == 0) {
+			if (!isReported)
+				qCritical() << Q_FUNC_INFO << m_source << "is smaller than one" << m_resolution << "frame";
+			return false;
+		}
+		m_fileData = m_file.map(0, m_framesCount * frameBytes);
+		if (m_fileData == NULL) {
+			if (!isReported)
+				qCritical() << Q_FUNC_INFO << "couldn't map" << m_source << m_file.errorString();
+			return false;
+		}
+		data = m_fileData;
+	}
+
+	DEBUG_LOW_LEVEL << Q_FUNC_INFO << m_source << m_resolution << m_framesCount << "frames";
+
+	GrabbedScreen grabScreen;
+	grabScreen.imgData = data;
+	grabScreen.imgDataSize = frameBytes;
+	grabScreen.imgFormat = BufferFormatArgb;
+	grabScreen.bytesPerRow = m_resolution.width() * sizeof(quint32);
+	grabScreen.screenInfo = screens.first();
+	// keep the aspect, zones have to stay inside the frame
+	const QRect &desktop = grabScreen.screenInfo.rect;
+	grabScreen.scale = qMin(static_cast<double>(m_resolution.width()) / desktop.width(),
+							static_cast<double>(m_resolution.height()) / desktop.height());
+	_screensWithWidgets.append(grabScreen);
+
+	m_frameIndex = -1;
+	return true;
+}
+
+GrabResult SyntheticGrabber::grabScreens()
+{
+	if (_screensWithWidgets.isEmpty())
+		return GrabResultError;
+
+	m_frameIndex = (m_frameIndex + 1) % m_framesCount;
+
+	GrabbedScreen &screen = _screensWithWidgets.first();
+	const uchar *data = m_fileData ? m_fileData : reinterpret_cast<const uchar *>(m_frames.constData());
+	screen.imgData = data + m_frameIndex * screen.imgDataSize;
+	return GrabResultOk;
+}
+
+void SyntheticGrabber::renderPattern(int pattern, int frame, int framesCount, quint32 *pixels) const
+{
+	const int width = m_resolution.width();
+	const int height = m_resolution.height();
+
+	switch (pattern) {
+	case PatternGradient: {
+		QVector<QRgb> row(width);
+		const int shift = width * frame / framesCount;
+		for (int x = 0; x < width; ++x)
+			row[x] = QColor::fromHsv(359 * ((x + shift) % width) / width, 255, 255).rgb();
+		// darker to the bottom, so horizontal edges differ as well
+		for (int y = 0; y < height; ++y) {
+			const int value = 255 - 127 * y / height;
+			quint32 *line = pixels + y * width;
+			for (int x = 0; x < width; ++x)
+				line[x] = qRgb(qRed(row[x]) * value / 255, qGreen(row[x]) * value / 255, qBlue(row[x]) * value / 255);
+		}
+		break;
+	}
+	case PatternBars:
+		for (int y = 0; y < height; ++y)
+			for (int x = 0; x < width; ++x)
+				pixels[y * width + x] = BarColors[x * BarsCount / width];
+		break;
+	case PatternNoise: {
+		// xorshift32, seeded by the frame
+		quint32 state = 2463534242u + frame * 2654435761u;
+		for (qint64 i = 0; i < static_cast<qint64>(width) * height; ++i) {
+			state ^= state << 13;
+			state ^= state >> 17;
+			state ^= state << 5;
+			pixels[i] = state | 0xff000000;
+		}
+		break;
+	}
+	case PatternFlash:
+		std::fill(pixels, pixels + static_cast<qint64>(width) * height, frame % 2 ? qRgb(255, 255, 255) : qRgb(0, 0, 0));
+		break;
+	}
+}
+
+#endif // SYNTHETIC_GRAB_SUPPORT
@@ -80,11 +80,13 @@ void WinAPIGrabber::freeScreens()
 	_screensWithWidgets.clear();
 }
 
-QList< ScreenInfo > * WinAPIGrabber::screensWithWidgets(QList< ScreenInfo > * result, const QList<GrabWidget *> &grabWidgets)
+QList< ScreenInfo > * WinAPIGrabber::screensWithWidgets(QList< ScreenInfo > * result, const QList<GrabbedArea> &grabAreas)
 {
 	result->clear();
-	for (int i = 0; i < grabWidgets.size(); ++i) {
-		HMONITOR hMonitorNew = MonitorFromWindow(reinterpret_cast<HWND>(grabWidgets[i]->winId()), MONITOR_DEFAULTTONULL);
+	for (int i = 0; i < grabAreas.size(); ++i) {
+		const QRect &areaRect = grabAreas[i].rect;
+		const RECT rect = { areaRect.left(), areaRect.top(), areaRect.right() + 1, areaRect.bottom() + 1 };
+		HMONITOR hMonitorNew = MonitorFromRect(&rect, MONITOR_DEFAULTTONULL);
 
 		if (hMonitorNew != NULL) {
 			MONITORINFO monitorInfo;
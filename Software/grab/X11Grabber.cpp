@@ -31,27 +31,75 @@
 // x shared-mem extension
 #include <sys/shm.h>
 #include <X11/extensions/XShm.h>
+// damage extension, tells which parts of the screen have changed
+#include <X11/extensions/Xdamage.h>
+#include <X11/extensions/Xfixes.h>
+// render extension, scales the screen down on the server side
+#include <X11/extensions/Xrender.h>
 #include <cmath>
+#include <algorithm>
+#include <limits>
 #include <sys/ipc.h>
 #include <errno.h>
 #include <inttypes.h>
 
+struct X11PyramidLevel
+{
+    Pixmap pixmap;
+    Picture picture;
+    QSize size;
+};
+
 struct X11GrabberData
 {
     X11GrabberData()
         : image(NULL)
+        , damage(None)
+        , damageRegion(None)
+        , isFullRefreshNeeded(true)
+        , rootPicture(None)
     {
         memset(&shminfo, 0, sizeof(shminfo));
     }
 
     XImage *image;
     XShmSegmentInfo shminfo;
+    QPoint origin; // top left corner of the captured region in root window coordinates
+    Damage damage;
+    XserverRegion damageRegion; // receives damage accumulated since the previous grab
+    bool isFullRefreshNeeded; // image content is stale, e.g. just allocated
+    Picture rootPicture; // source of the first pyramid level
+    QVector<X11PyramidLevel> pyramid; // each level halves the previous one, \a image holds the last one
 };
 
 X11Grabber::X11Grabber(QObject *parent, GrabberContext * context)
     : GrabberBase(parent, context)
+    , _isDamageSupported(false)
+    , _isRenderSupported(false)
+    , _regionsDownscaleEnabled(false)
 {
     _display = XOpenDisplay(NULL);
+
+    int eventBase, errorBase, major, minor;
+    if (_display
+        && XDamageQueryExtension(_display, &eventBase, &errorBase)
+        && XDamageQueryVersion(_display, &major, &minor)
+        && XFixesQueryExtension(_display, &eventBase, &errorBase)
+        && XFixesQueryVersion(_display, &major, &minor) && major >= 2) {
+        _isDamageSupported = true;
+    } else {
+        qWarning() << Q_FUNC_INFO << "XDamage is not available, every frame is grabbed entirely";
+    }
+
+    // pad repeat is 0.10
+    if (_display
+        && XRenderQueryExtension(_display, &eventBase, &errorBase)
+        && XRenderQueryVersion(_display, &major, &minor)
+        && (major > 0 || minor >= 10)) {
+        _isRenderSupported = true;
+    } else {
+        qWarning() << Q_FUNC_INFO << "XRender is not available, screen is grabbed at full resolution";
+    }
 }
 
 X11Grabber::~X11Grabber()
@@ -60,32 +108,163 @@ X11Grabber::~X11Grabber()
     XCloseDisplay(_display);
 }
 
-QList<ScreenInfo> * X11Grabber::screensWithWidgets(QList<ScreenInfo> *result, const QList<GrabWidget *> &grabWidgets)
+namespace
+{
+    // regions are merged while their bounding rect costs at most that much more than the regions themselves
+    constexpr const qint64 RegionMergeWasteRatio = 3; // in halves, i.e. 1.5
+    constexpr const qint64 RegionMergeWastePixels = 64 * 64;
+
+    // downscaling on capture halves the region at most that many times
+    constexpr const int DownscaleLevelsMax = 4;
+    // and stops before the smallest widget of the region gets narrower than that
+    constexpr const int DownscaledWidgetSideMin = 8;
+
+    qint64 area(const QRect &rect)
+    {
+        return static_cast<qint64>(rect.width()) * rect.height();
+    }
+
+    /*!
+        Groups rects into a few bounding regions. Adjacent zones along an edge end up in one
+        region while zones on different edges stay apart, so a typical layout is captured as
+        four border strips instead of the whole screen.
+    */
+    QList<QRect> mergeRegions(QList<QRect> regions)
+    {
+        std::sort(regions.begin(), regions.end(), [](const QRect &a, const QRect &b) {
+            return a.top() < b.top() || (a.top() == b.top() && a.left() < b.left());
+        });
+
+        bool isMerged = true;
+        while (isMerged) {
+            isMerged = false;
+            for (int i = 0; i < regions.size(); ++i) {
+                for (int k = i + 1; k < regions.size();) {
+                    const QRect united = regions[i].united(regions[k]);
+                    const qint64 separate = area(regions[i]) + area(regions[k]);
+                    if (area(united) * 2 <= separate * RegionMergeWasteRatio || area(united) <= separate + RegionMergeWastePixels) {
+                        regions[i] = united;
+                        regions.removeAt(k);
+                        isMerged = true;
+                    } else {
+                        ++k;
+                    }
+                }
+            }
+        }
+        return regions;
+    }
+}
+
+QList<ScreenInfo> * X11Grabber::screensWithWidgets(QList<ScreenInfo> *result, const QList<GrabbedArea> &grabAreas)
 {
     result->clear();
 
+    QVector<QRect> screenRects;
     for (int i = 0; i < ScreenCount(_display); ++i) {
         XWindowAttributes xwa;
         XGetWindowAttributes(_display, RootWindow(_display, i), &xwa);
-        ScreenInfo screen;
-        intptr_t handle = i;
-        screen.handle = reinterpret_cast<void *>(handle);
-        screen.rect = QRect(xwa.x, xwa.y, xwa.width, xwa.height);
-        for (int k = 0; k < grabWidgets.size(); ++k) {
-            if (screen.rect.intersects(grabWidgets[k]->rect())) {
-                result->append(screen);
-                break;
-            }
+        screenRects.append(QRect(xwa.x, xwa.y, xwa.width, xwa.height));
+    }
+
+    QVector<QRect> regionsAreas;
+    regionsAreas.reserve(grabAreas.size());
+    for (const GrabbedArea &area : grabAreas)
+        regionsAreas.append(area.isEnabled ? area.rect : QRect());
+
+    // clustering is quadratic, redo it only when widgets or screens change
+    if (regionsAreas == _regionsAreas && screenRects == _regionsScreenRects
+        && m_isDownscaleOnCaptureEnabled == _regionsDownscaleEnabled) {
+        *result = _regions;
+        return result;
+    }
+
+    _regionsLevels.clear();
+
+    for (int i = 0; i < screenRects.size(); ++i) {
+        const QRect &screenRect = screenRects[i];
+        QList<QRect> rects;
+        QRect disabledRect;
+        for (const GrabbedArea &area : grabAreas) {
+            const QRect clipped = area.rect.intersected(screenRect);
+            if (clipped.isEmpty())
+                continue;
+            if (area.isEnabled)
+                rects.append(clipped);
+            else if (disabledRect.isEmpty())
+                disabledRect = clipped;
+        }
+        // all widgets on the screen are disabled, keep a small region so the frame still completes
+        if (rects.isEmpty() && !disabledRect.isEmpty())
+            rects.append(disabledRect);
+
+        for (const QRect &region : mergeRegions(rects)) {
+            ScreenInfo screen;
+            intptr_t handle = i;
+            screen.handle = reinterpret_cast<void *>(handle);
+            screen.rect = region;
+            result->append(screen);
+            _regionsLevels.append(downscaleLevels(region, grabAreas));
         }
     }
 
+    _regionsAreas = regionsAreas;
+    _regionsScreenRects = screenRects;
+    _regionsDownscaleEnabled = m_isDownscaleOnCaptureEnabled;
+    _regions = *result;
     return result;
 }
 
+/*!
+    Number of times the region may be halved on capture. The smallest widget of the region keeps
+    at least \a DownscaledWidgetSideMin pixels per side, so its color still averages a few pixels.
+*/
+int X11Grabber::downscaleLevels(const QRect &region, const QList<GrabbedArea> &grabAreas) const
+{
+    if (!m_isDownscaleOnCaptureEnabled || !_isRenderSupported)
+        return 0;
+
+    int sideMin = std::numeric_limits<int>::max();
+    for (const GrabbedArea &area : grabAreas) {
+        const QRect clipped = area.rect.intersected(region);
+        if (area.isEnabled && !clipped.isEmpty())
+            sideMin = qMin(sideMin, qMin(clipped.width(), clipped.height()));
+    }
+
+    int levels = 0;
+    while (levels < DownscaleLevelsMax && (sideMin >> (levels + 1)) >= DownscaledWidgetSideMin)
+        ++levels;
+    return levels;
+}
+
+bool X11Grabber::isReallocationNeeded(const QList<ScreenInfo> &screens) const
+{
+    if (GrabberBase::isReallocationNeeded(screens))
+        return true;
+
+    // same regions, but widgets were resized or downscaling was toggled
+    for (int i = 0; i < _screensWithWidgets.size(); ++i) {
+        const X11GrabberData *d = reinterpret_cast<const X11GrabberData *>(_screensWithWidgets[i].associatedData);
+        if (d->pyramid.size() != _regionsLevels.value(i))
+            return true;
+    }
+    return false;
+}
+
 void X11Grabber::freeScreens()
 {
     for (int i = 0; i < _screensWithWidgets.size(); ++i) {
         X11GrabberData *d = reinterpret_cast<X11GrabberData *>(_screensWithWidgets[i].associatedData);
+        for (const X11PyramidLevel &level : d->pyramid) {
+            XRenderFreePicture(_display, level.picture);
+            XFreePixmap(_display, level.pixmap);
+        }
+        if (d->rootPicture != None)
+            XRenderFreePicture(_display, d->rootPicture);
+        if (d->damage != None)
+            XDamageDestroy(_display, d->damage);
+        if (d->damageRegion != None)
+            XFixesDestroyRegion(_display, d->damageRegion);
         XShmDetach(_display, &d->shminfo);
         XDestroyImage(d->image);
         shmdt (d->shminfo.shmaddr);
@@ -114,6 +293,17 @@ bool X11Grabber::reallocate(const QList<ScreenInfo> &screens)
 
         Screen * xscreen = ScreenOfDisplay(_display, screenid);
 
+        XWindowAttributes xwa;
+        XGetWindowAttributes(_display, RootWindow(_display, screenid), &xwa);
+        d->origin = screens[i].rect.topLeft() - QPoint(xwa.x, xwa.y);
+
+        const int levels = _regionsLevels.value(i);
+        if (levels > 0 && allocatePyramid(d, screenid, QSize(width, height), levels)) {
+            width = d->pyramid.last().size.width();
+            height = d->pyramid.last().size.height();
+            DEBUG_HIGH_LEVEL << "downscaled to " << width << "x" << height;
+        }
+
         d->image = XShmCreateImage(_display, DefaultVisualOfScreen(xscreen),
                                    DefaultDepthOfScreen(xscreen),
                                    ZPixmap, NULL, &d->shminfo,
@@ -134,6 +324,11 @@ bool X11Grabber::reallocate(const QList<ScreenInfo> &screens)
         d->shminfo.readOnly = False;
 
         XShmAttach(_display, &d->shminfo);
+
+        if (_isDamageSupported) {
+            d->damage = XDamageCreate(_display, RootWindow(_display, screenid), XDamageReportNonEmpty);
+            d->damageRegion = XFixesCreateRegion(_display, NULL, 0);
+        }
         XSync(_display, False);
 
         GrabbedScreen grabScreen;
@@ -141,6 +336,7 @@ bool X11Grabber::reallocate(const QList<ScreenInfo> &screens)
         grabScreen.imgDataSize = imagesize;
         grabScreen.bytesPerRow = d->image->bytes_per_line;
         grabScreen.imgFormat = BufferFormatArgb;
+        grabScreen.scale = 1.0 / (1 << d->pyramid.size());
         grabScreen.screenInfo = screens[i];
         grabScreen.associatedData = d;
         _screensWithWidgets.append(grabScreen);
@@ -150,45 +346,193 @@ bool X11Grabber::reallocate(const QList<ScreenInfo> &screens)
     return true;
 }
 
+/*!
+    Builds the chain of pixmaps the region is scaled down through. Every level is half the size
+    of the previous one and is sampled bilinearly exactly between source pixels, which averages
+    2x2 blocks, so the last level is a box filtered copy of the region rather than a point sampled one.
+*/
+bool X11Grabber::allocatePyramid(X11GrabberData *d, int screenid, const QSize &size, int levels)
+{
+    Screen * xscreen = ScreenOfDisplay(_display, screenid);
+    Window root = RootWindow(_display, screenid);
+
+    XRenderPictFormat *format = XRenderFindVisualFormat(_display, DefaultVisualOfScreen(xscreen));
+    if (format == NULL) {
+        qWarning() << Q_FUNC_INFO << "no render format for the root visual, screen" << screenid << "is grabbed at full resolution";
+        return false;
+    }
+
+    XRenderPictureAttributes pa;
+    pa.subwindow_mode = IncludeInferiors;
+    pa.repeat = RepeatPad; // odd sizes sample one pixel past the edge
+    d->rootPicture = XRenderCreatePicture(_display, root, format, CPSubwindowMode | CPRepeat, &pa);
+
+    // destination pixel p samples the source at 2p (+ region origin for the root window)
+    XTransform transform;
+    memset(&transform, 0, sizeof(transform));
+    transform.matrix[0][0] = XDoubleToFixed(2);
+    transform.matrix[1][1] = XDoubleToFixed(2);
+    transform.matrix[2][2] = XDoubleToFixed(1);
+    transform.matrix[0][2] = XDoubleToFixed(d->origin.x());
+    transform.matrix[1][2] = XDoubleToFixed(d->origin.y());
+    XRenderSetPictureTransform(_display, d->rootPicture, &transform);
+    XRenderSetPictureFilter(_display, d->rootPicture, FilterBilinear, NULL, 0);
+
+    transform.matrix[0][2] = 0;
+    transform.matrix[1][2] = 0;
+
+    QSize levelSize = size;
+    for (int i = 0; i < levels; ++i) {
+        levelSize = QSize((levelSize.width() + 1) / 2, (levelSize.height() + 1) / 2);
+
+        X11PyramidLevel level;
+        level.size = levelSize;
+        level.pixmap = XCreatePixmap(_display, root, levelSize.width(), levelSize.height(), DefaultDepthOfScreen(xscreen));
+        level.picture = XRenderCreatePicture(_display, level.pixmap, format, CPRepeat, &pa);
+        // the last level is only fetched
+        if (i + 1 < levels) {
+            XRenderSetPictureTransform(_display, level.picture, &transform);
+            XRenderSetPictureFilter(_display, level.picture, FilterBilinear, NULL, 0);
+        }
+        d->pyramid.append(level);
+    }
+    return true;
+}
+
+/*!
+    Renders the region through the pyramid on the server and fetches the last, smallest level.
+*/
+void X11Grabber::grabDownscaled(const GrabbedScreen &screen)
+{
+    X11GrabberData *d = reinterpret_cast<X11GrabberData *>(screen.associatedData);
+
+    Picture source = d->rootPicture;
+    for (const X11PyramidLevel &level : d->pyramid) {
+        XRenderComposite(_display, PictOpSrc, source, None, level.picture,
+                         0, 0, 0, 0, 0, 0, level.size.width(), level.size.height());
+        source = level.picture;
+    }
+
+    XShmGetImage(_display, d->pyramid.last().pixmap, d->image, 0, 0, AllPlanes);
+}
+
+void X11Grabber::grabRegion(const GrabbedScreen &screen)
+{
+    const X11GrabberData *d = reinterpret_cast<const X11GrabberData *>(screen.associatedData);
+    if (d->pyramid.isEmpty())
+        grabRows(screen, 0, screen.screenInfo.rect.height());
+    else
+        grabDownscaled(screen);
+}
+
 GrabResult X11Grabber::grabScreens()
 {
+    if (!_isDamageSupported) {
+        for (int i = 0; i < _screensWithWidgets.size(); ++i)
+            grabRegion(_screensWithWidgets[i]);
+        return GrabResultOk;
+    }
+
+    // the display is ours, the only events on it are DamageNotify, damage itself is fetched below
+    while (XPending(_display)) {
+        XEvent event;
+        XNextEvent(_display, &event);
+    }
+
+    QVector<QRect> enabledAreas;
+    enabledAreas.reserve(_grabAreas.size());
+    for (const GrabbedArea &area : _grabAreas)
+        if (area.isEnabled)
+            enabledAreas.append(area.rect);
+    const bool isAreasChanged = (enabledAreas != _damageAreas);
+    _damageAreas = enabledAreas;
+
+    bool isUpdated = false;
     for (int i = 0; i < _screensWithWidgets.size(); ++i) {
-        XShmGetImage(_display,
-                     RootWindow(_display, reinterpret_cast<intptr_t>(_screensWithWidgets[i].screenInfo.handle)),
-                     reinterpret_cast<X11GrabberData *>(_screensWithWidgets[i].associatedData)->image,
-                     0,
-                     0,
-                     AllPlanes
-                     );
-    }
-#if 0
-    DEBUG_LOW_LEVEL << "QImage";
-    QImage *pic = new QImage(1024,768,QImage::Format_RGB32);
-    DEBUG_LOW_LEVEL << "format";
-    unsigned long pixel;
-    for (int y = 0; y < 768; y++)
-    {
-        for (int x = 0; x < 1024; x++)
-        {
-            pixel = XGetPixel(image, x, y);
-            int r = (pixel >> 16) & 0xff;
-            int g = (pixel >>  8) & 0xff;
-            int b = (pixel >>  0) & 0xff;
-            //QRgb rgb = QRgb() (r,g,b);
-            pic->setPixel(x,y,pixel);
+        X11GrabberData *d = reinterpret_cast<X11GrabberData *>(_screensWithWidgets[i].associatedData);
+        const QRect &regionRect = _screensWithWidgets[i].screenInfo.rect;
+
+        XDamageSubtract(_display, d->damage, None, d->damageRegion);
+
+        // widgets moved or were enabled, their pixels may never have been fetched
+        if (isAreasChanged)
+            d->isFullRefreshNeeded = true;
+
+        if (d->isFullRefreshNeeded) {
+            grabRegion(_screensWithWidgets[i]);
+            d->isFullRefreshNeeded = false;
+            isUpdated = true;
+            continue;
         }
+
+        int rectsCount = 0;
+        XRectangle *rects = XFixesFetchRegion(_display, d->damageRegion, &rectsCount);
+        if (rects == NULL)
+            continue;
+
+        // rows of the damaged parts of the widgets, region-local
+        _damageRows.clear();
+        const QPoint rootOffset = regionRect.topLeft() - d->origin;
+        for (int k = 0; k < rectsCount; ++k) {
+            const QRect damaged = QRect(rects[k].x, rects[k].y, rects[k].width, rects[k].height).translated(rootOffset);
+            for (const QRect &area : enabledAreas) {
+                const QRect dirty = damaged.intersected(area).intersected(regionRect);
+                if (!dirty.isEmpty())
+                    _damageRows.append(qMakePair(dirty.top() - regionRect.top(), dirty.bottom() - regionRect.top() + 1));
+            }
+        }
+        XFree(rects);
+
+        if (_damageRows.isEmpty())
+            continue;
+
+        // scaling is cheap on the server and the fetch is small, no point in splitting it into bands
+        if (!d->pyramid.isEmpty()) {
+            grabDownscaled(_screensWithWidgets[i]);
+            isUpdated = true;
+            continue;
+        }
+
+        std::sort(_damageRows.begin(), _damageRows.end());
+        int bandBegin = _damageRows[0].first;
+        int bandEnd = _damageRows[0].second;
+        for (int k = 1; k <= _damageRows.size(); ++k) {
+            if (k < _damageRows.size() && _damageRows[k].first <= bandEnd) {
+                bandEnd = qMax(bandEnd, _damageRows[k].second);
+                continue;
+            }
+            grabRows(_screensWithWidgets[i], bandBegin, bandEnd - bandBegin);
+            if (k < _damageRows.size()) {
+                bandBegin = _damageRows[k].first;
+                bandEnd = _damageRows[k].second;
+            }
+        }
+        isUpdated = true;
     }
-    DEBUG_LOW_LEVEL << "save";
-    pic->save("/home/atarity/.Lightpack/test.bmp");
-#endif
-    /*
-    _context->grabResult->clear();
-    foreach(GrabWidget * widget, *_context->grabWidgets) {
-        _context->grabResult->append( widget->isAreaEnabled() ? getColor(widget) : qRgb(0,0,0) );
-    }
-    return GrabResultOk;
-    */
-    return GrabResultOk;
+
+    return isUpdated ? GrabResultOk : GrabResultFrameNotReady;
+}
+
+/*!
+    Refreshes full-width rows [y, y + height) of the region image. Rows of the band have the
+    same stride as in the whole image, so the band is fetched in place into the same shared
+    memory segment through a copy of the image header.
+*/
+void X11Grabber::grabRows(const GrabbedScreen &screen, int y, int height)
+{
+    X11GrabberData *d = reinterpret_cast<X11GrabberData *>(screen.associatedData);
+
+    XImage band = *d->image;
+    band.height = height;
+    band.data = d->image->data + y * d->image->bytes_per_line;
+
+    XShmGetImage(_display,
+                 RootWindow(_display, reinterpret_cast<intptr_t>(screen.screenInfo.handle)),
+                 &band,
+                 d->origin.x(),
+                 d->origin.y() + y,
+                 AllPlanes
+                 );
 }
 
 #endif // X11_GRAB_SUPPORT
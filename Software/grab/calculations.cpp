@@ -25,7 +25,9 @@
 
 #include "calculations.hpp"
 #include <stdint.h>
+#include <string.h>
 #include <immintrin.h>
+#include "SimdLevel.hpp"
 
 #define PIXEL_FORMAT_ARGB 2,1,0 // channel positions in a 4 byte color
 #define PIXEL_FORMAT_ABGR 0,1,2
@@ -235,98 +237,293 @@ namespace {
 	};
 
 
-enum SIMDLevel {
-	None = 0,
-	SSE4_1 = 1 << 0,
-	AVX2 = 1 << 1
-};
+	// strided variants sample every stride-th pixel of every stride-th row,
+	// the top-left pixel of the rect is always sampled
+	template<uint8_t offsetR, uint8_t offsetG, uint8_t offsetB>
+	static ColorValue accumulateBufferStrided(
+		const int * const buff,
+		const size_t pitch,
+		const QRect& rect,
+		const int stride) {
+		const unsigned char* const buffer = (const unsigned char* const)buff;
 
-#if defined(Q_OS_MACOS)
-#include <sys/sysctl.h>
-// https://developer.apple.com/documentation/apple_silicon/about_the_rosetta_translation_environment?language=objc
-static uint32_t available_simd() {
-	uint32_t level = SIMDLevel::None;
-	int ret = 0;
-	size_t size = sizeof(ret);
-	if (sysctlbyname("hw.optional.avx2_0", &ret, &size, NULL, 0) == 0 && ret == 1)
-		level |= SIMDLevel::AVX2;
-	ret = 0;
-	size = sizeof(ret);
-	if (sysctlbyname("hw.optional.sse4_1", &ret, &size, NULL, 0) == 0 && ret == 1)
-		level |= SIMDLevel::SSE4_1;
-	return level;
-}
-#elif defined(__INTEL_COMPILER) && (__INTEL_COMPILER >= 1300)
-// https://software.intel.com/en-us/articles/how-to-detect-new-instruction-support-in-the-4th-generation-intel-core-processor-family
-static uint32_t available_simd() {
-	uint32_t level = SIMDLevel::None;
-	if (_may_i_use_cpu_feature(_FEATURE_AVX2))
-		level |= SIMDLevel::AVX2;
-	if (_may_i_use_cpu_feature(_FEATURE_SSE4_1))
-		level |= SIMDLevel::SSE4_1;
-	return level;
-}
-#else /* non-Intel compiler */
-void run_cpuid(uint32_t eax, uint32_t ecx, uint32_t* abcd)
-{
-#if defined(_MSC_VER)
-	__cpuidex((int*)abcd, eax, ecx);
-#else
-	uint32_t ebx = 0;
-	uint32_t edx = 0;
-# if defined( __i386__ ) && defined ( __PIC__ )
-	 /* in case of PIC under 32-bit EBX cannot be clobbered */
-	__asm__ ( "movl %%ebx, %%edi \n\t cpuid \n\t xchgl %%ebx, %%edi" : "=D" (ebx),
-# else
-	__asm__ ( "cpuid" : "+b" (ebx),
-# endif
-			  "+a" (eax), "+c" (ecx), "=d" (edx) );
-	abcd[0] = eax; abcd[1] = ebx; abcd[2] = ecx; abcd[3] = edx;
-#endif
-}
+		ColorValue color{0,0,0};
+		size_t count = 0;
+		for (int currentY = 0; currentY < rect.height(); currentY += stride) {
+			for (int currentX = 0; currentX < rect.width(); currentX += stride) {
+				const size_t index = pitch * bytesPerPixel * (rect.y() + currentY) + (rect.x() + currentX) * bytesPerPixel;
+				color.r += PIXEL_R(0);
+				color.g += PIXEL_G(0);
+				color.b += PIXEL_B(0);
+				++count;
+			}
+		}
+		color.r = (color.r / count) & 0xff;
+		color.g = (color.g / count) & 0xff;
+		color.b = (color.b / count) & 0xff;
+		return color;
+	};
 
+	template<uint8_t offsetR, uint8_t offsetG, uint8_t offsetB>
+	static ColorValue accumulateBufferStrided128(
+		const int * const buffer,
+		const size_t pitch,
+		const QRect& rect,
+		const int stride) {
+
+		__m128i sum[bytesPerPixel] = {
+			_mm_setzero_si128(),
+			_mm_setzero_si128(),
+			_mm_setzero_si128(),
+			_mm_setzero_si128()
+		};
+
+		constexpr const char zero = (char)(1<<7);
+		const __m128i shuffleR = _mm_set_epi8(
+			zero,zero,zero,3*4+offsetR,
+			zero,zero,zero,2*4+offsetR,
+			zero,zero,zero,1*4+offsetR,
+			zero,zero,zero,0*4+offsetR
+		);
+		const __m128i shuffleG = _mm_set_epi8(
+			zero,zero,zero,3*4+offsetG,
+			zero,zero,zero,2*4+offsetG,
+			zero,zero,zero,1*4+offsetG,
+			zero,zero,zero,0*4+offsetG
+		);
+		const __m128i shuffleB = _mm_set_epi8(
+			zero,zero,zero,3*4+offsetB,
+			zero,zero,zero,2*4+offsetB,
+			zero,zero,zero,1*4+offsetB,
+			zero,zero,zero,0*4+offsetB
+		);
+		const size_t columns = (rect.width() + stride - 1) / stride;
+		const size_t rows = (rect.height() + stride - 1) / stride;
+		const size_t softlimit = columns / pixelsPerStep;
+		const size_t delta = columns % pixelsPerStep;
+
+		ColorValue color{0,0,0};
+		for (size_t currentY = 0; currentY < (size_t)rect.height(); currentY += stride) {
+			const int * const line = &buffer[pitch * (rect.y() + currentY) + rect.x()];
+			for (size_t currentX = 0; currentX < softlimit; ++currentX) {
+				// no gather before AVX2, compose the vector from 4 strided loads
+				const int * const pixels = line + currentX * pixelsPerStep * stride;
+				const __m128i vec4 = _mm_setr_epi32(pixels[0], pixels[stride], pixels[2 * stride], pixels[3 * stride]);
+				sum[offsetR] = _mm_add_epi32(sum[offsetR], _mm_shuffle_epi8(vec4, shuffleR));
+				sum[offsetG] = _mm_add_epi32(sum[offsetG], _mm_shuffle_epi8(vec4, shuffleG));
+				sum[offsetB] = _mm_add_epi32(sum[offsetB], _mm_shuffle_epi8(vec4, shuffleB));
+			}
+			for (size_t currentX = softlimit * pixelsPerStep; currentX < softlimit * pixelsPerStep + delta; ++currentX) {
+				const unsigned char * const pixel = (const unsigned char *)&line[currentX * stride];
+				color.r += pixel[offsetR];
+				color.g += pixel[offsetG];
+				color.b += pixel[offsetB];
+			}
+		}
+		const __m128i horizontalSum128 = _mm_hadd_epi32(_mm_hadd_epi32(sum[0], sum[1]), _mm_hadd_epi32(sum[2], sum[3]));
+		const size_t count = rows * columns;
+
+		color.r = ((color.r + _mm_extract_epi32(horizontalSum128, offsetR)) / count) & 0xff;
+		color.g = ((color.g + _mm_extract_epi32(horizontalSum128, offsetG)) / count) & 0xff;
+		color.b = ((color.b + _mm_extract_epi32(horizontalSum128, offsetB)) / count) & 0xff;
+		return color;
+	};
+
+	template<uint8_t offsetR, uint8_t offsetG, uint8_t offsetB>
+	static ColorValue accumulateBufferStrided256(
+		const int * const buffer,
+		const size_t pitch,
+		const QRect& rect,
+		const int stride) {
+
+		__m256i sum[bytesPerPixel] = {
+			_mm256_setzero_si256(),
+			_mm256_setzero_si256(),
+			_mm256_setzero_si256(),
+			_mm256_setzero_si256()
+		}; // A,R,G,B sums
+
+		constexpr const char zero = (char)(1<<7);
+		const __m256i shuffleR = _mm256_broadcastsi128_si256(_mm_set_epi8(
+			zero,zero,zero,3*4+offsetR,
+			zero,zero,zero,2*4+offsetR,
+			zero,zero,zero,1*4+offsetR,
+			zero,zero,zero,0*4+offsetR
+		));
+		const __m256i shuffleG = _mm256_broadcastsi128_si256(_mm_set_epi8(
+			zero,zero,zero,3*4+offsetG,
+			zero,zero,zero,2*4+offsetG,
+			zero,zero,zero,1*4+offsetG,
+			zero,zero,zero,0*4+offsetG
+		));
+		const __m256i shuffleB = _mm256_broadcastsi128_si256(_mm_set_epi8(
+			zero,zero,zero,3*4+offsetB,
+			zero,zero,zero,2*4+offsetB,
+			zero,zero,zero,1*4+offsetB,
+			zero,zero,zero,0*4+offsetB
+		));
+		const __m256i lanes = _mm256_setr_epi32(0,1,2,3,4,5,6,7);
+		// pixel offsets of one gather: 0, stride, 2*stride...
+		const __m256i gatherIndex = _mm256_mullo_epi32(lanes, _mm256_set1_epi32(stride));
+
+		const size_t columns = (rect.width() + stride - 1) / stride;
+		const size_t rows = (rect.height() + stride - 1) / stride;
+		const size_t softlimit = columns / pixelsPerStep / 2;
+		const size_t delta = columns % (pixelsPerStep * 2);
+		// gather only delta number of pixels at the end of each row
+		const __m256i gathermask = _mm256_cmpgt_epi32(_mm256_set1_epi32(delta), lanes);
+
+		for (size_t currentY = 0; currentY < (size_t)rect.height(); currentY += stride) {
+			const int * const line = &buffer[pitch * (rect.y() + currentY) + rect.x()];
+			for (size_t currentX = 0; currentX < softlimit; ++currentX) {
+				const __m256i vec8 = _mm256_i32gather_epi32(line + currentX * pixelsPerStep * 2 * stride, gatherIndex, sizeof(int));
+				sum[offsetR] = _mm256_add_epi32(sum[offsetR], _mm256_shuffle_epi8(vec8, shuffleR));
+				sum[offsetG] = _mm256_add_epi32(sum[offsetG], _mm256_shuffle_epi8(vec8, shuffleG));
+				sum[offsetB] = _mm256_add_epi32(sum[offsetB], _mm256_shuffle_epi8(vec8, shuffleB));
+			}
+			if (delta > 0) {
+				const __m256i vec8 = _mm256_mask_i32gather_epi32(_mm256_setzero_si256(), line + softlimit * pixelsPerStep * 2 * stride, gatherIndex, gathermask, sizeof(int));
+				sum[offsetR] = _mm256_add_epi32(sum[offsetR], _mm256_shuffle_epi8(vec8, shuffleR));
+				sum[offsetG] = _mm256_add_epi32(sum[offsetG], _mm256_shuffle_epi8(vec8, shuffleG));
+				sum[offsetB] = _mm256_add_epi32(sum[offsetB], _mm256_shuffle_epi8(vec8, shuffleB));
+			}
+		}
+
+		const __m256i horizontalSum256 = _mm256_hadd_epi32(_mm256_hadd_epi32(sum[0], sum[1]) , _mm256_hadd_epi32(sum[2], sum[3]));
+		const __m128i horizontalSum128 = _mm_add_epi32(_mm256_extracti128_si256(horizontalSum256, 0), _mm256_extracti128_si256(horizontalSum256, 1));
+		const size_t count = rows * columns;
+		ColorValue color;
+		color.r = (_mm_extract_epi32(horizontalSum128, offsetR) / count) & 0xff;
+		color.g = (_mm_extract_epi32(horizontalSum128, offsetG) / count) & 0xff;
+		color.b = (_mm_extract_epi32(horizontalSum128, offsetB) / count) & 0xff;
+		return color;
+	};
+
+	// integral image entries are laid out as (R, G, B, unused) 32bit sums
+	constexpr const uint8_t channelsPerEntry = 4;
+
+	template<uint8_t offsetR, uint8_t offsetG, uint8_t offsetB>
+	static void integrateBuffer(
+		const int * const buff,
+		const size_t pitch,
+		const QRect& rect,
+		uint32_t * const table) {
+		const unsigned char* const buffer = (const unsigned char* const)buff;
+		const size_t stride = (rect.width() + 1) * channelsPerEntry;
+
+		memset(table, 0, stride * sizeof(uint32_t));
+		for (int currentY = 0; currentY < rect.height(); ++currentY) {
+			uint32_t * const row = table + stride * (currentY + 1);
+			const uint32_t * const previousRow = row - stride;
+			memset(row, 0, channelsPerEntry * sizeof(uint32_t));
+
+			uint32_t r = 0, g = 0, b = 0;
+			for (int currentX = 0; currentX < rect.width(); ++currentX) {
+				const size_t index = pitch * bytesPerPixel * (rect.y() + currentY) + (rect.x() + currentX) * bytesPerPixel;
+				r += PIXEL_R(0);
+				g += PIXEL_G(0);
+				b += PIXEL_B(0);
+				const size_t entry = (currentX + 1) * channelsPerEntry;
+				row[entry + 0] = previousRow[entry + 0] + r;
+				row[entry + 1] = previousRow[entry + 1] + g;
+				row[entry + 2] = previousRow[entry + 2] + b;
+				row[entry + 3] = 0;
+			}
+		}
+	};
+
+	template<uint8_t offsetR, uint8_t offsetG, uint8_t offsetB>
+	static void integrateBuffer128(
+		const int * const buffer,
+		const size_t pitch,
+		const QRect& rect,
+		uint32_t * const table) {
+		const size_t stride = (rect.width() + 1) * channelsPerEntry;
+
+		// re-arrange ARGB into 0BGR so one pixel fills one table entry
+		constexpr const char zero = (char)(1<<7);
+		const __m128i shuffle = _mm_set_epi8(
+			zero,zero,zero,zero,
+			zero,zero,zero,offsetB,
+			zero,zero,zero,offsetG,
+			zero,zero,zero,offsetR
+		);
+
+		memset(table, 0, stride * sizeof(uint32_t));
+		for (size_t currentY = 0; currentY < (size_t)rect.height(); ++currentY) {
+			uint32_t * const row = table + stride * (currentY + 1);
+			const uint32_t * const previousRow = row - stride;
+			_mm_storeu_si128((__m128i*)row, _mm_setzero_si128());
+
+			// running sum of the current row
+			__m128i rowSum = _mm_setzero_si128();
+			for (size_t currentX = 0; currentX < (size_t)rect.width(); ++currentX) {
+				const size_t index = pitch * (rect.y() + currentY) + rect.x() + currentX;
+				const size_t entry = (currentX + 1) * channelsPerEntry;
+				rowSum = _mm_add_epi32(rowSum, _mm_shuffle_epi8(_mm_cvtsi32_si128(buffer[index]), shuffle));
+				_mm_storeu_si128((__m128i*)&row[entry], _mm_add_epi32(rowSum, _mm_loadu_si128((const __m128i*)&previousRow[entry])));
+			}
+		}
+	};
+
+	template<uint8_t offsetR, uint8_t offsetG, uint8_t offsetB>
+	static void integrateBuffer256(
+		const int * const buffer,
+		const size_t pitch,
+		const QRect& rect,
+		uint32_t * const table) {
+		const size_t stride = (rect.width() + 1) * channelsPerEntry;
+
+		// low lane takes the first pixel, high lane the second one
+		constexpr const char zero = (char)(1<<7);
+		const __m256i shuffle = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_set_epi8(
+			zero,zero,zero,zero,
+			zero,zero,zero,offsetB,
+			zero,zero,zero,offsetG,
+			zero,zero,zero,offsetR
+		)), _mm_set_epi8(
+			zero,zero,zero,zero,
+			zero,zero,zero,1*4+offsetB,
+			zero,zero,zero,1*4+offsetG,
+			zero,zero,zero,1*4+offsetR
+		), 1);
+		const __m128i shuffleSingle = _mm256_castsi256_si128(shuffle);
+
+		const size_t softlimit = rect.width() / 2;
+
+		memset(table, 0, stride * sizeof(uint32_t));
+		for (size_t currentY = 0; currentY < (size_t)rect.height(); ++currentY) {
+			uint32_t * const row = table + stride * (currentY + 1);
+			const uint32_t * const previousRow = row - stride;
+			_mm_storeu_si128((__m128i*)row, _mm_setzero_si128());
+
+			// running sum of the current row, same value in both lanes
+			__m256i rowSum = _mm256_setzero_si256();
+			for (size_t currentX = 0; currentX < softlimit; ++currentX) {
+				const size_t index = pitch * (rect.y() + currentY) + rect.x() + currentX * 2;
+				const size_t entry = (currentX * 2 + 1) * channelsPerEntry;
+				const __m128i vec2 = _mm_loadl_epi64((const __m128i*)&buffer[index]);
+				// (p0, p1)
+				__m256i sum = _mm256_shuffle_epi8(_mm256_broadcastsi128_si256(vec2), shuffle);
+				// (p0, p0 + p1)
+				sum = _mm256_add_epi32(sum, _mm256_permute2x128_si256(sum, sum, 0x08));
+				sum = _mm256_add_epi32(sum, rowSum);
+				rowSum = _mm256_permute2x128_si256(sum, sum, 0x11);
+				_mm256_storeu_si256((__m256i*)&row[entry], _mm256_add_epi32(sum, _mm256_loadu_si256((const __m256i*)&previousRow[entry])));
+			}
+			if (rect.width() % 2) {
+				const size_t index = pitch * (rect.y() + currentY) + rect.x() + rect.width() - 1;
+				const size_t entry = rect.width() * channelsPerEntry;
+				const __m128i sum = _mm_add_epi32(_mm256_castsi256_si128(rowSum), _mm_shuffle_epi8(_mm_cvtsi32_si128(buffer[index]), shuffleSingle));
+				_mm_storeu_si128((__m128i*)&row[entry], _mm_add_epi32(sum, _mm_loadu_si128((const __m128i*)&previousRow[entry])));
+			}
+		}
+	};
 
-#if defined(_MSC_VER)
-# include <intrin.h>
-#endif
-static uint32_t available_simd() {
-	uint32_t abcd[4] = {0,0,0,0};
-
-	run_cpuid(1, 0, abcd);
-	uint32_t eax = 0x07;
-	uint32_t ecx = 0x00;
-#if defined(_MSC_VER)
-	__cpuidex((int*)abcd, eax, ecx);
-#else
-	uint32_t ebx = 0;
-	uint32_t edx = 0;
-# if defined( __i386__ ) && defined ( __PIC__ )
-	 /* in case of PIC under 32-bit EBX cannot be clobbered */
-	__asm__ ( "movl %%ebx, %%edi \n\t cpuid \n\t xchgl %%ebx, %%edi" : "=D" (ebx),
-# else
-	__asm__ ( "cpuid" : "+b" (ebx),
-# endif
-			  "+a" (eax), "+c" (ecx), "=d" (edx) );
-	abcd[0] = eax; abcd[1] = ebx; abcd[2] = ecx; abcd[3] = edx;
-#endif
-	uint32_t level = SIMDLevel::None;
-	// CPUID.(EAX=07H, ECX=0H):EBX.AVX2[bit 5]==1
-	run_cpuid(7, 0, abcd);
-	if ((abcd[1] & (1 << 5)))
-		level |= SIMDLevel::AVX2;
-
-	// CPUID.(EAX=01H, ECX=0H):ECX.SSE4_1[bit 19]==1
-	run_cpuid(1, 0, abcd);
-	if ((abcd[2] & (1 << 19)))
-		level |= SIMDLevel::SSE4_1;
-
-	return level;
-}
-#endif
 
 /*
-	accumulateBuffer128 requires SSE4.1
-	accumulateBuffer256 requires AVX2
+	accumulateBuffer128, accumulateBufferStrided128 and integrateBuffer128 require SSE4.1
+	accumulateBuffer256, accumulateBufferStrided256 and integrateBuffer256 require AVX2
 
 	instruction availability:
 	Steam Hardware & Software Survey (March 2020)
@@ -340,20 +537,50 @@ auto accumulateABGR = accumulateBuffer<PIXEL_FORMAT_ABGR>;
 auto accumulateRGBA = accumulateBuffer<PIXEL_FORMAT_RGBA>;
 auto accumulateBGRA = accumulateBuffer<PIXEL_FORMAT_BGRA>;
 
+auto accumulateStridedARGB = accumulateBufferStrided<PIXEL_FORMAT_ARGB>;
+auto accumulateStridedABGR = accumulateBufferStrided<PIXEL_FORMAT_ABGR>;
+auto accumulateStridedRGBA = accumulateBufferStrided<PIXEL_FORMAT_RGBA>;
+auto accumulateStridedBGRA = accumulateBufferStrided<PIXEL_FORMAT_BGRA>;
+
+auto integrateARGB = integrateBuffer<PIXEL_FORMAT_ARGB>;
+auto integrateABGR = integrateBuffer<PIXEL_FORMAT_ABGR>;
+auto integrateRGBA = integrateBuffer<PIXEL_FORMAT_RGBA>;
+auto integrateBGRA = integrateBuffer<PIXEL_FORMAT_BGRA>;
+
 struct simdupgrade {
 	simdupgrade() {
-		uint32_t level = available_simd();
-		if (level & SIMDLevel::AVX2) {
+		uint32_t level = PrismatikMath::availableSimd();
+		if (level & PrismatikMath::SIMDLevel::AVX2) {
 			accumulateARGB = accumulateBuffer256<PIXEL_FORMAT_ARGB>;
 			accumulateABGR = accumulateBuffer256<PIXEL_FORMAT_ABGR>;
 			accumulateRGBA = accumulateBuffer256<PIXEL_FORMAT_RGBA>;
 			accumulateBGRA = accumulateBuffer256<PIXEL_FORMAT_BGRA>;
+
+			accumulateStridedARGB = accumulateBufferStrided256<PIXEL_FORMAT_ARGB>;
+			accumulateStridedABGR = accumulateBufferStrided256<PIXEL_FORMAT_ABGR>;
+			accumulateStridedRGBA = accumulateBufferStrided256<PIXEL_FORMAT_RGBA>;
+			accumulateStridedBGRA = accumulateBufferStrided256<PIXEL_FORMAT_BGRA>;
+
+			integrateARGB = integrateBuffer256<PIXEL_FORMAT_ARGB>;
+			integrateABGR = integrateBuffer256<PIXEL_FORMAT_ABGR>;
+			integrateRGBA = integrateBuffer256<PIXEL_FORMAT_RGBA>;
+			integrateBGRA = integrateBuffer256<PIXEL_FORMAT_BGRA>;
 		}
-		else if (level & SIMDLevel::SSE4_1) {
+		else if (level & PrismatikMath::SIMDLevel::SSE4_1) {
 			accumulateARGB = accumulateBuffer128<PIXEL_FORMAT_ARGB>;
 			accumulateABGR = accumulateBuffer128<PIXEL_FORMAT_ABGR>;
 			accumulateRGBA = accumulateBuffer128<PIXEL_FORMAT_RGBA>;
 			accumulateBGRA = accumulateBuffer128<PIXEL_FORMAT_BGRA>;
+
+			accumulateStridedARGB = accumulateBufferStrided128<PIXEL_FORMAT_ARGB>;
+			accumulateStridedABGR = accumulateBufferStrided128<PIXEL_FORMAT_ABGR>;
+			accumulateStridedRGBA = accumulateBufferStrided128<PIXEL_FORMAT_RGBA>;
+			accumulateStridedBGRA = accumulateBufferStrided128<PIXEL_FORMAT_BGRA>;
+
+			integrateARGB = integrateBuffer128<PIXEL_FORMAT_ARGB>;
+			integrateABGR = integrateBuffer128<PIXEL_FORMAT_ABGR>;
+			integrateRGBA = integrateBuffer128<PIXEL_FORMAT_RGBA>;
+			integrateBGRA = integrateBuffer128<PIXEL_FORMAT_BGRA>;
 		}
 	}
 };
@@ -362,7 +589,37 @@ simdupgrade avxup;
 
 namespace Grab {
 	namespace Calculations {
-		QRgb calculateAvgColor(const unsigned char * const buffer, BufferFormat bufferFormat, const size_t pitch, const QRect &rect) {
+		static QRgb calculateAvgColorStrided(const unsigned char * const buffer, BufferFormat bufferFormat, const size_t pitch, const QRect &rect, const int samplingStride) {
+
+			ColorValue color;
+			switch(bufferFormat) {
+			case BufferFormatArgb:
+				color = accumulateStridedARGB((int*)buffer, pitch / bytesPerPixel, rect, samplingStride);
+				break;
+
+			case BufferFormatAbgr:
+				color = accumulateStridedABGR((int*)buffer, pitch / bytesPerPixel, rect, samplingStride);
+				break;
+
+			case BufferFormatRgba:
+				color = accumulateStridedRGBA((int*)buffer, pitch / bytesPerPixel, rect, samplingStride);
+				break;
+
+			case BufferFormatBgra:
+				color = accumulateStridedBGRA((int*)buffer, pitch / bytesPerPixel, rect, samplingStride);
+				break;
+			default:
+				return -1;
+				break;
+			}
+
+			return qRgb(color.r, color.g, color.b);
+		}
+
+		QRgb calculateAvgColor(const unsigned char * const buffer, BufferFormat bufferFormat, const size_t pitch, const QRect &rect, const int samplingStride) {
+
+			if (samplingStride > 1)
+				return calculateAvgColorStrided(buffer, bufferFormat, pitch, rect, samplingStride);
 
 			ColorValue color;
 			switch(bufferFormat) {
@@ -388,5 +645,55 @@ namespace Grab {
 
 			return qRgb(color.r, color.g, color.b);
 		}
+
+		bool calculateIntegralImage(const unsigned char * const buffer, BufferFormat bufferFormat, const size_t pitch, const QRect &rect, IntegralImage &result) {
+
+			result.rect = rect;
+			result.data.resize((size_t)(rect.width() + 1) * (rect.height() + 1) * channelsPerEntry);
+
+			switch(bufferFormat) {
+			case BufferFormatArgb:
+				integrateARGB((int*)buffer, pitch / bytesPerPixel, rect, result.data.data());
+				break;
+
+			case BufferFormatAbgr:
+				integrateABGR((int*)buffer, pitch / bytesPerPixel, rect, result.data.data());
+				break;
+
+			case BufferFormatRgba:
+				integrateRGBA((int*)buffer, pitch / bytesPerPixel, rect, result.data.data());
+				break;
+
+			case BufferFormatBgra:
+				integrateBGRA((int*)buffer, pitch / bytesPerPixel, rect, result.data.data());
+				break;
+			default:
+				result.rect = QRect();
+				result.data.clear();
+				return false;
+				break;
+			}
+
+			return true;
+		}
+
+		QRgb calculateAvgColor(const IntegralImage &integralImage, const QRect &rect) {
+			Q_ASSERT(integralImage.rect.contains(rect));
+
+			const size_t stride = (integralImage.rect.width() + 1) * channelsPerEntry;
+			const size_t left = (rect.x() - integralImage.rect.x()) * channelsPerEntry;
+			const size_t right = left + rect.width() * channelsPerEntry;
+			const size_t top = (rect.y() - integralImage.rect.y()) * stride;
+			const size_t bottom = top + rect.height() * stride;
+			const uint32_t * const data = integralImage.data.data();
+
+			// unsigned wrap-around cancels out as long as the rect sum itself fits 32 bits
+			const size_t count = rect.height() * rect.width();
+			const uint32_t r = data[bottom + right + 0] - data[bottom + left + 0] - data[top + right + 0] + data[top + left + 0];
+			const uint32_t g = data[bottom + right + 1] - data[bottom + left + 1] - data[top + right + 1] + data[top + left + 1];
+			const uint32_t b = data[bottom + right + 2] - data[bottom + left + 2] - data[top + right + 2] + data[top + left + 2];
+
+			return qRgb((r / count) & 0xff, (g / count) & 0xff, (b / count) & 0xff);
+		}
 	}
 }
@@ -33,12 +33,24 @@ CONFIG(clang) {
 }
 
 DEFINES += $${SUPPORTED_GRABBERS}
+contains(DEFINES, SYNTHETIC_GRAB_SUPPORT) {
+    GRABBERS_HEADERS += include/SyntheticGrabber.hpp
+    GRABBERS_SOURCES += SyntheticGrabber.cpp
+}
+
 # Linux/UNIX platform
 unix:!macx {
     contains(DEFINES, X11_GRAB_SUPPORT) {
         GRABBERS_HEADERS += include/X11Grabber.hpp
         GRABBERS_SOURCES += X11Grabber.cpp
     }
+
+    contains(DEFINES, PIPEWIRE_GRAB_SUPPORT) {
+        QT += dbus
+        PKGCONFIG += libpipewire-0.3
+        GRABBERS_HEADERS += include/PipeWireGrabber.hpp
+        GRABBERS_SOURCES += PipeWireGrabber.cpp
+    }
 }
 
 # Mac platform
@@ -82,12 +94,14 @@ HEADERS += \
     include/GrabberBase.hpp \
     include/ColorProvider.hpp \
     include/GrabberContext.hpp \
+    include/FramePacer.hpp \
     include/BlueLightReduction.hpp \
     $${GRABBERS_HEADERS}
 
 SOURCES += \
     calculations.cpp \
     GrabberBase.cpp \
+    FramePacer.cpp \
     include/ColorProvider.cpp \
     BlueLightReduction.cpp \
     $${GRABBERS_SOURCES}
@@ -57,7 +57,7 @@ protected slots:
 	virtual bool reallocate(const QList< ScreenInfo > &grabScreens);
 	virtual void showAdminMessage();
 
-	virtual QList< ScreenInfo > * screensWithWidgets(QList< ScreenInfo > * result, const QList<GrabWidget *> &grabWidgets);
+	virtual QList< ScreenInfo > * screensWithWidgets(QList< ScreenInfo > * result, const QList<GrabbedArea> &grabAreas);
 
 private:
 	QScopedPointer<D3D10GrabberImpl> m_impl;
@@ -76,8 +76,8 @@ protected slots:
 	virtual bool reallocate(const QList< ScreenInfo > &grabScreens);
 	bool _reallocate(const QList< ScreenInfo > &grabScreens, bool noRecursion = false);
 
-	virtual QList< ScreenInfo > * screensWithWidgets(QList< ScreenInfo > * result, const QList<GrabWidget *> &grabWidgets);
-	QList< ScreenInfo > * __screensWithWidgets(QList< ScreenInfo > * result, const QList<GrabWidget *> &grabWidgets, bool noRecursion = false);
+	virtual QList< ScreenInfo > * screensWithWidgets(QList< ScreenInfo > * result, const QList<GrabbedArea> &grabAreas);
+	QList< ScreenInfo > * __screensWithWidgets(QList< ScreenInfo > * result, const QList<GrabbedArea> &grabAreas, bool noRecursion = false);
 
 	virtual bool isReallocationNeeded(const QList< ScreenInfo > &grabScreens) const;
 
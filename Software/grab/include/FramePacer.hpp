@@ -0,0 +1,113 @@
+/*
+ * FramePacer.hpp
+ *
+ *	Created on: 18.10.2026
+ *		Project: Prismatik
+ *
+ *	Prismatik is a free, open-source software: you can redistribute it and/or
+ *	modify it under the terms of the GNU General Public License as published
+ *	by the Free Software Foundation, either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	Prismatik and Lightpack files is distributed in the hope that it will be
+ *	useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.	See the GNU
+ *	General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with this program.	If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+
+#include <chrono>
+#include <QMetaType>
+
+namespace Grab
+{
+	/*!
+		Frame timing measured by \a FramePacer since the previous \a FramePacer#takeStats() call
+	*/
+	struct FramePacingStats {
+		double intervalMs = 0.0; // interval the pacer schedules frames at, after alignment and adaptation
+		double frameTimeMs = 0.0; // mean time between frame starts
+		double latencyMs = 0.0; // mean grab + process + hand-off time
+		double jitterMs = 0.0; // mean absolute deviation of frame starts from their deadlines
+		int deadlineMisses = 0; // deadlines skipped because the previous frame was still running
+		int framesCount = 0;
+	};
+
+	/*!
+		Schedules frames against a monotonic clock. Deadlines advance by a fixed interval
+		from the previous deadline, not from the end of the previous frame, so the time spent
+		grabbing doesn't shift the phase. The interval is stretched when frames take longer
+		than the target interval and can be snapped to a multiple of the display refresh period.
+		Not thread-safe.
+	*/
+	class FramePacer
+	{
+	public:
+		typedef std::chrono::steady_clock Clock;
+
+		FramePacer();
+
+		void setTargetInterval(std::chrono::microseconds interval);
+		std::chrono::microseconds targetInterval() const { return m_targetInterval; }
+		/*!
+			\param hz display refresh rate, 0 if unknown
+		*/
+		void setDisplayRefreshRate(double hz);
+		void setAlignToDisplayRefresh(bool isEnabled);
+
+		/*!
+			Interval actually used to schedule frames
+		*/
+		std::chrono::microseconds interval() const { return m_interval; }
+
+		/*!
+			Starts a new schedule, the first deadline is \a now
+		*/
+		void reset(Clock::time_point now);
+		Clock::time_point nextDeadline() const { return m_deadline; }
+
+		void frameStarted(Clock::time_point now);
+		/*!
+			Accounts frame latency and moves the deadline to the next frame
+		*/
+		void frameFinished(Clock::time_point now);
+		/*!
+			No frame this time, e.g. the source isn't ready yet. Moves the deadline to the next
+			frame without counting one
+		*/
+		void skipFrame(Clock::time_point now);
+
+		FramePacingStats takeStats();
+
+	private:
+		void updateInterval();
+
+	private:
+		std::chrono::microseconds m_targetInterval;
+		std::chrono::microseconds m_interval;
+		std::chrono::microseconds m_refreshPeriod;
+		bool m_isAlignToDisplayRefresh;
+
+		Clock::time_point m_deadline;
+		Clock::time_point m_frameStart;
+		Clock::time_point m_previousFrameStart;
+		bool m_isFrameStarted;
+		bool m_hasPreviousFrame;
+		double m_latencyAvgUs; // exponential moving average, drives the adaptation
+
+		// accumulated for stats
+		double m_frameTimeSumUs;
+		double m_latencySumUs;
+		double m_jitterSumUs;
+		int m_frameTimesCount;
+		int m_framesCount;
+		int m_deadlineMisses;
+	};
+}
+
+Q_DECLARE_METATYPE(Grab::FramePacingStats)
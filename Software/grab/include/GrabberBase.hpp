@@ -28,12 +28,14 @@
 #include <QSharedPointer>
 #include <QColor>
 #include <QTimer>
-#include "src/GrabWidget.hpp"
+#include <QVector>
+#include <QThreadPool>
+#include <QMutex>
+#include "GrabberContext.hpp"
+#include "FramePacer.hpp"
 #include "calculations.hpp"
 
 
-class GrabberContext;
-
 enum GrabResult {
 	GrabResultOk,
 	GrabResultFrameNotReady,
@@ -66,6 +68,15 @@ struct GrabbedScreen {
 	size_t bytesPerRow = 0; // some grabbing methods won't return values equal to (width * bytesPerPixel) because of alignment / padding
 };
 
+/*!
+	Grab widget mapped onto a grabbed screen buffer
+*/
+struct GrabbedZone {
+	int screenIndex = -1; // index in GrabberBase#_screensWithWidgets, -1 if \a fallbackColor should be used
+	QRect rect; // in grabbed buffer coordinates
+	QRgb fallbackColor = 0;
+};
+
 #define DECLARE_GRABBER_NAME(grabber_name) \
 	virtual const char * name() const { \
 		static const char * static_grabber_name = (grabber_name); \
@@ -79,26 +90,43 @@ struct GrabbedScreen {
 class GrabberBase : public QObject
 {
 	Q_OBJECT
+	friend class GrabZonesBatch;
 public:
 
 	/*!
 		\param parent standart Qt-specific owner
-		\param grabResult \code QList \endcode to write results of grabbing to
-		\param grabWidgets List of GrabWidgets
+		\param grabberContext holds \code QList \endcode to write results of grabbing to
+		and snapshot of grab areas
 	*/
 	GrabberBase(QObject * parent, GrabberContext * grabberContext);
 	virtual ~GrabberBase() {}
 
 	virtual const char * name() const = 0;
 
-	virtual void startGrabbing();
-	virtual void stopGrabbing();
 	virtual bool isGrabbingStarted() const;
+
+	/*!
+		Frame timing since the previous call, safe to call from any thread
+	*/
+	Grab::FramePacingStats takeFramePacingStats();
 public slots:
 
+	virtual void startGrabbing();
+	virtual void stopGrabbing();
 	virtual void setGrabInterval(int msec);
+	virtual void setDisplayRefreshRate(double hz);
+	virtual void setAlignToDisplayRefreshEnabled(bool isEnabled);
+	virtual void setIntegralImageEnabled(bool isEnabled);
+	virtual void setSamplingStride(int samplingStride);
+	/*!
+		Lets grabbers that can scale on the capture side fetch smaller frames, see \a GrabbedScreen#scale
+	*/
+	virtual void setDownscaleOnCaptureEnabled(bool isEnabled);
 	virtual void grab();
 
+private slots:
+	void onGrabTimeout();
+
 protected:
 	/*!
 		Grabs screens and saves them to \a GrabberBase#_screensWithWidgets field. Called by
@@ -106,6 +134,11 @@ protected:
 		\return GrabResult
 	*/
 	virtual GrabResult grabScreens() = 0;
+	/*!
+		Called after every \a grabScreens() once the zones are evaluated, the data of the
+		screens isn't read after it until the next \a grabScreens()
+	*/
+	virtual void releaseScreens() {}
 	/*!
 		* Frees unnecessary resources and allocates needed ones based on \a ScreenInfo
 		* \param grabScreens
@@ -114,14 +147,23 @@ protected:
 	virtual bool reallocate(const QList< ScreenInfo > &grabScreens) = 0;
 
 	/*!
-		* Get all screens grab widgets lies on.
+		* Get all screens grab areas lies on.
 		* \param result
-		* \param grabWidgets
+		* \param grabAreas
 		* \return
 		*/
-	virtual QList< ScreenInfo > * screensWithWidgets(QList< ScreenInfo > * result, const QList<GrabWidget *> &grabWidgets) = 0;
+	virtual QList< ScreenInfo > * screensWithWidgets(QList< ScreenInfo > * result, const QList<GrabbedArea> &grabAreas) = 0;
 	virtual bool isReallocationNeeded(const QList< ScreenInfo > &grabScreens) const;
+	int grabInterval() const;
+	void scheduleNextGrab();
+	void grabFrame();
 	const GrabbedScreen * screenOfRect(const QRect &rect) const;
+	int screenIndexOfRect(const QRect &rect) const;
+	void prepareZone(const GrabbedArea &area, GrabbedZone &zone) const;
+	void updateIntegralImages();
+	QRgb evaluateZone(const GrabbedZone &zone) const;
+	void evaluateZones(int from, int to, QRgb *colors) const;
+	void evaluateAllZones();
 
 signals:
 	void frameGrabAttempted(GrabResult grabResult);
@@ -136,5 +178,16 @@ protected:
 	GrabResult _lastGrabResult;
 	int grabScreensCount;
 	QList<GrabbedScreen> _screensWithWidgets;
-	QScopedPointer<QTimer> m_timer;
+	QList<GrabbedArea> _grabAreas;
+	QVector<GrabbedZone> _zones;
+	QVector<QRgb> _zoneColors;
+	QThreadPool m_zonesThreadPool;
+	QVector<Grab::Calculations::IntegralImage> _integralImages;
+	bool m_isIntegralImageEnabled;
+	int m_samplingStride;
+	bool m_isDownscaleOnCaptureEnabled;
+	bool m_isGrabbingStarted;
+	Grab::FramePacer m_framePacer;
+	mutable QMutex m_framePacerMutex;
+	QScopedPointer<QTimer> m_timer; // single shot, re-armed by \a scheduleNextGrab()
 };
@@ -27,10 +27,20 @@
 #ifndef GRABBERCONTEXT_HPP
 #define GRABBERCONTEXT_HPP
 
+#include <chrono>
 #include <QList>
 #include <QRgb>
-
-class GrabWidget;
+#include <QRect>
+#include <QMutex>
+
+/*!
+	Snapshot of a GrabWidget taken on the GUI thread. Grabbers run in the capture thread
+	and must not touch the widgets themselves.
+*/
+struct GrabbedArea {
+	QRect rect; // frame geometry in desktop coordinates
+	bool isEnabled = true;
+};
 
 struct AllocatedBuf {
 	AllocatedBuf()
@@ -94,13 +104,28 @@ public:
 			}
 		}
 	}
+
+	void setGrabAreas(const QList<GrabbedArea> &grabAreas) {
+		QMutexLocker locker(&_grabAreasMutex);
+		_grabAreas = grabAreas;
+	}
+
+	QList<GrabbedArea> grabAreas() const {
+		QMutexLocker locker(&_grabAreasMutex);
+		return _grabAreas;
+	}
+
 public:
-	QList<GrabWidget *> *grabWidgets;
 	QList<QRgb> *grabResult;
+	// of the frame in grabResult, for latency tracing
+	std::chrono::steady_clock::time_point grabStarted;
+	std::chrono::steady_clock::time_point grabFinished;
 
 
 private:
 	QList<AllocatedBuf *> _allocatedBufs;
+	QList<GrabbedArea> _grabAreas;
+	mutable QMutex _grabAreasMutex;
 };
 
 
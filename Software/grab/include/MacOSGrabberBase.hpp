@@ -45,12 +45,12 @@ public:
 	static double getDisplayScalingRatio(CGDirectDisplayID display);
 	static double getDisplayRefreshRate(CGDirectDisplayID display);
 protected slots:
-	virtual QList< ScreenInfo > * screensWithWidgets(QList< ScreenInfo > * result, const QList<GrabWidget *> &grabWidgets);
+	virtual QList< ScreenInfo > * screensWithWidgets(QList< ScreenInfo > * result, const QList<GrabbedArea> &grabAreas);
 	virtual GrabResult grabScreens();
 	virtual bool reallocate(const QList<ScreenInfo> &screens);
 protected:
 	static bool allocateScreenBuffer(const ScreenInfo& screen, GrabbedScreen& grabScreen);
-	static bool getScreenInfoFromRect(const CGDirectDisplayID display, const QList<GrabWidget *>& grabWidgets, ScreenInfo& screenInfo);
+	static bool getScreenInfoFromRect(const CGDirectDisplayID display, const QList<GrabbedArea>& grabAreas, ScreenInfo& screenInfo);
 #ifndef QT_NO_DEBUG
 	static void saveGrabbedScreenToBMP(const GrabbedScreen& screen);
 #endif // QT_NO_DEBUG
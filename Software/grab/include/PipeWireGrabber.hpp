@@ -0,0 +1,109 @@
+/*
+ * PipeWireGrabber.hpp
+ *
+ *	Created on: 18.10.2026
+ *		Project: Prismatik
+ *
+ *	Prismatik is a free, open-source software: you can redistribute it and/or
+ *	modify it under the terms of the GNU General Public License as published
+ *	by the Free Software Foundation, either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	Prismatik and Lightpack files is distributed in the hope that it will be
+ *	useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.	See the GNU
+ *	General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with this program.	If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+
+#include "GrabberBase.hpp"
+#include "../src/enums.hpp"
+
+#ifdef PIPEWIRE_GRAB_SUPPORT
+
+#include <QVariantMap>
+#include <QVector>
+#include <QRect>
+
+struct pw_thread_loop;
+struct pw_context;
+struct pw_core;
+struct PipeWireStream;
+
+using namespace Grab;
+
+/*!
+	Screen cast grabber for Wayland (and X11) sessions. Screens are shared by the user through
+	the xdg-desktop-portal ScreenCast interface, frames arrive as PipeWire BGRx buffers in shared
+	memory. The latest buffer of each stream is held and handed to \a GrabberBase as is, without
+	copying; it goes back to the stream when the next one is taken.
+
+	For testing without a portal set PRISMATIK_PIPEWIRE_NODE to a comma separated list of node
+	ids of the local PipeWire daemon, e.g. of a videotestsrc ! pipewiresink pipeline.
+	The nodes are mapped onto the desktop screens in order.
+*/
+class PipeWireGrabber : public GrabberBase
+{
+	Q_OBJECT
+public:
+	PipeWireGrabber(QObject *parent, GrabberContext *context);
+	virtual ~PipeWireGrabber();
+
+	DECLARE_GRABBER_NAME("PipeWireGrabber")
+
+public slots:
+	virtual void startGrabbing();
+	virtual void stopGrabbing();
+	virtual void grab();
+
+protected:
+	virtual GrabResult grabScreens();
+	virtual void releaseScreens();
+	virtual bool reallocate(const QList<ScreenInfo> &screens);
+	virtual QList<ScreenInfo> * screensWithWidgets(QList<ScreenInfo> *result, const QList<GrabbedArea> &grabAreas);
+
+private slots:
+	void onPortalResponse(uint response, const QVariantMap &results);
+
+private:
+	enum PortalState {
+		PortalStateIdle,
+		PortalStateCreatingSession,
+		PortalStateSelectingSources,
+		PortalStateStarting,
+		PortalStateStarted,
+		PortalStateFailed
+	};
+
+	void startScreenCast();
+	bool callPortal(const QString &method, const QVariantList &arguments, QVariantMap options, PortalState nextState);
+	QVariant portalProperty(const QString &name) const;
+	QString newHandleToken();
+	void openPipeWireRemote(const QVariantMap &results);
+	void closeSession();
+
+	bool connectStreams(int fd, const QList< QPair<uint, QRect> > &nodes);
+	void destroyStreams();
+	void setStreamsActive(bool isActive);
+
+private:
+	PortalState m_portalState;
+	QString m_sessionHandle;
+	QString m_requestPath;
+	QString m_restoreToken;
+	uint m_portalVersion;
+	int m_handleTokenCounter;
+	QVector<QRect> m_desktopScreens;
+
+	pw_thread_loop *m_loop;
+	pw_context *m_context;
+	pw_core *m_core;
+	QVector<PipeWireStream *> m_streams;
+};
+
+#endif // PIPEWIRE_GRAB_SUPPORT
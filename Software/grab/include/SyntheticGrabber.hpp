@@ -0,0 +1,93 @@
+/*
+ * SyntheticGrabber.hpp
+ *
+ *	Created on: 18.10.2026
+ *		Project: Prismatik
+ *
+ *	Prismatik is a free, open-source software: you can redistribute it and/or
+ *	modify it under the terms of the GNU General Public License as published
+ *	by the Free Software Foundation, either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	Prismatik and Lightpack files is distributed in the hope that it will be
+ *	useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.	See the GNU
+ *	General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with this program.	If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+
+#include "GrabberBase.hpp"
+#include "../src/enums.hpp"
+
+#ifdef SYNTHETIC_GRAB_SUPPORT
+
+#include <QFile>
+#include <QSize>
+#include <QStringList>
+#include <QVector>
+
+using namespace Grab;
+
+/*!
+	Grabber without a display. Frames are either generated from a pattern or played back from
+	a raw BGRA file (width * height * 4 bytes per frame, frames one after another, looped).
+	Frames only depend on the frame number, so runs are reproducible, which makes it suitable
+	for benchmarking the processing pipeline and devices on headless machines.
+
+	Patterns are rendered in advance, a grab only points the screen at the next frame.
+*/
+class SyntheticGrabber : public GrabberBase
+{
+	Q_OBJECT
+public:
+	SyntheticGrabber(QObject *parent, GrabberContext *context);
+	virtual ~SyntheticGrabber();
+
+	DECLARE_GRABBER_NAME("SyntheticGrabber")
+
+	/*!
+		Names of the generated patterns, anything else is treated as a file path
+	*/
+	static const QStringList & patterns();
+
+public slots:
+	virtual void setGrabInterval(int msec);
+	/*!
+		\param source pattern name or path to a raw BGRA file
+		\param resolution size of the frames, also of the frames in the file
+		\param frameRate frames per second, 0 keeps the interval set by \a setGrabInterval()
+		\param desktopRect frames are stretched over it, the frame itself is the desktop if empty
+	*/
+	void setSource(const QString &source, const QSize &resolution, int frameRate, const QRect &desktopRect);
+
+protected:
+	virtual GrabResult grabScreens();
+	virtual bool reallocate(const QList<ScreenInfo> &screens);
+	virtual QList<ScreenInfo> * screensWithWidgets(QList<ScreenInfo> *result, const QList<GrabbedArea> &grabAreas);
+	virtual bool isReallocationNeeded(const QList<ScreenInfo> &screens) const;
+
+private:
+	void renderPattern(int pattern, int frame, int framesCount, quint32 *pixels) const;
+	void applyGrabInterval();
+
+private:
+	QString m_source;
+	QSize m_resolution;
+	int m_frameRate;
+	int m_grabIntervalMs;
+	QRect m_desktopRect;
+	bool m_isSourceChanged;
+
+	QVector<quint32> m_frames; // rendered pattern, frames one after another
+	QFile m_file;
+	const uchar *m_fileData; // mapped frames of the file
+	qint64 m_framesCount;
+	qint64 m_frameIndex;
+};
+
+#endif // SYNTHETIC_GRAB_SUPPORT
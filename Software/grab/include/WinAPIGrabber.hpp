@@ -60,7 +60,7 @@ protected slots:
 	virtual GrabResult grabScreens();
 	virtual bool reallocate(const QList< ScreenInfo > &grabScreens);
 
-	virtual QList< ScreenInfo > * screensWithWidgets(QList< ScreenInfo > * result, const QList<GrabWidget *> &grabWidgets);
+	virtual QList< ScreenInfo > * screensWithWidgets(QList< ScreenInfo > * result, const QList<GrabbedArea> &grabAreas);
 
 protected:
 	void freeScreens();
@@ -31,6 +31,8 @@
 #ifdef X11_GRAB_SUPPORT
 
 #include <QScopedPointer>
+#include <QVector>
+#include <QPair>
 #include "../src/debug.h"
 
 struct X11GrabberData;
@@ -49,12 +51,28 @@ public:
 protected:
     virtual GrabResult grabScreens();
     virtual bool reallocate(const QList<ScreenInfo> &screens);
-    virtual QList<ScreenInfo> * screensWithWidgets(QList<ScreenInfo> *result, const QList<GrabWidget *> &grabWidgets);
+    virtual QList<ScreenInfo> * screensWithWidgets(QList<ScreenInfo> *result, const QList<GrabbedArea> &grabAreas);
+    virtual bool isReallocationNeeded(const QList<ScreenInfo> &screens) const;
 
 private:
     void freeScreens();
+    int downscaleLevels(const QRect &region, const QList<GrabbedArea> &grabAreas) const;
+    bool allocatePyramid(X11GrabberData *d, int screenid, const QSize &size, int levels);
+    void grabRegion(const GrabbedScreen &screen);
+    void grabRows(const GrabbedScreen &screen, int y, int height);
+    void grabDownscaled(const GrabbedScreen &screen);
 
 private:
     _XDisplay *_display;
+    bool _isDamageSupported;
+    bool _isRenderSupported;
+    // bounding regions of the widgets, each one is captured into its own segment
+    QList<ScreenInfo> _regions;
+    QVector<QRect> _regionsAreas; // widgets the regions were built for, empty rects for disabled ones
+    QVector<QRect> _regionsScreenRects;
+    QVector<int> _regionsLevels; // times each region is halved on capture, see downscaleLevels()
+    bool _regionsDownscaleEnabled;
+    QVector<QRect> _damageAreas; // enabled areas of the previous frame
+    QVector< QPair<int, int> > _damageRows;
 };
 #endif // X11_GRAB_SUPPORT
@@ -28,10 +28,31 @@
 #include <QRect>
 #include <QRgb>
 #include <QList>
+#include <vector>
+#include <stdint.h>
 #include "common/BufferFormat.h"
 
 namespace Grab {
 	namespace Calculations {
-		QRgb calculateAvgColor(const unsigned char * const buffer, BufferFormat bufferFormat, const size_t pitch, const QRect &rect);
+		/*!
+			Summed-area table of a part of a grabbed frame. Each entry holds r, g, b sums (and one
+			padding lane) of all pixels above and to the left of it, so the average color of any
+			rectangle inside \a rect can be looked up in O(1).
+			Sums are kept in 32 bits and wrap around, lookups stay exact for rects up to
+			\a IntegralImageMaxArea pixels.
+		*/
+		struct IntegralImage {
+			QRect rect; // covered region in grabbed buffer coordinates
+			std::vector<uint32_t> data; // (rect.width() + 1) * (rect.height() + 1) entries
+		};
+		constexpr const size_t IntegralImageMaxArea = (1 << 24);
+
+		/*!
+			\param samplingStride only every samplingStride-th pixel of every samplingStride-th row is read,
+			1 reads the whole rect
+		*/
+		QRgb calculateAvgColor(const unsigned char * const buffer, BufferFormat bufferFormat, const size_t pitch, const QRect &rect, const int samplingStride = 1);
+		bool calculateIntegralImage(const unsigned char * const buffer, BufferFormat bufferFormat, const size_t pitch, const QRect &rect, IntegralImage &result);
+		QRgb calculateAvgColor(const IntegralImage &integralImage, const QRect &rect);
 	}
 }
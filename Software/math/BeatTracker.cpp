@@ -0,0 +1,245 @@
+/*
+ * BeatTracker.cpp
+ *
+ *	Created on: 18.10.2026
+ *		Project: Prismatik
+ *
+ *	Prismatik is a free, open-source software: you can redistribute it and/or
+ *	modify it under the terms of the GNU General Public License as published
+ *	by the Free Software Foundation, either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	Prismatik and Lightpack files is distributed in the hope that it will be
+ *	useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.	See the GNU
+ *	General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with this program.	If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "BeatTracker.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+	const double Compression = 1000.0; // log(1 + C * magnitude)
+	const double MeanTime = 1.0; // s, time constant of the flux average
+	const double OnsetThreshold = 1.5; // times the average
+	const double MinFlux = 0.002; // no onsets in near silence
+	const double MinOnsetInterval = 0.1; // s
+
+	const double EnvelopeRate = 100.0; // Hz
+	const size_t EnvelopeSize = 600; // 6 s
+	const size_t MinEnvelopeForTempo = 300;
+	const double TempoInterval = 0.5; // s between estimates
+	const double MinBpm = 60.0;
+	const double MaxBpm = 200.0;
+	const double PreferredBpm = 120.0; // resolves half and double tempo
+
+	const double MatchWindow = 0.25; // of the period, onsets within are on the grid
+	const double LostBeats = 4.0; // periods without an onset on the grid to start it over
+}
+
+namespace PrismatikMath
+{
+	BeatTracker::BeatTracker()
+		: m_envelope(EnvelopeSize)
+	{
+		reset();
+	}
+
+	void BeatTracker::reset()
+	{
+		m_previous.clear();
+		m_startTime = 0.0;
+		m_lastTime = 0.0;
+		m_flux = 0.0;
+		m_fluxMean = 0.0;
+		m_isOnset = false;
+		m_lastOnsetTime = -MinOnsetInterval;
+		m_onsetsCount = 0;
+
+		std::fill(m_envelope.begin(), m_envelope.end(), 0.0f);
+		m_envelopeIndex = 0;
+		m_envelopeFilled = 0;
+		m_envelopeTime = 0.0;
+		m_lastTempoTime = 0.0;
+
+		m_tempo = 0.0;
+		m_confidence = 0.0;
+		m_beatTime = 0.0;
+		m_lastMatchTime = 0.0;
+	}
+
+	double BeatTracker::strength() const
+	{
+		return m_fluxMean > 0.0 ? m_flux / m_fluxMean : 0.0;
+	}
+
+	bool BeatTracker::process(const float *spectrum, size_t size, double time)
+	{
+		if (m_previous.size() != size) {
+			m_previous.resize(size);
+			for (size_t i = 0; i < size; ++i)
+				m_previous[i] = std::log1p(Compression * spectrum[i]);
+			m_startTime = time;
+			m_lastTime = time;
+			m_envelopeTime = time;
+			m_lastTempoTime = time;
+			m_isOnset = false;
+			return false;
+		}
+
+		double flux = 0.0;
+		bool isChanged = false;
+		for (size_t i = 0; i < size; ++i) {
+			const float value = std::log1p(Compression * spectrum[i]);
+			const float rise = value - m_previous[i];
+			isChanged = isChanged || rise != 0.0f;
+			if (rise > 0.0f)
+				flux += rise;
+			m_previous[i] = value;
+		}
+		if (!isChanged)
+			return m_isOnset = false;
+
+		m_flux = flux / size;
+		// the average needs a while to settle before it's a threshold
+		m_isOnset = m_flux > m_fluxMean * OnsetThreshold + MinFlux
+				&& time - m_lastOnsetTime >= MinOnsetInterval && time - m_startTime >= MeanTime;
+
+		const double alpha = 1.0 - std::exp(-(time - m_lastTime) / MeanTime);
+		m_fluxMean += (m_flux - m_fluxMean) * alpha;
+		m_lastTime = time;
+
+		addToEnvelope(std::max(0.0, m_flux - m_fluxMean), time);
+		if (m_envelopeFilled >= MinEnvelopeForTempo && time - m_lastTempoTime >= TempoInterval) {
+			estimateTempo();
+			m_lastTempoTime = time;
+		}
+
+		if (m_isOnset) {
+			m_lastOnsetTime = time;
+			++m_onsetsCount;
+			trackBeat(time);
+		}
+		return m_isOnset;
+	}
+
+	void BeatTracker::addToEnvelope(double value, double time)
+	{
+		// bins without a spectrum stay 0, the periodicity is still there
+		while (time >= m_envelopeTime + 1.0 / EnvelopeRate) {
+			m_envelopeIndex = (m_envelopeIndex + 1) % EnvelopeSize;
+			m_envelope[m_envelopeIndex] = 0.0f;
+			m_envelopeFilled = std::min(m_envelopeFilled + 1, EnvelopeSize);
+			m_envelopeTime += 1.0 / EnvelopeRate;
+		}
+		m_envelope[m_envelopeIndex] = std::max(m_envelope[m_envelopeIndex], static_cast<float>(value));
+	}
+
+	void BeatTracker::estimateTempo()
+	{
+		// oldest to newest, smoothed so onsets a bin apart still correlate
+		std::vector<float> envelope(m_envelopeFilled);
+		for (size_t i = 0; i < m_envelopeFilled; ++i) {
+			float sum = 0.0f;
+			for (int k = -2; k <= 2; ++k) {
+				const size_t j = std::min(m_envelopeFilled - 1, static_cast<size_t>(std::max<ptrdiff_t>(0, static_cast<ptrdiff_t>(i) + k)));
+				sum += m_envelope[(m_envelopeIndex + EnvelopeSize - m_envelopeFilled + 1 + j) % EnvelopeSize] * (3 - std::abs(k));
+			}
+			envelope[i] = sum / 9.0f;
+		}
+
+		const size_t minLag = static_cast<size_t>(60.0 * EnvelopeRate / MaxBpm);
+		const size_t maxLag = static_cast<size_t>(60.0 * EnvelopeRate / MinBpm);
+
+		std::vector<double> correlation(maxLag + 2);
+		for (size_t lag = 0; lag < correlation.size(); ++lag) {
+			if (lag != 0 && lag < minLag - 1)
+				continue;
+			double sum = 0.0;
+			for (size_t i = lag; i < envelope.size(); ++i)
+				sum += envelope[i] * envelope[i - lag];
+			// every lag is averaged over as many products
+			correlation[lag] = sum / (envelope.size() - lag);
+		}
+		if (correlation[0] <= 0.0) {
+			m_confidence = 0.0;
+			return;
+		}
+
+		size_t bestLag = 0;
+		double bestScore = 0.0;
+		for (size_t lag = minLag; lag <= maxLag; ++lag) {
+			const double octaves = std::log2(60.0 * EnvelopeRate / lag / PreferredBpm);
+			const double score = correlation[lag] * std::exp(-0.5 * octaves * octaves);
+			if (score > bestScore) {
+				bestScore = score;
+				bestLag = lag;
+			}
+		}
+		if (bestLag == 0) {
+			m_confidence = 0.0;
+			return;
+		}
+
+		// parabola through the neighbours for a lag between the bins
+		double lag = bestLag;
+		const double left = correlation[bestLag - 1], center = correlation[bestLag], right = correlation[bestLag + 1];
+		const double curvature = left - 2.0 * center + right;
+		if (curvature < 0.0)
+			lag += 0.5 * (left - right) / curvature;
+
+		const double tempo = 60.0 * EnvelopeRate / lag;
+		m_confidence = std::min(1.0, std::max(0.0, center / correlation[0]));
+
+		// follow small drifts smoothly, jump to a new tempo
+		if (m_tempo == 0.0 || std::abs(tempo - m_tempo) > m_tempo * 0.1)
+			m_tempo = tempo;
+		else
+			m_tempo += (tempo - m_tempo) * 0.3;
+	}
+
+	void BeatTracker::trackBeat(double time)
+	{
+		if (m_tempo == 0.0)
+			return;
+
+		const double period = 60.0 / m_tempo;
+		if (m_lastMatchTime == 0.0 || time - m_lastMatchTime > LostBeats * period) {
+			m_beatTime = time;
+			m_lastMatchTime = time;
+			return;
+		}
+
+		// pull the grid halfway towards onsets near a beat, ignore the ones in between
+		const double nearestBeat = m_beatTime + std::round((time - m_beatTime) / period) * period;
+		const double error = time - nearestBeat;
+		if (std::abs(error) < MatchWindow * period) {
+			m_beatTime = nearestBeat + error * 0.5;
+			m_lastMatchTime = time;
+		}
+	}
+
+	double BeatTracker::beatPhase(double time) const
+	{
+		if (m_tempo == 0.0 || m_lastMatchTime == 0.0)
+			return 0.0;
+
+		const double beats = (time - m_beatTime) * m_tempo / 60.0;
+		return beats - std::floor(beats);
+	}
+
+	double BeatTracker::nextBeatTime(double time) const
+	{
+		if (m_tempo == 0.0 || m_lastMatchTime == 0.0)
+			return 0.0;
+
+		const double period = 60.0 / m_tempo;
+		return m_beatTime + (std::floor((time - m_beatTime) / period) + 1.0) * period;
+	}
+}
@@ -0,0 +1,365 @@
+/*
+ * ColorBatch.cpp
+ *
+ *	Created on: 18.10.2026
+ *		Project: Prismatik
+ *
+ *	Prismatik is a free, open-source software: you can redistribute it and/or
+ *	modify it under the terms of the GNU General Public License as published
+ *	by the Free Software Foundation, either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	Prismatik and Lightpack files is distributed in the hope that it will be
+ *	useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.	See the GNU
+ *	General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with this program.	If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "ColorBatch.hpp"
+#include "PrismatikMath.hpp"
+#include "SimdLevel.hpp"
+#include <algorithm>
+#include <array>
+#include <immintrin.h>
+
+namespace PrismatikMath
+{
+namespace
+{
+	// RgbToXyz() matrix with the rows divided by the D65 white of XyzToLab()
+	constexpr const float xyzMatrix[3][3] = {
+		{ 0.4124564f / 95.047f, 0.3575761f / 95.047f, 0.1804375f / 95.047f },
+		{ 0.2126729f / 100.0f, 0.7151522f / 100.0f, 0.0721750f / 100.0f },
+		{ 0.0193339f / 108.883f, 0.1191920f / 108.883f, 0.9503041f / 108.883f }
+	};
+	// XyzToRgb() matrix with the columns multiplied by the D65 white of LabToXyz()
+	constexpr const float rgbMatrix[3][3] = {
+		{ 3.2404542f * 0.95047f, -1.5371385f * 1.0f, -0.4985314f * 1.08883f },
+		{ -0.9692660f * 0.95047f, 1.8760108f * 1.0f, 0.0415560f * 1.08883f },
+		{ 0.0556434f * 0.95047f, -0.2040259f * 1.0f, 1.0572252f * 1.08883f }
+	};
+	constexpr const float labEpsilon = 0.008856f;
+	constexpr const float labKappa = 7.787f;
+	constexpr const float labOffset = 16.0f / 116.0f;
+	constexpr const float srgbThreshold = 0.0031308f;
+	// float bit pattern of an initial cube root guess is pattern / 3 + cbrtMagic
+	constexpr const int cbrtMagic = 709921077;
+
+	// 8 bit sRGB channel value to linear, times 100 as in RgbToXyz()
+	std::array<float, 256> makeLinearTable() {
+		std::array<float, 256> table;
+		for (size_t i = 0; i < table.size(); ++i) {
+			const double v = i / 255.0;
+			table[i] = ((v > 0.04045) ? pow((v + 0.055) / 1.055, 2.4) : (v / 12.92)) * 100.0;
+		}
+		return table;
+	}
+
+	const float * linearTable() {
+		static const std::array<float, 256> table = makeLinearTable();
+		return table.data();
+	}
+
+	static void rgbToLabScalar(const QList<QRgb> &colors, LabBatch &result) {
+		for (int i = 0; i < colors.size(); ++i) {
+			StructRgb rgb;
+			rgb.r = qRed(colors[i]);
+			rgb.g = qGreen(colors[i]);
+			rgb.b = qBlue(colors[i]);
+			StructXyz xyz;
+			StructLabF lab;
+			RgbToXyz(rgb, xyz);
+			XyzToLab(xyz, lab);
+			result.l[i] = lab.l;
+			result.a[i] = lab.a;
+			result.b[i] = lab.b;
+		}
+	}
+
+	static void labToRgbScalar(const LabBatch &lab, QList<QRgb> &result) {
+		for (size_t i = 0; i < lab.size(); ++i) {
+			StructLabF labF;
+			labF.l = lab.l[i];
+			labF.a = lab.a[i];
+			labF.b = lab.b[i];
+			StructXyz xyz;
+			StructRgb rgb;
+			LabToXyz(labF, xyz);
+			XyzToRgb(xyz, rgb);
+			result[i] = qRgb(rgb.r, rgb.g, rgb.b);
+		}
+	}
+
+
+	// x > 0, three Newton steps from the bit pattern guess are enough for single precision
+	SIMD_TARGET_SSE4_1 static inline __m128 cbrt128(const __m128 x) {
+		const __m128 third = _mm_set1_ps(1.0f / 3.0f);
+		const __m128i guess = _mm_cvttps_epi32(_mm_mul_ps(_mm_cvtepi32_ps(_mm_castps_si128(x)), third));
+		__m128 y = _mm_castsi128_ps(_mm_add_epi32(guess, _mm_set1_epi32(cbrtMagic)));
+		for (int i = 0; i < 3; ++i)
+			y = _mm_mul_ps(_mm_add_ps(_mm_add_ps(y, y), _mm_div_ps(x, _mm_mul_ps(y, y))), third);
+		return y;
+	}
+
+	// f(t) of XyzToLab()
+	SIMD_TARGET_SSE4_1 static inline __m128 labF128(const __m128 t) {
+		const __m128 epsilon = _mm_set1_ps(labEpsilon);
+		const __m128 cube = cbrt128(_mm_max_ps(t, epsilon));
+		const __m128 linear = _mm_add_ps(_mm_mul_ps(t, _mm_set1_ps(labKappa)), _mm_set1_ps(labOffset));
+		return _mm_blendv_ps(linear, cube, _mm_cmpgt_ps(t, epsilon));
+	}
+
+	// inverse of f(t), LabToXyz()
+	SIMD_TARGET_SSE4_1 static inline __m128 labFInverse128(const __m128 f) {
+		const __m128 f3 = _mm_mul_ps(_mm_mul_ps(f, f), f);
+		const __m128 linear = _mm_mul_ps(_mm_sub_ps(f, _mm_set1_ps(labOffset)), _mm_set1_ps(1.0f / labKappa));
+		return _mm_blendv_ps(linear, f3, _mm_cmpgt_ps(f3, _mm_set1_ps(labEpsilon)));
+	}
+
+	// sRGB companding of XyzToRgb() scaled to 0..255, v >= 0
+	SIMD_TARGET_SSE4_1 static inline __m128i companding128(const __m128 v) {
+		// v^(1/2.4) == ((v^5)^(1/3))^(1/4)
+		const __m128 clamped = _mm_min_ps(_mm_max_ps(v, _mm_set1_ps(srgbThreshold)), _mm_set1_ps(1.0f));
+		const __m128 v2 = _mm_mul_ps(clamped, clamped);
+		const __m128 v5 = _mm_mul_ps(_mm_mul_ps(v2, v2), clamped);
+		const __m128 power = _mm_sqrt_ps(_mm_sqrt_ps(cbrt128(v5)));
+		const __m128 encoded = _mm_min_ps(_mm_sub_ps(_mm_mul_ps(power, _mm_set1_ps(1.055f)), _mm_set1_ps(0.055f)), _mm_set1_ps(1.0f));
+		const __m128 linear = _mm_mul_ps(v, _mm_set1_ps(12.92f));
+		const __m128 result = _mm_blendv_ps(linear, encoded, _mm_cmpgt_ps(v, _mm_set1_ps(srgbThreshold)));
+		return _mm_cvttps_epi32(_mm_mul_ps(result, _mm_set1_ps(255.0f)));
+	}
+
+	SIMD_TARGET_SSE4_1 static void rgbToLab128(const QList<QRgb> &colors, LabBatch &result) {
+		constexpr const size_t lanes = 4;
+		const float * const table = linearTable();
+		const size_t count = colors.size();
+		for (size_t i = 0; i < count; i += lanes) {
+			alignas(16) float channels[3][lanes];
+			for (size_t lane = 0; lane < lanes; ++lane) {
+				// the last color fills up the lanes past the end
+				const QRgb color = colors[std::min(i + lane, count - 1)];
+				channels[0][lane] = table[qRed(color)];
+				channels[1][lane] = table[qGreen(color)];
+				channels[2][lane] = table[qBlue(color)];
+			}
+			const __m128 r = _mm_load_ps(channels[0]);
+			const __m128 g = _mm_load_ps(channels[1]);
+			const __m128 b = _mm_load_ps(channels[2]);
+
+			__m128 f[3];
+			for (int row = 0; row < 3; ++row)
+				f[row] = labF128(_mm_add_ps(_mm_add_ps(
+					_mm_mul_ps(r, _mm_set1_ps(xyzMatrix[row][0])),
+					_mm_mul_ps(g, _mm_set1_ps(xyzMatrix[row][1]))),
+					_mm_mul_ps(b, _mm_set1_ps(xyzMatrix[row][2]))));
+
+			alignas(16) float lab[3][lanes];
+			_mm_store_ps(lab[0], _mm_sub_ps(_mm_mul_ps(f[1], _mm_set1_ps(116.0f)), _mm_set1_ps(16.0f)));
+			_mm_store_ps(lab[1], _mm_mul_ps(_mm_sub_ps(f[0], f[1]), _mm_set1_ps(500.0f)));
+			_mm_store_ps(lab[2], _mm_mul_ps(_mm_sub_ps(f[1], f[2]), _mm_set1_ps(200.0f)));
+
+			const size_t n = std::min(lanes, count - i);
+			std::copy(lab[0], lab[0] + n, result.l.begin() + i);
+			std::copy(lab[1], lab[1] + n, result.a.begin() + i);
+			std::copy(lab[2], lab[2] + n, result.b.begin() + i);
+		}
+	}
+
+	SIMD_TARGET_SSE4_1 static void labToRgb128(const LabBatch &lab, QList<QRgb> &result) {
+		constexpr const size_t lanes = 4;
+		const size_t count = lab.size();
+		for (size_t i = 0; i < count; i += lanes) {
+			__m128 l, a, b;
+			if (i + lanes <= count) {
+				l = _mm_loadu_ps(&lab.l[i]);
+				a = _mm_loadu_ps(&lab.a[i]);
+				b = _mm_loadu_ps(&lab.b[i]);
+			} else {
+				alignas(16) float tail[3][lanes] = {};
+				std::copy(lab.l.begin() + i, lab.l.end(), tail[0]);
+				std::copy(lab.a.begin() + i, lab.a.end(), tail[1]);
+				std::copy(lab.b.begin() + i, lab.b.end(), tail[2]);
+				l = _mm_load_ps(tail[0]);
+				a = _mm_load_ps(tail[1]);
+				b = _mm_load_ps(tail[2]);
+			}
+
+			const __m128 fy = _mm_mul_ps(_mm_add_ps(l, _mm_set1_ps(16.0f)), _mm_set1_ps(1.0f / 116.0f));
+			const __m128 fx = _mm_add_ps(_mm_mul_ps(a, _mm_set1_ps(1.0f / 500.0f)), fy);
+			const __m128 fz = _mm_sub_ps(fy, _mm_mul_ps(b, _mm_set1_ps(1.0f / 200.0f)));
+			const __m128 x = labFInverse128(fx);
+			const __m128 y = labFInverse128(fy);
+			const __m128 z = labFInverse128(fz);
+
+			__m128i rgb = _mm_set1_epi32((int)0xff000000);
+			for (int row = 0; row < 3; ++row) {
+				const __m128 v = _mm_max_ps(_mm_add_ps(_mm_add_ps(
+					_mm_mul_ps(x, _mm_set1_ps(rgbMatrix[row][0])),
+					_mm_mul_ps(y, _mm_set1_ps(rgbMatrix[row][1]))),
+					_mm_mul_ps(z, _mm_set1_ps(rgbMatrix[row][2]))), _mm_setzero_ps());
+				rgb = _mm_or_si128(rgb, _mm_slli_epi32(companding128(v), 16 - 8 * row));
+			}
+
+			alignas(16) QRgb colors[lanes];
+			_mm_store_si128((__m128i*)colors, rgb);
+			const size_t n = std::min(lanes, count - i);
+			for (size_t lane = 0; lane < n; ++lane)
+				result[i + lane] = colors[lane];
+		}
+	}
+
+
+	SIMD_TARGET_AVX2 static inline __m256 cbrt256(const __m256 x) {
+		const __m256 third = _mm256_set1_ps(1.0f / 3.0f);
+		const __m256i guess = _mm256_cvttps_epi32(_mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_castps_si256(x)), third));
+		__m256 y = _mm256_castsi256_ps(_mm256_add_epi32(guess, _mm256_set1_epi32(cbrtMagic)));
+		for (int i = 0; i < 3; ++i)
+			y = _mm256_mul_ps(_mm256_add_ps(_mm256_add_ps(y, y), _mm256_div_ps(x, _mm256_mul_ps(y, y))), third);
+		return y;
+	}
+
+	SIMD_TARGET_AVX2 static inline __m256 labF256(const __m256 t) {
+		const __m256 epsilon = _mm256_set1_ps(labEpsilon);
+		const __m256 cube = cbrt256(_mm256_max_ps(t, epsilon));
+		const __m256 linear = _mm256_add_ps(_mm256_mul_ps(t, _mm256_set1_ps(labKappa)), _mm256_set1_ps(labOffset));
+		return _mm256_blendv_ps(linear, cube, _mm256_cmp_ps(t, epsilon, _CMP_GT_OQ));
+	}
+
+	SIMD_TARGET_AVX2 static inline __m256 labFInverse256(const __m256 f) {
+		const __m256 f3 = _mm256_mul_ps(_mm256_mul_ps(f, f), f);
+		const __m256 linear = _mm256_mul_ps(_mm256_sub_ps(f, _mm256_set1_ps(labOffset)), _mm256_set1_ps(1.0f / labKappa));
+		return _mm256_blendv_ps(linear, f3, _mm256_cmp_ps(f3, _mm256_set1_ps(labEpsilon), _CMP_GT_OQ));
+	}
+
+	SIMD_TARGET_AVX2 static inline __m256i companding256(const __m256 v) {
+		const __m256 clamped = _mm256_min_ps(_mm256_max_ps(v, _mm256_set1_ps(srgbThreshold)), _mm256_set1_ps(1.0f));
+		const __m256 v2 = _mm256_mul_ps(clamped, clamped);
+		const __m256 v5 = _mm256_mul_ps(_mm256_mul_ps(v2, v2), clamped);
+		const __m256 power = _mm256_sqrt_ps(_mm256_sqrt_ps(cbrt256(v5)));
+		const __m256 encoded = _mm256_min_ps(_mm256_sub_ps(_mm256_mul_ps(power, _mm256_set1_ps(1.055f)), _mm256_set1_ps(0.055f)), _mm256_set1_ps(1.0f));
+		const __m256 linear = _mm256_mul_ps(v, _mm256_set1_ps(12.92f));
+		const __m256 result = _mm256_blendv_ps(linear, encoded, _mm256_cmp_ps(v, _mm256_set1_ps(srgbThreshold), _CMP_GT_OQ));
+		return _mm256_cvttps_epi32(_mm256_mul_ps(result, _mm256_set1_ps(255.0f)));
+	}
+
+	SIMD_TARGET_AVX2 static void rgbToLab256(const QList<QRgb> &colors, LabBatch &result) {
+		constexpr const size_t lanes = 8;
+		const float * const table = linearTable();
+		const size_t count = colors.size();
+		const __m256i channelMask = _mm256_set1_epi32(0xff);
+		for (size_t i = 0; i < count; i += lanes) {
+			alignas(32) QRgb block[lanes];
+			for (size_t lane = 0; lane < lanes; ++lane)
+				block[lane] = colors[std::min(i + lane, count - 1)];
+			const __m256i vec8 = _mm256_load_si256((const __m256i*)block);
+			const __m256 r = _mm256_i32gather_ps(table, _mm256_and_si256(_mm256_srli_epi32(vec8, 16), channelMask), sizeof(float));
+			const __m256 g = _mm256_i32gather_ps(table, _mm256_and_si256(_mm256_srli_epi32(vec8, 8), channelMask), sizeof(float));
+			const __m256 b = _mm256_i32gather_ps(table, _mm256_and_si256(vec8, channelMask), sizeof(float));
+
+			__m256 f[3];
+			for (int row = 0; row < 3; ++row)
+				f[row] = labF256(_mm256_add_ps(_mm256_add_ps(
+					_mm256_mul_ps(r, _mm256_set1_ps(xyzMatrix[row][0])),
+					_mm256_mul_ps(g, _mm256_set1_ps(xyzMatrix[row][1]))),
+					_mm256_mul_ps(b, _mm256_set1_ps(xyzMatrix[row][2]))));
+
+			const __m256 l = _mm256_sub_ps(_mm256_mul_ps(f[1], _mm256_set1_ps(116.0f)), _mm256_set1_ps(16.0f));
+			const __m256 la = _mm256_mul_ps(_mm256_sub_ps(f[0], f[1]), _mm256_set1_ps(500.0f));
+			const __m256 lb = _mm256_mul_ps(_mm256_sub_ps(f[1], f[2]), _mm256_set1_ps(200.0f));
+			if (i + lanes <= count) {
+				_mm256_storeu_ps(&result.l[i], l);
+				_mm256_storeu_ps(&result.a[i], la);
+				_mm256_storeu_ps(&result.b[i], lb);
+			} else {
+				alignas(32) float lab[3][lanes];
+				_mm256_store_ps(lab[0], l);
+				_mm256_store_ps(lab[1], la);
+				_mm256_store_ps(lab[2], lb);
+				const size_t n = count - i;
+				std::copy(lab[0], lab[0] + n, result.l.begin() + i);
+				std::copy(lab[1], lab[1] + n, result.a.begin() + i);
+				std::copy(lab[2], lab[2] + n, result.b.begin() + i);
+			}
+		}
+	}
+
+	SIMD_TARGET_AVX2 static void labToRgb256(const LabBatch &lab, QList<QRgb> &result) {
+		constexpr const size_t lanes = 8;
+		const size_t count = lab.size();
+		for (size_t i = 0; i < count; i += lanes) {
+			__m256 l, a, b;
+			if (i + lanes <= count) {
+				l = _mm256_loadu_ps(&lab.l[i]);
+				a = _mm256_loadu_ps(&lab.a[i]);
+				b = _mm256_loadu_ps(&lab.b[i]);
+			} else {
+				alignas(32) float tail[3][lanes] = {};
+				std::copy(lab.l.begin() + i, lab.l.end(), tail[0]);
+				std::copy(lab.a.begin() + i, lab.a.end(), tail[1]);
+				std::copy(lab.b.begin() + i, lab.b.end(), tail[2]);
+				l = _mm256_load_ps(tail[0]);
+				a = _mm256_load_ps(tail[1]);
+				b = _mm256_load_ps(tail[2]);
+			}
+
+			const __m256 fy = _mm256_mul_ps(_mm256_add_ps(l, _mm256_set1_ps(16.0f)), _mm256_set1_ps(1.0f / 116.0f));
+			const __m256 fx = _mm256_add_ps(_mm256_mul_ps(a, _mm256_set1_ps(1.0f / 500.0f)), fy);
+			const __m256 fz = _mm256_sub_ps(fy, _mm256_mul_ps(b, _mm256_set1_ps(1.0f / 200.0f)));
+			const __m256 x = labFInverse256(fx);
+			const __m256 y = labFInverse256(fy);
+			const __m256 z = labFInverse256(fz);
+
+			__m256i rgb = _mm256_set1_epi32((int)0xff000000);
+			for (int row = 0; row < 3; ++row) {
+				const __m256 v = _mm256_max_ps(_mm256_add_ps(_mm256_add_ps(
+					_mm256_mul_ps(x, _mm256_set1_ps(rgbMatrix[row][0])),
+					_mm256_mul_ps(y, _mm256_set1_ps(rgbMatrix[row][1]))),
+					_mm256_mul_ps(z, _mm256_set1_ps(rgbMatrix[row][2]))), _mm256_setzero_ps());
+				rgb = _mm256_or_si256(rgb, _mm256_slli_epi32(companding256(v), 16 - 8 * row));
+			}
+
+			alignas(32) QRgb colors[lanes];
+			_mm256_store_si256((__m256i*)colors, rgb);
+			const size_t n = std::min(lanes, count - i);
+			for (size_t lane = 0; lane < n; ++lane)
+				result[i + lane] = colors[lane];
+		}
+	}
+
+
+	/*
+		*128 kernels require SSE4.1, *256 kernels require AVX2,
+		scalar functions by default, same as grab/calculations.cpp
+	*/
+	auto rgbToLabKernel = rgbToLabScalar;
+	auto labToRgbKernel = labToRgbScalar;
+
+	struct simdupgrade {
+		simdupgrade() {
+			const uint32_t level = availableSimd();
+			if (level & SIMDLevel::AVX2) {
+				rgbToLabKernel = rgbToLab256;
+				labToRgbKernel = labToRgb256;
+			} else if (level & SIMDLevel::SSE4_1) {
+				rgbToLabKernel = rgbToLab128;
+				labToRgbKernel = labToRgb128;
+			}
+		}
+	};
+	simdupgrade simdup;
+} // namespace
+
+	void rgbToLab(const QList<QRgb> &colors, LabBatch &result) {
+		result.resize(colors.size());
+		rgbToLabKernel(colors, result);
+	}
+
+	void labToRgb(const LabBatch &lab, QList<QRgb> &result) {
+		Q_ASSERT(static_cast<size_t>(result.size()) >= lab.size());
+		labToRgbKernel(lab, result);
+	}
+}
@@ -0,0 +1,154 @@
+/*
+ * ColorCorrectionLut.cpp
+ *
+ *	Created on: 18.10.2026
+ *		Project: Prismatik
+ *
+ *	Prismatik is a free, open-source software: you can redistribute it and/or
+ *	modify it under the terms of the GNU General Public License as published
+ *	by the Free Software Foundation, either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	Prismatik and Lightpack files is distributed in the hope that it will be
+ *	useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.	See the GNU
+ *	General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with this program.	If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "ColorCorrectionLut.hpp"
+#include "PrismatikMath.hpp"
+#include <algorithm>
+#include <array>
+#include <limits>
+
+namespace PrismatikMath
+{
+	namespace
+	{
+		const int LightnessMax = 100;
+
+		int exactLightness(double luminance)
+		{
+			StructXyz xyz;
+			xyz.y = luminance;
+			return toLab(xyz).l;
+		}
+
+		typedef std::array<double, LightnessMax + 1> LightnessBoundaries;
+
+		/*!
+			boundaries[l] is the lowest luminance with lightness l, found by bisection over
+			\a toLab() itself, so lookups agree with it down to the last bit
+		*/
+		LightnessBoundaries findLightnessBoundaries()
+		{
+			LightnessBoundaries boundaries;
+			boundaries[0] = 0.0;
+			for (int l = 1; l <= LightnessMax; ++l) {
+				double lo = boundaries[l - 1]; // lightness below l
+				double hi = 200.0; // lightness l or above, Y of white is 100
+				while (true) {
+					const double mid = lo + (hi - lo) / 2;
+					if (mid <= lo || mid >= hi)
+						break;
+					if (exactLightness(mid) < l)
+						lo = mid;
+					else
+						hi = mid;
+				}
+				boundaries[l] = hi;
+			}
+			return boundaries;
+		}
+
+		const double * lightnessBoundaries()
+		{
+			static const LightnessBoundaries boundaries = findLightnessBoundaries();
+			return boundaries.data();
+		}
+	}
+
+	ColorCorrectionLut::ColorCorrectionLut()
+		: m_gamma(1.0)
+		, m_brightness(100)
+		, m_threshold(0)
+		, m_thresholdLuminance(0.0)
+	{
+		lightnessBoundaries();
+		rebuildGammaTables();
+	}
+
+	void ColorCorrectionLut::setGamma(double gamma)
+	{
+		if (gamma == m_gamma)
+			return;
+		m_gamma = gamma;
+		rebuildGammaTables();
+	}
+
+	void ColorCorrectionLut::setBrightness(unsigned int brightness)
+	{
+		if (brightness == m_brightness)
+			return;
+		m_brightness = brightness;
+		rebuildCorrectedTable();
+	}
+
+	void ColorCorrectionLut::setLuminosityThreshold(int threshold)
+	{
+		if (threshold == m_threshold)
+			return;
+		m_threshold = threshold;
+		const double *boundaries = lightnessBoundaries();
+		if (threshold <= 0)
+			m_thresholdLuminance = 0.0;
+		else if (threshold > LightnessMax)
+			m_thresholdLuminance = std::numeric_limits<double>::infinity();
+		else
+			m_thresholdLuminance = boundaries[threshold];
+	}
+
+	int ColorCorrectionLut::lightness(double luminance)
+	{
+		const double *boundaries = lightnessBoundaries();
+		return std::upper_bound(boundaries + 1, boundaries + LightnessMax + 1, luminance) - (boundaries + 1);
+	}
+
+	void ColorCorrectionLut::rebuildGammaTables()
+	{
+		for (int i = 0; i < 256; ++i) {
+			// same steps as applyColorModifications() took per LED
+			const constexpr double k = 4095/255.0;
+			StructRgb color;
+			color.r = color.g = color.b = i * k;
+			gammaCorrection(m_gamma, color);
+			m_gammaTable[i] = color.r;
+
+			// toXyz() of a color with a single channel set leaves the products of that channel only
+			StructRgb channel;
+			channel.r = color.r;
+			m_luminanceTable[0][i] = toXyz(channel).y;
+			channel.r = 0;
+			channel.g = color.g;
+			m_luminanceTable[1][i] = toXyz(channel).y;
+			channel.g = 0;
+			channel.b = color.b;
+			m_luminanceTable[2][i] = toXyz(channel).y;
+		}
+		rebuildCorrectedTable();
+	}
+
+	void ColorCorrectionLut::rebuildCorrectedTable()
+	{
+		for (int i = 0; i < 256; ++i) {
+			StructRgb color;
+			color.r = color.g = color.b = m_gammaTable[i];
+			brightnessCorrection(m_brightness, color);
+			m_correctedTable[i] = color.r;
+		}
+	}
+}
@@ -0,0 +1,53 @@
+/*
+ * ColorSequence.cpp
+ *
+ *	Created on: 18.10.2026
+ *		Project: Prismatik
+ *
+ *	Prismatik is a free, open-source software: you can redistribute it and/or
+ *	modify it under the terms of the GNU General Public License as published
+ *	by the Free Software Foundation, either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	Prismatik and Lightpack files is distributed in the hope that it will be
+ *	useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.	See the GNU
+ *	General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with this program.	If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "ColorSequence.hpp"
+
+namespace PrismatikMath
+{
+	ColorSequence::ColorSequence(const QString &sequence)
+		: m_offsetR(0)
+		, m_offsetG(1)
+		, m_offsetB(2)
+	{
+		if (sequence.size() != 3)
+			return;
+
+		const int offsetR = sequence.indexOf(QLatin1Char('R'));
+		const int offsetG = sequence.indexOf(QLatin1Char('G'));
+		const int offsetB = sequence.indexOf(QLatin1Char('B'));
+		if (offsetR < 0 || offsetG < 0 || offsetB < 0)
+			return;
+
+		m_offsetR = offsetR;
+		m_offsetG = offsetG;
+		m_offsetB = offsetB;
+	}
+
+	char * ColorSequence::write(const QList<StructRgb> &colors, int from, int count, char *out, unsigned shift) const
+	{
+		// QList keeps StructRgb by pointer, the colors aren't contiguous for a vector shuffle
+		const int to = from + count;
+		for (int i = from; i < to; ++i)
+			out = write(colors.at(i), out, shift);
+		return out;
+	}
+}
@@ -0,0 +1,209 @@
+/*
+ * FilterBank.cpp
+ *
+ *	Created on: 18.10.2026
+ *		Project: Prismatik
+ *
+ *	Prismatik is a free, open-source software: you can redistribute it and/or
+ *	modify it under the terms of the GNU General Public License as published
+ *	by the Free Software Foundation, either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	Prismatik and Lightpack files is distributed in the hope that it will be
+ *	useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.	See the GNU
+ *	General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with this program.	If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "FilterBank.hpp"
+#include "SimdLevel.hpp"
+#include <algorithm>
+#include <cmath>
+#include <immintrin.h>
+
+namespace PrismatikMath
+{
+namespace
+{
+	float sumScalar(const float *weights, const float *bins, size_t count) {
+		float sum = 0.0f;
+		for (size_t i = 0; i < count; ++i)
+			sum += weights[i] * bins[i];
+		return sum;
+	}
+
+	float peakScalar(const float *weights, const float *bins, size_t count) {
+		float peak = 0.0f;
+		for (size_t i = 0; i < count; ++i)
+			peak = std::max(peak, weights[i] * bins[i]);
+		return peak;
+	}
+
+	SIMD_TARGET_SSE4_1 float sum128(const float *weights, const float *bins, size_t count) {
+		__m128 sum = _mm_setzero_ps();
+		size_t i = 0;
+		for (; i + 4 <= count; i += 4)
+			sum = _mm_add_ps(sum, _mm_mul_ps(_mm_loadu_ps(weights + i), _mm_loadu_ps(bins + i)));
+		sum = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+		sum = _mm_add_ss(sum, _mm_shuffle_ps(sum, sum, 1));
+		return _mm_cvtss_f32(sum) + sumScalar(weights + i, bins + i, count - i);
+	}
+
+	SIMD_TARGET_SSE4_1 float peak128(const float *weights, const float *bins, size_t count) {
+		__m128 peak = _mm_setzero_ps();
+		size_t i = 0;
+		for (; i + 4 <= count; i += 4)
+			peak = _mm_max_ps(peak, _mm_mul_ps(_mm_loadu_ps(weights + i), _mm_loadu_ps(bins + i)));
+		peak = _mm_max_ps(peak, _mm_movehl_ps(peak, peak));
+		peak = _mm_max_ss(peak, _mm_shuffle_ps(peak, peak, 1));
+		return std::max(_mm_cvtss_f32(peak), peakScalar(weights + i, bins + i, count - i));
+	}
+
+	SIMD_TARGET_AVX2 float sum256(const float *weights, const float *bins, size_t count) {
+		__m256 sum = _mm256_setzero_ps();
+		size_t i = 0;
+		for (; i + 8 <= count; i += 8)
+			sum = _mm256_add_ps(sum, _mm256_mul_ps(_mm256_loadu_ps(weights + i), _mm256_loadu_ps(bins + i)));
+		__m128 half = _mm_add_ps(_mm256_castps256_ps128(sum), _mm256_extractf128_ps(sum, 1));
+		half = _mm_add_ps(half, _mm_movehl_ps(half, half));
+		half = _mm_add_ss(half, _mm_shuffle_ps(half, half, 1));
+		return _mm_cvtss_f32(half) + sumScalar(weights + i, bins + i, count - i);
+	}
+
+	SIMD_TARGET_AVX2 float peak256(const float *weights, const float *bins, size_t count) {
+		__m256 peak = _mm256_setzero_ps();
+		size_t i = 0;
+		for (; i + 8 <= count; i += 8)
+			peak = _mm256_max_ps(peak, _mm256_mul_ps(_mm256_loadu_ps(weights + i), _mm256_loadu_ps(bins + i)));
+		__m128 half = _mm_max_ps(_mm256_castps256_ps128(peak), _mm256_extractf128_ps(peak, 1));
+		half = _mm_max_ps(half, _mm_movehl_ps(half, half));
+		half = _mm_max_ss(half, _mm_shuffle_ps(half, half, 1));
+		return std::max(_mm_cvtss_f32(half), peakScalar(weights + i, bins + i, count - i));
+	}
+
+	/*
+		*128 kernels require SSE4.1, *256 kernels require AVX2,
+		scalar functions by default, same as ColorBatch.cpp
+	*/
+	auto sumKernel = sumScalar;
+	auto peakKernel = peakScalar;
+
+	struct simdupgrade {
+		simdupgrade() {
+			const uint32_t level = availableSimd();
+			if (level & SIMDLevel::AVX2) {
+				sumKernel = sum256;
+				peakKernel = peak256;
+			} else if (level & SIMDLevel::SSE4_1) {
+				sumKernel = sum128;
+				peakKernel = peak128;
+			}
+		}
+	};
+	simdupgrade simdup;
+} // namespace
+
+	FilterBank::FilterBank()
+		: m_shape(ShapePeak)
+		, m_minHz(0.0)
+		, m_maxHz(0.0)
+		, m_spectrumSize(0)
+		, m_sampleRate(0.0)
+	{
+	}
+
+	bool FilterBank::configure(Shape shape, int bandsCount, double minHz, double maxHz, size_t spectrumSize, double sampleRate)
+	{
+		bandsCount = std::max(0, bandsCount);
+		if (shape == m_shape && bandsCount == this->bandsCount() && minHz == m_minHz && maxHz == m_maxHz
+			&& spectrumSize == m_spectrumSize && sampleRate == m_sampleRate)
+			return false;
+
+		m_shape = shape;
+		m_minHz = minHz;
+		m_maxHz = maxHz;
+		m_spectrumSize = spectrumSize;
+		m_sampleRate = sampleRate;
+		m_bands.clear();
+		m_weights.clear();
+		m_values.assign(bandsCount, 0.0f);
+		if (bandsCount == 0 || spectrumSize == 0 || sampleRate <= 0.0)
+			return true;
+
+		const double binHz = sampleRate / 2 / spectrumSize;
+		std::vector<double> edges(bandsCount + 1);
+		for (int k = 0; k <= bandsCount; ++k)
+			edges[k] = k == 0 ? minHz : k == bandsCount ? maxHz : minHz * std::pow(maxHz / minHz, static_cast<double>(k) / bandsCount);
+
+		std::vector<float> weights;
+		if (shape == ShapeTriangle) {
+			// centers of the bands, the edges of the bank close the first and the last triangle
+			std::vector<double> points(bandsCount + 2);
+			points.front() = edges.front();
+			points.back() = edges.back();
+			for (int k = 0; k < bandsCount; ++k)
+				points[k + 1] = std::sqrt(edges[k] * edges[k + 1]);
+
+			for (int k = 0; k < bandsCount; ++k) {
+				const double low = points[k], center = points[k + 1], high = points[k + 2];
+				const size_t firstBin = std::min(spectrumSize - 1, static_cast<size_t>(std::max(0.0, std::ceil(low / binHz))));
+				const size_t endBin = std::min(spectrumSize, static_cast<size_t>(std::max(0.0, std::ceil(high / binHz))));
+
+				weights.clear();
+				float sum = 0.0f;
+				for (size_t bin = firstBin; bin < endBin; ++bin) {
+					const double hz = bin * binHz;
+					const double weight = hz <= center
+							? (center > low ? (hz - low) / (center - low) : 1.0)
+							: (high > center ? (high - hz) / (high - center) : 1.0);
+					weights.push_back(std::max(0.0, weight));
+					sum += weights.back();
+				}
+				if (sum > 0.0f) {
+					for (float &weight : weights)
+						weight /= sum;
+					addBand(firstBin, weights);
+				} else {
+					// narrower than a bin, take the nearest one
+					const size_t bin = std::min(spectrumSize - 1, static_cast<size_t>(std::lround(center / binHz)));
+					addBand(bin, std::vector<float>(1, 1.0f));
+				}
+			}
+		} else {
+			size_t previousEnd = 0;
+			for (int k = 0; k < bandsCount; ++k) {
+				size_t firstBin = std::max(previousEnd, static_cast<size_t>(std::max(0.0, std::ceil(edges[k] / binHz))));
+				size_t endBin = static_cast<size_t>(std::max(0.0, std::ceil(edges[k + 1] / binHz)));
+				firstBin = std::min(firstBin, spectrumSize - 1);
+				endBin = std::min(std::max(endBin, firstBin + 1), spectrumSize);
+				addBand(firstBin, std::vector<float>(endBin - firstBin, 1.0f));
+				previousEnd = endBin;
+			}
+		}
+		return true;
+	}
+
+	void FilterBank::addBand(size_t firstBin, const std::vector<float> &weights)
+	{
+		Band band;
+		band.firstBin = firstBin;
+		band.offset = m_weights.size();
+		band.count = weights.size();
+		m_bands.push_back(band);
+		m_weights.insert(m_weights.end(), weights.begin(), weights.end());
+	}
+
+	const float * FilterBank::apply(const float *spectrum)
+	{
+		auto kernel = m_shape == ShapePeak ? peakKernel : sumKernel;
+		for (size_t k = 0; k < m_bands.size(); ++k) {
+			const Band &band = m_bands[k];
+			m_values[k] = kernel(m_weights.data() + band.offset, spectrum + band.firstBin, band.count);
+		}
+		return m_values.data();
+	}
+}
@@ -0,0 +1,79 @@
+/*
+ * SampleRing.cpp
+ *
+ *	Created on: 18.10.2026
+ *		Project: Prismatik
+ *
+ *	Prismatik is a free, open-source software: you can redistribute it and/or
+ *	modify it under the terms of the GNU General Public License as published
+ *	by the Free Software Foundation, either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	Prismatik and Lightpack files is distributed in the hope that it will be
+ *	useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.	See the GNU
+ *	General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with this program.	If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "SampleRing.hpp"
+#include <algorithm>
+#include <cstring>
+
+namespace PrismatikMath
+{
+	SampleRing::SampleRing(size_t capacity)
+		: m_writeIndex(0)
+		, m_readIndex(0)
+		, m_droppedCount(0)
+	{
+		size_t size = 1;
+		while (size < capacity)
+			size <<= 1;
+		m_buffer.resize(size);
+		m_mask = size - 1;
+	}
+
+	size_t SampleRing::write(const float *samples, size_t count)
+	{
+		const size_t writeIndex = m_writeIndex.load(std::memory_order_relaxed);
+		const size_t readIndex = m_readIndex.load(std::memory_order_acquire);
+		const size_t writeCount = std::min(count, m_buffer.size() - (writeIndex - readIndex));
+
+		const size_t offset = writeIndex & m_mask;
+		const size_t firstPart = std::min(writeCount, m_buffer.size() - offset);
+		memcpy(m_buffer.data() + offset, samples, firstPart * sizeof(float));
+		memcpy(m_buffer.data(), samples + firstPart, (writeCount - firstPart) * sizeof(float));
+
+		m_writeIndex.store(writeIndex + writeCount, std::memory_order_release);
+		if (writeCount < count)
+			m_droppedCount.fetch_add(count - writeCount, std::memory_order_relaxed);
+		return writeCount;
+	}
+
+	size_t SampleRing::available() const
+	{
+		return m_writeIndex.load(std::memory_order_acquire) - m_readIndex.load(std::memory_order_relaxed);
+	}
+
+	bool SampleRing::peek(float *dest, size_t count) const
+	{
+		if (available() < count)
+			return false;
+
+		const size_t offset = m_readIndex.load(std::memory_order_relaxed) & m_mask;
+		const size_t firstPart = std::min(count, m_buffer.size() - offset);
+		memcpy(dest, m_buffer.data() + offset, firstPart * sizeof(float));
+		memcpy(dest + firstPart, m_buffer.data(), (count - firstPart) * sizeof(float));
+		return true;
+	}
+
+	void SampleRing::skip(size_t count)
+	{
+		const size_t readIndex = m_readIndex.load(std::memory_order_relaxed);
+		m_readIndex.store(readIndex + std::min(count, available()), std::memory_order_release);
+	}
+}
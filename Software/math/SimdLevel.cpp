@@ -0,0 +1,113 @@
+/*
+ * SimdLevel.cpp
+ *
+ *	Created on: 18.10.2026
+ *		Project: Prismatik
+ *
+ *	Prismatik is a free, open-source software: you can redistribute it and/or
+ *	modify it under the terms of the GNU General Public License as published
+ *	by the Free Software Foundation, either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	Prismatik and Lightpack files is distributed in the hope that it will be
+ *	useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.	See the GNU
+ *	General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with this program.	If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "SimdLevel.hpp"
+#include <QtGlobal>
+
+#if defined(Q_OS_MACOS)
+#include <sys/sysctl.h>
+#elif defined(__INTEL_COMPILER) && (__INTEL_COMPILER >= 1300)
+#include <immintrin.h>
+#elif defined(_MSC_VER)
+# include <intrin.h>
+#endif
+
+namespace PrismatikMath
+{
+#if defined(Q_OS_MACOS)
+// https://developer.apple.com/documentation/apple_silicon/about_the_rosetta_translation_environment?language=objc
+uint32_t availableSimd() {
+	uint32_t level = SIMDLevel::None;
+	int ret = 0;
+	size_t size = sizeof(ret);
+	if (sysctlbyname("hw.optional.avx2_0", &ret, &size, NULL, 0) == 0 && ret == 1)
+		level |= SIMDLevel::AVX2;
+	ret = 0;
+	size = sizeof(ret);
+	if (sysctlbyname("hw.optional.sse4_1", &ret, &size, NULL, 0) == 0 && ret == 1)
+		level |= SIMDLevel::SSE4_1;
+	return level;
+}
+#elif defined(__INTEL_COMPILER) && (__INTEL_COMPILER >= 1300)
+// https://software.intel.com/en-us/articles/how-to-detect-new-instruction-support-in-the-4th-generation-intel-core-processor-family
+uint32_t availableSimd() {
+	uint32_t level = SIMDLevel::None;
+	if (_may_i_use_cpu_feature(_FEATURE_AVX2))
+		level |= SIMDLevel::AVX2;
+	if (_may_i_use_cpu_feature(_FEATURE_SSE4_1))
+		level |= SIMDLevel::SSE4_1;
+	return level;
+}
+#else /* non-Intel compiler */
+static void run_cpuid(uint32_t eax, uint32_t ecx, uint32_t* abcd)
+{
+#if defined(_MSC_VER)
+	__cpuidex((int*)abcd, eax, ecx);
+#else
+	uint32_t ebx = 0;
+	uint32_t edx = 0;
+# if defined( __i386__ ) && defined ( __PIC__ )
+	 /* in case of PIC under 32-bit EBX cannot be clobbered */
+	__asm__ ( "movl %%ebx, %%edi \n\t cpuid \n\t xchgl %%ebx, %%edi" : "=D" (ebx),
+# else
+	__asm__ ( "cpuid" : "+b" (ebx),
+# endif
+			  "+a" (eax), "+c" (ecx), "=d" (edx) );
+	abcd[0] = eax; abcd[1] = ebx; abcd[2] = ecx; abcd[3] = edx;
+#endif
+}
+
+
+uint32_t availableSimd() {
+	uint32_t abcd[4] = {0,0,0,0};
+
+	run_cpuid(1, 0, abcd);
+	uint32_t eax = 0x07;
+	uint32_t ecx = 0x00;
+#if defined(_MSC_VER)
+	__cpuidex((int*)abcd, eax, ecx);
+#else
+	uint32_t ebx = 0;
+	uint32_t edx = 0;
+# if defined( __i386__ ) && defined ( __PIC__ )
+	 /* in case of PIC under 32-bit EBX cannot be clobbered */
+	__asm__ ( "movl %%ebx, %%edi \n\t cpuid \n\t xchgl %%ebx, %%edi" : "=D" (ebx),
+# else
+	__asm__ ( "cpuid" : "+b" (ebx),
+# endif
+			  "+a" (eax), "+c" (ecx), "=d" (edx) );
+	abcd[0] = eax; abcd[1] = ebx; abcd[2] = ecx; abcd[3] = edx;
+#endif
+	uint32_t level = SIMDLevel::None;
+	// CPUID.(EAX=07H, ECX=0H):EBX.AVX2[bit 5]==1
+	run_cpuid(7, 0, abcd);
+	if ((abcd[1] & (1 << 5)))
+		level |= SIMDLevel::AVX2;
+
+	// CPUID.(EAX=01H, ECX=0H):ECX.SSE4_1[bit 19]==1
+	run_cpuid(1, 0, abcd);
+	if ((abcd[2] & (1 << 19)))
+		level |= SIMDLevel::SSE4_1;
+
+	return level;
+}
+#endif
+}
@@ -0,0 +1,163 @@
+/*
+ * TemporalFilter.cpp
+ *
+ *	Created on: 18.10.2026
+ *		Project: Prismatik
+ *
+ *	Prismatik is a free, open-source software: you can redistribute it and/or
+ *	modify it under the terms of the GNU General Public License as published
+ *	by the Free Software Foundation, either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	Prismatik and Lightpack files is distributed in the hope that it will be
+ *	useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.	See the GNU
+ *	General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with this program.	If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "TemporalFilter.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace PrismatikMath
+{
+	namespace
+	{
+		// closer than that to the target rounds to the target
+		const float SettledDistance = 0.5f;
+		// per second, slower than that the spring won't move the colors by a step anymore
+		const float SettledVelocity = 1.0f;
+	}
+
+	TemporalFilter::TemporalFilter()
+		: m_mode(ModeNone)
+		, m_timeConstant(0.1)
+		, m_elapsed(0.0)
+		, m_isSettled(true)
+	{
+	}
+
+	void TemporalFilter::setMode(Mode mode)
+	{
+		m_mode = mode;
+		std::fill(m_velocities.begin(), m_velocities.end(), 0.0f);
+		m_origins = m_values;
+		m_elapsed = 0.0;
+		if (m_mode == ModeNone)
+			settle();
+	}
+
+	void TemporalFilter::setTimeConstant(double seconds)
+	{
+		m_timeConstant = seconds;
+	}
+
+	void TemporalFilter::setTarget(const QRgb *colors, int count)
+	{
+		const bool isResized = count != size();
+		m_targets.resize(count * 3);
+		for (int i = 0; i < count; ++i) {
+			m_targets[i * 3] = qRed(colors[i]);
+			m_targets[i * 3 + 1] = qGreen(colors[i]);
+			m_targets[i * 3 + 2] = qBlue(colors[i]);
+		}
+
+		if (isResized) {
+			m_values = m_targets;
+			m_velocities.assign(m_targets.size(), 0.0f);
+		}
+		m_origins = m_values;
+		m_elapsed = 0.0;
+		m_isSettled = false;
+
+		if (isResized || m_mode == ModeNone || m_timeConstant <= 0.0)
+			settle();
+	}
+
+	void TemporalFilter::advance(double seconds)
+	{
+		if (m_isSettled)
+			return;
+		if (m_mode == ModeNone || m_timeConstant <= 0.0) {
+			settle();
+			return;
+		}
+
+		m_elapsed += seconds;
+		const size_t count = m_targets.size();
+		float maxDistance = 0.0f;
+		float maxVelocity = 0.0f;
+
+		switch (m_mode) {
+		case ModeExponential: {
+			const float k = 1.0f - std::exp(-seconds / m_timeConstant);
+			for (size_t i = 0; i < count; ++i) {
+				m_values[i] += (m_targets[i] - m_values[i]) * k;
+				maxDistance = std::max(maxDistance, std::abs(m_targets[i] - m_values[i]));
+			}
+			break;
+		}
+		case ModeSpring: {
+			// exact solution of x'' = -w^2 (x - target) - 2w x' over the step
+			const float w = 2.0f / m_timeConstant;
+			const float t = seconds;
+			const float decay = std::exp(-w * t);
+			for (size_t i = 0; i < count; ++i) {
+				const float c1 = m_values[i] - m_targets[i];
+				const float c2 = m_velocities[i] + w * c1;
+				m_values[i] = m_targets[i] + (c1 + c2 * t) * decay;
+				m_velocities[i] = (c2 - w * (c1 + c2 * t)) * decay;
+				maxDistance = std::max(maxDistance, std::abs(m_targets[i] - m_values[i]));
+				maxVelocity = std::max(maxVelocity, std::abs(m_velocities[i]));
+			}
+			break;
+		}
+		case ModeLinear: {
+			const float f = std::min(1.0, m_elapsed / m_timeConstant);
+			for (size_t i = 0; i < count; ++i) {
+				m_values[i] = m_origins[i] + (m_targets[i] - m_origins[i]) * f;
+				maxDistance = std::max(maxDistance, std::abs(m_targets[i] - m_values[i]));
+			}
+			break;
+		}
+		default:
+			break;
+		}
+
+		if (maxDistance < SettledDistance && maxVelocity < SettledVelocity)
+			settle();
+	}
+
+	void TemporalFilter::values(QRgb *colors) const
+	{
+		const int count = size();
+		for (int i = 0; i < count; ++i) {
+			colors[i] = qRgb(
+				std::lround(std::min(std::max(m_values[i * 3], 0.0f), 255.0f)),
+				std::lround(std::min(std::max(m_values[i * 3 + 1], 0.0f), 255.0f)),
+				std::lround(std::min(std::max(m_values[i * 3 + 2], 0.0f), 255.0f)));
+		}
+	}
+
+	void TemporalFilter::reset()
+	{
+		m_values.clear();
+		m_velocities.clear();
+		m_origins.clear();
+		m_targets.clear();
+		m_elapsed = 0.0;
+		m_isSettled = true;
+	}
+
+	void TemporalFilter::settle()
+	{
+		m_values = m_targets;
+		std::fill(m_velocities.begin(), m_velocities.end(), 0.0f);
+		m_isSettled = true;
+	}
+}
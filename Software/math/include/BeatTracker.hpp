@@ -0,0 +1,103 @@
+/*
+ * BeatTracker.hpp
+ *
+ *	Created on: 18.10.2026
+ *		Project: Prismatik
+ *
+ *	Prismatik is a free, open-source software: you can redistribute it and/or
+ *	modify it under the terms of the GNU General Public License as published
+ *	by the Free Software Foundation, either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	Prismatik and Lightpack files is distributed in the hope that it will be
+ *	useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.	See the GNU
+ *	General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with this program.	If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace PrismatikMath
+{
+	/*!
+		Onset and beat tracker working on a stream of FFT magnitude spectra.
+
+		Onsets are detected from the spectral flux, the rise of the log compressed magnitudes
+		from one spectrum to the next, against its recent average. The tempo comes from the
+		autocorrelation of the flux resampled at a fixed rate, and the beat grid is kept in phase
+		with the onsets which land near a predicted beat, so the next beat can be predicted.
+
+		Time is passed in explicitly, in seconds; spectra may come at any, also varying, rate.
+		A spectrum equal to the previous one isn't new and is skipped.
+	*/
+	class BeatTracker
+	{
+	public:
+		BeatTracker();
+
+		/*!
+			\return true if \a spectrum has an onset
+		*/
+		bool process(const float *spectrum, size_t size, double time);
+		void reset();
+
+		bool isOnset() const { return m_isOnset; }
+		/*!
+			Onset strength of the last spectrum, 1 is the recent average
+		*/
+		double strength() const;
+		unsigned long long onsetsCount() const { return m_onsetsCount; }
+
+		/*!
+			Beats per minute, 0 while unknown
+		*/
+		double tempo() const { return m_tempo; }
+		/*!
+			How periodic the recent onsets are, 0 to 1
+		*/
+		double confidence() const { return m_confidence; }
+		/*!
+			Position within the beat at \a time, 0 on the beat up to 1 right before the next one,
+			0 while the tempo is unknown
+		*/
+		double beatPhase(double time) const;
+		/*!
+			\return time of the first beat after \a time, 0 while the tempo is unknown
+		*/
+		double nextBeatTime(double time) const;
+
+	private:
+		void addToEnvelope(double value, double time);
+		void estimateTempo();
+		void trackBeat(double time);
+
+	private:
+		std::vector<float> m_previous; // log magnitudes
+		double m_startTime;
+		double m_lastTime;
+		double m_flux;
+		double m_fluxMean;
+		bool m_isOnset;
+		double m_lastOnsetTime;
+		unsigned long long m_onsetsCount;
+
+		// flux above the mean at a fixed rate, for the tempo
+		std::vector<float> m_envelope;
+		size_t m_envelopeIndex;
+		size_t m_envelopeFilled;
+		double m_envelopeTime; // start of the current bin
+		double m_lastTempoTime;
+
+		double m_tempo;
+		double m_confidence;
+		double m_beatTime; // a beat of the grid
+		double m_lastMatchTime; // last onset on the grid
+	};
+}
@@ -0,0 +1,61 @@
+/*
+ * ColorBatch.hpp
+ *
+ *	Created on: 18.10.2026
+ *		Project: Prismatik
+ *
+ *	Prismatik is a free, open-source software: you can redistribute it and/or
+ *	modify it under the terms of the GNU General Public License as published
+ *	by the Free Software Foundation, either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	Prismatik and Lightpack files is distributed in the hope that it will be
+ *	useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.	See the GNU
+ *	General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with this program.	If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+
+#include <QList>
+#include <QRgb>
+#include <vector>
+
+namespace PrismatikMath
+{
+	/*!
+		Lab colors stored channel by channel (SoA), so batch kernels load several colors of one
+		channel with one instruction. Same scale as \a StructLabF, single precision.
+	*/
+	struct LabBatch {
+		std::vector<float> l, a, b;
+
+		size_t size() const { return l.size(); }
+		void resize(size_t count) {
+			l.resize(count);
+			a.resize(count);
+			b.resize(count);
+		}
+	};
+
+	// largest difference of batch results from the scalar functions, checked by LightpackMathTest
+	constexpr const float LabBatchTolerance = 0.01f; // absolute, per L, a and b
+	constexpr const int RgbBatchTolerance = 1; // per channel
+
+	/*!
+		Batch versions of \a RgbToXyz() + \a XyzToLab() and \a LabToXyz() + \a XyzToRgb() for 8 bit RGB.
+		Run with AVX2 or SSE4.1 kernels when the CPU has them, with the scalar functions otherwise.
+		Kernels compute in single precision with approximated cube root and power, results differ
+		from the scalar functions by less than \a LabBatchTolerance (0.01) in each of L, a and b
+		and by at most \a RgbBatchTolerance (1) in each RGB channel.
+	*/
+	void rgbToLab(const QList<QRgb> &colors, LabBatch &result);
+	/*!
+		\param result has to hold lab.size() colors
+	*/
+	void labToRgb(const LabBatch &lab, QList<QRgb> &result);
+}
@@ -0,0 +1,105 @@
+/*
+ * ColorCorrectionLut.hpp
+ *
+ *	Created on: 18.10.2026
+ *		Project: Prismatik
+ *
+ *	Prismatik is a free, open-source software: you can redistribute it and/or
+ *	modify it under the terms of the GNU General Public License as published
+ *	by the Free Software Foundation, either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	Prismatik and Lightpack files is distributed in the hope that it will be
+ *	useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.	See the GNU
+ *	General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with this program.	If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+
+#include <QRgb>
+#include "colorspace_types.h"
+
+namespace PrismatikMath
+{
+	/*!
+		Lookup tables for the per LED part of the device color modifications. Colors come in
+		with 8 bits per channel, so each table has an entry per 8 bit value, built with the very
+		functions it replaces, and gives exactly what they would compute:
+		renormalization to 12 bit followed by \a gammaCorrection(), \a brightnessCorrection()
+		on top of that, and the sRGB linearized luminance Y of \a toXyz().
+
+		Lab lightness of a luminance is found among the precomputed Y boundaries of every
+		\a toLab() lightness value, no pow() or cbrt() per LED.
+
+		Tables are rebuilt by the setters only when the value actually changes.
+	*/
+	class ColorCorrectionLut
+	{
+	public:
+		ColorCorrectionLut();
+
+		void setGamma(double gamma);
+		void setBrightness(unsigned int brightness);
+		void setLuminosityThreshold(int threshold);
+
+		/*!
+			12 bit color after gamma correction
+		*/
+		StructRgb gammaCorrected(const QRgb color) const {
+			StructRgb result;
+			result.r = m_gammaTable[qRed(color)];
+			result.g = m_gammaTable[qGreen(color)];
+			result.b = m_gammaTable[qBlue(color)];
+			return result;
+		}
+
+		/*!
+			\a gammaCorrected() with the brightness applied
+		*/
+		StructRgb corrected(const QRgb color) const {
+			StructRgb result;
+			result.r = m_correctedTable[qRed(color)];
+			result.g = m_correctedTable[qGreen(color)];
+			result.b = m_correctedTable[qBlue(color)];
+			return result;
+		}
+
+		/*!
+			Y of \a toXyz() for \a gammaCorrected()
+		*/
+		double luminance(const QRgb color) const {
+			return m_luminanceTable[0][qRed(color)] + m_luminanceTable[1][qGreen(color)] + m_luminanceTable[2][qBlue(color)];
+		}
+
+		/*!
+			Whether \a toLab() lightness of \a gammaCorrected() is below the threshold
+		*/
+		bool isBelowThreshold(const QRgb color) const {
+			return luminance(color) < m_thresholdLuminance;
+		}
+
+		/*!
+			\a toLab() lightness of a color with luminance Y
+		*/
+		static int lightness(double luminance);
+
+	private:
+		void rebuildGammaTables();
+		void rebuildCorrectedTable();
+
+	private:
+		double m_gamma;
+		unsigned int m_brightness;
+		int m_threshold;
+		double m_thresholdLuminance; // lowest luminance with lightness of the threshold
+
+		unsigned m_gammaTable[256];
+		unsigned m_correctedTable[256];
+		double m_luminanceTable[3][256]; // weighted linear red, green and blue
+	};
+}
@@ -0,0 +1,65 @@
+/*
+ * ColorSequence.hpp
+ *
+ *	Created on: 18.10.2026
+ *		Project: Prismatik
+ *
+ *	Prismatik is a free, open-source software: you can redistribute it and/or
+ *	modify it under the terms of the GNU General Public License as published
+ *	by the Free Software Foundation, either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	Prismatik and Lightpack files is distributed in the hope that it will be
+ *	useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.	See the GNU
+ *	General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with this program.	If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+
+#include <QList>
+#include <QString>
+#include "colorspace_types.h"
+
+namespace PrismatikMath
+{
+	/*!
+		Channel order of a device, such as "GRB", compiled once into the byte offset of every
+		channel, so serializing a frame writes each channel straight to its place instead of
+		comparing the order string for every LED. Anything but a permutation of "RGB" is taken
+		as "RGB", as the devices always did.
+	*/
+	class ColorSequence
+	{
+	public:
+		explicit ColorSequence(const QString &sequence = QString());
+
+		bool isRgb() const { return m_offsetR == 0 && m_offsetG == 1 && m_offsetB == 2; }
+
+		/*!
+			Writes 3 bytes of \a color to \a out, each channel shifted right by \a shift bits
+			\return position right after the written bytes
+		*/
+		char * write(const StructRgb &color, char *out, unsigned shift = 0) const {
+			out[m_offsetR] = static_cast<char>(color.r >> shift);
+			out[m_offsetG] = static_cast<char>(color.g >> shift);
+			out[m_offsetB] = static_cast<char>(color.b >> shift);
+			return out + 3;
+		}
+
+		/*!
+			Writes \a count colors starting at \a from, 3 bytes each, to \a out
+			\return position right after the written bytes
+		*/
+		char * write(const QList<StructRgb> &colors, int from, int count, char *out, unsigned shift = 0) const;
+
+	private:
+		int m_offsetR;
+		int m_offsetG;
+		int m_offsetB;
+	};
+}
@@ -0,0 +1,85 @@
+/*
+ * FilterBank.hpp
+ *
+ *	Created on: 18.10.2026
+ *		Project: Prismatik
+ *
+ *	Prismatik is a free, open-source software: you can redistribute it and/or
+ *	modify it under the terms of the GNU General Public License as published
+ *	by the Free Software Foundation, either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	Prismatik and Lightpack files is distributed in the hope that it will be
+ *	useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.	See the GNU
+ *	General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with this program.	If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace PrismatikMath
+{
+	/*!
+		Log spaced frequency bands of an FFT magnitude spectrum, such as one band per LED. The
+		bank is a sparse matrix, a run of bin weights per band, computed from the sample rate
+		once and rebuilt only when a parameter changes, so a frame only multiplies the runs.
+		Runs are applied with AVX2 or SSE4.1 kernels when the CPU has them.
+
+		Bin i of the spectrum is at i * sampleRate / 2 / spectrumSize Hz.
+	*/
+	class FilterBank
+	{
+	public:
+		enum Shape {
+			ShapePeak, // highest bin of the band, bands side by side
+			ShapeSum, // sum of the bins of the band, bands side by side
+			ShapeTriangle // weighted average, triangles from the center of the band below to the one above (mel like)
+		};
+
+		FilterBank();
+
+		/*!
+			Bands spaced evenly on a log scale from \a minHz to \a maxHz, every band gets at least
+			one bin. Does nothing if nothing changed.
+			\param minHz has to be above 0 for more than one band
+			\return true if the bank was rebuilt
+		*/
+		bool configure(Shape shape, int bandsCount, double minHz, double maxHz, size_t spectrumSize, double sampleRate);
+
+		int bandsCount() const { return static_cast<int>(m_bands.size()); }
+		size_t spectrumSize() const { return m_spectrumSize; }
+
+		/*!
+			\param spectrum \a spectrumSize() magnitudes
+			\return \a bandsCount() values, valid until the next call
+		*/
+		const float * apply(const float *spectrum);
+
+	private:
+		struct Band {
+			size_t firstBin;
+			size_t offset; // of the weights
+			size_t count;
+		};
+
+		void addBand(size_t firstBin, const std::vector<float> &weights);
+
+	private:
+		Shape m_shape;
+		double m_minHz;
+		double m_maxHz;
+		size_t m_spectrumSize;
+		double m_sampleRate;
+
+		std::vector<Band> m_bands;
+		std::vector<float> m_weights; // runs of all the bands one after another
+		std::vector<float> m_values;
+	};
+}
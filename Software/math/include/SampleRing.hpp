@@ -0,0 +1,73 @@
+/*
+ * SampleRing.hpp
+ *
+ *	Created on: 18.10.2026
+ *		Project: Prismatik
+ *
+ *	Prismatik is a free, open-source software: you can redistribute it and/or
+ *	modify it under the terms of the GNU General Public License as published
+ *	by the Free Software Foundation, either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	Prismatik and Lightpack files is distributed in the hope that it will be
+ *	useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.	See the GNU
+ *	General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with this program.	If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+namespace PrismatikMath
+{
+	/*!
+		Lock-free ring of audio samples with one writer and one reader, so the audio callback
+		never waits for the analysis. Samples which don't fit are dropped and counted, the
+		writer never overwrites what the reader hasn't consumed yet.
+
+		The reader may look at the same samples several times before consuming them, which is
+		how overlapping windows are read.
+	*/
+	class SampleRing
+	{
+	public:
+		/*!
+			\param capacity rounded up to a power of 2
+		*/
+		explicit SampleRing(size_t capacity);
+
+		size_t capacity() const { return m_buffer.size(); }
+
+		// writer side
+		/*!
+			\return number of samples written, less than \a count if the ring is full
+		*/
+		size_t write(const float *samples, size_t count);
+		size_t droppedCount() const { return m_droppedCount.load(std::memory_order_relaxed); }
+
+		// reader side
+		size_t available() const;
+		/*!
+			Copies \a count oldest samples to \a dest without consuming them
+			\return false if less than \a count samples are available
+		*/
+		bool peek(float *dest, size_t count) const;
+		void skip(size_t count);
+		void discard() { skip(available()); }
+
+	private:
+		std::vector<float> m_buffer;
+		size_t m_mask;
+		// both only grow, the difference is the number of available samples
+		std::atomic<size_t> m_writeIndex;
+		std::atomic<size_t> m_readIndex;
+		std::atomic<size_t> m_droppedCount;
+	};
+}
@@ -0,0 +1,51 @@
+/*
+ * SimdLevel.hpp
+ *
+ *	Created on: 18.10.2026
+ *		Project: Prismatik
+ *
+ *	Prismatik is a free, open-source software: you can redistribute it and/or
+ *	modify it under the terms of the GNU General Public License as published
+ *	by the Free Software Foundation, either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	Prismatik and Lightpack files is distributed in the hope that it will be
+ *	useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.	See the GNU
+ *	General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with this program.	If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+/*
+	Kernels for an instruction set above the baseline of the build are compiled for it one by
+	one, the rest of the library has to run everywhere. Only call them after availableSimd().
+	MSVC takes the intrinsics without flags.
+*/
+#if defined(__GNUC__) || defined(__clang__)
+#define SIMD_TARGET_SSE4_1 __attribute__((target("sse4.1")))
+#define SIMD_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define SIMD_TARGET_SSE4_1
+#define SIMD_TARGET_AVX2
+#endif
+
+namespace PrismatikMath
+{
+	enum SIMDLevel {
+		None = 0,
+		SSE4_1 = 1 << 0,
+		AVX2 = 1 << 1
+	};
+
+	/*!
+		SIMD instruction sets of the CPU the application runs on, bit mask of \a SIMDLevel
+	*/
+	uint32_t availableSimd();
+}
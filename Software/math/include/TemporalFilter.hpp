@@ -0,0 +1,88 @@
+/*
+ * TemporalFilter.hpp
+ *
+ *	Created on: 18.10.2026
+ *		Project: Prismatik
+ *
+ *	Prismatik is a free, open-source software: you can redistribute it and/or
+ *	modify it under the terms of the GNU General Public License as published
+ *	by the Free Software Foundation, either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	Prismatik and Lightpack files is distributed in the hope that it will be
+ *	useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.	See the GNU
+ *	General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with this program.	If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+
+#include <vector>
+#include <QRgb>
+
+namespace PrismatikMath
+{
+	/*!
+		Per channel temporal filter for LED colors. Time is passed in explicitly and every mode
+		is integrated exactly over it, so the result doesn't depend on how often \a advance()
+		is called: 4 steps of 1/120 s give the same colors as one step of 1/30 s.
+	*/
+	class TemporalFilter
+	{
+	public:
+		enum Mode {
+			ModeNone, // colors are the target
+			ModeExponential, // first order low pass, 63% of a change within the time constant
+			ModeSpring, // critically damped spring, eases in and out without overshoot, 60% within the time constant
+			ModeLinear, // straight from the previous colors to the target within the time constant
+			ModesCount
+		};
+
+		TemporalFilter();
+
+		void setMode(Mode mode);
+		Mode mode() const { return m_mode; }
+		/*!
+			\param seconds for \a ModeLinear the interval between targets interpolates
+			between them with the least lag
+		*/
+		void setTimeConstant(double seconds);
+
+		/*!
+			Colors to move towards. A different number of colors starts over from \a colors.
+		*/
+		void setTarget(const QRgb *colors, int count);
+		void advance(double seconds);
+
+		int size() const { return static_cast<int>(m_targets.size() / 3); }
+		/*!
+			\param colors receives \a size() colors
+		*/
+		void values(QRgb *colors) const;
+		/*!
+			Whether the colors have reached the target and stay there
+		*/
+		bool isSettled() const { return m_isSettled; }
+
+		void reset();
+
+	private:
+		void settle();
+
+	private:
+		Mode m_mode;
+		double m_timeConstant;
+		double m_elapsed; // since the target was set
+		bool m_isSettled;
+
+		// 3 channels per color, 0..255
+		std::vector<float> m_values;
+		std::vector<float> m_velocities; // per second, ModeSpring
+		std::vector<float> m_origins; // values when the target was set, ModeLinear
+		std::vector<float> m_targets;
+	};
+}
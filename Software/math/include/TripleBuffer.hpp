@@ -0,0 +1,83 @@
+/*
+ * TripleBuffer.hpp
+ *
+ *	Created on: 18.10.2026
+ *		Project: Prismatik
+ *
+ *	Prismatik is a free, open-source software: you can redistribute it and/or
+ *	modify it under the terms of the GNU General Public License as published
+ *	by the Free Software Foundation, either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	Prismatik and Lightpack files is distributed in the hope that it will be
+ *	useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.	See the GNU
+ *	General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with this program.	If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+
+#include <atomic>
+
+namespace PrismatikMath
+{
+	/*!
+		Hands the latest value from one thread to another without locks. The writer fills the
+		back buffer and publishes it, the reader takes the newest published value, values
+		published in between are skipped. Neither side ever waits for the other.
+	*/
+	template <typename T>
+	class TripleBuffer
+	{
+	public:
+		TripleBuffer()
+			: m_back(0)
+			, m_middle(1)
+			, m_front(2)
+		{
+		}
+
+		/*!
+			Sets all the buffers to \a value, only while neither side is running
+		*/
+		void reset(const T &value) {
+			for (T &buffer : m_buffers)
+				buffer = value;
+			m_middle.store(1, std::memory_order_relaxed);
+			m_back = 0;
+			m_front = 2;
+		}
+
+		// writer side
+		T & back() { return m_buffers[m_back]; }
+		void publish() {
+			m_back = m_middle.exchange(m_back | DirtyBit, std::memory_order_acq_rel) & IndexMask;
+		}
+
+		// reader side
+		/*!
+			Takes the last published value if there is a new one
+			\return true if \a front() changed
+		*/
+		bool update() {
+			if (!(m_middle.load(std::memory_order_relaxed) & DirtyBit))
+				return false;
+			m_front = m_middle.exchange(m_front, std::memory_order_acq_rel) & IndexMask;
+			return true;
+		}
+		const T & front() const { return m_buffers[m_front]; }
+
+	private:
+		static const int DirtyBit = 4;
+		static const int IndexMask = 3;
+
+		T m_buffers[3];
+		int m_back;
+		std::atomic<int> m_middle; // index of the buffer in between, DirtyBit if it wasn't read yet
+		int m_front;
+	};
+}
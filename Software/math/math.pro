@@ -14,8 +14,25 @@ include(../build-config.prf)
 INCLUDEPATH += ./include
 
 SOURCES += \
-    PrismatikMath.cpp
+    PrismatikMath.cpp \
+    ColorCorrectionLut.cpp \
+    ColorBatch.cpp \
+    SimdLevel.cpp \
+    TemporalFilter.cpp \
+    ColorSequence.cpp \
+    SampleRing.cpp \
+    BeatTracker.cpp \
+    FilterBank.cpp
 
 HEADERS += \
     include/colorspace_types.h \
-    include/PrismatikMath.hpp
+    include/PrismatikMath.hpp \
+    include/ColorCorrectionLut.hpp \
+    include/ColorBatch.hpp \
+    include/SimdLevel.hpp \
+    include/TemporalFilter.hpp \
+    include/ColorSequence.hpp \
+    include/SampleRing.hpp \
+    include/TripleBuffer.hpp \
+    include/BeatTracker.hpp \
+    include/FilterBank.hpp
@@ -111,32 +111,42 @@ void AbstractLedDevice::updateDeviceSettings()
 	Modifies colors according to gamma, luminosity threshold, white balance and brightness settings
 	All modifications are made over extended 12bit RGB, so \code outColors \endcode will contain 12bit
 	RGB instead of 8bit.
+	Gamma and brightness come from \a m_colorCorrection tables, only colors below the luminosity
+	threshold go through Lab.
 */
-void AbstractLedDevice::applyColorModifications(const QList<QRgb> &inColors, QList<StructRgb> &outColors) {
+void AbstractLedDevice::applyColorModifications(const ColorFrame &inColors, QList<StructRgb> &outColors) {
 
 	const bool isApplyWBAdjustments = m_wbAdjustments.count() == inColors.count();
 
-	for(int i = 0; i < inColors.count(); i++) {
+	m_colorCorrection.setGamma(m_gamma);
+	m_colorCorrection.setBrightness(m_brightness);
+	m_colorCorrection.setLuminosityThreshold(m_luminosityThreshold);
 
-		//renormalize to 12bit
-		const constexpr double k = 4095/255.0;
-		outColors[i].r = qRed(inColors[i]) * k;
-		outColors[i].g = qGreen(inColors[i]) * k;
-		outColors[i].b = qBlue(inColors[i]) * k;
-
-		PrismatikMath::gammaCorrection(m_gamma, outColors[i]);
+	bool isAnyBelowThreshold = false;
+	for (int i = 0; i < inColors.count(); i++) {
+		if (m_colorCorrection.isBelowThreshold(inColors[i])) {
+			isAnyBelowThreshold = true;
+			continue;
+		}
+		outColors[i] = m_colorCorrection.corrected(inColors[i]);
 	}
 
-	const StructLab avgColor = PrismatikMath::toLab(PrismatikMath::avgColor(outColors));
-
-	const double ampCoef = m_ledMilliAmps / (4095.0 * 3.0) / 1000.0;
-	double estimatedTotalAmps = 0.0;
+	if (isAnyBelowThreshold) {
+		StructLab avgColor;
+		if (m_isMinimumLuminosityEnabled) {
+			for (int i = 0; i < inColors.count(); i++)
+				outColors[i] = m_colorCorrection.gammaCorrected(inColors[i]);
+			avgColor = PrismatikMath::toLab(PrismatikMath::avgColor(outColors));
+		}
 
-	for (int i = 0; i < outColors.count(); ++i) {
-		StructLab lab = PrismatikMath::toLab(outColors[i]);
-		const int dl = m_luminosityThreshold - lab.l;
-		if (dl > 0) {
+		for (int i = 0; i < inColors.count(); ++i) {
+			if (!m_colorCorrection.isBelowThreshold(inColors[i])) {
+				outColors[i] = m_colorCorrection.corrected(inColors[i]);
+				continue;
+			}
 			if (m_isMinimumLuminosityEnabled) { // apply minimum luminosity or dead-zone
+				StructLab lab = PrismatikMath::toLab(outColors[i]);
+				const int dl = m_luminosityThreshold - lab.l;
 				// Cross-fade a and b channels to avarage value within kFadingRange, fadingFactor = (dL - fadingRange)^2 / (fadingRange^2)
 				constexpr int kFadingRange = 5;
 				const double fadingCoeff = dl < kFadingRange ? (dl - kFadingRange)*(dl - kFadingRange)/(kFadingRange*kFadingRange): 1;
@@ -145,17 +155,20 @@ void AbstractLedDevice::applyColorModifications(const QList<QRgb> &inColors, QLi
 				lab.l = m_luminosityThreshold;
 				lab.a += PrismatikMath::round(da * fadingCoeff);
 				lab.b += PrismatikMath::round(db * fadingCoeff);
-				const StructRgb rgb = PrismatikMath::toRgb(lab);
-				outColors[i] = rgb;
+				outColors[i] = PrismatikMath::toRgb(lab);
 			} else {
 				outColors[i].r = 0;
 				outColors[i].g = 0;
 				outColors[i].b = 0;
 			}
+			PrismatikMath::brightnessCorrection(m_brightness, outColors[i]);
 		}
+	}
 
-		PrismatikMath::brightnessCorrection(m_brightness, outColors[i]);
+	const double ampCoef = m_ledMilliAmps / (4095.0 * 3.0) / 1000.0;
+	double estimatedTotalAmps = 0.0;
 
+	for (int i = 0; i < outColors.count(); ++i) {
 		if (isApplyWBAdjustments) {
 			outColors[i].r *= m_wbAdjustments[i].red;
 			outColors[i].g *= m_wbAdjustments[i].green;
@@ -183,6 +196,13 @@ void AbstractLedDevice::applyColorModifications(const QList<QRgb> &inColors, QLi
 	}
 }
 
+void AbstractLedDevice::traceFrameWritten(const ColorFrame & colors)
+{
+	// colors set again after a settings change are stamped already, only grabbed frames count
+	if (colors.stageTimestamp(ColorFrame::StageGrabStarted) != 0 && colors.markStage(ColorFrame::StageWritten))
+		emit frameWritten(colors);
+}
+
 void AbstractLedDevice::applyDithering(QList<StructRgb>& colors, int colorDepth)
 {
 	unsigned int maxColorValueIn = 4095;
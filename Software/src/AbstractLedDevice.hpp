@@ -30,6 +30,8 @@
 #include "colorspace_types.h"
 #include "types.h"
 #include "SettingsDefaults.hpp"
+#include "ColorCorrectionLut.hpp"
+#include "ColorFrame.hpp"
 /*!
 	Abstract class representing any LED device.
 	\a LedDeviceManager
@@ -57,11 +59,15 @@ signals:
 	*/
 	void commandCompleted(bool ok);
 	void colorsUpdated(QList<QRgb> colors);
+	/*!
+		A grabbed frame has been written out, it is stamped at every \a ColorFrame#Stage
+	*/
+	void frameWritten(const ColorFrame &colors);
 
 public slots:
 	virtual void open() = 0;
 	virtual void close() = 0;
-	virtual void setColors(const QList<QRgb> & colors) = 0;
+	virtual void setColors(const ColorFrame & colors) = 0;
 	virtual void switchOffLeds() = 0;
 
 	/*!
@@ -96,8 +102,12 @@ public slots:
 	virtual void setUsbPowerLedDisabled(bool isDisabled);
 
 protected:
-	virtual void applyColorModifications(const QList<QRgb> & inColors, QList<StructRgb> & outColors);
+	virtual void applyColorModifications(const ColorFrame & inColors, QList<StructRgb> & outColors);
 	virtual void applyDithering(QList<StructRgb>& colors, int colorDepth);
+	/*!
+		To be called when the write of \a colors has returned, for latency tracing
+	*/
+	void traceFrameWritten(const ColorFrame & colors);
 
 protected:
 	QString m_colorSequence;
@@ -112,6 +122,9 @@ protected:
 
 	QList<WBAdjustment> m_wbAdjustments;
 
-	QList<QRgb> m_colorsSaved;
+	ColorFrame m_colorsSaved;
 	QList<StructRgb> m_colorsBuffer;
+
+private:
+	PrismatikMath::ColorCorrectionLut m_colorCorrection;
 };
@@ -43,8 +43,6 @@ AbstractLedDeviceUdp::AbstractLedDeviceUdp(const QString& address, const QString
 	}
 
 	m_timeout = timeout;
-
-	m_Socket = NULL;
 }
 
 AbstractLedDeviceUdp::~AbstractLedDeviceUdp()
@@ -54,26 +52,16 @@ AbstractLedDeviceUdp::~AbstractLedDeviceUdp()
 
 void AbstractLedDeviceUdp::close()
 {
-	if (m_Socket != NULL) {
-		m_Socket->close();
-
-		delete m_Socket;
-		m_Socket = NULL;
-	}
+	m_sender.close();
 }
 
 void AbstractLedDeviceUdp::open()
 {
 	DEBUG_LOW_LEVEL << Q_FUNC_INFO;
 
-	if (m_Socket != NULL)
-		m_Socket->close();
-	else
-		m_Socket = new QUdpSocket(this);
-
-	m_Socket->connectToHost(m_address, m_port, QIODevice::WriteOnly);
+	m_sender.open(m_address, m_port, this);
 	// TODO: connection slots
-	// emit openDeviceSuccess(m_Socket->isValid());
+	// emit openDeviceSuccess(m_sender.isValid());
 	emit openDeviceSuccess(true);
 
 	reinitBufferHeader();
@@ -105,12 +93,7 @@ void AbstractLedDeviceUdp::setColorDepth(int value)
 
 void AbstractLedDeviceUdp::switchOffLeds()
 {
-	const int count = m_colorsSaved.count();
-	QList<QRgb> blackFrame;
-	blackFrame.reserve(count);
-	for (int i = 0; i < count; i++)
-		blackFrame << 0;
-	setColors(blackFrame);
+	setColors(ColorFrame(m_colorsSaved.count()));
 }
 
 void AbstractLedDeviceUdp::resizeColorsBuffer(int buffSize)
@@ -136,20 +119,17 @@ void AbstractLedDeviceUdp::requestFirmwareVersion()
 	emit commandCompleted(true);
 }
 
-bool AbstractLedDeviceUdp::writeBuffer(const QByteArray& buff)
+char * AbstractLedDeviceUdp::beginPacket()
 {
-	DEBUG_MID_LEVEL << Q_FUNC_INFO << "Hex:" << buff.toHex();
-
-	if (m_Socket == NULL)
-		return false;
-
-	const qint64 bytesWritten = m_Socket->write(buff.data(), buff.size());
+	return m_sender.beginPacket(m_writeBufferHeader);
+}
 
-	if (bytesWritten != buff.count())
-	{
-		qWarning() << Q_FUNC_INFO << "bytesWritten != buff.count():" << bytesWritten << buff.count() << " " << m_Socket->errorString();
-		return false;
-	}
+void AbstractLedDeviceUdp::endPacket(const char *end)
+{
+	m_sender.endPacket(end);
+}
 
-	return true;
+bool AbstractLedDeviceUdp::writePackets()
+{
+	return m_sender.writePackets();
 }
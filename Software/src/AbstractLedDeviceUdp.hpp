@@ -28,7 +28,8 @@
 
 #include "AbstractLedDevice.hpp"
 #include "colorspace_types.h"
-#include <QUdpSocket>
+#include "ColorSequence.hpp"
+#include "UdpPacketSender.hpp"
 
 class AbstractLedDeviceUdp : public AbstractLedDevice
 {
@@ -50,17 +51,24 @@ public slots:
 
 protected:
 	QByteArray m_writeBufferHeader;
-	QByteArray m_writeBuffer;
+	PrismatikMath::ColorSequence m_colorOrder; // WLED takes RGB, the order of the strip is set on the controller
 
 	void resizeColorsBuffer(int buffSize);
 	virtual void reinitBufferHeader() = 0;
-	bool writeBuffer(const QByteArray& buff);
+
+	/*!
+		Packets of a frame, see \a UdpPacketSender
+		\return position right after the header of the new packet
+	*/
+	char * beginPacket();
+	void endPacket(const char *end);
+	bool writePackets();
 
 	uint8_t m_timeout;
 	constexpr static const uint8_t InfiniteTimeout = (uint8_t)255;
 
 private:
-	QUdpSocket* m_Socket;
+	UdpPacketSender m_sender;
 
 	QString m_address;
 	uint16_t m_port {21324};
@@ -25,6 +25,7 @@
  */
 
 #include <QtNetwork>
+#include <QtEndian>
 #include <stdlib.h>
 
 #include "ApiServer.hpp"
@@ -89,6 +90,11 @@ const char * const ApiServer::CmdResultGetColors = "colors:";
 const char * const ApiServer::CmdGetFPS = "getfps";
 const char * const ApiServer::CmdResultFPS = "fps:";
 
+const char * const ApiServer::CmdGetFramePacing = "getframepacing";
+const char * const ApiServer::CmdResultFramePacing = "framepacing:";
+const char * const ApiServer::CmdGetFrameLatency = "getlatency";
+const char * const ApiServer::CmdResultFrameLatency = "latency:";
+
 const char * const ApiServer::CmdGetScreenSize = "getscreensize";
 const char * const ApiServer::CmdResultScreenSize = "screensize:";
 
@@ -120,6 +126,9 @@ const char * const ApiServer::CmdResultSoundVizColors = "soundvizcolors:";
 
 const char * const ApiServer::CmdGetSoundVizLiquid = "getsoundvizliquid";
 const char * const ApiServer::CmdResultSoundVizLiquid = "soundvizliquid:";
+
+const char * const ApiServer::CmdGetSoundBeat = "getsoundbeat";
+const char * const ApiServer::CmdResultSoundBeat = "soundbeat:";
 #endif
 const char * const ApiServer::CmdGetPersistOnUnlock = "getpersistonunlock";
 const char * const ApiServer::CmdGetPersistOnUnlock_On = "persistonunlock:on\r\n";
@@ -179,6 +188,14 @@ const char * const ApiServer::CmdSetPersistOnUnlock = "setpersistonunlock:";
 const char * const ApiServer::CmdSetPersistOnUnlock_On = "on";
 const char * const ApiServer::CmdSetPersistOnUnlock_Off = "off";
 
+const char * const ApiServer::CmdSetBinaryMode = "setbinarymode:";
+const char * const ApiServer::CmdSetBinaryMode_On = "on";
+const char * const ApiServer::CmdSetBinaryMode_Off = "off";
+
+const char ApiServer::BinaryFrameMagic = '\xff';
+const int ApiServer::BinaryFrameHeaderSize = 6;
+const int ApiServer::BinaryFrameMaxPayloadSize = 2 + 3 * MaximumNumberOfLeds::AbsoluteMaximum;
+
 const int ApiServer::SignalWaitTimeoutMs = 1000; // 1 second
 
 ApiServer::ApiServer(QObject *parent)
@@ -268,6 +285,7 @@ void ApiServer::incomingConnection(qintptr socketDescriptor)
 
 	ClientInfo cs;
 	cs.isAuthorized = !m_isAuthEnabled;
+	cs.isBinaryMode = false;
 	// set default sessionkey (disable lock priority)
 	cs.sessionKey = QStringLiteral("API%1%2").arg(lightpack->GetSessionKey(QStringLiteral("API")), QString::number(m_clients.count()));
 
@@ -305,8 +323,19 @@ void ApiServer::clientProcessCommands()
 
 	QTcpSocket *client = qobject_cast<QTcpSocket*>(sender());
 
-	while (m_clients.contains(client) && client->canReadLine())
+	while (m_clients.contains(client))
 	{
+		if (isBinaryFrameNext(client))
+		{
+			// wait for the rest of the frame if it is incomplete
+			if (!processBinaryFrame(client))
+				return;
+			continue;
+		}
+
+		if (!client->canReadLine())
+			return;
+
 		QString sessionKey =	m_clients[client].sessionKey;
 		int m_lockedClient = lightpack->CheckLock(sessionKey);
 
@@ -463,6 +492,9 @@ void ApiServer::clientProcessCommands()
 			case SupportedDevices::DeviceTypeWarls:
 				max = MaximumNumberOfLeds::Warls;
 				break;
+			case SupportedDevices::DeviceTypeUdpFanout:
+				max = MaximumNumberOfLeds::UdpFanout;
+				break;
 			default:
 				max = MaximumNumberOfLeds::Default;
 			}
@@ -509,6 +541,27 @@ void ApiServer::clientProcessCommands()
 
 			result = QStringLiteral("%1%2\r\n").arg(CmdResultFPS).arg(lightpack->GetFPS());
 		}
+		else if (cmdBuffer == CmdGetFramePacing)
+		{
+			API_DEBUG_OUT << CmdGetFramePacing;
+
+			const Grab::FramePacingStats stats = lightpack->GetFramePacing();
+			result = QStringLiteral("%1%2,%3,%4,%5,%6\r\n").arg(CmdResultFramePacing)
+					.arg(stats.intervalMs).arg(stats.frameTimeMs).arg(stats.latencyMs)
+					.arg(stats.jitterMs).arg(stats.deadlineMisses);
+		}
+		else if (cmdBuffer == CmdGetFrameLatency)
+		{
+			API_DEBUG_OUT << CmdGetFrameLatency;
+
+			const FrameLatencyStats stats = lightpack->GetFrameLatency();
+			result = QStringLiteral("%1frames=%2;").arg(CmdResultFrameLatency).arg(stats.framesCount);
+			for (int span = 0; span < FrameLatencyStats::SpansCount; ++span)
+				result += QStringLiteral("%1=%2,%3,%4;")
+						.arg(QLatin1String(FrameLatencyStats::spanName(static_cast<FrameLatencyStats::Span>(span))))
+						.arg(stats.spans[span].p50Ms).arg(stats.spans[span].p95Ms).arg(stats.spans[span].p99Ms);
+			result += QStringLiteral("\r\n");
+		}
 		else if (cmdBuffer == CmdGetScreenSize)
 		{
 			API_DEBUG_OUT << CmdGetScreenSize;
@@ -616,6 +669,15 @@ void ApiServer::clientProcessCommands()
 
 			result = QStringLiteral("%1%2\r\n").arg(CmdResultSoundVizLiquid).arg(lightpack->GetSoundVizLiquidMode() ? 1 : 0);
 		}
+		else if (cmdBuffer == CmdGetSoundBeat)
+		{
+			API_DEBUG_OUT << CmdGetSoundBeat;
+
+			const SoundBeat beat = lightpack->GetSoundBeat();
+			result = QStringLiteral("%1%2,%3,%4,%5\r\n").arg(CmdResultSoundBeat)
+					.arg(beat.tempo, 0, 'f', 1).arg(beat.confidence, 0, 'f', 2)
+					.arg(beat.phase, 0, 'f', 2).arg(beat.onsetsCount);
+		}
 #endif
 		else if (cmdBuffer == CmdGetPersistOnUnlock)
 		{
@@ -697,33 +759,7 @@ void ApiServer::clientProcessCommands()
 					// Start task
 					emit startParseSetColorTask(cmdBuffer);
 
-					// Wait signal from m_apiSetColorTask with success or fail result of parsing buffer.
-					// After SignalWaitTimeoutMs milliseconds, the cycle of waiting will end and the
-					// variable m_isTaskSetColorDone will be reset to 'true' state.
-					// Also in cycle we process requests from over clients, if this request is setcolor when
-					// it will be ignored because of m_isTaskSetColorDone == false
-
-					m_timer.restart();
-
-					while (m_isTaskSetColorDone == false && m_timer.hasExpired(SignalWaitTimeoutMs) == false)
-					{
-						QApplication::processEvents(QEventLoop::WaitForMoreEvents, SignalWaitTimeoutMs);
-					}
-
-					if (m_isTaskSetColorDone)
-					{
-						if (m_isTaskSetColorParseSuccess)
-						{
-							lightpack->SetLockAlive(sessionKey);
-							result = CmdSetResult_Ok;
-						}
-						else
-							result = CmdSetResult_Error;
-					} else {
-						m_isTaskSetColorDone = true; // cmd setcolor is available
-						result = CmdSetResult_Error;
-						qWarning() << Q_FUNC_INFO << "Timeout waiting taskIsSuccess() signal from m_apiSetColorTask";
-					}
+					result = waitSetColorTask(sessionKey);
 				} else {
 					qWarning() << Q_FUNC_INFO << "Task setcolor is not completed (you should increase the delay to not skip commands), skip setcolor.";
 				}
@@ -737,6 +773,28 @@ void ApiServer::clientProcessCommands()
 				result = CmdSetResult_Busy;
 			}
 		}
+		else if (cmdBuffer.startsWith(CmdSetBinaryMode))
+		{
+			API_DEBUG_OUT << CmdSetBinaryMode;
+
+			// per connection, doesn't need the lock
+			cmdBuffer.remove(0, cmdBuffer.indexOf(':') + 1);
+			API_DEBUG_OUT << QString(cmdBuffer);
+
+			if (cmdBuffer == CmdSetBinaryMode_On)
+			{
+				m_clients[client].isBinaryMode = true;
+				result = CmdSetResult_Ok;
+			}
+			else if (cmdBuffer == CmdSetBinaryMode_Off)
+			{
+				m_clients[client].isBinaryMode = false;
+				result = CmdSetResult_Ok;
+			} else {
+				API_DEBUG_OUT << CmdSetBinaryMode << "Error (mode not recognized):" << QString(cmdBuffer);
+				result = CmdSetResult_Error;
+			}
+		}
 		else if (cmdBuffer.startsWith(CmdSetGamma))
 		{
 			API_DEBUG_OUT << CmdSetGamma;
@@ -1235,6 +1293,113 @@ void ApiServer::clientProcessCommands()
 	}
 }
 
+bool ApiServer::isBinaryFrameNext(QTcpSocket* client)
+{
+	if (!m_clients[client].isBinaryMode)
+		return false;
+
+	char magic = 0;
+	return client->peek(&magic, 1) == 1 && magic == BinaryFrameMagic;
+}
+
+bool ApiServer::processBinaryFrame(QTcpSocket* client)
+{
+	const QByteArray header = client->peek(BinaryFrameHeaderSize);
+	if (header.size() < BinaryFrameHeaderSize)
+		return false;
+
+	const int type = static_cast<uchar>(header[1]);
+	const quint32 payloadSize = qFromBigEndian<quint32>(header.constData() + 2);
+	if (payloadSize > static_cast<quint32>(BinaryFrameMaxPayloadSize))
+	{
+		// the frame can't be skipped without reading all of it, there is no way back to the next one
+		qWarning() << Q_FUNC_INFO << "binary frame is too big:" << payloadSize << "closing connection";
+		writeData(client, CmdSetResult_Error);
+		client->close();
+		return false;
+	}
+	if (client->bytesAvailable() < BinaryFrameHeaderSize + payloadSize)
+		return false;
+
+	client->skip(BinaryFrameHeaderSize);
+	const QByteArray payload = client->read(payloadSize);
+
+	API_DEBUG_OUT << Q_FUNC_INFO << "type:" << type << "payload:" << payloadSize;
+
+	QString result = CmdSetResult_Error;
+
+	const QString sessionKey = m_clients[client].sessionKey;
+	const int lockedClient = lightpack->CheckLock(sessionKey);
+
+	if (m_isAuthEnabled && m_clients[client].isAuthorized == false)
+	{
+		result = CmdApiCheck_AuthRequired;
+	}
+	else if (type != BinaryFrameSetColor || payload.size() < 2)
+	{
+		API_DEBUG_OUT << Q_FUNC_INFO << "unknown binary frame:" << type << payloadSize;
+		result = CmdSetResult_Error;
+	}
+	else if (lockedClient == 1)
+	{
+		if (m_isTaskSetColorDone)
+		{
+			m_isTaskSetColorDone = false;
+			m_isTaskSetColorParseSuccess = false;
+
+			// the task checks the LEDs against their number, the colors are copied as they are
+			const int firstLed = qFromBigEndian<quint16>(payload.constData());
+			emit startSetRgbColorTask(firstLed, payload.mid(2));
+
+			result = waitSetColorTask(sessionKey);
+		} else {
+			qWarning() << Q_FUNC_INFO << "Task setcolor is not completed (you should increase the delay to not skip commands), skip binary setcolor.";
+			result = CmdSetResult_Busy;
+		}
+	}
+	else if (lockedClient == 0)
+	{
+		result = CmdSetResult_NotLocked;
+	}
+	else // lockedClient != client
+	{
+		result = CmdSetResult_Busy;
+	}
+
+	writeData(client, result);
+	return true;
+}
+
+QString ApiServer::waitSetColorTask(const QString & sessionKey)
+{
+	// Wait signal from m_apiSetColorTask with success or fail result of parsing buffer.
+	// After SignalWaitTimeoutMs milliseconds, the cycle of waiting will end and the
+	// variable m_isTaskSetColorDone will be reset to 'true' state.
+	// Also in cycle we process requests from over clients, if this request is setcolor when
+	// it will be ignored because of m_isTaskSetColorDone == false
+
+	m_timer.restart();
+
+	while (m_isTaskSetColorDone == false && m_timer.hasExpired(SignalWaitTimeoutMs) == false)
+	{
+		QApplication::processEvents(QEventLoop::WaitForMoreEvents, SignalWaitTimeoutMs);
+	}
+
+	if (m_isTaskSetColorDone)
+	{
+		if (m_isTaskSetColorParseSuccess)
+		{
+			lightpack->SetLockAlive(sessionKey);
+			return CmdSetResult_Ok;
+		}
+		return CmdSetResult_Error;
+	}
+
+	m_isTaskSetColorDone = true; // cmd setcolor is available
+	qWarning() << Q_FUNC_INFO << "Timeout waiting taskIsSuccess() signal from m_apiSetColorTask";
+	return CmdSetResult_Error;
+}
+
 void ApiServer::taskSetColorIsSuccess(bool isSuccess)
 {
 	m_isTaskSetColorDone = true;
@@ -1261,6 +1426,7 @@ void ApiServer::initApiSetColorTask()
 	connect(m_apiSetColorTask, &ApiServerSetColorTask::taskParseSetColorIsSuccess, this, &ApiServer::taskSetColorIsSuccess, Qt::QueuedConnection);
 
 	connect(this, &ApiServer::startParseSetColorTask, m_apiSetColorTask, &ApiServerSetColorTask::startParseSetColorTask, Qt::QueuedConnection);
+	connect(this, &ApiServer::startSetRgbColorTask, m_apiSetColorTask, &ApiServerSetColorTask::startSetRgbColorTask, Qt::QueuedConnection);
 	connect(this, &ApiServer::updateApiDeviceNumberOfLeds,	m_apiSetColorTask, &ApiServerSetColorTask::setApiDeviceNumberOfLeds, Qt::QueuedConnection);
 	connect(this, &ApiServer::clearColorBuffers,				m_apiSetColorTask, &ApiServerSetColorTask::reinitColorBuffers);
 
@@ -1436,6 +1602,16 @@ void ApiServer::initHelpMessage()
 				QStringLiteral("Get FPS grabing"),
 				formatHelp(CmdResultFPS + QStringLiteral("25.57"))
 				);
+	m_helpMessage += formatHelp(
+				CmdGetFramePacing,
+				QStringLiteral("Get grab frame timing for the last second. Format: \"I,T,L,J,M\", where I - scheduled frame interval, T - mean time between frames, L - mean grab and processing time, J - mean deviation from the schedule (all in ms), M - number of missed deadlines."),
+				formatHelp(CmdResultFramePacing + QStringLiteral("16.7,16.7,4.2,0.35,0"))
+				);
+	m_helpMessage += formatHelp(
+				CmdGetFrameLatency,
+				QStringLiteral("Get p50, p95 and p99 latency in ms of the frames written to the device in the last 5 seconds, for the grab, processing, queue and device write stages and in total from the grab start to the end of the write."),
+				formatHelp(CmdResultFrameLatency + QStringLiteral("frames=300;grab=2.1,3.4,5.2;process=0.8,1.1,1.6;queue=0.2,4.6,9.8;write=1.4,2.3,3.1;total=5.1,10.2,17.9;"))
+				);
 	m_helpMessage += formatHelp(
 				CmdGetScreenSize,
 				QStringLiteral("Get size screen"),
@@ -1476,6 +1652,11 @@ void ApiServer::initHelpMessage()
 		QStringLiteral("Get wether or not sound visualization is in liquid color mode. Since API 2.1"),
 		formatHelp(CmdResultSoundVizLiquid + QStringLiteral("1"))
 		);
+	m_helpMessage += formatHelp(
+		CmdGetSoundBeat,
+		QStringLiteral("Get the beat of the sound visualization. Format: \"T,C,P,N\", where T - tempo in beats per minute (0 while unknown), C - confidence of the tempo from 0 to 1, P - position within the beat from 0 on the beat to 1 right before the next one, N - number of onsets detected so far."),
+		formatHelp(CmdResultSoundBeat + QStringLiteral("128.0,0.81,0.25,412"))
+		);
 #endif
 	m_helpMessage += formatHelp(
 		CmdGetPersistOnUnlock,
@@ -1498,6 +1679,17 @@ void ApiServer::initHelpMessage()
 				formatHelp(CmdSetColor + QStringLiteral("1-255,255,30;2-12,12,12;3-1,2,3;")),
 				helpCmdSetResults);
 
+	m_helpMessage += formatHelp(
+				CmdSetBinaryMode,
+				QStringLiteral("Accept binary frames on this connection besides text commands, for many LEDs at high rates. "
+							   "A frame is a 6 byte header: 0xFF, type, payload size (4 bytes, big endian); then the payload. "
+							   "Type 1 sets colors: index of the first LED from 0 (2 bytes, big endian), then R, G, B bytes per LED. "
+							   "Every frame is answered like setcolor, it works only on locking time (see lock)."),
+				formatHelp(CmdSetBinaryMode + QString(CmdSetBinaryMode_On)) +
+				formatHelp(CmdSetBinaryMode + QString(CmdSetBinaryMode_Off)),
+				formatHelp(CmdSetResult_Ok) +
+				formatHelp(CmdSetResult_Error));
+
 	m_helpMessage += formatHelp(
 				CmdSetLeds,
 				QStringLiteral("Set areas on several LEDs. Format: \"N-X,Y,W,H;\", where N - number of led, X,Y - position, H,W-size. Works only on locking time (see lock)."),
@@ -1601,13 +1793,13 @@ void ApiServer::initShortHelpMessage()
 			<< CmdGetStatus << CmdGetStatusAPI
 			<< CmdGetProfile << CmdGetProfiles
 			<< CmdGetCountLeds << CmdGetLeds << CmdGetColors
-			<< CmdGetFPS << CmdGetScreenSize << CmdGetBacklight
+			<< CmdGetFPS << CmdGetFramePacing << CmdGetFrameLatency << CmdGetScreenSize << CmdGetBacklight
 			<< CmdGetGamma << CmdGetBrightness << CmdGetSmooth
 #ifdef SOUNDVIZ_SUPPORT
-			<< CmdGetSoundVizColors << CmdGetSoundVizLiquid
+			<< CmdGetSoundVizColors << CmdGetSoundVizLiquid << CmdGetSoundBeat
 #endif
 			<< CmdGetPersistOnUnlock
-			<< CmdSetColor << CmdSetLeds
+			<< CmdSetColor << CmdSetBinaryMode << CmdSetLeds
 			<< CmdSetGamma << CmdSetBrightness << CmdSetSmooth
 			<< CmdSetProfile << CmdNewProfile << CmdDeleteProfile
 			<< CmdSetStatus << CmdSetBacklight
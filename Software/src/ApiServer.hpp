@@ -43,6 +43,7 @@ struct ClientInfo
 {
 	bool isAuthorized;
 	QString sessionKey;
+	bool isBinaryMode; // binary frames are accepted besides text commands, see setbinarymode
 	// Think about it. May be we need to save gamma,
 	// smooth and brightness and after success lock send
 	// this values to device?
@@ -109,6 +110,10 @@ public:
 
 	static const char * const CmdGetFPS;
 	static const char * const CmdResultFPS;
+	static const char * const CmdGetFramePacing;
+	static const char * const CmdResultFramePacing;
+	static const char * const CmdGetFrameLatency;
+	static const char * const CmdResultFrameLatency;
 
 	static const char * const CmdGetScreenSize;
 	static const char * const CmdResultScreenSize;
@@ -140,6 +145,9 @@ public:
 
 	static const char * const CmdGetSoundVizLiquid;
 	static const char * const CmdResultSoundVizLiquid;
+
+	static const char * const CmdGetSoundBeat;
+	static const char * const CmdResultSoundBeat;
 #endif
 
 	static const char * const CmdGetPersistOnUnlock;
@@ -198,10 +206,27 @@ public:
 	static const char * const CmdSetPersistOnUnlock_On;
 	static const char * const CmdSetPersistOnUnlock_Off;
 
+	static const char * const CmdSetBinaryMode;
+	static const char * const CmdSetBinaryMode_On;
+	static const char * const CmdSetBinaryMode_Off;
+
+	// Binary frame: header of BinaryFrameHeaderSize bytes, then the payload
+	//   0     BinaryFrameMagic, never the first byte of a text command
+	//   1     type, BinaryFrameType
+	//   2..5  payload size in bytes, big endian
+	// BinaryFrameSetColor payload: index of the first LED (from 0, 2 bytes, big endian), then R, G, B per LED
+	enum BinaryFrameType {
+		BinaryFrameSetColor = 1
+	};
+	static const char BinaryFrameMagic;
+	static const int BinaryFrameHeaderSize;
+	static const int BinaryFrameMaxPayloadSize;
+
 	static const int SignalWaitTimeoutMs;
 
 signals:
 	void startParseSetColorTask(QByteArray buffer);
+	void startSetRgbColorTask(int firstLed, QByteArray rgb);
 	void errorOnStartListening(QString errorMessage);
 	void clearColorBuffers();
 	void updateApiDeviceNumberOfLeds(int value);
@@ -225,6 +250,9 @@ private:
 	void startListening();
 	void stopListening();
 	void writeData(QTcpSocket* client, const QString & data);
+	bool isBinaryFrameNext(QTcpSocket* client);
+	bool processBinaryFrame(QTcpSocket* client);
+	QString waitSetColorTask(const QString & sessionKey);
 	QString formatHelp(const QString & cmd);
 	QString formatHelp(const QString & cmd, const QString & description);
 	QString formatHelp(const QString & cmd, const QString & description, const QString & results);
@@ -178,6 +178,27 @@ end:
 	}
 }
 
+void ApiServerSetColorTask::startSetRgbColorTask(int firstLed, QByteArray rgb)
+{
+	API_DEBUG_OUT << Q_FUNC_INFO << firstLed << rgb.size() << "task thread:" << thread()->currentThreadId();
+
+	// rgb holds R, G, B bytes for the LEDs from firstLed on, nothing to parse
+	const int count = rgb.size() / 3;
+	if (firstLed < 0 || count == 0 || rgb.size() % 3 != 0 || firstLed + count > m_numberOfLeds)
+	{
+		API_DEBUG_OUT << "LEDs are out of bounds:" << firstLed << count << m_numberOfLeds;
+		emit taskParseSetColorIsSuccess(false);
+		return;
+	}
+
+	const uchar *color = reinterpret_cast<const uchar *>(rgb.constData());
+	for (int i = firstLed; i < firstLed + count; i++, color += 3)
+		m_colors[i] = qRgb(color[0], color[1], color[2]);
+
+	emit taskParseSetColorDone(m_colors);
+	emit taskParseSetColorIsSuccess(true);
+}
+
 void ApiServerSetColorTask::reinitColorBuffers()
 {
 	m_colors.clear();
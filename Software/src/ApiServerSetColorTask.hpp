@@ -42,6 +42,7 @@ signals:
 
 public slots:
 	void startParseSetColorTask(QByteArray buffer);
+	void startSetRgbColorTask(int firstLed, QByteArray rgb);
 	void reinitColorBuffers();
 	void setApiDeviceNumberOfLeds(int value);
 
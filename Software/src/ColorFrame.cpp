@@ -0,0 +1,295 @@
+/*
+ * ColorFrame.cpp
+ *
+ *	Created on: 18.10.2026
+ *		Project: Prismatik
+ *
+ *	Prismatik is a free, open-source software: you can redistribute it and/or
+ *	modify it under the terms of the GNU General Public License as published
+ *	by the Free Software Foundation, either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	Prismatik and Lightpack files is distributed in the hope that it will be
+ *	useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.	See the GNU
+ *	General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with this program.	If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "ColorFrame.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <new>
+#include <QMutex>
+#include <QVector>
+
+struct ColorFrameData
+{
+	std::atomic<int> ref;
+	int size;
+	int capacity;
+	quint64 sequence;
+	std::atomic<qint64> timestamps[ColorFrame::StagesCount];
+
+	// colors follow the header in the same block
+	QRgb * colors() { return reinterpret_cast<QRgb *>(this + 1); }
+};
+
+namespace
+{
+	// free buffers kept for reuse, a frame is usually held by the producer, the slot,
+	// the device manager, a queued call and the device at the same time
+	const int PoolBuffersMax = 32;
+
+	ColorFrameData * allocateData(int capacity)
+	{
+		void *block = ::operator new(sizeof(ColorFrameData) + capacity * sizeof(QRgb));
+		ColorFrameData *d = new (block) ColorFrameData;
+		d->capacity = capacity;
+		return d;
+	}
+
+	void deallocateData(ColorFrameData *d)
+	{
+		d->~ColorFrameData();
+		::operator delete(d);
+	}
+
+	class ColorFramePool
+	{
+	public:
+		ColorFramePool()
+			: m_allocatedCount(0)
+		{
+			m_free.reserve(PoolBuffersMax);
+		}
+
+		~ColorFramePool()
+		{
+			for (ColorFrameData *d : m_free)
+				deallocateData(d);
+		}
+
+		ColorFrameData * acquire(int size)
+		{
+			ColorFrameData *d = NULL;
+			{
+				QMutexLocker locker(&m_mutex);
+				// the most recently released buffer is the most likely one to be in cache
+				for (int i = m_free.size() - 1; i >= 0; --i) {
+					if (m_free[i]->capacity >= size) {
+						d = m_free[i];
+						m_free[i] = m_free.last();
+						m_free.removeLast();
+						break;
+					}
+				}
+			}
+			if (d == NULL) {
+				d = allocateData(size);
+				m_allocatedCount++;
+			}
+			d->ref.store(1, std::memory_order_relaxed);
+			d->size = size;
+			d->sequence = 0;
+			for (std::atomic<qint64> &timestamp : d->timestamps)
+				timestamp.store(0, std::memory_order_relaxed);
+			return d;
+		}
+
+		void release(ColorFrameData *d)
+		{
+			{
+				QMutexLocker locker(&m_mutex);
+				if (m_free.size() < PoolBuffersMax) {
+					m_free.append(d);
+					return;
+				}
+			}
+			deallocateData(d);
+		}
+
+		int allocatedCount() const { return m_allocatedCount; }
+
+	private:
+		QMutex m_mutex;
+		QVector<ColorFrameData *> m_free;
+		std::atomic<int> m_allocatedCount;
+	};
+
+	Q_GLOBAL_STATIC(ColorFramePool, colorFramePool)
+
+	ColorFrameData * acquireData(int size)
+	{
+		return colorFramePool->acquire(size);
+	}
+
+	void releaseData(ColorFrameData *d)
+	{
+		if (d == NULL || d->ref.fetch_sub(1, std::memory_order_acq_rel) != 1)
+			return;
+		// frames can outlive the pool at exit
+		if (colorFramePool.isDestroyed())
+			deallocateData(d);
+		else
+			colorFramePool->release(d);
+	}
+}
+
+ColorFrame::ColorFrame()
+	: d(NULL)
+{
+}
+
+ColorFrame::ColorFrame(int size, QRgb value)
+	: d(acquireData(size))
+{
+	std::fill_n(d->colors(), size, value);
+}
+
+ColorFrame::ColorFrame(const QList<QRgb> &colors)
+	: d(acquireData(colors.size()))
+{
+	std::copy(colors.cbegin(), colors.cend(), d->colors());
+}
+
+ColorFrame::ColorFrame(const ColorFrame &other)
+	: d(other.d)
+{
+	if (d)
+		d->ref.fetch_add(1, std::memory_order_relaxed);
+}
+
+ColorFrame::ColorFrame(ColorFrame &&other) noexcept
+	: d(other.d)
+{
+	other.d = NULL;
+}
+
+ColorFrame::~ColorFrame()
+{
+	releaseData(d);
+}
+
+ColorFrame & ColorFrame::operator=(const ColorFrame &other)
+{
+	if (other.d)
+		other.d->ref.fetch_add(1, std::memory_order_relaxed);
+	releaseData(d);
+	d = other.d;
+	return *this;
+}
+
+ColorFrame & ColorFrame::operator=(ColorFrame &&other) noexcept
+{
+	std::swap(d, other.d);
+	return *this;
+}
+
+int ColorFrame::size() const
+{
+	return d ? d->size : 0;
+}
+
+const QRgb * ColorFrame::constData() const
+{
+	return d ? d->colors() : NULL;
+}
+
+QRgb * ColorFrame::data()
+{
+	if (d == NULL)
+		return NULL;
+	detach();
+	return d->colors();
+}
+
+void ColorFrame::fill(QRgb value)
+{
+	std::fill_n(data(), size(), value);
+}
+
+quint64 ColorFrame::sequence() const
+{
+	return d ? d->sequence : 0;
+}
+
+void ColorFrame::setSequence(quint64 sequence)
+{
+	if (d == NULL)
+		d = acquireData(0);
+	detach();
+	d->sequence = sequence;
+}
+
+qint64 ColorFrame::stageTimestamp(Stage stage) const
+{
+	return d ? d->timestamps[stage].load(std::memory_order_relaxed) : 0;
+}
+
+void ColorFrame::setStageTimestamp(Stage stage, qint64 timestamp)
+{
+	if (d == NULL)
+		d = acquireData(0);
+	detach();
+	d->timestamps[stage].store(timestamp, std::memory_order_relaxed);
+}
+
+bool ColorFrame::markStage(Stage stage) const
+{
+	if (d == NULL)
+		return false;
+	qint64 unstamped = 0;
+	return d->timestamps[stage].compare_exchange_strong(unstamped, timestamp(), std::memory_order_relaxed);
+}
+
+QList<QRgb> ColorFrame::toList() const
+{
+	QList<QRgb> colors;
+	colors.reserve(size());
+	for (const QRgb color : *this)
+		colors.append(color);
+	return colors;
+}
+
+bool ColorFrame::operator==(const ColorFrame &other) const
+{
+	return size() == other.size() && std::equal(begin(), end(), other.begin());
+}
+
+qint64 ColorFrame::timestamp()
+{
+	using namespace std::chrono;
+	return duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+int ColorFrame::allocatedBuffersCount()
+{
+	return colorFramePool->allocatedCount();
+}
+
+void ColorFrame::detach()
+{
+	if (d->ref.load(std::memory_order_acquire) == 1)
+		return;
+
+	ColorFrameData *copy = acquireData(d->size);
+	std::copy_n(d->colors(), d->size, copy->colors());
+	copy->sequence = d->sequence;
+	for (int stage = 0; stage < StagesCount; ++stage)
+		copy->timestamps[stage].store(d->timestamps[stage].load(std::memory_order_relaxed), std::memory_order_relaxed);
+	releaseData(d);
+	d = copy;
+}
+
+QDebug operator<<(QDebug debug, const ColorFrame &frame)
+{
+	QDebugStateSaver saver(debug);
+	debug.nospace() << "ColorFrame(" << frame.sequence() << ", " << frame.toList() << ')';
+	return debug;
+}
@@ -0,0 +1,131 @@
+/*
+ * ColorFrame.hpp
+ *
+ *	Created on: 18.10.2026
+ *		Project: Prismatik
+ *
+ *	Prismatik is a free, open-source software: you can redistribute it and/or
+ *	modify it under the terms of the GNU General Public License as published
+ *	by the Free Software Foundation, either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	Prismatik and Lightpack files is distributed in the hope that it will be
+ *	useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.	See the GNU
+ *	General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with this program.	If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+
+#include <QDebug>
+#include <QList>
+#include <QMetaType>
+#include <QRgb>
+
+struct ColorFrameData;
+
+/*!
+	Colors of all LEDs for one frame, stored contiguously, with the sequence number of the frame
+	and the time its colors were captured. Copies share the colors through a reference count
+	which is safe to use from different threads, \a data() copies them first if the frame is
+	shared, the way Qt containers do.
+
+	Buffers are recycled: when the last copy of a frame goes away its buffer returns to a pool
+	and the next frame of the same or a smaller size takes it, so frames passed around at a
+	constant number of LEDs don't allocate.
+*/
+class ColorFrame
+{
+public:
+	/*!
+		Points of the way from the screen to the LEDs at which frames are stamped, in order
+	*/
+	enum Stage {
+		StageGrabStarted,
+		StageGrabFinished, // screen captured, zone colors not evaluated yet
+		StageProcessed, // colors are ready for the devices
+		StageEnqueued, // handed over to the device
+		StageWritten, // the device has written the colors out
+		StagesCount
+	};
+
+	ColorFrame();
+	explicit ColorFrame(int size, QRgb value = 0);
+	ColorFrame(const QList<QRgb> &colors);
+	ColorFrame(const ColorFrame &other);
+	ColorFrame(ColorFrame &&other) noexcept;
+	~ColorFrame();
+
+	ColorFrame & operator=(const ColorFrame &other);
+	ColorFrame & operator=(ColorFrame &&other) noexcept;
+
+	int size() const;
+	int count() const { return size(); }
+	bool isEmpty() const { return size() == 0; }
+
+	const QRgb * constData() const;
+	const QRgb * begin() const { return constData(); }
+	const QRgb * end() const { return constData() + size(); }
+	QRgb operator[](int i) const { Q_ASSERT(i >= 0 && i < size()); return constData()[i]; }
+	QRgb at(int i) const { return (*this)[i]; }
+	QRgb first() const { return (*this)[0]; }
+
+	/*!
+		Writable colors, the frame stops sharing them with its copies
+	*/
+	QRgb * data();
+	void fill(QRgb value);
+
+	/*!
+		Number of the frame given by its source, 0 if the source doesn't number frames
+	*/
+	quint64 sequence() const;
+	void setSequence(quint64 sequence);
+
+	/*!
+		\a timestamp() at which the frame passed \a stage, 0 if it didn't
+	*/
+	qint64 stageTimestamp(Stage stage) const;
+	void setStageTimestamp(Stage stage, qint64 timestamp);
+
+	/*!
+		Stamps \a stage with the current time unless it is stamped already. Unlike the other
+		setters it doesn't detach: stamps are shared by all copies, so the stages after the
+		producer don't copy the colors. Safe to call from any thread.
+		\return true if the stage wasn't stamped before
+	*/
+	bool markStage(Stage stage) const;
+
+	QList<QRgb> toList() const;
+
+	/*!
+		Compares colors only
+	*/
+	bool operator==(const ColorFrame &other) const;
+	bool operator!=(const ColorFrame &other) const { return !(*this == other); }
+
+	/*!
+		Monotonic clock in nanoseconds
+	*/
+	static qint64 timestamp();
+
+	/*!
+		Number of frame buffers allocated so far, taking a recycled buffer doesn't count
+	*/
+	static int allocatedBuffersCount();
+
+private:
+	void detach();
+
+private:
+	ColorFrameData *d;
+};
+
+Q_DECLARE_TYPEINFO(ColorFrame, Q_MOVABLE_TYPE);
+Q_DECLARE_METATYPE(ColorFrame)
+
+QDebug operator<<(QDebug debug, const ColorFrame &frame);
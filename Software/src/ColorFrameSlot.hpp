@@ -0,0 +1,82 @@
+/*
+ * ColorFrameSlot.hpp
+ *
+ *	Created on: 18.10.2026
+ *		Project: Prismatik
+ *
+ *	Prismatik is a free, open-source software: you can redistribute it and/or
+ *	modify it under the terms of the GNU General Public License as published
+ *	by the Free Software Foundation, either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	Prismatik and Lightpack files is distributed in the hope that it will be
+ *	useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.	See the GNU
+ *	General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with this program.	If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+
+#include <atomic>
+#include "ColorFrame.hpp"
+
+/*!
+	Lock-free single-producer / single-consumer slot holding the latest color frame.
+	Implemented as a triple buffer: the producer fills \a writeBuffer() and publishes it,
+	the consumer takes whatever was published last. Frames which were not taken in time
+	are overwritten, so a slow consumer never makes the producer wait or queue up.
+*/
+class ColorFrameSlot
+{
+public:
+	ColorFrameSlot()
+		: m_middle(1)
+		, m_back(0)
+		, m_front(2)
+	{}
+
+	/*!
+		Producer side. Frame to set before calling \a publish()
+	*/
+	ColorFrame & writeBuffer() { return m_buffers[m_back]; }
+
+	/*!
+		Producer side. Makes the write buffer available to the consumer.
+		\return true if the consumer has already taken the previous frame and needs to be
+		notified, false if the previous frame was replaced before it was taken
+	*/
+	bool publish()
+	{
+		const int previous = m_middle.exchange(m_back | FreshBit, std::memory_order_acq_rel);
+		m_back = previous & IndexMask;
+		return (previous & FreshBit) == 0;
+	}
+
+	/*!
+		Consumer side. Takes the latest published frame.
+		\param colors receives the frame, left untouched if nothing new was published
+		\return true if a new frame was taken
+	*/
+	bool take(ColorFrame &colors)
+	{
+		if ((m_middle.load(std::memory_order_acquire) & FreshBit) == 0)
+			return false;
+
+		m_front = m_middle.exchange(m_front, std::memory_order_acq_rel) & IndexMask;
+		colors = m_buffers[m_front];
+		return true;
+	}
+
+private:
+	static constexpr const int IndexMask = 0x3;
+	static constexpr const int FreshBit = 0x4;
+
+	ColorFrame m_buffers[3];
+	std::atomic<int> m_middle; // index of the buffer exchanged between threads | FreshBit
+	int m_back; // owned by the producer
+	int m_front; // owned by the consumer
+};
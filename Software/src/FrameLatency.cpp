@@ -0,0 +1,103 @@
+/*
+ * FrameLatency.cpp
+ *
+ *	Created on: 18.10.2026
+ *		Project: Prismatik
+ *
+ *	Prismatik is a free, open-source software: you can redistribute it and/or
+ *	modify it under the terms of the GNU General Public License as published
+ *	by the Free Software Foundation, either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	Prismatik and Lightpack files is distributed in the hope that it will be
+ *	useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.	See the GNU
+ *	General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with this program.	If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "FrameLatency.hpp"
+
+#include <cmath>
+
+LatencyHistogram::LatencyHistogram()
+{
+	clear();
+}
+
+void LatencyHistogram::add(qint64 durationNs)
+{
+	const double us = durationNs / 1000.0;
+	int bucket = 0;
+	if (us >= 1.0)
+		bucket = qMin(1 + static_cast<int>(std::log2(us) * BucketsPerOctave), static_cast<int>(m_buckets.size()) - 1);
+	m_buckets[bucket]++;
+	m_count++;
+}
+
+void LatencyHistogram::clear()
+{
+	m_buckets.fill(0);
+	m_count = 0;
+}
+
+double LatencyHistogram::percentileMs(double fraction) const
+{
+	if (m_count == 0)
+		return 0.0;
+
+	const int rank = qMax(1, static_cast<int>(std::ceil(fraction * m_count)));
+	int bucket = 0;
+	for (int count = m_buckets[0]; count < rank; count += m_buckets[bucket])
+		++bucket;
+
+	if (bucket == 0)
+		return 0.0005;
+	// geometric middle of the bucket
+	return std::exp2((bucket - 0.5) / BucketsPerOctave) / 1000.0;
+}
+
+const char * FrameLatencyStats::spanName(Span span)
+{
+	switch (span) {
+	case SpanGrab: return "grab";
+	case SpanProcess: return "process";
+	case SpanQueue: return "queue";
+	case SpanWrite: return "write";
+	case SpanTotal: return "total";
+	default: return "";
+	}
+}
+
+void FrameLatencyTracer::addFrame(const ColorFrame &frame)
+{
+	qint64 timestamps[ColorFrame::StagesCount];
+	for (int stage = 0; stage < ColorFrame::StagesCount; ++stage) {
+		timestamps[stage] = frame.stageTimestamp(static_cast<ColorFrame::Stage>(stage));
+		if (timestamps[stage] == 0)
+			return;
+	}
+
+	// spans up to SpanTotal are between consecutive stages
+	for (int span = 0; span < FrameLatencyStats::SpanTotal; ++span)
+		m_histograms[span].add(timestamps[span + 1] - timestamps[span]);
+	m_histograms[FrameLatencyStats::SpanTotal].add(
+		timestamps[ColorFrame::StageWritten] - timestamps[ColorFrame::StageGrabStarted]);
+}
+
+FrameLatencyStats FrameLatencyTracer::takeStats()
+{
+	FrameLatencyStats stats;
+	stats.framesCount = m_histograms[FrameLatencyStats::SpanTotal].count();
+	for (int span = 0; span < FrameLatencyStats::SpansCount; ++span) {
+		LatencyHistogram &histogram = m_histograms[span];
+		stats.spans[span].p50Ms = histogram.percentileMs(0.50);
+		stats.spans[span].p95Ms = histogram.percentileMs(0.95);
+		stats.spans[span].p99Ms = histogram.percentileMs(0.99);
+		histogram.clear();
+	}
+	return stats;
+}
@@ -0,0 +1,101 @@
+/*
+ * FrameLatency.hpp
+ *
+ *	Created on: 18.10.2026
+ *		Project: Prismatik
+ *
+ *	Prismatik is a free, open-source software: you can redistribute it and/or
+ *	modify it under the terms of the GNU General Public License as published
+ *	by the Free Software Foundation, either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	Prismatik and Lightpack files is distributed in the hope that it will be
+ *	useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.	See the GNU
+ *	General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with this program.	If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+
+#include <array>
+#include <QMetaType>
+#include "ColorFrame.hpp"
+
+/*!
+	Distribution of durations in logarithmic buckets, 8 per octave from 1 us to about a minute,
+	so percentiles are accurate to about 9%. Adding is constant time and doesn't allocate.
+*/
+class LatencyHistogram
+{
+public:
+	LatencyHistogram();
+
+	void add(qint64 durationNs);
+	int count() const { return m_count; }
+	void clear();
+
+	/*!
+		\param fraction of the durations which are not longer than the result, 0.5 for the median
+		\return duration in ms, 0 if nothing was added
+	*/
+	double percentileMs(double fraction) const;
+
+private:
+	static const int BucketsPerOctave = 8;
+	static const int Octaves = 26;
+
+	std::array<int, BucketsPerOctave * Octaves + 1> m_buckets; // the first one is below 1 us
+	int m_count;
+};
+
+/*!
+	Latency percentiles of the frames written to the device since the previous
+	\a FrameLatencyTracer#takeStats() call
+*/
+struct FrameLatencyStats {
+	/*!
+		Parts of the way of a frame, each between two consecutive \a ColorFrame#Stage
+	*/
+	enum Span {
+		SpanGrab, // screen capture
+		SpanProcess, // zone colors and post-processing
+		SpanQueue, // waiting for the device manager
+		SpanWrite, // waiting for the device and writing to it
+		SpanTotal, // from the start of the grab to the end of the write
+		SpansCount
+	};
+
+	struct Percentiles {
+		double p50Ms = 0.0;
+		double p95Ms = 0.0;
+		double p99Ms = 0.0;
+	};
+
+	static const char * spanName(Span span);
+
+	Percentiles spans[SpansCount];
+	int framesCount = 0;
+};
+
+/*!
+	Collects latencies of frames which went all the way from the grabber to the device.
+	Not thread-safe.
+*/
+class FrameLatencyTracer
+{
+public:
+	/*!
+		Frames not stamped at every \a ColorFrame#Stage are ignored
+	*/
+	void addFrame(const ColorFrame &frame);
+	FrameLatencyStats takeStats();
+
+private:
+	LatencyHistogram m_histograms[FrameLatencyStats::SpansCount];
+};
+
+Q_DECLARE_METATYPE(FrameLatencyStats)
@@ -0,0 +1,104 @@
+/*
+ * FrameSmoother.cpp
+ *
+ *	Created on: 18.10.2026
+ *		Project: Prismatik
+ *
+ *	Prismatik is a free, open-source software: you can redistribute it and/or
+ *	modify it under the terms of the GNU General Public License as published
+ *	by the Free Software Foundation, either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	Prismatik and Lightpack files is distributed in the hope that it will be
+ *	useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.	See the GNU
+ *	General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with this program.	If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "FrameSmoother.hpp"
+
+#include <QTimer>
+#include "debug.h"
+
+FrameSmoother::FrameSmoother(QObject *parent)
+	: QObject(parent)
+	, m_lastOutputTimestamp(0)
+	, m_isTargetOutput(true)
+{
+	m_timer = new QTimer(this);
+	m_timer->setTimerType(Qt::PreciseTimer);
+	connect(m_timer, &QTimer::timeout, this, &FrameSmoother::outputFrame);
+}
+
+void FrameSmoother::setMode(int mode)
+{
+	DEBUG_LOW_LEVEL << Q_FUNC_INFO << mode;
+	if (mode < PrismatikMath::TemporalFilter::ModeNone || mode >= PrismatikMath::TemporalFilter::ModesCount) {
+		qWarning() << Q_FUNC_INFO << "unknown mode" << mode;
+		mode = PrismatikMath::TemporalFilter::ModeNone;
+	}
+	m_filter.setMode(static_cast<PrismatikMath::TemporalFilter::Mode>(mode));
+	if (!isEnabled())
+		reset();
+}
+
+void FrameSmoother::setTimeConstant(int ms)
+{
+	DEBUG_LOW_LEVEL << Q_FUNC_INFO << ms;
+	m_filter.setTimeConstant(ms / 1000.0);
+}
+
+void FrameSmoother::setOutputFrameRate(int hz)
+{
+	DEBUG_LOW_LEVEL << Q_FUNC_INFO << hz;
+	// QTimer has millisecond resolution, the filter is advanced by the time actually passed
+	m_timer->setInterval(qMax(1, qRound(1000.0 / qMax(1, hz))));
+}
+
+void FrameSmoother::setTarget(const ColorFrame & colors)
+{
+	DEBUG_HIGH_LEVEL << Q_FUNC_INFO << colors.sequence();
+
+	m_filter.setTarget(colors.constData(), colors.size());
+	m_target = colors;
+	m_isTargetOutput = false;
+
+	if (!m_timer->isActive()) {
+		m_lastOutputTimestamp = ColorFrame::timestamp();
+		m_timer->start();
+	}
+}
+
+void FrameSmoother::reset()
+{
+	m_timer->stop();
+	m_filter.reset();
+	m_target = ColorFrame();
+	m_isTargetOutput = true;
+}
+
+void FrameSmoother::outputFrame()
+{
+	const qint64 now = ColorFrame::timestamp();
+	m_filter.advance((now - m_lastOutputTimestamp) / 1e9);
+	m_lastOutputTimestamp = now;
+
+	ColorFrame frame(m_filter.size());
+	m_filter.values(frame.data());
+	if (!m_isTargetOutput) {
+		// latency is traced from the grab to the first frame which moves towards it
+		frame.setSequence(m_target.sequence());
+		for (int stage = ColorFrame::StageGrabStarted; stage < ColorFrame::StageEnqueued; ++stage)
+			frame.setStageTimestamp(static_cast<ColorFrame::Stage>(stage), m_target.stageTimestamp(static_cast<ColorFrame::Stage>(stage)));
+		m_isTargetOutput = true;
+	}
+
+	if (m_filter.isSettled())
+		m_timer->stop();
+
+	emit frameSmoothed(frame);
+}
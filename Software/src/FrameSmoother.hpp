@@ -0,0 +1,72 @@
+/*
+ * FrameSmoother.hpp
+ *
+ *	Created on: 18.10.2026
+ *		Project: Prismatik
+ *
+ *	Prismatik is a free, open-source software: you can redistribute it and/or
+ *	modify it under the terms of the GNU General Public License as published
+ *	by the Free Software Foundation, either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	Prismatik and Lightpack files is distributed in the hope that it will be
+ *	useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.	See the GNU
+ *	General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with this program.	If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+
+#include <QObject>
+#include "ColorFrame.hpp"
+#include "TemporalFilter.hpp"
+
+class QTimer;
+
+/*!
+	Device independent temporal smoothing of grabbed frames. Grabbed frames become the target
+	of a \a PrismatikMath::TemporalFilter, smoothed frames are put out at their own rate, which
+	can be higher than the grab rate: grabbing at 30 FPS with a 120 Hz output and
+	\a PrismatikMath::TemporalFilter::ModeLinear interpolates three frames between grabs.
+	Output stops once the colors have reached the target.
+
+	Lives in the thread of \a LedDeviceManager.
+*/
+class FrameSmoother : public QObject
+{
+	Q_OBJECT
+public:
+	explicit FrameSmoother(QObject *parent = 0);
+
+	bool isEnabled() const { return m_filter.mode() != PrismatikMath::TemporalFilter::ModeNone; }
+
+signals:
+	void frameSmoothed(const ColorFrame & colors);
+
+public slots:
+	/*!
+		\param mode \a PrismatikMath::TemporalFilter::Mode
+	*/
+	void setMode(int mode);
+	void setTimeConstant(int ms);
+	void setOutputFrameRate(int hz);
+	void setTarget(const ColorFrame & colors);
+	/*!
+		Stops the output and forgets the colors
+	*/
+	void reset();
+
+private slots:
+	void outputFrame();
+
+private:
+	PrismatikMath::TemporalFilter m_filter;
+	QTimer *m_timer;
+	qint64 m_lastOutputTimestamp;
+	ColorFrame m_target; // its sequence and stamps go with the first output frame after it
+	bool m_isTargetOutput;
+};
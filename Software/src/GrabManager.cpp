@@ -26,6 +26,7 @@
 
 #include <QtMath>
 #include <QApplication>
+#include <QThread>
 
 #include "debug.h"
 #include "PrismatikMath.hpp"
@@ -36,11 +37,13 @@
 #include "WinAPIGrabber.hpp"
 #include "DDuplGrabber.hpp"
 #include "X11Grabber.hpp"
+#include "PipeWireGrabber.hpp"
+#include "SyntheticGrabber.hpp"
 #include "MacOSCGGrabber.hpp"
 #include "MacOSAVGrabber.h"
 #include "D3D10Grabber.hpp"
 #include "GrabManager.hpp"
-#include "BlueLightReduction.hpp"
+#include "GrabProcessor.hpp"
 #ifdef Q_OS_WIN
 #include "WinUtils.hpp"
 #endif // Q_OS_WIN
@@ -49,7 +52,8 @@ using namespace SettingsScope;
 
 using namespace std::chrono_literals;
 constexpr const std::chrono::milliseconds FPS_UPDATE_INTERVAL = 500ms;
-constexpr const std::chrono::milliseconds FAKE_GRAB_INTERVAL = 900ms;
+// frame pacing is averaged over whole seconds, every few FPS updates
+constexpr const std::chrono::milliseconds FRAME_PACING_INTERVAL = 1000ms;
 
 #ifdef D3D10_GRAB_SUPPORT
 
@@ -66,17 +70,27 @@ GrabManager::GrabManager(QWidget *parent) : QObject(parent)
 	DEBUG_LOW_LEVEL << Q_FUNC_INFO;
 
 	qRegisterMetaType<GrabResult>("GrabResult");
+	qRegisterMetaType<Grab::FramePacingStats>("Grab::FramePacingStats");
 
 	m_parentWidget = parent;
 
 	m_grabCountLastInterval = 0;
 	m_grabCountThisInterval = 0;
+	m_framePacingTicks = 0;
 
-	m_blueLightClient = nullptr;
+	m_isSyntheticGrabberForced = false;
+	m_syntheticFrameRate = 0;
 
 	m_grabberContext = new GrabberContext();
 
-	m_isSendDataOnlyIfColorsChanged = Settings::isSendDataOnlyIfColorsChanges();
+	m_captureThread = new QThread();
+	m_captureThread->setObjectName(QStringLiteral("CaptureThread"));
+
+	m_grabProcessor = new GrabProcessor(m_grabberContext);
+	m_grabProcessor->moveToThread(m_captureThread);
+	connect(m_grabProcessor, &GrabProcessor::frameAvailable, this, &GrabManager::colorFrameAvailable, Qt::DirectConnection);
+
+	m_captureThread->start(QThread::HighPriority);
 
 	initGrabbers();
 	m_grabber = queryGrabber(Settings::getGrabberType());
@@ -88,17 +102,10 @@ GrabManager::GrabManager(QWidget *parent) : QObject(parent)
 
 	m_timerUpdateFPS->setInterval(FPS_UPDATE_INTERVAL);
 
-	m_timerFakeGrab = new QTimer(this);
-	m_timerFakeGrab->setTimerType(Qt::PreciseTimer);
-	connect(m_timerFakeGrab, &QTimer::timeout, this, &GrabManager::timeoutFakeGrab);
-	m_timerFakeGrab->setSingleShot(false);
-	m_timerFakeGrab->setInterval(FAKE_GRAB_INTERVAL);
-
-	m_isPauseGrabWhileResizeOrMoving = false;
 	m_isGrabWidgetsVisible = false;
 	m_isGrabbingStarted = false;
+	m_isGrabbingSuspendedDueToDeviceError = false;
 
-	initColorLists(MaximumNumberOfLeds::Default);
 	initLedWidgets(MaximumNumberOfLeds::Default);
 
 	int idx = 0;
@@ -111,6 +118,7 @@ GrabManager::GrabManager(QWidget *parent) : QObject(parent)
 
 	connect(qGuiApp, &QGuiApplication::screenAdded, this, &GrabManager::onScreenCountChanged);
 	connect(qGuiApp, &QGuiApplication::screenRemoved, this, &GrabManager::onScreenCountChanged);
+	connect(qGuiApp, &QGuiApplication::primaryScreenChanged, this, &GrabManager::updateDisplayRefreshRate);
 
 	updateScreenGeometry();
 
@@ -125,33 +133,37 @@ GrabManager::~GrabManager()
 	DEBUG_LOW_LEVEL << Q_FUNC_INFO;
 
 	m_grabber = NULL;
-	delete m_timerFakeGrab;
 	delete m_timerUpdateFPS;
 
-	if (m_blueLightClient)
-		delete m_blueLightClient;
-
-	for (int i = 0; i < m_ledWidgets.size(); i++)
-	{
-		delete m_ledWidgets[i];
-	}
-
-	m_ledWidgets.clear();
-
+	// grabbers have to be destroyed in the thread they live in,
+	// deferred deletions are processed when the capture thread finishes
 	for (int i = 0; i < m_grabbers.size(); i++)
 		if (m_grabbers[i]){
 			DEBUG_LOW_LEVEL << "deleting " << m_grabbers[i]->name();
-			delete m_grabbers[i];
+			m_grabbers[i]->deleteLater();
 			m_grabbers[i] = NULL;
 		}
 
 	m_grabbers.clear();
+	m_grabProcessor->deleteLater();
+	m_grabProcessor = NULL;
+
+	m_captureThread->quit();
+	m_captureThread->wait();
+	delete m_captureThread;
 
 #ifdef D3D10_GRAB_SUPPORT
 	delete m_d3d10Grabber;
 	m_d3d10Grabber = NULL;
 #endif
 
+	for (int i = 0; i < m_ledWidgets.size(); i++)
+	{
+		delete m_ledWidgets[i];
+	}
+
+	m_ledWidgets.clear();
+
 	delete m_grabberContext;
 }
 
@@ -159,24 +171,24 @@ void GrabManager::start(bool isGrabEnabled)
 {
 	DEBUG_LOW_LEVEL << Q_FUNC_INFO << isGrabEnabled;
 
-	clearColorsNew();
-
 	m_isGrabbingStarted = isGrabEnabled;
 	if (!isGrabEnabled && m_isGrabbingSuspendedDueToDeviceError) {
 		m_isGrabbingSuspendedDueToDeviceError = false; // Don't restart after device recovery if the user stopped
 	}
 
+	QMetaObject::invokeMethod(m_grabProcessor, "start", Qt::QueuedConnection, Q_ARG(bool, isGrabEnabled));
+
 	if (m_grabber != NULL) {
 		if (isGrabEnabled) {
 			m_timerUpdateFPS->start();
-			m_grabber->startGrabbing();
+			m_framePacingTicks = 0;
+			QMetaObject::invokeMethod(m_grabber, "startGrabbing", Qt::AutoConnection);
 			m_isGrabbingSuspendedDueToDeviceError = false;
 		} else {
-			clearColorsCurrent();
 			m_timerUpdateFPS->stop();
-			m_timerFakeGrab->stop();
-			m_grabber->stopGrabbing();
+			QMetaObject::invokeMethod(m_grabber, "stopGrabbing", Qt::AutoConnection);
 			emit ambilightTimeOfUpdatingColors(0);
+			emit framePacingEvaluated(Grab::FramePacingStats());
 		}
 	}
 }
@@ -204,15 +216,20 @@ void GrabManager::ledDeviceOpenSuccess(bool isSuccess) {
 void GrabManager::onGrabberTypeChanged(const Grab::GrabberType grabberType)
 {
 	DEBUG_LOW_LEVEL << Q_FUNC_INFO << grabberType;
+	if (m_isSyntheticGrabberForced) {
+		qWarning() << Q_FUNC_INFO << "synthetic grabber is forced from the command line, ignoring" << grabberType;
+		return;
+	}
 	QApplication::setOverrideCursor(Qt::WaitCursor);
 
 	bool isStartNeeded = false;
 	if (m_grabber != NULL) {
-		isStartNeeded = m_grabber->isGrabbingStarted();
+		// grabber itself lives in the capture thread, m_isGrabbingStarted mirrors its state
+		isStartNeeded = m_isGrabbingStarted;
 #ifdef D3D10_GRAB_SUPPORT
 		isStartNeeded = isStartNeeded || (m_d3d10Grabber != NULL && m_d3d10Grabber->isGrabbingStarted());
 #endif
-		m_grabber->stopGrabbing();
+		QMetaObject::invokeMethod(m_grabber, "stopGrabbing", Qt::AutoConnection);
 	}
 
 	m_grabber = queryGrabber(grabberType);
@@ -222,9 +239,9 @@ void GrabManager::onGrabberTypeChanged(const Grab::GrabberType grabberType)
 		if (Settings::isDx1011GrabberEnabled())
 			m_d3d10Grabber->startGrabbing();
 		else
-			m_grabber->startGrabbing();
+			QMetaObject::invokeMethod(m_grabber, "startGrabbing", Qt::AutoConnection);
 #else
-		m_grabber->startGrabbing();
+		QMetaObject::invokeMethod(m_grabber, "startGrabbing", Qt::AutoConnection);
 #endif
 	}
 
@@ -237,12 +254,12 @@ void GrabManager::onGrabberStateChangeRequested(bool isStartRequested) {
 	if (grabber != m_grabber) {
 		if (isStartRequested) {
 			if (m_isGrabbingStarted && Settings::isDx1011GrabberEnabled()) {
-				m_grabber->stopGrabbing();
+				QMetaObject::invokeMethod(m_grabber, "stopGrabbing", Qt::AutoConnection);
 				grabber->startGrabbing();
 				grabber->setGrabInterval(Settings::getGrabSlowdown());
 			}
 		} else {
-			m_grabber->startGrabbing();
+			QMetaObject::invokeMethod(m_grabber, "startGrabbing", Qt::AutoConnection);
 			grabber->stopGrabbing();
 		}
 	} else {
@@ -257,7 +274,7 @@ void GrabManager::onGrabSlowdownChanged(int ms)
 {
 	DEBUG_LOW_LEVEL << Q_FUNC_INFO << ms;
 	if (m_grabber)
-		m_grabber->setGrabInterval(ms);
+		QMetaObject::invokeMethod(m_grabber, "setGrabInterval", Qt::AutoConnection, Q_ARG(int, ms));
 	else
 		qWarning() << Q_FUNC_INFO << "trying to change grab slowdown while there is no grabber";
 }
@@ -265,54 +282,137 @@ void GrabManager::onGrabSlowdownChanged(int ms)
 void GrabManager::onGrabAvgColorsEnabledChanged(bool state)
 {
 	DEBUG_LOW_LEVEL << Q_FUNC_INFO << state;
-	m_avgColorsOnAllLeds = state;
+	QMetaObject::invokeMethod(m_grabProcessor, "setAvgColorsEnabled", Qt::QueuedConnection, Q_ARG(bool, state));
 }
 
 void GrabManager::onGrabOverBrightenChanged(int value) {
 	DEBUG_LOW_LEVEL << Q_FUNC_INFO << value;
-	m_overBrighten = value;
+	QMetaObject::invokeMethod(m_grabProcessor, "setOverBrighten", Qt::QueuedConnection, Q_ARG(int, value));
 }
 
 void GrabManager::onGrabApplyBlueLightReductionChanged(bool state)
 {
 	DEBUG_LOW_LEVEL << Q_FUNC_INFO << state;
-	m_isApplyBlueLightReduction = state;
-
-	if (m_isApplyBlueLightReduction && m_blueLightClient == nullptr)
-	{
-		m_blueLightClient = BlueLightReduction::create();
-		if (m_blueLightClient == nullptr)
-			qWarning() << Q_FUNC_INFO << "could not create Blue Light Reduction client";
-	}
-	else if (!m_isApplyBlueLightReduction && m_blueLightClient != nullptr)
-	{
-		delete m_blueLightClient;
-		m_blueLightClient = nullptr;
-	}
+	QMetaObject::invokeMethod(m_grabProcessor, "setApplyBlueLightReduction", Qt::QueuedConnection, Q_ARG(bool, state));
 }
 
 void GrabManager::onGrabApplyColorTemperatureChanged(bool state)
 {
 	DEBUG_LOW_LEVEL << Q_FUNC_INFO << state;
-	m_isApplyColorTemperature = state;
+	QMetaObject::invokeMethod(m_grabProcessor, "setApplyColorTemperature", Qt::QueuedConnection, Q_ARG(bool, state));
 }
 
 void GrabManager::onGrabColorTemperatureChanged(int value)
 {
 	DEBUG_LOW_LEVEL << Q_FUNC_INFO << value;
-	m_colorTemperature = value;
+	QMetaObject::invokeMethod(m_grabProcessor, "setColorTemperature", Qt::QueuedConnection, Q_ARG(int, value));
 }
 
 void GrabManager::onGrabGammaChanged(double gamma)
 {
 	DEBUG_LOW_LEVEL << Q_FUNC_INFO << gamma;
-	m_gamma = gamma;
+	QMetaObject::invokeMethod(m_grabProcessor, "setGamma", Qt::QueuedConnection, Q_ARG(double, gamma));
+}
+
+void GrabManager::onGrabIntegralImageEnabledChanged(bool state)
+{
+	DEBUG_LOW_LEVEL << Q_FUNC_INFO << state;
+	for (GrabberBase *grabber : m_grabbers)
+		if (grabber)
+			QMetaObject::invokeMethod(grabber, "setIntegralImageEnabled", Qt::AutoConnection, Q_ARG(bool, state));
+#ifdef D3D10_GRAB_SUPPORT
+	if (m_d3d10Grabber)
+		m_d3d10Grabber->setIntegralImageEnabled(state);
+#endif
+}
+
+void GrabManager::onGrabSamplingStrideChanged(int value)
+{
+	DEBUG_LOW_LEVEL << Q_FUNC_INFO << value;
+	for (GrabberBase *grabber : m_grabbers)
+		if (grabber)
+			QMetaObject::invokeMethod(grabber, "setSamplingStride", Qt::AutoConnection, Q_ARG(int, value));
+#ifdef D3D10_GRAB_SUPPORT
+	if (m_d3d10Grabber)
+		m_d3d10Grabber->setSamplingStride(value);
+#endif
+}
+
+void GrabManager::onGrabAlignToDisplayRefreshEnabledChanged(bool state)
+{
+	DEBUG_LOW_LEVEL << Q_FUNC_INFO << state;
+	for (GrabberBase *grabber : m_grabbers)
+		if (grabber)
+			QMetaObject::invokeMethod(grabber, "setAlignToDisplayRefreshEnabled", Qt::AutoConnection, Q_ARG(bool, state));
+#ifdef D3D10_GRAB_SUPPORT
+	if (m_d3d10Grabber)
+		m_d3d10Grabber->setAlignToDisplayRefreshEnabled(state);
+#endif
+}
+
+void GrabManager::onGrabDownscaleOnCaptureEnabledChanged(bool state)
+{
+	DEBUG_LOW_LEVEL << Q_FUNC_INFO << state;
+	for (GrabberBase *grabber : m_grabbers)
+		if (grabber)
+			QMetaObject::invokeMethod(grabber, "setDownscaleOnCaptureEnabled", Qt::AutoConnection, Q_ARG(bool, state));
+#ifdef D3D10_GRAB_SUPPORT
+	if (m_d3d10Grabber)
+		m_d3d10Grabber->setDownscaleOnCaptureEnabled(state);
+#endif
+}
+
+void GrabManager::onGrabSyntheticSourceChanged()
+{
+	DEBUG_LOW_LEVEL << Q_FUNC_INFO;
+	if (m_isSyntheticGrabberForced)
+		return;
+	m_syntheticSource = Settings::getGrabSyntheticSource();
+	m_syntheticResolution = Settings::getGrabSyntheticResolution();
+	m_syntheticFrameRate = Settings::getGrabSyntheticFrameRate();
+	updateSyntheticSource();
+}
+
+/*!
+	Grabs from \a SyntheticGrabber for the rest of the session regardless of the profile,
+	used for benchmarks started from the command line
+*/
+void GrabManager::forceSyntheticGrabber(const QString &source, const QSize &resolution, int frameRate)
+{
+	DEBUG_LOW_LEVEL << Q_FUNC_INFO << source << resolution << frameRate;
+	if (m_grabbers[Grab::GrabberTypeSynthetic] == NULL) {
+		qCritical() << Q_FUNC_INFO << "synthetic grabber is not supported by this build";
+		return;
+	}
+
+	onGrabberTypeChanged(Grab::GrabberTypeSynthetic);
+	m_isSyntheticGrabberForced = true;
+	m_syntheticSource = source;
+	m_syntheticResolution = resolution.isEmpty() ? Settings::getGrabSyntheticResolution() : resolution;
+	m_syntheticFrameRate = frameRate;
+	updateSyntheticSource();
+}
+
+void GrabManager::updateSyntheticSource()
+{
+	GrabberBase *grabber = m_grabbers.value(Grab::GrabberTypeSynthetic);
+	// profile is not loaded yet
+	if (grabber == NULL || m_syntheticSource.isEmpty())
+		return;
+
+	QRect desktopRect;
+	for (const QRect &screenRect : m_lastScreenGeometry)
+		desktopRect = desktopRect.united(screenRect);
+
+	QMetaObject::invokeMethod(grabber, "setSource", Qt::AutoConnection,
+		Q_ARG(QString, m_syntheticSource), Q_ARG(QSize, m_syntheticResolution),
+		Q_ARG(int, m_syntheticFrameRate), Q_ARG(QRect, desktopRect));
 }
 
 void GrabManager::onSendDataOnlyIfColorsEnabledChanged(bool state)
 {
 	DEBUG_LOW_LEVEL << Q_FUNC_INFO << state;
-	m_isSendDataOnlyIfColorsChanged = state;
+	QMetaObject::invokeMethod(m_grabProcessor, "setSendDataOnlyIfColorsChanged", Qt::QueuedConnection, Q_ARG(bool, state));
 }
 
 #ifdef D3D10_GRAB_SUPPORT
@@ -333,7 +433,7 @@ void GrabManager::setNumberOfLeds(int numberOfLeds)
 {
 	DEBUG_LOW_LEVEL << Q_FUNC_INFO << numberOfLeds;
 
-	initColorLists(numberOfLeds);
+	QMetaObject::invokeMethod(m_grabProcessor, "setNumberOfLeds", Qt::QueuedConnection, Q_ARG(int, numberOfLeds));
 	initLedWidgets(numberOfLeds);
 
 	for (int i = 0; i < m_ledWidgets.size(); i++)
@@ -341,11 +441,18 @@ void GrabManager::setNumberOfLeds(int numberOfLeds)
 		m_ledWidgets[i]->settingsProfileChanged();
 		m_ledWidgets[i]->setVisible(m_isGrabWidgetsVisible);
 	}
+
+	updateGrabAreas();
 }
 
 void GrabManager::reset()
 {
-	clearColorsCurrent();
+	QMetaObject::invokeMethod(m_grabProcessor, "reset", Qt::QueuedConnection);
+}
+
+ColorFrameSlot * GrabManager::colorFrameSlot()
+{
+	return m_grabProcessor->frameSlot();
 }
 
 void GrabManager::settingsProfileChanged(const QString &profileName)
@@ -353,13 +460,18 @@ void GrabManager::settingsProfileChanged(const QString &profileName)
 	DEBUG_LOW_LEVEL << Q_FUNC_INFO;
 	Q_UNUSED(profileName)
 
-	m_isSendDataOnlyIfColorsChanged = Settings::isSendDataOnlyIfColorsChanges();
-	m_avgColorsOnAllLeds = Settings::isGrabAvgColorsEnabled();
-	m_overBrighten = Settings::getGrabOverBrighten();
-	m_isApplyBlueLightReduction = Settings::isGrabApplyBlueLightReductionEnabled();
-	m_isApplyColorTemperature = Settings::isGrabApplyColorTemperatureEnabled();
-	m_colorTemperature = Settings::getGrabColorTemperature();
-	m_gamma = Settings::getGrabGamma();
+	onSendDataOnlyIfColorsEnabledChanged(Settings::isSendDataOnlyIfColorsChanges());
+	onGrabAvgColorsEnabledChanged(Settings::isGrabAvgColorsEnabled());
+	onGrabOverBrightenChanged(Settings::getGrabOverBrighten());
+	onGrabApplyBlueLightReductionChanged(Settings::isGrabApplyBlueLightReductionEnabled());
+	onGrabApplyColorTemperatureChanged(Settings::isGrabApplyColorTemperatureEnabled());
+	onGrabColorTemperatureChanged(Settings::getGrabColorTemperature());
+	onGrabGammaChanged(Settings::getGrabGamma());
+	onGrabIntegralImageEnabledChanged(Settings::isGrabIntegralImageEnabled());
+	onGrabSamplingStrideChanged(Settings::getGrabSamplingStride());
+	onGrabAlignToDisplayRefreshEnabledChanged(Settings::isGrabAlignToDisplayRefreshEnabled());
+	onGrabDownscaleOnCaptureEnabledChanged(Settings::isGrabDownscaleOnCaptureEnabled());
+	onGrabSyntheticSourceChanged();
 
 	setNumberOfLeds(Settings::getNumberOfLeds(Settings::getConnectedDevice()));
 }
@@ -405,129 +517,53 @@ void GrabManager::setWhiteLedWidgets(bool state)
 	}
 }
 
-void GrabManager::handleGrabbedColors()
-{
-	DEBUG_HIGH_LEVEL << Q_FUNC_INFO;
-
-	if (m_grabber == NULL)
-	{
-		qCritical() << Q_FUNC_INFO << "m_grabber == NULL";
-		return;
-	}
-
-	// Temporary switch off updating colors
-	// if one of LED widgets resizing or moving
-	if (m_isPauseGrabWhileResizeOrMoving)
-	{
-		return;
-	}
-
-	// Work on a copy
-	m_colorsProcessing = m_colorsNew;
-
-	bool isColorsChanged = false;
-
-	int avgR = 0, avgG = 0, avgB = 0;
-	int countGrabEnabled = 0;
-
-	if (m_isApplyColorTemperature)
-	{
-		PrismatikMath::applyColorTemperature(m_colorsProcessing, m_colorTemperature, m_gamma);
-	}
-	else if (m_isApplyBlueLightReduction && m_blueLightClient)
-		m_blueLightClient->apply(m_colorsProcessing, SettingsScope::Profile::Grab::GammaDefault);
-
-	if (m_avgColorsOnAllLeds)
-	{
-		for (int i = 0; i < m_ledWidgets.size(); i++)
-		{
-			if (m_ledWidgets[i]->isAreaEnabled())
-			{
-				avgR += qRed(m_colorsProcessing[i]);
-				avgG += qGreen(m_colorsProcessing[i]);
-				avgB += qBlue(m_colorsProcessing[i]);
-				countGrabEnabled++;
-			}
-		}
-		if (countGrabEnabled != 0)
-		{
-			avgR /= countGrabEnabled;
-			avgG /= countGrabEnabled;
-			avgB /= countGrabEnabled;
-		}
-		// Set one AVG color to all LEDs
-		for (int ledIndex = 0; ledIndex < m_ledWidgets.size(); ledIndex++)
-		{
-			if (m_ledWidgets[ledIndex]->isAreaEnabled())
-			{
-				m_colorsProcessing[ledIndex] = qRgb(avgR, avgG, avgB);
-			}
-		}
-	}
-
-	for (int i = 0; i < m_ledWidgets.size(); i++)
-	{
-		QRgb newColor = m_colorsProcessing[i];
-		if (m_overBrighten) {
-			int dRed = qRed(newColor);
-			int dGreen = qGreen(newColor);
-			int dBlue = qBlue(newColor);
-			int highest = qMax(dRed, qMax(dGreen, dBlue));
-			double scaleFactor = qMin((100 + 5 * m_overBrighten) / 100.0, 255.0 / highest);
-			newColor = qRgb(dRed * scaleFactor, dGreen * scaleFactor, dBlue * scaleFactor);
-		}
-
-		if (m_colorsCurrent[i] != newColor)
-		{
-			m_colorsCurrent[i] = newColor;
-			isColorsChanged = true;
-		}
-	}
-
-	if ((m_isSendDataOnlyIfColorsChanged == false) || isColorsChanged)
-	{
-		emit updateLedsColors(m_colorsCurrent);
-	}
-
-	m_grabCountThisInterval++;
-
-	if (m_isSendDataOnlyIfColorsChanged == false)
-	{
-		m_timerFakeGrab->start();
-	}
-}
-
-void GrabManager::timeoutFakeGrab()
-{
-	if (m_isSendDataOnlyIfColorsChanged == false && m_isGrabbingStarted)
-	{
-		emit updateLedsColors(m_colorsCurrent);
-	}
-	else
-	{
-		m_timerFakeGrab->stop();
-	}
-}
-
 void GrabManager::timeoutUpdateFPS()
 {
 	DEBUG_HIGH_LEVEL << Q_FUNC_INFO;
+	m_grabCountThisInterval = m_grabProcessor->takeProcessedFramesCount();
 	emit ambilightTimeOfUpdatingColors((2.0 * FPS_UPDATE_INTERVAL.count()) / (m_grabCountLastInterval + m_grabCountThisInterval));
 
 	m_grabCountLastInterval = m_grabCountThisInterval;
 	m_grabCountThisInterval = 0;
+
+	if (++m_framePacingTicks < FRAME_PACING_INTERVAL / FPS_UPDATE_INTERVAL)
+		return;
+	m_framePacingTicks = 0;
+
+	GrabberBase *grabber = m_grabber;
+#ifdef D3D10_GRAB_SUPPORT
+	if (m_d3d10Grabber != NULL && m_d3d10Grabber->isGrabbingStarted())
+		grabber = m_d3d10Grabber;
+#endif
+	if (grabber != NULL)
+		emit framePacingEvaluated(grabber->takeFramePacingStats());
 }
 
 void GrabManager::pauseWhileResizeOrMoving()
 {
 	DEBUG_MID_LEVEL << Q_FUNC_INFO;
-	m_isPauseGrabWhileResizeOrMoving = true;
+	QMetaObject::invokeMethod(m_grabProcessor, "setPaused", Qt::QueuedConnection, Q_ARG(bool, true));
 }
 
 void GrabManager::resumeAfterResizeOrMoving()
 {
 	DEBUG_MID_LEVEL << Q_FUNC_INFO;
-	m_isPauseGrabWhileResizeOrMoving = false;
+	updateGrabAreas();
+	QMetaObject::invokeMethod(m_grabProcessor, "setPaused", Qt::QueuedConnection, Q_ARG(bool, false));
+}
+
+void GrabManager::updateGrabAreas()
+{
+	DEBUG_MID_LEVEL << Q_FUNC_INFO;
+	QList<GrabbedArea> grabAreas;
+	grabAreas.reserve(m_ledWidgets.size());
+	for (const GrabWidget *widget : m_ledWidgets) {
+		GrabbedArea area;
+		area.rect = widget->frameGeometry();
+		area.isEnabled = widget->isAreaEnabled();
+		grabAreas.append(area);
+	}
+	m_grabberContext->setGrabAreas(grabAreas);
 }
 
 void GrabManager::updateScreenGeometry()
@@ -540,6 +576,8 @@ void GrabManager::updateScreenGeometry()
 	}
 
 	emit changeScreen();
+	updateSyntheticSource();
+	updateDisplayRefreshRate();
 	if (m_grabber == NULL)
 	{
 		qCritical() << Q_FUNC_INFO << "m_grabber == NULL";
@@ -548,6 +586,24 @@ void GrabManager::updateScreenGeometry()
 
 }
 
+/*!
+	Frame pacer of the grabbers can snap its interval to the refresh period of the primary screen
+*/
+void GrabManager::updateDisplayRefreshRate()
+{
+	const QScreen *screen = QGuiApplication::primaryScreen();
+	const double hz = screen ? screen->refreshRate() : 0.0;
+	DEBUG_LOW_LEVEL << Q_FUNC_INFO << hz;
+
+	for (GrabberBase *grabber : m_grabbers)
+		if (grabber)
+			QMetaObject::invokeMethod(grabber, "setDisplayRefreshRate", Qt::AutoConnection, Q_ARG(double, hz));
+#ifdef D3D10_GRAB_SUPPORT
+	if (m_d3d10Grabber)
+		m_d3d10Grabber->setDisplayRefreshRate(hz);
+#endif
+}
+
 void GrabManager::onScreenCountChanged(QScreen* screen)
 {
 	Q_UNUSED(screen)
@@ -615,15 +671,14 @@ void GrabManager::scaleLedWidgets(const int screenIndexResized, const QRect& scr
 	}
 
 	m_lastScreenGeometry[screenIndexResized] = screenGeometry;
+
+	updateGrabAreas();
 }
 
 void GrabManager::initGrabbers()
 {
 	DEBUG_LOW_LEVEL << Q_FUNC_INFO;
 
-	m_grabberContext->grabWidgets = &m_ledWidgets;
-	m_grabberContext->grabResult = &m_colorsNew;
-
 	for (int i = 0; i < Grab::GrabbersCount; i++)
 		m_grabbers.append(NULL);
 
@@ -641,6 +696,14 @@ void GrabManager::initGrabbers()
 	m_grabbers[Grab::GrabberTypeX11] = initGrabber(new X11Grabber(NULL, m_grabberContext));
 #endif
 
+#ifdef PIPEWIRE_GRAB_SUPPORT
+	m_grabbers[Grab::GrabberTypePipeWire] = initGrabber(new PipeWireGrabber(NULL, m_grabberContext));
+#endif
+
+#ifdef SYNTHETIC_GRAB_SUPPORT
+	m_grabbers[Grab::GrabberTypeSynthetic] = initGrabber(new SyntheticGrabber(NULL, m_grabberContext));
+#endif
+
 #ifdef MAC_OS_CG_GRAB_SUPPORT
 	m_grabbers[Grab::GrabberTypeMacCoreGraphics] = initGrabber(new MacOSCGGrabber(NULL, m_grabberContext));
 #endif
@@ -659,11 +722,31 @@ void GrabManager::initGrabbers()
 }
 
 GrabberBase *GrabManager::initGrabber(GrabberBase * grabber) {
-	QMetaObject::invokeMethod(grabber, "setGrabInterval", Qt::QueuedConnection, Q_ARG(int, Settings::getGrabSlowdown()));
-	bool isConnected = connect(grabber, &GrabberBase::frameGrabAttempted, this, &GrabManager::onFrameGrabAttempted, Qt::QueuedConnection);
-	Q_ASSERT_X(isConnected, "connecting grabber to grabManager", "failed");
+	grabber->setIntegralImageEnabled(Settings::isGrabIntegralImageEnabled());
+	grabber->setSamplingStride(Settings::getGrabSamplingStride());
+	grabber->setAlignToDisplayRefreshEnabled(Settings::isGrabAlignToDisplayRefreshEnabled());
+	grabber->setDownscaleOnCaptureEnabled(Settings::isGrabDownscaleOnCaptureEnabled());
+	if (const QScreen *screen = QGuiApplication::primaryScreen())
+		grabber->setDisplayRefreshRate(screen->refreshRate());
+
+	bool isConnected;
+#ifdef D3D10_GRAB_SUPPORT
+	// D3D10Grabber is driven by its own injector and worker threads and shows message boxes,
+	// so it stays in the GUI thread. Block until the frame is processed, it shares grabResult
+	// with the capture thread.
+	if (qobject_cast<D3D10Grabber *>(grabber)) {
+		isConnected = connect(grabber, &GrabberBase::frameGrabAttempted, m_grabProcessor, &GrabProcessor::onFrameGrabAttempted, Qt::BlockingQueuedConnection);
+	} else
+#endif
+	{
+		grabber->moveToThread(m_captureThread);
+		isConnected = connect(grabber, &GrabberBase::frameGrabAttempted, m_grabProcessor, &GrabProcessor::onFrameGrabAttempted, Qt::DirectConnection);
+	}
+	Q_ASSERT_X(isConnected, "connecting grabber to grabProcessor", "failed");
 	Q_UNUSED(isConnected);
 
+	QMetaObject::invokeMethod(grabber, "setGrabInterval", Qt::QueuedConnection, Q_ARG(int, Settings::getGrabSlowdown()));
+
 	return grabber;
 }
 
@@ -698,51 +781,11 @@ GrabberBase *GrabManager::queryGrabber(Grab::GrabberType grabberType)
 		result = m_grabbers[Grab::GrabberTypeQt];
 	}
 
-	result->setGrabInterval(Settings::getGrabSlowdown());
+	QMetaObject::invokeMethod(result, "setGrabInterval", Qt::AutoConnection, Q_ARG(int, Settings::getGrabSlowdown()));
 
 	return result;
 }
 
-void GrabManager::onFrameGrabAttempted(GrabResult grabResult) {
-	if (grabResult == GrabResultOk) {
-		handleGrabbedColors();
-	}
-}
-
-void GrabManager::initColorLists(int numberOfLeds)
-{
-	DEBUG_LOW_LEVEL << Q_FUNC_INFO << numberOfLeds;
-
-	m_colorsCurrent.clear();
-	m_colorsNew.clear();
-
-	for (int i = 0; i < numberOfLeds; i++)
-	{
-		m_colorsCurrent << 0;
-		m_colorsNew		<< 0;
-	}
-}
-
-void GrabManager::clearColorsNew()
-{
-	DEBUG_MID_LEVEL << Q_FUNC_INFO;
-
-	for (int i = 0; i < m_colorsNew.size(); i++)
-	{
-		m_colorsNew[i] = 0;
-	}
-}
-
-void GrabManager::clearColorsCurrent()
-{
-	DEBUG_MID_LEVEL << Q_FUNC_INFO;
-
-	for (int i = 0; i < m_colorsCurrent.size(); i++)
-	{
-		m_colorsCurrent[i] = 0;
-	}
-}
-
 void GrabManager::initLedWidgets(int numberOfLeds)
 {
 	DEBUG_LOW_LEVEL << Q_FUNC_INFO << numberOfLeds;
@@ -760,6 +803,7 @@ void GrabManager::initLedWidgets(int numberOfLeds)
 
 		connect(ledWidget, &GrabWidget::resizeOrMoveStarted, this, &GrabManager::pauseWhileResizeOrMoving);
 		connect(ledWidget, &GrabWidget::resizeOrMoveCompleted, this, &GrabManager::resumeAfterResizeOrMoving);
+		connect(ledWidget, &GrabWidget::areaEnabledChanged, this, &GrabManager::updateGrabAreas);
 
 // TODO: Check out this line!
 //			First LED widget using to determine grabbing-monitor in WinAPI version of Grab
@@ -782,6 +826,7 @@ void GrabManager::initLedWidgets(int numberOfLeds)
 
 			connect(ledWidget, &GrabWidget::resizeOrMoveStarted, this, &GrabManager::pauseWhileResizeOrMoving);
 			connect(ledWidget, &GrabWidget::resizeOrMoveCompleted, this, &GrabManager::resumeAfterResizeOrMoving);
+			connect(ledWidget, &GrabWidget::areaEnabledChanged, this, &GrabManager::updateGrabAreas);
 
 			m_ledWidgets << ledWidget;
 		}
@@ -31,11 +31,12 @@
 #include "enums.hpp"
 
 class GrabberContext;
+class GrabProcessor;
+class GrabWidget;
+class ColorFrameSlot;
 class TimeEvaluations;
 class D3D10Grabber;
 
-namespace BlueLightReduction { class Client; };
-
 class GrabManager : public QObject
 {
 	Q_OBJECT
@@ -45,8 +46,15 @@ public:
 	virtual ~GrabManager();
 
 signals:
-	void updateLedsColors(const QList<QRgb> & colors);
+	/*!
+		A new frame is published to \a colorFrameSlot(). Emitted from the capture thread.
+	*/
+	void colorFrameAvailable();
 	void ambilightTimeOfUpdatingColors(double ms);
+	/*!
+		Frame timing of the last second, emitted once a second while grabbing
+	*/
+	void framePacingEvaluated(const Grab::FramePacingStats &stats);
 	void changeScreen();
 	void onSessionChange(int change);
 
@@ -58,6 +66,13 @@ public:
 	void setNumberOfLeds(int numberOfLeds);
 	void reset();
 
+	/*!
+		Latest processed frame, taken by \a LedDeviceManager when \a colorFrameAvailable() is emitted
+	*/
+	ColorFrameSlot * colorFrameSlot();
+
+	void forceSyntheticGrabber(const QString &source, const QSize &resolution, int frameRate);
+
 public slots:
 	void onGrabberTypeChanged(const Grab::GrabberType grabberType);
 	void onGrabSlowdownChanged(int ms);
@@ -67,6 +82,11 @@ public slots:
 	void onGrabApplyColorTemperatureChanged(bool state);
 	void onGrabColorTemperatureChanged(int value);
 	void onGrabGammaChanged(double value);
+	void onGrabIntegralImageEnabledChanged(bool state);
+	void onGrabSamplingStrideChanged(int value);
+	void onGrabAlignToDisplayRefreshEnabledChanged(bool state);
+	void onGrabDownscaleOnCaptureEnabledChanged(bool state);
+	void onGrabSyntheticSourceChanged();
 	void onSendDataOnlyIfColorsEnabledChanged(bool state);
 #ifdef D3D10_GRAB_SUPPORT
 	void onDx1011GrabberEnabledChanged(bool state);
@@ -82,12 +102,11 @@ public slots:
 	void onGrabberStateChangeRequested(bool isStartRequested);
 
 private slots:
-	void handleGrabbedColors();
-	void timeoutFakeGrab();
 	void timeoutUpdateFPS();
 	void pauseWhileResizeOrMoving();
 	void resumeAfterResizeOrMoving();
-	void onFrameGrabAttempted(GrabResult result);
+	void updateGrabAreas();
+	void updateDisplayRefreshRate();
 	void updateScreenGeometry();
 	void onScreenCountChanged(QScreen* screen);
 
@@ -99,10 +118,8 @@ private:
 #ifdef D3D10_GRAB_SUPPORT
 	void reinitDx1011Grabber();
 #endif
-	void initColorLists(int numberOfLeds);
-	void clearColorsNew();
-	void clearColorsCurrent();
 	void initLedWidgets(int numberOfLeds);
+	void updateSyntheticSource();
 
 private:
 	QList<GrabberBase*> m_grabbers;
@@ -113,36 +130,29 @@ private:
 	D3D10Grabber *m_d3d10Grabber;
 #endif
 
-	BlueLightReduction::Client* m_blueLightClient;
+	QThread *m_captureThread;
+	GrabProcessor *m_grabProcessor;
 
 	QTimer *m_timerUpdateFPS;
-	QTimer *m_timerFakeGrab;
 	QWidget *m_parentWidget;
 	QList<GrabWidget *> m_ledWidgets;
-	QList<QRgb> m_grabResult;
 	const static QColor m_backgroundAndTextColors[10][2];
 
-	QList<QRgb> m_colorsCurrent;
-	QList<QRgb> m_colorsNew;
-	QList<QRgb> m_colorsProcessing;
-
 	QRect m_screenSavedRect;
 	int m_screenSavedIndex;
 
-	bool m_isPauseGrabWhileResizeOrMoving;
-	bool m_isSendDataOnlyIfColorsChanged;
-	bool m_avgColorsOnAllLeds;
 	bool m_isGrabbingStarted;
 	bool m_isGrabbingSuspendedDueToDeviceError;
-	int m_overBrighten;
-	bool m_isApplyBlueLightReduction;
-	bool m_isApplyColorTemperature;
-	double m_gamma;
-	int m_colorTemperature;
 
 	int m_grabCountThisInterval;
 	int m_grabCountLastInterval;
+	int m_framePacingTicks; // FPS updates since the pacing stats were taken
 
 	bool m_isGrabWidgetsVisible;
 	GrabberContext * m_grabberContext;
+
+	bool m_isSyntheticGrabberForced;
+	QString m_syntheticSource;
+	QSize m_syntheticResolution;
+	int m_syntheticFrameRate;
 };
@@ -0,0 +1,318 @@
+/*
+ * GrabProcessor.cpp
+ *
+ *	Created on: 18.10.2026
+ *		Project: Prismatik
+ *
+ *	Prismatik is a free, open-source software: you can redistribute it and/or
+ *	modify it under the terms of the GNU General Public License as published
+ *	by the Free Software Foundation, either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	Prismatik and Lightpack files is distributed in the hope that it will be
+ *	useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.	See the GNU
+ *	General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with this program.	If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <algorithm>
+#include <QTimer>
+
+#include "debug.h"
+#include "PrismatikMath.hpp"
+#include "SettingsDefaults.hpp"
+#include "GrabberContext.hpp"
+#include "BlueLightReduction.hpp"
+#include "GrabProcessor.hpp"
+
+using namespace std::chrono_literals;
+constexpr const std::chrono::milliseconds FAKE_GRAB_INTERVAL = 900ms;
+
+namespace
+{
+	qint64 toTimestamp(std::chrono::steady_clock::time_point time)
+	{
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count();
+	}
+}
+
+GrabProcessor::GrabProcessor(GrabberContext *grabberContext, QObject *parent)
+	: QObject(parent)
+	, m_grabberContext(grabberContext)
+	, m_processedFramesCount(0)
+	, m_blueLightClient(nullptr)
+	, m_frameSequence(0)
+	, m_grabStartedTimestamp(0)
+	, m_grabFinishedTimestamp(0)
+	, m_isGrabbingStarted(false)
+	, m_isPaused(false)
+	, m_isSendDataOnlyIfColorsChanged(true)
+	, m_avgColorsOnAllLeds(false)
+	, m_overBrighten(0)
+	, m_isApplyBlueLightReduction(false)
+	, m_isApplyColorTemperature(false)
+	, m_gamma(SettingsScope::Profile::Grab::GammaDefault)
+	, m_colorTemperature(SettingsScope::Profile::Grab::ColorTemperatureDefault)
+{
+	DEBUG_LOW_LEVEL << Q_FUNC_INFO;
+
+	// grabbers write straight into the processor's input list, both live in the capture thread
+	m_grabberContext->grabResult = &m_colorsNew;
+
+	m_timerFakeGrab = new QTimer(this);
+	m_timerFakeGrab->setTimerType(Qt::PreciseTimer);
+	connect(m_timerFakeGrab, &QTimer::timeout, this, &GrabProcessor::timeoutFakeGrab);
+	m_timerFakeGrab->setSingleShot(false);
+	m_timerFakeGrab->setInterval(FAKE_GRAB_INTERVAL);
+}
+
+GrabProcessor::~GrabProcessor()
+{
+	DEBUG_LOW_LEVEL << Q_FUNC_INFO;
+
+	if (m_blueLightClient)
+		delete m_blueLightClient;
+}
+
+void GrabProcessor::start(bool isGrabEnabled)
+{
+	DEBUG_LOW_LEVEL << Q_FUNC_INFO << isGrabEnabled;
+
+	m_isGrabbingStarted = isGrabEnabled;
+	clearColorsNew();
+
+	if (!isGrabEnabled) {
+		clearColorsCurrent();
+		m_timerFakeGrab->stop();
+	}
+}
+
+void GrabProcessor::reset()
+{
+	clearColorsCurrent();
+}
+
+void GrabProcessor::setNumberOfLeds(int numberOfLeds)
+{
+	DEBUG_LOW_LEVEL << Q_FUNC_INFO << numberOfLeds;
+
+	m_colorsCurrent.clear();
+	m_colorsNew.clear();
+
+	for (int i = 0; i < numberOfLeds; i++)
+	{
+		m_colorsCurrent << 0;
+		m_colorsNew		<< 0;
+	}
+}
+
+void GrabProcessor::setPaused(bool isPaused)
+{
+	DEBUG_MID_LEVEL << Q_FUNC_INFO << isPaused;
+	m_isPaused = isPaused;
+}
+
+void GrabProcessor::setAvgColorsEnabled(bool state)
+{
+	m_avgColorsOnAllLeds = state;
+}
+
+void GrabProcessor::setOverBrighten(int value)
+{
+	m_overBrighten = value;
+}
+
+void GrabProcessor::setApplyBlueLightReduction(bool state)
+{
+	m_isApplyBlueLightReduction = state;
+
+	if (m_isApplyBlueLightReduction && m_blueLightClient == nullptr)
+	{
+		m_blueLightClient = BlueLightReduction::create();
+		if (m_blueLightClient == nullptr)
+			qWarning() << Q_FUNC_INFO << "could not create Blue Light Reduction client";
+	}
+	else if (!m_isApplyBlueLightReduction && m_blueLightClient != nullptr)
+	{
+		delete m_blueLightClient;
+		m_blueLightClient = nullptr;
+	}
+}
+
+void GrabProcessor::setApplyColorTemperature(bool state)
+{
+	m_isApplyColorTemperature = state;
+}
+
+void GrabProcessor::setColorTemperature(int value)
+{
+	m_colorTemperature = value;
+}
+
+void GrabProcessor::setGamma(double value)
+{
+	m_gamma = value;
+}
+
+void GrabProcessor::setSendDataOnlyIfColorsChanged(bool state)
+{
+	m_isSendDataOnlyIfColorsChanged = state;
+}
+
+void GrabProcessor::onFrameGrabAttempted(GrabResult grabResult)
+{
+	if (grabResult == GrabResultOk) {
+		handleGrabbedColors();
+	}
+}
+
+void GrabProcessor::handleGrabbedColors()
+{
+	DEBUG_HIGH_LEVEL << Q_FUNC_INFO;
+
+	// Temporary switch off updating colors
+	// if one of LED widgets resizing or moving
+	if (m_isPaused || !m_isGrabbingStarted)
+	{
+		return;
+	}
+
+	m_grabStartedTimestamp = toTimestamp(m_grabberContext->grabStarted);
+	m_grabFinishedTimestamp = toTimestamp(m_grabberContext->grabFinished);
+
+	// Work on a copy, element by element so that neither list detaches from the other
+	if (m_colorsProcessing.size() != m_colorsNew.size()) {
+		m_colorsProcessing.clear();
+		m_colorsProcessing.reserve(m_colorsNew.size());
+		for (const QRgb color : m_colorsNew)
+			m_colorsProcessing.append(color);
+	} else {
+		std::copy(m_colorsNew.cbegin(), m_colorsNew.cend(), m_colorsProcessing.begin());
+	}
+
+	const QList<GrabbedArea> grabAreas = m_grabberContext->grabAreas();
+	const int ledsCount = qMin(qMin(m_colorsProcessing.size(), m_colorsCurrent.size()), grabAreas.size());
+
+	bool isColorsChanged = false;
+
+	int avgR = 0, avgG = 0, avgB = 0;
+	int countGrabEnabled = 0;
+
+	if (m_isApplyColorTemperature)
+	{
+		PrismatikMath::applyColorTemperature(m_colorsProcessing, m_colorTemperature, m_gamma);
+	}
+	else if (m_isApplyBlueLightReduction && m_blueLightClient)
+		m_blueLightClient->apply(m_colorsProcessing, SettingsScope::Profile::Grab::GammaDefault);
+
+	if (m_avgColorsOnAllLeds)
+	{
+		for (int i = 0; i < ledsCount; i++)
+		{
+			if (grabAreas[i].isEnabled)
+			{
+				avgR += qRed(m_colorsProcessing[i]);
+				avgG += qGreen(m_colorsProcessing[i]);
+				avgB += qBlue(m_colorsProcessing[i]);
+				countGrabEnabled++;
+			}
+		}
+		if (countGrabEnabled != 0)
+		{
+			avgR /= countGrabEnabled;
+			avgG /= countGrabEnabled;
+			avgB /= countGrabEnabled;
+		}
+		// Set one AVG color to all LEDs
+		for (int ledIndex = 0; ledIndex < ledsCount; ledIndex++)
+		{
+			if (grabAreas[ledIndex].isEnabled)
+			{
+				m_colorsProcessing[ledIndex] = qRgb(avgR, avgG, avgB);
+			}
+		}
+	}
+
+	for (int i = 0; i < ledsCount; i++)
+	{
+		QRgb newColor = m_colorsProcessing[i];
+		if (m_overBrighten) {
+			int dRed = qRed(newColor);
+			int dGreen = qGreen(newColor);
+			int dBlue = qBlue(newColor);
+			int highest = qMax(dRed, qMax(dGreen, dBlue));
+			double scaleFactor = qMin((100 + 5 * m_overBrighten) / 100.0, 255.0 / highest);
+			newColor = qRgb(dRed * scaleFactor, dGreen * scaleFactor, dBlue * scaleFactor);
+		}
+
+		if (m_colorsCurrent[i] != newColor)
+		{
+			m_colorsCurrent[i] = newColor;
+			isColorsChanged = true;
+		}
+	}
+
+	if ((m_isSendDataOnlyIfColorsChanged == false) || isColorsChanged)
+	{
+		publishColors();
+	}
+
+	m_processedFramesCount++;
+
+	if (m_isSendDataOnlyIfColorsChanged == false)
+	{
+		m_timerFakeGrab->start();
+	}
+}
+
+void GrabProcessor::publishColors()
+{
+	ColorFrame frame(m_colorsCurrent);
+	frame.setSequence(++m_frameSequence);
+	if (m_grabStartedTimestamp != 0) {
+		frame.setStageTimestamp(ColorFrame::StageGrabStarted, m_grabStartedTimestamp);
+		frame.setStageTimestamp(ColorFrame::StageGrabFinished, m_grabFinishedTimestamp);
+		frame.setStageTimestamp(ColorFrame::StageProcessed, ColorFrame::timestamp());
+	}
+	m_frameSlot.writeBuffer() = std::move(frame);
+	if (m_frameSlot.publish())
+		emit frameAvailable();
+}
+
+void GrabProcessor::timeoutFakeGrab()
+{
+	if (m_isSendDataOnlyIfColorsChanged == false && m_isGrabbingStarted)
+	{
+		// colors sent again aren't a new capture, keep them out of the latency stats
+		m_grabStartedTimestamp = 0;
+		publishColors();
+	}
+	else
+	{
+		m_timerFakeGrab->stop();
+	}
+}
+
+void GrabProcessor::clearColorsNew()
+{
+	DEBUG_MID_LEVEL << Q_FUNC_INFO;
+
+	for (int i = 0; i < m_colorsNew.size(); i++)
+	{
+		m_colorsNew[i] = 0;
+	}
+}
+
+void GrabProcessor::clearColorsCurrent()
+{
+	DEBUG_MID_LEVEL << Q_FUNC_INFO;
+
+	for (int i = 0; i < m_colorsCurrent.size(); i++)
+	{
+		m_colorsCurrent[i] = 0;
+	}
+}
@@ -0,0 +1,112 @@
+/*
+ * GrabProcessor.hpp
+ *
+ *	Created on: 18.10.2026
+ *		Project: Prismatik
+ *
+ *	Prismatik is a free, open-source software: you can redistribute it and/or
+ *	modify it under the terms of the GNU General Public License as published
+ *	by the Free Software Foundation, either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	Prismatik and Lightpack files is distributed in the hope that it will be
+ *	useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.	See the GNU
+ *	General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with this program.	If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+
+#include <atomic>
+#include <QObject>
+#include <QList>
+#include <QRgb>
+
+#include "GrabberBase.hpp"
+#include "ColorFrameSlot.hpp"
+
+class QTimer;
+class GrabberContext;
+
+namespace BlueLightReduction { class Client; };
+
+/*!
+	Post-processes grabbed colors (color temperature, blue light reduction, average color,
+	over-brighten) and publishes finished frames to \a ColorFrameSlot. Lives in the capture
+	thread together with the grabbers, \a GrabManager talks to it through queued calls only.
+*/
+class GrabProcessor : public QObject
+{
+	Q_OBJECT
+
+public:
+	GrabProcessor(GrabberContext *grabberContext, QObject *parent = 0);
+	virtual ~GrabProcessor();
+
+	ColorFrameSlot * frameSlot() { return &m_frameSlot; }
+
+	/*!
+		Number of processed frames since the previous call, safe to call from any thread
+	*/
+	int takeProcessedFramesCount() { return m_processedFramesCount.exchange(0); }
+
+signals:
+	/*!
+		Emitted when the consumer has taken the previous frame and a new one is published.
+		Frames published while the consumer is busy replace each other without a signal.
+	*/
+	void frameAvailable();
+
+public slots:
+	void start(bool isGrabEnabled);
+	void reset();
+	void setNumberOfLeds(int numberOfLeds);
+	void setPaused(bool isPaused);
+	void setAvgColorsEnabled(bool state);
+	void setOverBrighten(int value);
+	void setApplyBlueLightReduction(bool state);
+	void setApplyColorTemperature(bool state);
+	void setColorTemperature(int value);
+	void setGamma(double value);
+	void setSendDataOnlyIfColorsChanged(bool state);
+	void onFrameGrabAttempted(GrabResult grabResult);
+
+private slots:
+	void timeoutFakeGrab();
+
+private:
+	void handleGrabbedColors();
+	void publishColors();
+	void clearColorsNew();
+	void clearColorsCurrent();
+
+private:
+	GrabberContext *m_grabberContext;
+	ColorFrameSlot m_frameSlot;
+	std::atomic<int> m_processedFramesCount;
+
+	BlueLightReduction::Client* m_blueLightClient;
+	QTimer *m_timerFakeGrab;
+
+	QList<QRgb> m_colorsNew;
+	QList<QRgb> m_colorsCurrent;
+	QList<QRgb> m_colorsProcessing;
+	quint64 m_frameSequence;
+	// ColorFrame::timestamp() of the grab of the colors in m_colorsCurrent, 0 if they aren't fresh
+	qint64 m_grabStartedTimestamp;
+	qint64 m_grabFinishedTimestamp;
+
+	bool m_isGrabbingStarted;
+	bool m_isPaused;
+	bool m_isSendDataOnlyIfColorsChanged;
+	bool m_avgColorsOnAllLeds;
+	int m_overBrighten;
+	bool m_isApplyBlueLightReduction;
+	bool m_isApplyColorTemperature;
+	double m_gamma;
+	int m_colorTemperature;
+};
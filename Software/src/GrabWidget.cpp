@@ -770,6 +770,8 @@ void GrabWidget::onIsAreaEnabled_Toggled(const bool state)
 	}
 	setBackgroundColor(m_backgroundColor);
 	setTextColor(m_textColor);
+
+	emit areaEnabledChanged(m_selfId, state);
 }
 
 void GrabWidget::onOpenConfigButton_Clicked()
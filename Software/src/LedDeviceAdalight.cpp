@@ -30,6 +30,8 @@
 #include "debug.h"
 #include "stdio.h"
 #include <QtSerialPort/QSerialPortInfo>
+#include <algorithm>
+#include <cmath>
 
 using namespace SettingsScope;
 
@@ -79,7 +81,7 @@ void LedDeviceAdalight::close()
 	m_AdalightDevice = NULL;
 }
 
-static double getUpdatedValue(double from, double to, double step)
+static float getUpdatedValue(float from, float to, float step)
 {
     if(from < to)
     {
@@ -103,18 +105,17 @@ static double getUpdatedValue(double from, double to, double step)
 
 void LedDeviceAdalight::updateSmoothColors()
 {
-    for(int i = 0; i < currColors.size(); i++)
+    // calculate updated intermediate colors in Lab color space for a pleasent blending of colors
+    const size_t count = std::min(labCur.size(), labTarget.size());
+    for(size_t i = 0; i < count; i++)
     {
-        // calculate updated intermediate color in Lab color space for a pleasent blending of colors
-        labCur[i].l = getUpdatedValue(labCur[i].l, labTarget[i].l, step_sizes[i][0]);
-        labCur[i].a = getUpdatedValue(labCur[i].a, labTarget[i].a, step_sizes[i][1]);
-        labCur[i].b = getUpdatedValue(labCur[i].b, labTarget[i].b, step_sizes[i][2]);
-
-        // update currColors with the resulting RGB values
-        PrismatikMath::LabToXyz(labCur[i], xyzCur[i]);
-        PrismatikMath::XyzToRgb(xyzCur[i], rgbCur[i]);
-        currColors[i] = qRgb(rgbCur[i].r, rgbCur[i].g, rgbCur[i].b);
+        labCur.l[i] = getUpdatedValue(labCur.l[i], labTarget.l[i], labStep.l[i]);
+        labCur.a[i] = getUpdatedValue(labCur.a[i], labTarget.a[i], labStep.a[i]);
+        labCur.b[i] = getUpdatedValue(labCur.b[i], labTarget.b[i], labStep.b[i]);
     }
+
+    // update currColors with the resulting RGB values
+    PrismatikMath::labToRgb(labCur, currColors);
 }
 
 void LedDeviceAdalight::updateSmoothColorsTick()
@@ -126,116 +127,94 @@ void LedDeviceAdalight::updateSmoothColorsTick()
 
     resizeColorsBuffer(currColors.count());
 
+    // keeps advancing while the link is saturated, skipped ticks are merged into the next written frame
     updateSmoothColors();
 
-    applyColorModifications(currColors, m_colorsBuffer);
-
-    m_writeBuffer.clear();
-    m_writeBuffer.append(m_writeBufferHeader);
-
-    for (int i = 0; i < m_colorsBuffer.count(); i++)
+    const qint64 now = ColorFrame::timestamp();
+    reportFrameRate(now);
+    if (isLinkSaturated(now))
     {
-        StructRgb color = m_colorsBuffer[i];
+        DEBUG_MID_LEVEL << Q_FUNC_INFO << "Serial link saturated, skipping frame";
+        m_skippedFramesCount++;
+        emit commandCompleted(true);
+        return;
+    }
 
-        color.r = color.r >> 4;
-        color.g = color.g >> 4;
-        color.b = color.b >> 4;
+    applyColorModifications(ColorFrame(currColors), m_colorsBuffer);
 
-        if (m_colorSequence == "RBG")
-        {
-            m_writeBuffer.append(color.r);
-            m_writeBuffer.append(color.b);
-            m_writeBuffer.append(color.g);
-        }
-        else if (m_colorSequence == "BRG")
-        {
-            m_writeBuffer.append(color.b);
-            m_writeBuffer.append(color.r);
-            m_writeBuffer.append(color.g);
-        }
-        else if (m_colorSequence == "BGR")
-        {
-            m_writeBuffer.append(color.b);
-            m_writeBuffer.append(color.g);
-            m_writeBuffer.append(color.r);
-        }
-        else if (m_colorSequence == "GRB")
-        {
-            m_writeBuffer.append(color.g);
-            m_writeBuffer.append(color.r);
-            m_writeBuffer.append(color.b);
-        }
-        else if (m_colorSequence == "GBR")
-        {
-            m_writeBuffer.append(color.g);
-            m_writeBuffer.append(color.b);
-            m_writeBuffer.append(color.r);
-        }
-        else
-        {
-            m_writeBuffer.append(color.r);
-            m_writeBuffer.append(color.g);
-            m_writeBuffer.append(color.b);
-        }
-    }
+    // 12 bit colors, 8 bits go to the device
+    const int headerSize = m_writeBufferHeader.count();
+    m_writeBuffer.resize(headerSize + m_colorsBuffer.count() * 3);
+    char *out = m_writeBuffer.data();
+    std::copy(m_writeBufferHeader.constBegin(), m_writeBufferHeader.constEnd(), out);
+    m_colorOrder.write(m_colorsBuffer, 0, m_colorsBuffer.count(), out + headerSize, 4);
 
     bool ok = writeBuffer(m_writeBuffer);
 
+    traceFrameWritten(m_targetFrame);
     emit commandCompleted(ok);
 }
 
-void LedDeviceAdalight::initColors(const QList<QRgb> & colors)
+bool LedDeviceAdalight::isLinkSaturated(qint64 now) const
 {
-    currColors = colors;
+    if (m_AdalightDevice == NULL || m_smoothTimer == nullptr)
+        return false;
 
-    labCur = std::vector<StructLabF>(currColors.count());
-    labTarget = std::vector<StructLabF>(currColors.count());
-    xyzCur = std::vector<StructXyz>(currColors.count());
-    xyzTarget = std::vector<StructXyz>(currColors.count());
-    rgbCur = std::vector<StructRgb>(currColors.count());
-    rgbTarget = std::vector<StructRgb>(currColors.count());
+    // a frame written now would wait behind the ones still on the line, writing on the next tick is as fast
+    const qint64 tickNs = m_smoothTimer->interval() * 1000000LL;
+    return m_AdalightDevice->bytesToWrite() > 0 || m_lineBusyUntil - now > tickNs;
+}
 
-    for(int i = 0; i < currColors.size(); i++)
-    {
-        rgbCur[i].r = (unsigned)qRed(currColors[i]);
-        rgbCur[i].g = (unsigned)qGreen(currColors[i]);
-        rgbCur[i].b = (unsigned)qBlue(currColors[i]);
-        PrismatikMath::RgbToXyz(rgbCur[i], xyzCur[i]);
-        PrismatikMath::XyzToLab(xyzCur[i], labCur[i]);
-    }
-    step_sizes = std::vector<std::vector<double>>(currColors.count());
+void LedDeviceAdalight::reportFrameRate(qint64 now)
+{
+    const qint64 ReportIntervalNs = 5000000000LL;
+
+    if (m_frameRateReportTimestamp == 0)
+        m_frameRateReportTimestamp = now;
+    if (now - m_frameRateReportTimestamp < ReportIntervalNs)
+        return;
+
+    const double achievedFrameRate = m_writtenFramesCount * 1e9 / (now - m_frameRateReportTimestamp);
+    const double theoreticalFrameRate = PrismatikMath::theoreticalMaxFrameRate(m_colorsBuffer.count(), m_baudRate);
+    DEBUG_LOW_LEVEL << Q_FUNC_INFO << "FPS achieved:" << achievedFrameRate << "theoretical:" << theoreticalFrameRate
+                    << "skipped frames:" << m_skippedFramesCount << "LEDs:" << m_colorsBuffer.count() << "baud rate:" << m_baudRate;
+
+    m_frameRateReportTimestamp = now;
+    m_writtenFramesCount = 0;
+    m_skippedFramesCount = 0;
 }
 
-void LedDeviceAdalight::UpdateTargetColor(const QList<QRgb> & colors)
+void LedDeviceAdalight::initColors(const ColorFrame & colors)
+{
+    currColors = colors.toList();
+    PrismatikMath::rgbToLab(currColors, labCur);
+}
+
+void LedDeviceAdalight::UpdateTargetColor(const ColorFrame & colors)
 {
     // TODO: add as setting
     //const int numTransitions = 15;  // number of intermediate colors
     const int numTransitions = 8;  // number of intermediate colors
 
-    targetColors = colors;
-    for(int i = 0; i < targetColors.size(); i++)
-    {
-        rgbTarget[i].r = qRed(targetColors[i]);
-        rgbTarget[i].g = qGreen(targetColors[i]);
-        rgbTarget[i].b = qBlue(targetColors[i]);
-        PrismatikMath::RgbToXyz(rgbTarget[i], xyzTarget[i]);
-        PrismatikMath::XyzToLab(xyzTarget[i], labTarget[i]);
-    }
-
+    // copy into the existing list, it stays allocated while the number of LEDs doesn't change
+    if (targetColors.count() == colors.count())
+        std::copy(colors.begin(), colors.end(), targetColors.begin());
+    else
+        targetColors = colors.toList();
+    PrismatikMath::rgbToLab(targetColors, labTarget);
 
     // calculate step sizes between currColors and targetColors
-    for(int i = 0; i < targetColors.size(); i++)
+    const size_t count = std::min(labCur.size(), labTarget.size());
+    labStep.resize(count);
+    for(size_t i = 0; i < count; i++)
     {
-        step_sizes[i] =
-        {
-            abs((labTarget[i].l - labCur[i].l) / numTransitions),
-            abs((labTarget[i].a - labCur[i].a) / numTransitions),
-            abs((labTarget[i].b - labCur[i].b) / numTransitions)
-        };
+        labStep.l[i] = std::abs((labTarget.l[i] - labCur.l[i]) / numTransitions);
+        labStep.a[i] = std::abs((labTarget.a[i] - labCur.a[i]) / numTransitions);
+        labStep.b[i] = std::abs((labTarget.b[i] - labCur.b[i]) / numTransitions);
     }
 }
 
-void LedDeviceAdalight::setColors(const QList<QRgb> & colors)
+void LedDeviceAdalight::setColors(const ColorFrame & colors)
 {
     // TODO: add as setting
     const int intervalMs = 20;      // time between two intermediate colors
@@ -254,16 +233,14 @@ void LedDeviceAdalight::setColors(const QList<QRgb> & colors)
         m_smoothTimer->start();
     }
 
+    m_targetFrame = colors;
     UpdateTargetColor(colors);
 }
 
 void LedDeviceAdalight::switchOffLeds()
 {
-    int count = m_colorsSaved.count();
-    m_colorsSaved.clear();
-
-    for (int i = 0; i < count; i++)
-        m_colorsSaved << 0;
+    const int count = m_colorsSaved.count();
+    m_colorsSaved = ColorFrame(count);
 
     m_writeBuffer.clear();
     m_writeBuffer.append(m_writeBufferHeader);
@@ -298,6 +275,7 @@ void LedDeviceAdalight::setColorSequence(const QString& value)
     DEBUG_LOW_LEVEL << Q_FUNC_INFO << value;
 
     m_colorSequence = value;
+    m_colorOrder = PrismatikMath::ColorSequence(value);
     setColors(m_colorsSaved);
 }
 
@@ -328,6 +306,7 @@ void LedDeviceAdalight::open()
 		m_AdalightDevice = new QSerialPort();
 
 	m_AdalightDevice->setPortName(m_portName);// Settings::getAdalightSerialPortName());
+	m_lineBusyUntil = 0;
 
 	m_AdalightDevice->open(QIODevice::WriteOnly);
 	bool ok = m_AdalightDevice->isOpen();
@@ -412,6 +391,14 @@ bool LedDeviceAdalight::writeBuffer(const QByteArray & buff)
         return false;
     }
 
+    // the line sends this frame after the ones written before
+    const int ledsCount = (buff.count() - m_writeBufferHeader.count()) / 3;
+    const double frameRate = PrismatikMath::theoreticalMaxFrameRate(ledsCount, m_baudRate);
+    const qint64 now = ColorFrame::timestamp();
+    if (frameRate > 0)
+        m_lineBusyUntil = std::max(m_lineBusyUntil, now) + static_cast<qint64>(1e9 / frameRate);
+    m_writtenFramesCount++;
+
     return true;
 }
 
@@ -28,6 +28,8 @@
 
 #include "AbstractLedDevice.hpp"
 #include "colorspace_types.h"
+#include "ColorBatch.hpp"
+#include "ColorSequence.hpp"
 #include <QtSerialPort/QSerialPort>
 
 class LedDeviceAdalight : public AbstractLedDevice
@@ -43,7 +45,7 @@ public:
 public slots:
 	void open();
 	void close();
-	void setColors(const QList<QRgb> & /*colors*/);
+	void setColors(const ColorFrame & /*colors*/);
 	void switchOffLeds();
 	void setRefreshDelay(int /*value*/);
 	void setColorDepth(int /*value*/);
@@ -59,13 +61,15 @@ private slots:
 
 private:
     bool writeBuffer(const QByteArray & buff);
+    bool isLinkSaturated(qint64 now) const;
+    void reportFrameRate(qint64 now);
     void resizeColorsBuffer(int buffSize);
     void reinitBufferHeader(int ledsCount);
 
     // smoothing methods
     void updateSmoothColors();
-    void initColors(const QList<QRgb> & colors);
-    void UpdateTargetColor(const QList<QRgb> & colors);
+    void initColors(const ColorFrame & colors);
+    void UpdateTargetColor(const ColorFrame & colors);
 
 private:
     QSerialPort *m_AdalightDevice;
@@ -73,15 +77,20 @@ private:
     QByteArray m_writeBuffer;
     QString m_portName;
     int m_baudRate;
+    PrismatikMath::ColorSequence m_colorOrder;
+
+    // backpressure, the serial driver accepts writes faster than the line sends them
+    qint64 m_lineBusyUntil = 0; // estimated time the line is done with the written frames
+    qint64 m_frameRateReportTimestamp = 0;
+    int m_writtenFramesCount = 0;
+    int m_skippedFramesCount = 0;
 
     // smoothing variables
     QList<QRgb> targetColors;
     QList<QRgb> currColors;
+    ColorFrame m_targetFrame; // traced when the first tick after its arrival is written
     QTimer *m_smoothTimer = nullptr;
-    std::vector<StructRgb> rgbCur, rgbTarget;
-    std::vector<StructLabF> labCur, labTarget;
-    std::vector<StructXyz> xyzCur, xyzTarget;
-    std::vector<std::vector<double>> step_sizes;
+    PrismatikMath::LabBatch labCur, labTarget, labStep;
 
 	QTimer* m_lastWillTimer{nullptr};
 };
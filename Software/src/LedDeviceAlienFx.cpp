@@ -105,7 +105,7 @@ LedDeviceAlienFx::~LedDeviceAlienFx()
 	DEBUG_LOW_LEVEL << Q_FUNC_INFO << "destroy LedDeviceAlienFx : ILedDevice complete";
 }
 
-void LedDeviceAlienFx::setColors(const QList<QRgb> & colors)
+void LedDeviceAlienFx::setColors(const ColorFrame & colors)
 {
 	DEBUG_MID_LEVEL << Q_FUNC_INFO;
 	if (m_isInitialized)
@@ -135,15 +135,14 @@ void LedDeviceAlienFx::setColors(const QList<QRgb> & colors)
 	DEBUG_MID_LEVEL << Q_FUNC_INFO;
 
 	// Request new colors
+	traceFrameWritten(colors);
 	emit commandCompleted(true);
 }
 
 void LedDeviceAlienFx::switchOffLeds()
 {
 	// TODO: fill it with current leds count
-	QList<QRgb> blackColor;
-	blackColor << 0;
-	setColors(blackColor);
+	setColors(ColorFrame(1));
 }
 
 void LedDeviceAlienFx::setRefreshDelay(int /*value*/)
@@ -45,7 +45,7 @@ public:
 public slots:
 	void open();
 	void close(){};
-	void setColors(const QList<QRgb> & colors);
+	void setColors(const ColorFrame & colors);
 	void switchOffLeds();
 	void setRefreshDelay(int /*value*/);
 	void setColorDepth(int /*value*/);
@@ -30,6 +30,7 @@
 #include "debug.h"
 #include "stdio.h"
 #include <QtSerialPort/QSerialPortInfo>
+#include <algorithm>
 
 using namespace SettingsScope;
 
@@ -76,7 +77,7 @@ void LedDeviceArdulight::close()
 	m_ArdulightDevice = NULL;
 }
 
-void LedDeviceArdulight::setColors(const QList<QRgb> & colors)
+void LedDeviceArdulight::setColors(const ColorFrame & colors)
 {
 	DEBUG_MID_LEVEL << Q_FUNC_INFO << colors;
 
@@ -92,63 +93,22 @@ void LedDeviceArdulight::setColors(const QList<QRgb> & colors)
 		PrismatikMath::maxCorrection(254, m_colorsBuffer[i]);
 	}
 
-	m_writeBuffer.clear();
-	m_writeBuffer.append(m_writeBufferHeader);
-
-	for (int i = 0; i < m_colorsBuffer.count(); i++)
-	{
-		StructRgb color = m_colorsBuffer[i];
-
-		if (m_colorSequence == QStringLiteral("RBG"))
-		{
-			m_writeBuffer.append(color.r);
-			m_writeBuffer.append(color.b);
-			m_writeBuffer.append(color.g);
-		}
-		else if (m_colorSequence == QStringLiteral("BRG"))
-		{
-			m_writeBuffer.append(color.b);
-			m_writeBuffer.append(color.r);
-			m_writeBuffer.append(color.g);
-		}
-		else if (m_colorSequence == QStringLiteral("BGR"))
-		{
-			m_writeBuffer.append(color.b);
-			m_writeBuffer.append(color.g);
-			m_writeBuffer.append(color.r);
-		}
-		else if (m_colorSequence == QStringLiteral("GRB"))
-		{
-			m_writeBuffer.append(color.g);
-			m_writeBuffer.append(color.r);
-			m_writeBuffer.append(color.b);
-		}
-		else if (m_colorSequence == QStringLiteral("GBR"))
-		{
-			m_writeBuffer.append(color.g);
-			m_writeBuffer.append(color.b);
-			m_writeBuffer.append(color.r);
-		}
-		else
-		{
-			m_writeBuffer.append(color.r);
-			m_writeBuffer.append(color.g);
-			m_writeBuffer.append(color.b);
-		}
-	}
+	const int headerSize = m_writeBufferHeader.count();
+	m_writeBuffer.resize(headerSize + m_colorsBuffer.count() * 3);
+	char *out = m_writeBuffer.data();
+	std::copy(m_writeBufferHeader.constBegin(), m_writeBufferHeader.constEnd(), out);
+	m_colorOrder.write(m_colorsBuffer, 0, m_colorsBuffer.count(), out + headerSize);
 
 	bool ok = writeBuffer(m_writeBuffer);
 
+	traceFrameWritten(colors);
 	emit commandCompleted(ok);
 }
 
 void LedDeviceArdulight::switchOffLeds()
 {
-	int count = m_colorsSaved.count();
-	m_colorsSaved.clear();
-
-	for (int i = 0; i < count; i++)
-		m_colorsSaved << 0;
+	const int count = m_colorsSaved.count();
+	m_colorsSaved = ColorFrame(count);
 
 	m_writeBuffer.clear();
 	m_writeBuffer.append(m_writeBufferHeader);
@@ -184,6 +144,7 @@ void LedDeviceArdulight::setColorSequence(const QString& value)
 	DEBUG_LOW_LEVEL << Q_FUNC_INFO << value;
 
 	m_colorSequence = value;
+	m_colorOrder = PrismatikMath::ColorSequence(value);
 	setColors(m_colorsSaved);
 }
 
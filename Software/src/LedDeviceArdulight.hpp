@@ -28,6 +28,7 @@
 
 #include "AbstractLedDevice.hpp"
 #include "colorspace_types.h"
+#include "ColorSequence.hpp"
 #include <QtSerialPort/QSerialPort>
 
 class LedDeviceArdulight : public AbstractLedDevice
@@ -43,7 +44,7 @@ public:
 public slots:
 	void open();
 	void close();
-	void setColors(const QList<QRgb> & /*colors*/);
+	void setColors(const ColorFrame & /*colors*/);
 	void switchOffLeds();
 	void setRefreshDelay(int /*value*/);
 	void setColorDepth(int /*value*/);
@@ -66,5 +67,6 @@ private:
 
 	QString m_portName;
 	int m_baudRate;
+	PrismatikMath::ColorSequence m_colorOrder;
 	QTimer* m_lastWillTimer{ nullptr };
 };
@@ -41,9 +41,8 @@ int LedDeviceDnrgb::maxLedsCount()
 	return MaximumNumberOfLeds::Dnrgb;
 }
 
-void LedDeviceDnrgb::setColors(const QList<QRgb> & colors)
+void LedDeviceDnrgb::setColors(const ColorFrame & colors)
 {
-	bool ok = true;
 	bool sentPackets = false;
 
 	resizeColorsBuffer(colors.count());
@@ -53,10 +52,9 @@ void LedDeviceDnrgb::setColors(const QList<QRgb> & colors)
 
 	// Send multiple buffers
 	const int totalColorsSaved = m_processedColorsSaved.count();
-	const int totalColors = colors.count();
+	const int totalColors = m_colorsBuffer.count();
+	m_processedColorsSaved.resize(totalColors);
 	uint16_t startIndex = 0;
-	QList<QRgb> newColors;
-	newColors.reserve(colors.count());
 
 	while (startIndex < totalColors)
 	{
@@ -64,58 +62,51 @@ void LedDeviceDnrgb::setColors(const QList<QRgb> & colors)
 		while (startIndex < totalColors
 			&& startIndex < totalColorsSaved)
 		{
-			const StructRgb color = m_colorsBuffer[startIndex];
-			const QRgb newColor = qRgb(color.r, color.g, color.b);
-			if (m_processedColorsSaved[startIndex] != newColor)
+			const StructRgb& color = m_colorsBuffer[startIndex];
+			if (m_processedColorsSaved[startIndex] != qRgb(color.r, color.g, color.b))
 				break;
-			newColors << newColor;
 			startIndex++;
 		}
 
 		// get diffs
-		QByteArray colorPacket;
 		uint16_t colorPacketLen = 0;
 		while (colorPacketLen < LedsPerPacket
 			&& startIndex + colorPacketLen < totalColors)
 		{
-			const StructRgb color = m_colorsBuffer[startIndex + colorPacketLen];
+			const int index = startIndex + colorPacketLen;
+			const StructRgb& color = m_colorsBuffer[index];
 			const QRgb newColor = qRgb(color.r, color.g, color.b);
-			if (startIndex + colorPacketLen < totalColorsSaved
-				&& m_processedColorsSaved[startIndex + colorPacketLen] == newColor)
+			if (index < totalColorsSaved
+				&& m_processedColorsSaved[index] == newColor)
 				break;
 
-			newColors << newColor;
-			colorPacket.append(color.r);
-			colorPacket.append(color.g);
-			colorPacket.append(color.b);
-
+			m_processedColorsSaved[index] = newColor;
 			colorPacketLen++;
 		}
 
 		if (colorPacketLen > 0) {
-			m_writeBuffer.clear();
-			m_writeBuffer.append(m_writeBufferHeader);
-			m_writeBuffer.append((char)(startIndex >> 8));  //High byte
-			m_writeBuffer.append((char)startIndex);         //Low byte
-			m_writeBuffer.append(colorPacket);
+			char *out = beginPacket();
+			*out++ = (char)(startIndex >> 8);  //High byte
+			*out++ = (char)startIndex;         //Low byte
+			endPacket(m_colorOrder.write(m_colorsBuffer, startIndex, colorPacketLen, out));
 			startIndex += colorPacketLen;
-			ok &= writeBuffer(m_writeBuffer);
 			sentPackets = true;
 		}
 	}
 
 	// if no packets are sent, send empty packet to not timeout
 	if (!sentPackets && m_timeout != InfiniteTimeout) {
-		m_writeBuffer.clear();
-		m_writeBuffer.append(m_writeBufferHeader);
-		m_writeBuffer.append((char)0);
-		m_writeBuffer.append((char)0);
-		ok &= writeBuffer(m_writeBuffer);
+		char *out = beginPacket();
+		*out++ = (char)0;
+		*out++ = (char)0;
+		endPacket(out);
 	}
 
+	const bool ok = writePackets();
+
 	m_colorsSaved = colors;
-	m_processedColorsSaved = newColors;
 
+	traceFrameWritten(colors);
 	emit commandCompleted(ok);
 }
 
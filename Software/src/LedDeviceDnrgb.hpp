@@ -37,11 +37,11 @@ public:
 	int maxLedsCount();
 
 public slots:
-	void setColors(const QList<QRgb> & colors);
+	void setColors(const ColorFrame & colors);
 
 protected:
 	virtual void reinitBufferHeader();
 
 	constexpr static const int LedsPerPacket = 489;
-	QList<QRgb> m_processedColorsSaved;
+	QVector<QRgb> m_processedColorsSaved; // updated in place, the LEDs of the frame sent last
 };
@@ -41,7 +41,7 @@ int LedDeviceDrgb::maxLedsCount()
 	return MaximumNumberOfLeds::Drgb;
 }
 
-void LedDeviceDrgb::setColors(const QList<QRgb> & colors)
+void LedDeviceDrgb::setColors(const ColorFrame & colors)
 {
 	m_colorsSaved = colors;
 
@@ -50,18 +50,11 @@ void LedDeviceDrgb::setColors(const QList<QRgb> & colors)
 	applyColorModifications(colors, m_colorsBuffer);
 	applyDithering(m_colorsBuffer, 8);
 
-	m_writeBuffer.clear();
-	m_writeBuffer.reserve(m_writeBuffer.count() + m_colorsBuffer.count() * sizeof(char));
-	m_writeBuffer.append(m_writeBufferHeader);
+	char *out = beginPacket();
+	endPacket(m_colorOrder.write(m_colorsBuffer, 0, m_colorsBuffer.count(), out));
 
-	for (const StructRgb& color : m_colorsBuffer)
-	{
-		m_writeBuffer.append(color.r);
-		m_writeBuffer.append(color.g);
-		m_writeBuffer.append(color.b);
-	}
-
-	const bool ok = writeBuffer(m_writeBuffer);
+	const bool ok = writePackets();
+	traceFrameWritten(colors);
 	emit commandCompleted(ok);
 }
 
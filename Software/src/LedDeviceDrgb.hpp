@@ -37,7 +37,7 @@ public:
 	int maxLedsCount();
 
 public slots:
-	void setColors(const QList<QRgb> & colors);
+	void setColors(const ColorFrame & colors);
 
 protected:
 	virtual void reinitBufferHeader();
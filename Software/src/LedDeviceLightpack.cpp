@@ -63,7 +63,7 @@ LedDeviceLightpack::~LedDeviceLightpack()
 	closeDevices();
 }
 
-void LedDeviceLightpack::setColors(const QList<QRgb> & colors)
+void LedDeviceLightpack::setColors(const ColorFrame & colors)
 {
 #if QT_VERSION >= QT_VERSION_CHECK(5, 14, 0)
 	DEBUG_MID_LEVEL << Q_FUNC_INFO << Qt::hex << (colors.isEmpty() ? -1 : colors.first());
@@ -132,6 +132,7 @@ void LedDeviceLightpack::setColors(const QList<QRgb> & colors)
 
 //	locker.unlock();
 
+	traceFrameWritten(colors);
 
 	// WARNING: LedDeviceManager sends data only when the arrival of this signal
 	emit commandCompleted(ok);
@@ -147,14 +148,10 @@ void LedDeviceLightpack::switchOffLeds()
 {
 	DEBUG_LOW_LEVEL << Q_FUNC_INFO;
 
-	if (m_colorsSaved.empty())
-	{
-		for (int i = 0; i < maxLedsCount(); ++i)
-			m_colorsSaved << 0;
-	} else {
-		for (int i = 0; i < m_colorsSaved.count(); i++)
-			m_colorsSaved[i] = 0;
-	}
+	if (m_colorsSaved.isEmpty())
+		m_colorsSaved = ColorFrame(maxLedsCount());
+	else
+		m_colorsSaved.fill(0);
 
 	m_timerPingDevice->stop();
 
@@ -39,7 +39,10 @@
 #include "LedDeviceDrgb.hpp"
 #include "LedDeviceDnrgb.hpp"
 #include "LedDeviceWarls.hpp"
+#include "LedDeviceUdpFanout.hpp"
 #include "Settings.hpp"
+#include "ColorFrameSlot.hpp"
+#include "PrismatikMath.hpp"
 
 using namespace SettingsScope;
 
@@ -58,6 +61,26 @@ LedDeviceManager::LedDeviceManager(QObject *parent)
 
 	m_recreateTimer = NULL;
 
+	m_latencyStatsTimer = NULL;
+
+	m_transmitTimer = NULL;
+
+	m_isTransmitPending = false;
+	m_transmitFrameRate = SettingsScope::Profile::Device::TransmitFrameRateDefault;
+	m_serialBaudRate = 0;
+	m_transmitLedsCount = 0;
+	m_transmitIntervalNs = 0;
+	m_lastTransmitTimestamp = 0;
+	m_droppedFramesCount = 0;
+
+	m_colorFrameSlot = NULL;
+
+	// child, so it moves to the thread of the manager along with it
+	m_frameSmoother = new FrameSmoother(this);
+	connect(m_frameSmoother, &FrameSmoother::frameSmoothed, this, &LedDeviceManager::setColorFrame);
+
+	qRegisterMetaType<FrameLatencyStats>("FrameLatencyStats");
+
 	m_failedCreationAttempts = 0;
 
 	m_savedBrightness = SettingsScope::Profile::Device::BrightnessDefault;
@@ -100,6 +123,28 @@ void LedDeviceManager::init()
 		connect(m_recreateTimer, &QTimer::timeout, this, &LedDeviceManager::recreateLedDevice);
 	}
 
+	if (!m_latencyStatsTimer) {
+		m_latencyStatsTimer = new QTimer(this);
+		// long enough for meaningful p99 at common frame rates
+		using namespace std::chrono_literals;
+		m_latencyStatsTimer->setInterval(5s);
+		connect(m_latencyStatsTimer, &QTimer::timeout, this, &LedDeviceManager::timeoutLatencyStats);
+		m_latencyStatsTimer->start();
+	}
+
+	if (!m_transmitTimer) {
+		m_transmitTimer = new QTimer(this);
+		m_transmitTimer->setSingleShot(true);
+		m_transmitTimer->setTimerType(Qt::PreciseTimer);
+		connect(m_transmitTimer, &QTimer::timeout, this, &LedDeviceManager::transmitColors);
+	}
+
+	m_transmitFrameRate = Settings::getDeviceTransmitFrameRate();
+
+	m_frameSmoother->setMode(Settings::getDeviceTemporalFilter());
+	m_frameSmoother->setTimeConstant(Settings::getDeviceTemporalFilterTime());
+	m_frameSmoother->setOutputFrameRate(Settings::getDeviceOutputFrameRate());
+
 	initLedDevice();
 }
 
@@ -117,34 +162,91 @@ void LedDeviceManager::switchOnLeds()
 	DEBUG_LOW_LEVEL << Q_FUNC_INFO;
 
 	m_backlightStatus = Backlight::StatusOn;
-	if (m_isColorsSaved)
-		emit ledDeviceSetColors(m_savedColors);
+	if (m_isColorsSaved) {
+		m_isTransmitPending = true;
+		transmitColors();
+	}
 }
 
 void LedDeviceManager::setColors(const QList<QRgb> & colors)
+{
+	// mood lamp, sound visualizer and API colors have their own dynamics
+	m_frameSmoother->reset();
+	setColorFrame(ColorFrame(colors));
+}
+
+void LedDeviceManager::setColorFrame(const ColorFrame & colors)
 {
 	DEBUG_HIGH_LEVEL << Q_FUNC_INFO << "Is last command completed:" << m_isLastCommandCompleted
 					<< " m_backlightStatus = " << m_backlightStatus;
 
 	if (m_backlightStatus == Backlight::StatusOn)
 	{
+		if (m_isTransmitPending)
+			m_droppedFramesCount++;
 		m_savedColors = colors;
 		m_isColorsSaved = true;
-		if (m_isLastCommandCompleted)
-		{
-			m_cmdTimeoutTimer->start();
-			m_isLastCommandCompleted = false;
-			emit ledDeviceSetColors(colors);
-		} else {
-			cmdQueueAppend(LedDeviceCommands::SetColors);
+		m_isTransmitPending = true;
+		transmitColors();
+	}
+}
+
+void LedDeviceManager::transmitColors()
+{
+	// called again once the device completes its command or the interval has passed
+	if (!m_isTransmitPending || !m_isLastCommandCompleted)
+		return;
+
+	if (m_backlightStatus != Backlight::StatusOn) {
+		m_isTransmitPending = false;
+		return;
+	}
+
+	if (m_savedColors.size() != m_transmitLedsCount)
+		updateTransmitInterval(m_savedColors.size());
+
+	const qint64 now = ColorFrame::timestamp();
+	if (m_transmitIntervalNs > 0) {
+		const qint64 waitNs = m_lastTransmitTimestamp + m_transmitIntervalNs - now;
+		if (waitNs > 0) {
+			if (!m_transmitTimer->isActive())
+				m_transmitTimer->start(static_cast<int>((waitNs + 999999) / 1000000));
+			return;
 		}
 	}
+
+	m_isTransmitPending = false;
+	m_lastTransmitTimestamp = now;
+	m_cmdTimeoutTimer->start();
+	m_isLastCommandCompleted = false;
+	m_savedColors.markStage(ColorFrame::StageEnqueued);
+	emit ledDeviceSetColors(m_savedColors);
+}
+
+void LedDeviceManager::setColorFrameSlot(ColorFrameSlot *colorFrameSlot)
+{
+	m_colorFrameSlot = colorFrameSlot;
+}
+
+void LedDeviceManager::takeColorFrame()
+{
+	DEBUG_HIGH_LEVEL << Q_FUNC_INFO;
+
+	if (m_colorFrameSlot == NULL || !m_colorFrameSlot->take(m_colorFrame))
+		return;
+
+	if (m_frameSmoother->isEnabled())
+		m_frameSmoother->setTarget(m_colorFrame);
+	else
+		setColorFrame(m_colorFrame);
 }
 
 void LedDeviceManager::switchOffLeds()
 {
 	DEBUG_LOW_LEVEL << Q_FUNC_INFO << "Is last command completed:" << m_isLastCommandCompleted;
 
+	m_frameSmoother->reset();
+
 	if (m_isLastCommandCompleted)
 	{
 		m_cmdTimeoutTimer->start();
@@ -222,6 +324,35 @@ void LedDeviceManager::setSmoothSlowdown(int value)
 	}
 }
 
+void LedDeviceManager::setTemporalFilter(int mode)
+{
+	DEBUG_MID_LEVEL << Q_FUNC_INFO << mode;
+
+	m_frameSmoother->setMode(mode);
+}
+
+void LedDeviceManager::setTemporalFilterTime(int ms)
+{
+	DEBUG_MID_LEVEL << Q_FUNC_INFO << ms;
+
+	m_frameSmoother->setTimeConstant(ms);
+}
+
+void LedDeviceManager::setOutputFrameRate(int hz)
+{
+	DEBUG_MID_LEVEL << Q_FUNC_INFO << hz;
+
+	m_frameSmoother->setOutputFrameRate(hz);
+}
+
+void LedDeviceManager::setTransmitFrameRate(int hz)
+{
+	DEBUG_MID_LEVEL << Q_FUNC_INFO << hz;
+
+	m_transmitFrameRate = hz;
+	updateTransmitInterval(m_transmitLedsCount);
+}
+
 void LedDeviceManager::setGamma(double value)
 {
 	DEBUG_MID_LEVEL << Q_FUNC_INFO << value << "Is last command completed:" << m_isLastCommandCompleted;
@@ -346,6 +477,9 @@ void LedDeviceManager::updateDeviceSettings()
 {
 	DEBUG_MID_LEVEL << Q_FUNC_INFO << "Is last command completed:" << m_isLastCommandCompleted;
 
+	// the baud rate could have been changed
+	updateTransmitInterval(m_transmitLedsCount);
+
 	if (m_isLastCommandCompleted)
 	{
 		m_isLastCommandCompleted = false;
@@ -389,6 +523,8 @@ void LedDeviceManager::ledDeviceCommandCompleted(bool ok)
 		m_isLastCommandCompleted = true;
 	}
 
+	transmitColors();
+
 	emit ioDeviceSuccess(ok);
 }
 
@@ -411,6 +547,19 @@ void LedDeviceManager::ledDeviceIoDeviceSuccess(bool isSuccess)
 	emit ioDeviceSuccess(isSuccess);
 }
 
+void LedDeviceManager::ledDeviceFrameWritten(const ColorFrame & colors)
+{
+	m_latencyTracer.addFrame(colors);
+}
+
+void LedDeviceManager::timeoutLatencyStats()
+{
+	DEBUG_MID_LEVEL << Q_FUNC_INFO << "transmit interval, ns:" << m_transmitIntervalNs << "dropped frames:" << m_droppedFramesCount;
+	m_droppedFramesCount = 0;
+
+	emit frameLatencyEvaluated(m_latencyTracer.takeStats());
+}
+
 
 void LedDeviceManager::triggerRecreateLedDevice()
 {
@@ -430,6 +579,30 @@ void LedDeviceManager::triggerRecreateLedDevice()
 	}
 }
 
+void LedDeviceManager::updateTransmitInterval(int ledsCount)
+{
+	m_transmitLedsCount = ledsCount;
+
+	const SupportedDevices::DeviceType connectedDevice = Settings::getConnectedDevice();
+	if (connectedDevice == SupportedDevices::DeviceTypeAdalight)
+		m_serialBaudRate = Settings::getAdalightSerialPortBaudRate();
+	else if (connectedDevice == SupportedDevices::DeviceTypeArdulight)
+		m_serialBaudRate = Settings::getArdulightSerialPortBaudRate();
+	else
+		m_serialBaudRate = 0;
+
+	double frameRate = m_transmitFrameRate;
+	if (m_serialBaudRate > 0 && ledsCount > 0) {
+		// more frames than the line can carry would only pile up in the serial buffers
+		const double serialFrameRate = PrismatikMath::theoreticalMaxFrameRate(ledsCount, m_serialBaudRate);
+		if (serialFrameRate > 0 && (frameRate <= 0 || serialFrameRate < frameRate))
+			frameRate = serialFrameRate;
+	}
+	m_transmitIntervalNs = frameRate > 0 ? static_cast<qint64>(1e9 / frameRate) : 0;
+
+	DEBUG_LOW_LEVEL << Q_FUNC_INFO << "LEDs:" << ledsCount << "baud rate:" << m_serialBaudRate << "transmit rate:" << frameRate;
+}
+
 void LedDeviceManager::initLedDevice()
 {
 	DEBUG_LOW_LEVEL << Q_FUNC_INFO;
@@ -453,6 +626,7 @@ void LedDeviceManager::initLedDevice()
 
 		connectSignalSlotsLedDevice();
 	}
+	updateTransmitInterval(m_transmitLedsCount);
 	emit ledDeviceUpdateDeviceSettings();
 	emit ledDeviceOpen();
 }
@@ -511,6 +685,11 @@ AbstractLedDevice * LedDeviceManager::createLedDevice(SupportedDevices::DeviceTy
 		device = (AbstractLedDevice*)new LedDeviceWarls(Settings::getWarlsAddress(), Settings::getWarlsPort(), Settings::getWarlsTimeout());
 		break;
 
+	case SupportedDevices::DeviceTypeUdpFanout:
+		DEBUG_LOW_LEVEL << Q_FUNC_INFO << "SupportedDevices::UdpFanoutDevice";
+		device = (AbstractLedDevice*)new LedDeviceUdpFanout(Settings::getUdpFanoutEndpoints(), Settings::getUdpFanoutTimeout());
+		break;
+
 	case SupportedDevices::DeviceTypeVirtual:
 		DEBUG_LOW_LEVEL << Q_FUNC_INFO << "SupportedDevices::VirtualDevice";
 		device = (AbstractLedDevice *)new LedDeviceVirtual();
@@ -548,6 +727,7 @@ void LedDeviceManager::connectSignalSlotsLedDevice()
 	connect(m_ledDevice, &AbstractLedDevice::firmwareVersion,			this, &LedDeviceManager::firmwareVersion,						Qt::QueuedConnection);
 	connect(m_ledDevice, &AbstractLedDevice::firmwareVersionUnofficial,	this, &LedDeviceManager::firmwareVersionUnofficial,				Qt::QueuedConnection);
 	connect(m_ledDevice, &AbstractLedDevice::colorsUpdated,		this, &LedDeviceManager::setColors_VirtualDeviceCallback,	Qt::QueuedConnection);
+	connect(m_ledDevice, &AbstractLedDevice::frameWritten,		this, &LedDeviceManager::ledDeviceFrameWritten,	Qt::QueuedConnection);
 
 	connect(this, &LedDeviceManager::ledDeviceOpen,								m_ledDevice, &AbstractLedDevice::open,										Qt::QueuedConnection);
 	connect(this, &LedDeviceManager::ledDeviceSetColors,				m_ledDevice, &AbstractLedDevice::setColors,						Qt::QueuedConnection);
@@ -606,13 +786,6 @@ void LedDeviceManager::cmdQueueProcessNext()
 			processOffLeds();
 			break;
 
-		case LedDeviceCommands::SetColors:
-			if (m_isColorsSaved) {
-				m_cmdTimeoutTimer->start();
-				emit ledDeviceSetColors(m_savedColors);
-			}
-			break;
-
 		case LedDeviceCommands::SetUsbPowerLedDisabled:
 			m_cmdTimeoutTimer->start();
 			emit ledDeviceSetUsbPowerLedDisabled(m_savedUsbPowerLedDisabled);
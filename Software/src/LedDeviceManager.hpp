@@ -28,12 +28,19 @@
 
 #include "enums.hpp"
 #include "AbstractLedDevice.hpp"
+#include "ColorFrame.hpp"
+#include "FrameLatency.hpp"
+#include "FrameSmoother.hpp"
 
 class QTimer;
+class ColorFrameSlot;
 
 /*!
 	This class creates \a ILedDevice implementations and manages them after.
 	It is always better way to interact with ILedDevice through \code LedDeviceManager \endcode.
+
+	Colors are sent at the transmit rate of the device, independently of how often they come in.
+	Only the latest colors are kept, colors replaced before they were sent are dropped.
  */
 class LedDeviceManager : public QObject
 {
@@ -43,16 +50,22 @@ public:
 	explicit LedDeviceManager(QObject *parent = 0);
 	virtual ~LedDeviceManager();
 
+	/*!
+		Source of grabbed frames, read in \a takeColorFrame(). Set once before grabbing starts.
+	*/
+	void setColorFrameSlot(ColorFrameSlot *colorFrameSlot);
+
 signals:
 	void openDeviceSuccess(bool isSuccess);
 	void ioDeviceSuccess(bool isSuccess);
 	void firmwareVersion(const QString & fwVersion);
 	void firmwareVersionUnofficial(const int version);
 	void setColors_VirtualDeviceCallback(const QList<QRgb> & colors);
+	void frameLatencyEvaluated(const FrameLatencyStats & stats);
 
 	// This signals are directly connected to ILedDevice. Don't use outside.
 	void ledDeviceOpen();
-	void ledDeviceSetColors(const QList<QRgb> & colors);
+	void ledDeviceSetColors(const ColorFrame & colors);
 	void ledDeviceOffLeds();
 	void ledDeviceSetUsbPowerLedDisabled(bool isDisabled);
 	void ledDeviceSetRefreshDelay(int value);
@@ -76,6 +89,8 @@ public slots:
 
 	// This slots are protected from the overflow of queries
 	void setColors(const QList<QRgb> & colors);
+	void setColorFrame(const ColorFrame & colors);
+	void takeColorFrame();
 	void switchOffLeds();
 	void switchOnLeds();
 	void setUsbPowerLedDisabled(bool isDisabled);
@@ -88,6 +103,13 @@ public slots:
 	void setLuminosityThreshold(int value);
 	void setMinimumLuminosityEnabled(bool value);
 	void setDitheringEnabled(bool isEnabled);
+	void setTemporalFilter(int mode);
+	void setTemporalFilterTime(int ms);
+	void setOutputFrameRate(int hz);
+	/*!
+		\param hz 0 sends as soon as the device is done with the previous colors
+	*/
+	void setTransmitFrameRate(int hz);
 	void setColorSequence(const QString& value);
 	void requestFirmwareVersion();
 	void updateWBAdjustments();
@@ -98,6 +120,9 @@ private slots:
 	void ledDeviceCommandTimedOut();
 	void ledDeviceOpenDeviceSuccess(bool isSuccess);
 	void ledDeviceIoDeviceSuccess(bool isSuccess);
+	void ledDeviceFrameWritten(const ColorFrame & colors);
+	void timeoutLatencyStats();
+	void transmitColors();
 
 private:
 	void initLedDevice();
@@ -108,6 +133,7 @@ private:
 	void cmdQueueProcessNext();
 	void processOffLeds();
 	void triggerRecreateLedDevice();
+	void updateTransmitInterval(int ledsCount);
 
 private:
 	bool m_isLastCommandCompleted;
@@ -116,7 +142,18 @@ private:
 
 	QList<LedDeviceCommands::Cmd> m_cmdQueue;
 
-	QList<QRgb> m_savedColors;
+	ColorFrame m_savedColors;
+	ColorFrame m_colorFrame;
+	ColorFrameSlot *m_colorFrameSlot;
+	FrameLatencyTracer m_latencyTracer;
+	FrameSmoother *m_frameSmoother;
+	bool m_isTransmitPending; // m_savedColors haven't been sent yet
+	int m_transmitFrameRate;
+	int m_serialBaudRate; // 0 if the device isn't a serial one
+	int m_transmitLedsCount; // m_transmitIntervalNs is computed for that many LEDs
+	qint64 m_transmitIntervalNs;
+	qint64 m_lastTransmitTimestamp;
+	quint64 m_droppedFramesCount;
 	bool m_savedUsbPowerLedDisabled;
 	int m_savedRefreshDelay;
 	int m_savedColorDepth;
@@ -134,5 +171,7 @@ private:
 	QThread *m_ledDeviceThread;
 	QTimer *m_cmdTimeoutTimer;
 	QTimer *m_recreateTimer;
+	QTimer *m_latencyStatsTimer;
+	QTimer *m_transmitTimer;
 	int m_failedCreationAttempts;
 };
@@ -0,0 +1,172 @@
+/*
+ * LedDeviceUdpFanout.cpp
+ *
+ *	Created on: 18.10.2026
+ *		Project: Prismatik
+ *
+ *	Prismatik is a free, open-source software: you can redistribute it and/or
+ *	modify it under the terms of the GNU General Public License as published
+ *	by the Free Software Foundation, either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	Prismatik and Lightpack files is distributed in the hope that it will be
+ *	useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.	See the GNU
+ *	General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with this program.	If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "LedDeviceUdpFanout.hpp"
+#include "debug.h"
+
+LedDeviceUdpFanout::LedDeviceUdpFanout(const QString &endpoints, const uint8_t timeout, QObject * parent)
+	: AbstractLedDevice(parent)
+	, m_isWriting(false)
+	, m_isFramePending(false)
+	, m_timeout(timeout)
+{
+	DEBUG_LOW_LEVEL << Q_FUNC_INFO << endpoints;
+
+	m_sender = new UdpFanoutSender(UdpFanoutSender::parseEndpoints(endpoints, maxLedsCount()));
+	m_sender->moveToThread(&m_networkThread);
+	connect(m_sender, &UdpFanoutSender::packetsWritten, this, &LedDeviceUdpFanout::packetsWritten);
+
+	m_networkThread.setObjectName(QStringLiteral("UdpFanoutNetworkThread"));
+	m_networkThread.start(QThread::HighPriority);
+
+	m_writeBufferHeader.append((char)UdpDevice::Dnrgb);    // DNRGB protocol
+	m_writeBufferHeader.append((char)m_timeout);
+}
+
+LedDeviceUdpFanout::~LedDeviceUdpFanout()
+{
+	close();
+	m_networkThread.quit();
+	m_networkThread.wait();
+	delete m_sender;
+}
+
+void LedDeviceUdpFanout::open()
+{
+	DEBUG_LOW_LEVEL << Q_FUNC_INFO;
+
+	// sockets have to be created in the thread they send from
+	QMetaObject::invokeMethod(m_sender, "open", Qt::BlockingQueuedConnection);
+
+	if (m_sender->endpoints().isEmpty())
+		qWarning() << Q_FUNC_INFO << "no valid endpoints";
+	emit openDeviceSuccess(!m_sender->endpoints().isEmpty());
+}
+
+void LedDeviceUdpFanout::close()
+{
+	if (m_networkThread.isRunning())
+		QMetaObject::invokeMethod(m_sender, "close", Qt::BlockingQueuedConnection);
+}
+
+void LedDeviceUdpFanout::setColors(const ColorFrame & colors)
+{
+	m_colorsSaved = colors;
+
+	// only the latest frame is sent after the burst in flight
+	if (m_isWriting) {
+		m_isFramePending = true;
+		return;
+	}
+	writeFrame();
+}
+
+void LedDeviceUdpFanout::writeFrame()
+{
+	m_colorsWriting = m_colorsSaved;
+	resizeColorsBuffer(m_colorsWriting.count());
+
+	applyColorModifications(m_colorsWriting, m_colorsBuffer);
+	applyDithering(m_colorsBuffer, 8);
+
+	const QList<UdpFanoutSender::Endpoint> &endpoints = m_sender->endpoints();
+	for (int i = 0; i < endpoints.size(); i++) {
+		const UdpFanoutSender::Endpoint &endpoint = endpoints[i];
+		UdpPacketSender &sender = m_sender->sender(i);
+		const int lastLed = qMin(endpoint.firstLed + endpoint.ledsCount, m_colorsBuffer.count());
+		for (int led = endpoint.firstLed; led < lastLed; led += LedsPerPacket) {
+			// start index is the one on the controller
+			const int startIndex = led - endpoint.firstLed;
+			char *out = sender.beginPacket(m_writeBufferHeader);
+			*out++ = (char)(startIndex >> 8);  //High byte
+			*out++ = (char)startIndex;         //Low byte
+			sender.endPacket(m_colorOrder.write(m_colorsBuffer, led, qMin(LedsPerPacket, lastLed - led), out));
+		}
+	}
+
+	m_isWriting = true;
+	QMetaObject::invokeMethod(m_sender, "writePackets", Qt::QueuedConnection);
+}
+
+void LedDeviceUdpFanout::packetsWritten(bool ok)
+{
+	m_isWriting = false;
+
+	traceFrameWritten(m_colorsWriting);
+	emit commandCompleted(ok);
+
+	if (m_isFramePending) {
+		m_isFramePending = false;
+		writeFrame();
+	}
+}
+
+void LedDeviceUdpFanout::switchOffLeds()
+{
+	setColors(ColorFrame(m_colorsSaved.count()));
+}
+
+void LedDeviceUdpFanout::resizeColorsBuffer(int buffSize)
+{
+	if (m_colorsBuffer.count() == buffSize)
+		return;
+
+	if (buffSize > maxLedsCount())
+	{
+		qCritical() << Q_FUNC_INFO << "buffSize > maxLedsCount()" << buffSize << ">" << maxLedsCount();
+
+		buffSize = maxLedsCount();
+	}
+	m_colorsBuffer.clear();
+	m_colorsBuffer.reserve(buffSize);
+	for (int i = 0; i < buffSize; i++)
+		m_colorsBuffer << StructRgb();
+}
+
+void LedDeviceUdpFanout::setRefreshDelay(int value)
+{
+	Q_UNUSED(value);
+	emit commandCompleted(true);
+}
+
+void LedDeviceUdpFanout::setSmoothSlowdown(int value)
+{
+	Q_UNUSED(value);
+	emit commandCompleted(true);
+}
+
+void LedDeviceUdpFanout::setColorSequence(const QString& value)
+{
+	Q_UNUSED(value);
+	emit commandCompleted(true);
+}
+
+void LedDeviceUdpFanout::setColorDepth(int value)
+{
+	Q_UNUSED(value);
+	emit commandCompleted(true);
+}
+
+void LedDeviceUdpFanout::requestFirmwareVersion()
+{
+	emit firmwareVersion(QStringLiteral("N/A (%1 device, %2 endpoints)").arg(name()).arg(m_sender->endpoints().count()));
+	emit commandCompleted(true);
+}
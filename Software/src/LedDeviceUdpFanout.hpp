@@ -0,0 +1,83 @@
+/*
+ * LedDeviceUdpFanout.hpp
+ *
+ *	Created on: 18.10.2026
+ *		Project: Prismatik
+ *
+ *	Prismatik is a free, open-source software: you can redistribute it and/or
+ *	modify it under the terms of the GNU General Public License as published
+ *	by the Free Software Foundation, either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	Prismatik and Lightpack files is distributed in the hope that it will be
+ *	useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.	See the GNU
+ *	General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with this program.	If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+
+#include <QThread>
+#include "AbstractLedDevice.hpp"
+#include "colorspace_types.h"
+#include "ColorSequence.hpp"
+#include "UdpFanoutSender.hpp"
+#include "enums.hpp"
+
+/*!
+	Several WLED controllers driven as one strip. Every endpoint gets a range of the LEDs,
+	sent to it over DNRGB with its own socket. Packets of all the endpoints are built in the
+	thread of the device and the frame is sent in one burst from a dedicated network thread,
+	so the sends don't hold the device thread.
+
+	Endpoints are separated by ';', each as "address:port=first-last" with zero based,
+	inclusive LED indexes, e.g. "192.168.1.10:21324=0-299;192.168.1.11:21324=300-899".
+	Ranges may overlap to mirror LEDs.
+
+	Whole ranges are sent every frame, so a lost packet doesn't leave LEDs behind.
+	Failed sends and time in the send calls of every endpoint are logged at the low debug level.
+*/
+class LedDeviceUdpFanout : public AbstractLedDevice
+{
+	Q_OBJECT
+public:
+	LedDeviceUdpFanout(const QString &endpoints, const uint8_t timeout, QObject * parent = 0);
+	virtual ~LedDeviceUdpFanout();
+	QString name() const { return QStringLiteral("udpfanout"); }
+	int maxLedsCount() { return MaximumNumberOfLeds::UdpFanout; }
+	int defaultLedsCount() { return 10; }
+
+public slots:
+	void open();
+	void close();
+	void setColors(const ColorFrame & colors);
+	void switchOffLeds();
+	void setRefreshDelay(int value);
+	void setSmoothSlowdown(int value);
+	void setColorSequence(const QString& value);
+	void setColorDepth(int value);
+	void requestFirmwareVersion();
+
+private slots:
+	void packetsWritten(bool ok);
+
+private:
+	void writeFrame();
+	void resizeColorsBuffer(int buffSize);
+
+private:
+	QThread m_networkThread;
+	UdpFanoutSender *m_sender;
+	bool m_isWriting; // packets belong to the network thread
+	bool m_isFramePending;
+	ColorFrame m_colorsWriting;
+	QByteArray m_writeBufferHeader;
+	PrismatikMath::ColorSequence m_colorOrder; // WLED takes RGB
+	uint8_t m_timeout;
+
+	constexpr static const int LedsPerPacket = 489;
+};
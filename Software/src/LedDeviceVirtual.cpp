@@ -38,7 +38,7 @@ LedDeviceVirtual::LedDeviceVirtual(QObject * parent) : AbstractLedDevice(parent)
 	DEBUG_LOW_LEVEL << Q_FUNC_INFO;
 }
 
-void LedDeviceVirtual::setColors(const QList<QRgb> & colors)
+void LedDeviceVirtual::setColors(const ColorFrame & colors)
 {
 	if (!colors.isEmpty())
 	{
@@ -57,6 +57,7 @@ void LedDeviceVirtual::setColors(const QList<QRgb> & colors)
 
 		emit colorsUpdated(callbackColors);
 	}
+	traceFrameWritten(colors);
 	emit commandCompleted(true);
 }
 
@@ -67,13 +68,8 @@ int LedDeviceVirtual::maxLedsCount()
 
 void LedDeviceVirtual::switchOffLeds()
 {
-	int count = m_colorsSaved.count();
-	m_colorsSaved.clear();
-
-	for (int i = 0; i < count; i++) {
-		m_colorsSaved << 0;
-	}
-	emit colorsUpdated(m_colorsSaved);
+	m_colorsSaved = ColorFrame(m_colorsSaved.count());
+	emit colorsUpdated(m_colorsSaved.toList());
 	emit commandCompleted(true);
 }
 
@@ -41,7 +41,7 @@ int LedDeviceWarls::maxLedsCount()
 	return MaximumNumberOfLeds::Warls;
 }
 
-void LedDeviceWarls::setColors(const QList<QRgb> & colors)
+void LedDeviceWarls::setColors(const ColorFrame & colors)
 {
 	resizeColorsBuffer(colors.count());
 
@@ -49,31 +49,28 @@ void LedDeviceWarls::setColors(const QList<QRgb> & colors)
 	applyDithering(m_colorsBuffer, 8);
 
 	const int totalColorsSaved = m_processedColorsSaved.count();
-	m_writeBuffer.clear();
-	m_writeBuffer.append(m_writeBufferHeader);
-	QList<QRgb> newColors;
-	newColors.reserve(colors.count());
+	m_processedColorsSaved.resize(m_colorsBuffer.count());
+	// index and color of every changed LED, 255 LEDs at most fit a single packet
+	char *out = beginPacket();
 
 	for (int i = 0; i < m_colorsBuffer.count(); i++)
 	{
-		const StructRgb color = m_colorsBuffer[i];
+		const StructRgb& color = m_colorsBuffer[i];
 		const QRgb newColor = qRgb(color.r, color.g, color.b);
 		if (i >= totalColorsSaved || newColor != m_processedColorsSaved[i])
 		{
-
-			m_writeBuffer.append(i);
-			m_writeBuffer.append(color.r);
-			m_writeBuffer.append(color.g);
-			m_writeBuffer.append(color.b);
+			*out++ = (char)i;
+			out = m_colorOrder.write(color, out);
+			m_processedColorsSaved[i] = newColor;
 		}
-		newColors << newColor;
 	}
+	endPacket(out);
 
 	m_colorsSaved = colors;
-	m_processedColorsSaved = newColors;
 
 	// This may send the header only
-	const bool ok = writeBuffer(m_writeBuffer);
+	const bool ok = writePackets();
+	traceFrameWritten(colors);
 	emit commandCompleted(ok);
 }
 
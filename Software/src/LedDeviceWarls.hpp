@@ -37,10 +37,10 @@ public:
 	int maxLedsCount();
 
 public slots:
-	void setColors(const QList<QRgb> & colors);
+	void setColors(const ColorFrame & colors);
 
 protected:
 	virtual void reinitBufferHeader();
 
-	QList<QRgb> m_processedColorsSaved;
+	QVector<QRgb> m_processedColorsSaved; // updated in place, the LEDs of the frame sent last
 };
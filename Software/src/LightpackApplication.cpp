@@ -102,6 +102,7 @@ void LightpackApplication::initializeAll(const QString & appDirPath)
 
 	m_applicationDirPath = appDirPath;
 	m_noGui = false;
+	m_syntheticGrabFrameRate = 0;
 	m_isSessionLocked = false;
 
 
@@ -140,6 +141,7 @@ void LightpackApplication::initializeAll(const QString & appDirPath)
 
 	// Register QMetaType for Qt::QueuedConnection
 	qRegisterMetaType< QList<QRgb> >("QList<QRgb>");
+	qRegisterMetaType<ColorFrame>("ColorFrame");
 	qRegisterMetaType< QList<QString> >("QList<QString>");
 	qRegisterMetaType<Lightpack::Mode>("Lightpack::Mode");
 	qRegisterMetaType<Backlight::Status>("Backlight::Status");
@@ -487,6 +489,12 @@ void LightpackApplication::processCommandLineArguments()
 
 	if (m_isDebugLevelObtainedFromCmdArgs)
 		qDebug() << "Debug level" << g_debugLevel;
+
+	if (parser.isSetSyntheticGrab()) {
+		m_syntheticGrabSource = parser.syntheticGrabSource();
+		m_syntheticGrabResolution = parser.syntheticGrabResolution();
+		m_syntheticGrabFrameRate = parser.syntheticGrabFrameRate();
+	}
 }
 
 void LightpackApplication::outputMessage(const QString& message) const
@@ -588,7 +596,7 @@ void LightpackApplication::startApiServer()
 		connect(m_apiServer, &ApiServer::errorOnStartListening, m_settingsWindow, &SettingsWindow::onApiServer_ErrorOnStartListening);
 	}
 
-	connect(m_ledDeviceManager, &LedDeviceManager::ledDeviceSetColors,	m_pluginInterface, &LightpackPluginInterface::updateColorsCache,	Qt::QueuedConnection);
+	connect(m_ledDeviceManager, &LedDeviceManager::ledDeviceSetColors,	m_pluginInterface, &LightpackPluginInterface::updateColorFrameCache,	Qt::QueuedConnection);
 	connect(m_ledDeviceManager, &LedDeviceManager::ledDeviceSetSmoothSlowdown,			m_pluginInterface, &LightpackPluginInterface::updateSmoothCache,					Qt::QueuedConnection);
 	connect(m_ledDeviceManager, &LedDeviceManager::ledDeviceSetGamma,			m_pluginInterface, &LightpackPluginInterface::updateGammaCache,					Qt::QueuedConnection);
 	connect(m_ledDeviceManager, &LedDeviceManager::ledDeviceSetBrightness,			m_pluginInterface, &LightpackPluginInterface::updateBrightnessCache,				Qt::QueuedConnection);
@@ -647,6 +655,10 @@ void LightpackApplication::startLedDeviceManager()
 	connect(settings(), &Settings::deviceUsbPowerLedDisabledChanged, m_ledDeviceManager, &LedDeviceManager::setUsbPowerLedDisabled,			Qt::QueuedConnection);
 	connect(settings(), &Settings::deviceGammaChanged,				m_ledDeviceManager, &LedDeviceManager::setGamma,						Qt::QueuedConnection);
 	connect(settings(), &Settings::deviceDitheringEnabledChanged,	m_ledDeviceManager, &LedDeviceManager::setDitheringEnabled,			Qt::QueuedConnection);
+	connect(settings(), &Settings::deviceTemporalFilterChanged,		m_ledDeviceManager, &LedDeviceManager::setTemporalFilter,			Qt::QueuedConnection);
+	connect(settings(), &Settings::deviceTemporalFilterTimeChanged,	m_ledDeviceManager, &LedDeviceManager::setTemporalFilterTime,		Qt::QueuedConnection);
+	connect(settings(), &Settings::deviceOutputFrameRateChanged,	m_ledDeviceManager, &LedDeviceManager::setOutputFrameRate,			Qt::QueuedConnection);
+	connect(settings(), &Settings::deviceTransmitFrameRateChanged,	m_ledDeviceManager, &LedDeviceManager::setTransmitFrameRate,		Qt::QueuedConnection);
 	connect(settings(), &Settings::deviceBrightnessChanged,			m_ledDeviceManager, &LedDeviceManager::setBrightness,					Qt::QueuedConnection);
 	connect(settings(), &Settings::deviceBrightnessCapChanged,		m_ledDeviceManager, &LedDeviceManager::setBrightnessCap,				Qt::QueuedConnection);
 	connect(settings(), &Settings::luminosityThresholdChanged,		m_ledDeviceManager, &LedDeviceManager::setLuminosityThreshold,			Qt::QueuedConnection);
@@ -720,6 +732,13 @@ void LightpackApplication::initGrabManager()
 	connect(settings(), &Settings::grabApplyColorTemperatureChanged,         m_grabManager, &GrabManager::onGrabApplyColorTemperatureChanged,           Qt::QueuedConnection);
 	connect(settings(), &Settings::grabColorTemperatureChanged,               m_grabManager, &GrabManager::onGrabColorTemperatureChanged,                 Qt::QueuedConnection);
 	connect(settings(), &Settings::grabGammaChanged,                       m_grabManager, &GrabManager::onGrabGammaChanged,                         Qt::QueuedConnection);
+	connect(settings(), &Settings::grabIntegralImageEnabledChanged,			m_grabManager, &GrabManager::onGrabIntegralImageEnabledChanged,			Qt::QueuedConnection);
+	connect(settings(), &Settings::grabSamplingStrideChanged,				m_grabManager, &GrabManager::onGrabSamplingStrideChanged,				Qt::QueuedConnection);
+	connect(settings(), &Settings::grabAlignToDisplayRefreshEnabledChanged,	m_grabManager, &GrabManager::onGrabAlignToDisplayRefreshEnabledChanged,	Qt::QueuedConnection);
+	connect(settings(), &Settings::grabDownscaleOnCaptureEnabledChanged,	m_grabManager, &GrabManager::onGrabDownscaleOnCaptureEnabledChanged,	Qt::QueuedConnection);
+	connect(settings(), &Settings::grabSyntheticSourceChanged,				m_grabManager, &GrabManager::onGrabSyntheticSourceChanged,				Qt::QueuedConnection);
+	connect(settings(), &Settings::grabSyntheticResolutionChanged,			m_grabManager, &GrabManager::onGrabSyntheticSourceChanged,				Qt::QueuedConnection);
+	connect(settings(), &Settings::grabSyntheticFrameRateChanged,			m_grabManager, &GrabManager::onGrabSyntheticSourceChanged,				Qt::QueuedConnection);
 	connect(settings(), &Settings::sendDataOnlyIfColorsChangesChanged,		m_grabManager, &GrabManager::onSendDataOnlyIfColorsEnabledChanged,		Qt::QueuedConnection);
 #ifdef D3D10_GRAB_SUPPORT
 	connect(settings(), &Settings::dx1011GrabberEnabledChanged,				m_grabManager, &GrabManager::onDx1011GrabberEnabledChanged,				Qt::QueuedConnection);
@@ -741,16 +760,22 @@ void LightpackApplication::initGrabManager()
 		connect(settings(), &Settings::soundVisualizerMinColorChanged,			m_soundManager, &SoundManagerBase::setMinColor);
 		connect(settings(), &Settings::soundVisualizerLiquidSpeedChanged,			m_soundManager, &SoundManagerBase::setLiquidModeSpeed);
 		connect(settings(), &Settings::soundVisualizerLiquidModeChanged,			m_soundManager, &SoundManagerBase::setLiquidMode);
+		connect(settings(), &Settings::soundVisualizerFftOverlapChanged,			m_soundManager, &SoundManagerBase::setFftOverlap);
+		connect(settings(), &Settings::soundVisualizerCaptureQuantumChanged,		m_soundManager, &SoundManagerBase::setCaptureQuantum);
 		connect(settings(), &Settings::sendDataOnlyIfColorsChangesChanged,		m_soundManager, &SoundManagerBase::setSendDataOnlyIfColorsChanged);
 
 		connect(m_pluginInterface, &LightpackPluginInterface::updateSoundVizMinColor,			m_soundManager, &SoundManagerBase::setMinColor,								Qt::QueuedConnection);
 		connect(m_pluginInterface, &LightpackPluginInterface::updateSoundVizMaxColor,			m_soundManager, &SoundManagerBase::setMaxColor,								Qt::QueuedConnection);
 		connect(m_pluginInterface, &LightpackPluginInterface::updateSoundVizLiquid,				m_soundManager, &SoundManagerBase::setLiquidMode,								Qt::QueuedConnection);
+		connect(m_soundManager, &SoundManagerBase::beatEvaluated,		m_pluginInterface, &LightpackPluginInterface::refreshSoundBeat);
 	}
 #endif
 
 	connect(settings(), &Settings::currentProfileInited,			m_grabManager, &GrabManager::settingsProfileChanged,			Qt::QueuedConnection);
 
+	if (!m_syntheticGrabSource.isEmpty())
+		m_grabManager->forceSyntheticGrabber(m_syntheticGrabSource, m_syntheticGrabResolution, m_syntheticGrabFrameRate);
+
 	connect(settings(), &Settings::currentProfileInited,			m_moodlampManager, &MoodLampManager::settingsProfileChanged,			Qt::QueuedConnection);
 #ifdef SOUNDVIZ_SUPPORT
 	if (m_soundManager)
@@ -765,6 +790,8 @@ void LightpackApplication::initGrabManager()
 
 		// GrabManager to this
 		connect(m_grabManager, &GrabManager::ambilightTimeOfUpdatingColors, m_settingsWindow, &SettingsWindow::refreshAmbilightEvaluated);
+		connect(m_grabManager, &GrabManager::framePacingEvaluated, m_settingsWindow, &SettingsWindow::refreshFramePacing);
+		connect(m_ledDeviceManager, &LedDeviceManager::frameLatencyEvaluated, m_settingsWindow, &SettingsWindow::refreshFrameLatency);
 
 #ifdef SOUNDVIZ_SUPPORT
 		if (m_soundManager) {
@@ -781,8 +808,11 @@ void LightpackApplication::initGrabManager()
 	}
 
 	connect(m_grabManager, &GrabManager::ambilightTimeOfUpdatingColors, m_pluginInterface, &LightpackPluginInterface::refreshAmbilightEvaluated);
+	connect(m_grabManager, &GrabManager::framePacingEvaluated, m_pluginInterface, &LightpackPluginInterface::refreshFramePacing);
+	connect(m_ledDeviceManager, &LedDeviceManager::frameLatencyEvaluated, m_pluginInterface, &LightpackPluginInterface::refreshFrameLatency);
 
-	connect(m_grabManager, &GrabManager::updateLedsColors,	m_ledDeviceManager, &LedDeviceManager::setColors, Qt::QueuedConnection);
+	m_ledDeviceManager->setColorFrameSlot(m_grabManager->colorFrameSlot());
+	connect(m_grabManager, &GrabManager::colorFrameAvailable,	m_ledDeviceManager, &LedDeviceManager::takeColorFrame, Qt::QueuedConnection);
 	connect(m_moodlampManager, &MoodLampManager::updateLedsColors,	m_ledDeviceManager, &LedDeviceManager::setColors, Qt::QueuedConnection);
 	if (!m_noGui && m_settingsWindow)
 		connect(m_moodlampManager, &MoodLampManager::moodlampFrametime,		m_settingsWindow, &SettingsWindow::refreshAmbilightEvaluated, Qt::QueuedConnection);
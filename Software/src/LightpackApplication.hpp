@@ -122,6 +122,10 @@ private:
 	QString m_applicationDirPath;
 	bool m_isDebugLevelObtainedFromCmdArgs;
 	bool m_noGui;
+	// grab synthetic frames instead of the screen, set from the command line
+	QString m_syntheticGrabSource;
+	QSize m_syntheticGrabResolution;
+	int m_syntheticGrabFrameRate;
 	DeviceLocked::DeviceLockStatus m_deviceLockStatus;
 	bool m_isSettingsWindowActive;
 	Backlight::Status m_backlightStatus;
@@ -13,6 +13,10 @@ LightpackCommandLineParser::LightpackCommandLineParser()
 	, m_versionOption(m_parser.addVersionOption())
 	, m_helpOption(m_parser.addHelpOption())
 	, m_optionSetProfile(QStringLiteral("set-profile"), QStringLiteral("switch to another profile in already running instance"), QStringLiteral("profile"))
+	, m_syntheticGrabOption(QStringLiteral("synthetic-grab"), QStringLiteral("grab generated frames (gradient, bars, noise, flash) or a raw BGRA file instead of the screen"), QStringLiteral("source"))
+	, m_syntheticGrabSizeOption(QStringLiteral("synthetic-grab-size"), QStringLiteral("resolution of the synthetic frames, e.g. 1920x1080"), QStringLiteral("size"))
+	, m_syntheticGrabFpsOption(QStringLiteral("synthetic-grab-fps"), QStringLiteral("rate of the synthetic frames, grab interval of the profile if not set"), QStringLiteral("fps"))
+	, m_syntheticGrabFrameRate(0)
 {
 	m_parser.setApplicationDescription(QStringLiteral("Prismatik of Lightpack"));
 	m_parser.addOption(m_noGUIOption);
@@ -25,6 +29,9 @@ LightpackCommandLineParser::LightpackCommandLineParser()
 	m_parser.addOption(m_debugLevelLowOption);
 	m_parser.addOption(m_debugLevelZeroOption);
 	m_parser.addOption(m_optionSetProfile);
+	m_parser.addOption(m_syntheticGrabOption);
+	m_parser.addOption(m_syntheticGrabSizeOption);
+	m_parser.addOption(m_syntheticGrabFpsOption);
 }
 
 bool LightpackCommandLineParser::isSetNoGUI() const
@@ -71,6 +78,11 @@ bool LightpackCommandLineParser::isSetProfile() const
 	return m_parser.isSet(m_optionSetProfile);
 }
 
+bool LightpackCommandLineParser::isSetSyntheticGrab() const
+{
+	return m_parser.isSet(m_syntheticGrabOption);
+}
+
 Debug::DebugLevels LightpackCommandLineParser::debugLevel() const
 {
 	Q_ASSERT(isSetDebuglevel());
@@ -82,6 +94,19 @@ QString LightpackCommandLineParser::profileName() const {
 	return m_profileName;
 }
 
+QString LightpackCommandLineParser::syntheticGrabSource() const {
+	Q_ASSERT(isSetSyntheticGrab());
+	return m_syntheticGrabSource;
+}
+
+QSize LightpackCommandLineParser::syntheticGrabResolution() const {
+	return m_syntheticGrabResolution;
+}
+
+int LightpackCommandLineParser::syntheticGrabFrameRate() const {
+	return m_syntheticGrabFrameRate;
+}
+
 QString LightpackCommandLineParser::helpText() const {
 	return m_parser.helpText();
 }
@@ -89,6 +114,8 @@ QString LightpackCommandLineParser::helpText() const {
 QString LightpackCommandLineParser::errorText() const {
 	if (isSetBacklightOff() && isSetBacklightOn())
 		return QStringLiteral("Bad options specified!");
+	if (!m_errorText.isEmpty())
+		return m_errorText;
 	return m_parser.errorText();
 }
 
@@ -133,5 +160,28 @@ bool LightpackCommandLineParser::parse(const QStringList &arguments)
 	if (isSetBacklightOff() && isSetBacklightOn())
 		return false;
 
+	if (m_parser.isSet(m_syntheticGrabOption))
+		m_syntheticGrabSource = m_parser.value(m_syntheticGrabOption);
+
+	if (m_parser.isSet(m_syntheticGrabSizeOption)) {
+		const QStringList size = m_parser.value(m_syntheticGrabSizeOption).split(QLatin1Char('x'));
+		bool isWidthOk = false, isHeightOk = false;
+		if (size.size() == 2)
+			m_syntheticGrabResolution = QSize(size[0].toInt(&isWidthOk), size[1].toInt(&isHeightOk));
+		if (!isWidthOk || !isHeightOk || m_syntheticGrabResolution.isEmpty()) {
+			m_errorText = QStringLiteral("Invalid synthetic grab size: ") + m_parser.value(m_syntheticGrabSizeOption);
+			return false;
+		}
+	}
+
+	if (m_parser.isSet(m_syntheticGrabFpsOption)) {
+		bool isOk = false;
+		m_syntheticGrabFrameRate = m_parser.value(m_syntheticGrabFpsOption).toInt(&isOk);
+		if (!isOk || m_syntheticGrabFrameRate <= 0) {
+			m_errorText = QStringLiteral("Invalid synthetic grab fps: ") + m_parser.value(m_syntheticGrabFpsOption);
+			return false;
+		}
+	}
+
 	return true;
 }
@@ -29,6 +29,7 @@
 #include "debug.h"
 #include <QCoreApplication>
 #include <QCommandLineParser>
+#include <QSize>
 
 class LightpackCommandLineParser {
 public:
@@ -42,12 +43,19 @@ public:
 	bool isSetBacklightOn() const;
 	bool isSetDebuglevel() const;
 	bool isSetProfile() const;
+	bool isSetSyntheticGrab() const;
 	// Valid only if isSetDebuglevel() is true.
 	Debug::DebugLevels debugLevel() const;
 
 	// Valid only if isSetProfile() is true.
 	QString profileName() const;
 
+	// Valid only if isSetSyntheticGrab() is true.
+	QString syntheticGrabSource() const;
+	// Empty and 0 if not specified.
+	QSize syntheticGrabResolution() const;
+	int syntheticGrabFrameRate() const;
+
 	QString helpText() const;
 	QString errorText() const;
 
@@ -79,10 +87,18 @@ private:
 	const QCommandLineOption m_versionOption;
 	const QCommandLineOption m_helpOption;
 	const QCommandLineOption m_optionSetProfile;
+	// --synthetic-grab=<pattern | file> [--synthetic-grab-size=<width>x<height>] [--synthetic-grab-fps=<fps>]
+	const QCommandLineOption m_syntheticGrabOption;
+	const QCommandLineOption m_syntheticGrabSizeOption;
+	const QCommandLineOption m_syntheticGrabFpsOption;
 
 	// Values from command line.
 	Debug::DebugLevels m_debugLevel;
 	QString m_profileName;
+	QString m_syntheticGrabSource;
+	QSize m_syntheticGrabResolution;
+	int m_syntheticGrabFrameRate;
+	QString m_errorText;
 };
 
 #endif // LIGHTPACKCOMMANDLINEPARSER_H
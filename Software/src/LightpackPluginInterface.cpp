@@ -1,5 +1,7 @@
 #include <QtGui>
 #include <QApplication>
+#include <algorithm>
+#include <cmath>
 #include "LightpackPluginInterface.hpp"
 #include "Plugin.hpp"
 #include "Settings.hpp"
@@ -153,6 +155,16 @@ void LightpackPluginInterface::refreshAmbilightEvaluated(double updateResultMs)
 	}
 }
 
+void LightpackPluginInterface::refreshFramePacing(const Grab::FramePacingStats &stats)
+{
+	m_framePacing = stats;
+}
+
+void LightpackPluginInterface::refreshFrameLatency(const FrameLatencyStats &stats)
+{
+	m_frameLatency = stats;
+}
+
 void LightpackPluginInterface::refreshScreenRect(QRect rect)
 {
 	screen = rect;
@@ -164,6 +176,16 @@ void LightpackPluginInterface::updateColorsCache(const QList<QRgb> & colors)
 	m_curColors = colors;
 }
 
+void LightpackPluginInterface::updateColorFrameCache(const ColorFrame & colors)
+{
+	DEBUG_HIGH_LEVEL << Q_FUNC_INFO;
+	// reuse the cached list, it is only shared while GetColors() results are alive
+	if (m_curColors.size() == colors.size())
+		std::copy(colors.begin(), colors.end(), m_curColors.begin());
+	else
+		m_curColors = colors.toList();
+}
+
 
 void LightpackPluginInterface::updateGammaCache(double value)
 {
@@ -201,6 +223,12 @@ void LightpackPluginInterface::updateSoundVizLiquidCache(bool value)
 	DEBUG_MID_LEVEL << Q_FUNC_INFO;
 	m_soundVizLiquid = value;
 }
+
+void LightpackPluginInterface::refreshSoundBeat(const SoundBeat &beat)
+{
+	m_soundBeat = beat;
+	m_soundBeatTimer.start();
+}
 #endif
 
 QString LightpackPluginInterface::Version()
@@ -654,6 +682,16 @@ double LightpackPluginInterface::GetFPS()
 	return hz;
 }
 
+Grab::FramePacingStats LightpackPluginInterface::GetFramePacing()
+{
+	return m_framePacing;
+}
+
+FrameLatencyStats LightpackPluginInterface::GetFrameLatency()
+{
+	return m_frameLatency;
+}
+
 QRect LightpackPluginInterface::GetScreenSize()
 {
 	return screen;
@@ -708,6 +746,17 @@ bool LightpackPluginInterface::GetSoundVizLiquidMode()
 {
 	return m_soundVizLiquid;
 }
+
+SoundBeat LightpackPluginInterface::GetSoundBeat()
+{
+	// the phase keeps going since the last update
+	SoundBeat beat = m_soundBeat;
+	if (beat.tempo > 0.0 && m_soundBeatTimer.isValid()) {
+		const double beats = beat.phase + m_soundBeatTimer.elapsed() / 1000.0 * beat.tempo / 60.0;
+		beat.phase = beats - std::floor(beats);
+	}
+	return beat;
+}
 #endif
 
 bool LightpackPluginInterface::GetPersistOnUnlock()
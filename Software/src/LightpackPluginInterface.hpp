@@ -5,6 +5,12 @@
 #include <QObject>
 #include "enums.hpp"
 #include "Plugin.hpp"
+#include "FramePacer.hpp"
+#include "ColorFrame.hpp"
+#include "FrameLatency.hpp"
+#ifdef SOUNDVIZ_SUPPORT
+#include "SoundVisualizer.hpp"
+#endif
 
 class LightpackPluginInterface : public QObject
 {
@@ -52,6 +58,8 @@ public:
 	QList<QRect> GetLeds();
 	QList<QRgb> GetColors();
 	double GetFPS();
+	Grab::FramePacingStats GetFramePacing();
+	FrameLatencyStats GetFrameLatency();
 	QRect GetScreenSize();
 	int GetBacklight();
 	double GetGamma();
@@ -60,6 +68,7 @@ public:
 #ifdef SOUNDVIZ_SUPPORT
 	QPair<QColor, QColor> GetSoundVizColors();
 	bool GetSoundVizLiquidMode();
+	SoundBeat GetSoundBeat();
 #endif
 	bool GetPersistOnUnlock();
 
@@ -104,8 +113,11 @@ public slots:
 	void resultBacklightStatus(Backlight::Status status);
 	void changeProfile(const QString& profile);
 	void refreshAmbilightEvaluated(double updateResultMs);
+	void refreshFramePacing(const Grab::FramePacingStats &stats);
+	void refreshFrameLatency(const FrameLatencyStats &stats);
 	void refreshScreenRect(QRect rect);
 	void updateColorsCache(const QList<QRgb> & colors);
+	void updateColorFrameCache(const ColorFrame & colors);
 	void updateGammaCache(double value);
 	void updateBrightnessCache(int value);
 	void updateSmoothCache(int value);
@@ -113,6 +125,7 @@ public slots:
 	void updateSoundVizMinColorCache(QColor color);
 	void updateSoundVizMaxColorCache(QColor color);
 	void updateSoundVizLiquidCache(bool value);
+	void refreshSoundBeat(const SoundBeat &beat);
 #endif
 	void updatePlugin(const QList<Plugin*>& plugins);
 
@@ -128,6 +141,8 @@ private:
 	Backlight::Status m_backlightStatusResult;
 
 	double hz;
+	Grab::FramePacingStats m_framePacing;
+	FrameLatencyStats m_frameLatency;
 	QRect screen;
 
 	QList<QString> lockSessionKeys;
@@ -142,6 +157,8 @@ private:
 	QColor m_soundVizMin;
 	QColor m_soundVizMax;
 	bool m_soundVizLiquid;
+	SoundBeat m_soundBeat;
+	QElapsedTimer m_soundBeatTimer; // since m_soundBeat came
 #endif
 	bool m_persistOnUnlock;
 
@@ -0,0 +1,466 @@
+/*
+ * PipeWireSoundManager.cpp
+ *
+ *	Created on: 18.10.2026
+ *		Project: Prismatik
+ *
+ *	Prismatik is a free, open-source software: you can redistribute it and/or
+ *	modify it under the terms of the GNU General Public License as published
+ *	by the Free Software Foundation, either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	Prismatik and Lightpack files is distributed in the hope that it will be
+ *	useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.	See the GNU
+ *	General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with this program.	If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "PipeWireSoundManager.hpp"
+#include "debug.h"
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+
+#include <spa/param/audio/format-utils.h>
+#include <spa/utils/result.h>
+
+#ifndef PW_KEY_TARGET_OBJECT
+// before 0.3.44
+#define PW_KEY_TARGET_OBJECT PW_KEY_NODE_TARGET
+#endif
+
+namespace
+{
+	// the graph rate is unknown until the stream is linked, the latency is asked for in frames of that
+	const uint32_t AssumedGraphRate = 48000;
+	// seconds to wait for the daemon to answer
+	const int SyncTimeout = 2;
+}
+
+PipeWireSoundManager::PipeWireSoundManager(QObject *parent) : SoundManagerBase(parent)
+{
+	spa_zero(m_coreListener);
+	spa_zero(m_registryListener);
+	spa_zero(m_streamListener);
+
+	m_timer.setTimerType(Qt::PreciseTimer);
+	connect(&m_timer, &QTimer::timeout, this, &PipeWireSoundManager::updateColors);
+
+	connect(&m_coreAliveTimer, &QTimer::timeout, this, &PipeWireSoundManager::checkCore);
+}
+
+PipeWireSoundManager::~PipeWireSoundManager()
+{
+	if (m_isEnabled)
+		start(false);
+	uninit();
+}
+
+bool PipeWireSoundManager::init()
+{
+	pw_init(nullptr, nullptr);
+	m_isCoreBroken = false;
+
+	m_loop = pw_thread_loop_new("prismatik-audio", nullptr);
+	if (m_loop == nullptr) {
+		qCritical() << Q_FUNC_INFO << "couldn't create PipeWire loop";
+		return false;
+	}
+	m_context = pw_context_new(pw_thread_loop_get_loop(m_loop), nullptr, 0);
+	if (m_context == nullptr) {
+		qCritical() << Q_FUNC_INFO << "couldn't create PipeWire context";
+		uninit();
+		return false;
+	}
+	pw_thread_loop_start(m_loop);
+
+	pw_thread_loop_lock(m_loop);
+
+	m_core = pw_context_connect(m_context, nullptr, 0);
+	if (m_core == nullptr) {
+		pw_thread_loop_unlock(m_loop);
+		qWarning() << Q_FUNC_INFO << "couldn't connect to PipeWire";
+		uninit();
+		return false;
+	}
+
+	static const pw_core_events coreEvents = []() {
+		pw_core_events result;
+		spa_zero(result);
+		result.version = PW_VERSION_CORE_EVENTS;
+		result.done = onCoreDone;
+		result.error = onCoreError;
+		return result;
+	}();
+	pw_core_add_listener(m_core, &m_coreListener, &coreEvents, this);
+
+	static const pw_registry_events registryEvents = []() {
+		pw_registry_events result;
+		spa_zero(result);
+		result.version = PW_VERSION_REGISTRY_EVENTS;
+		result.global = onRegistryGlobal;
+		result.global_remove = onRegistryGlobalRemove;
+		return result;
+	}();
+	m_registry = pw_core_get_registry(m_core, PW_VERSION_REGISTRY, 0);
+	pw_registry_add_listener(m_registry, &m_registryListener, &registryEvents, this);
+
+	// the sinks which exist already are announced before the sync is done
+	const bool isSynced = syncCore();
+	updateDevices();
+
+	pw_thread_loop_unlock(m_loop);
+
+	if (!isSynced) {
+		qWarning() << Q_FUNC_INFO << "PipeWire didn't answer";
+		uninit();
+		return false;
+	}
+
+	m_isInited = true;
+	return true;
+}
+
+void PipeWireSoundManager::uninit()
+{
+	destroyStream();
+
+	if (m_loop) {
+		pw_thread_loop_lock(m_loop);
+		if (m_registry) {
+			spa_hook_remove(&m_registryListener);
+			pw_proxy_destroy(reinterpret_cast<pw_proxy *>(m_registry));
+			m_registry = nullptr;
+		}
+		if (m_core) {
+			spa_hook_remove(&m_coreListener);
+			pw_core_disconnect(m_core);
+			m_core = nullptr;
+		}
+		m_sinks.clear();
+		pw_thread_loop_unlock(m_loop);
+		pw_thread_loop_stop(m_loop);
+	}
+	if (m_context) {
+		pw_context_destroy(m_context);
+		m_context = nullptr;
+	}
+	if (m_loop) {
+		pw_thread_loop_destroy(m_loop);
+		m_loop = nullptr;
+	}
+
+	m_isInited = false;
+}
+
+bool PipeWireSoundManager::syncCore()
+{
+	// the loop is locked, pw_thread_loop_timed_wait() unlocks it while waiting
+	m_isSynced = false;
+	m_syncSeq = pw_core_sync(m_core, PW_ID_CORE, m_syncSeq);
+	while (!m_isSynced && !m_isCoreBroken) {
+		if (pw_thread_loop_timed_wait(m_loop, SyncTimeout) != 0)
+			return false;
+	}
+	return m_isSynced;
+}
+
+void PipeWireSoundManager::onCoreDone(void *data, uint32_t id, int seq)
+{
+	PipeWireSoundManager *pw = static_cast<PipeWireSoundManager *>(data);
+	if (id != PW_ID_CORE || seq != pw->m_syncSeq)
+		return;
+	pw->m_isSynced = true;
+	pw_thread_loop_signal(pw->m_loop, false);
+}
+
+void PipeWireSoundManager::onCoreError(void *data, uint32_t id, int seq, int res, const char *message)
+{
+	Q_UNUSED(seq);
+	PipeWireSoundManager *pw = static_cast<PipeWireSoundManager *>(data);
+	qWarning() << Q_FUNC_INFO << "object" << id << spa_strerror(res) << message;
+	if (id == PW_ID_CORE && res == -EPIPE) {
+		pw->m_isCoreBroken = true;
+		pw_thread_loop_signal(pw->m_loop, false);
+	}
+}
+
+void PipeWireSoundManager::onRegistryGlobal(void *data, uint32_t id, uint32_t permissions, const char *type, uint32_t version, const spa_dict *props)
+{
+	Q_UNUSED(permissions);
+	Q_UNUSED(version);
+	PipeWireSoundManager *pw = static_cast<PipeWireSoundManager *>(data);
+	if (props == nullptr || strcmp(type, PW_TYPE_INTERFACE_Node) != 0)
+		return;
+
+	// sources could be captured as well, but the visualizer is about what is playing
+	const char *mediaClass = spa_dict_lookup(props, PW_KEY_MEDIA_CLASS);
+	const char *name = spa_dict_lookup(props, PW_KEY_NODE_NAME);
+	if (mediaClass == nullptr || name == nullptr || strcmp(mediaClass, "Audio/Sink") != 0)
+		return;
+
+	const char *description = spa_dict_lookup(props, PW_KEY_NODE_DESCRIPTION);
+	Sink sink;
+	sink.id = id;
+	sink.name = QString::fromUtf8(name);
+	sink.description = QStringLiteral("Monitor of %1").arg(description ? QString::fromUtf8(description) : sink.name);
+	pw->m_sinks.append(sink);
+}
+
+void PipeWireSoundManager::onRegistryGlobalRemove(void *data, uint32_t id)
+{
+	PipeWireSoundManager *pw = static_cast<PipeWireSoundManager *>(data);
+	for (int i = 0; i < pw->m_sinks.size(); i++) {
+		if (pw->m_sinks[i].id == id) {
+			pw->m_sinks.removeAt(i);
+			return;
+		}
+	}
+}
+
+void PipeWireSoundManager::updateDevices()
+{
+	m_devices.clear();
+	m_devices.push_back({QStringLiteral("Default device"), QLatin1String("")});
+	for (const Sink &sink : m_sinks)
+		m_devices.push_back({sink.description, sink.name});
+}
+
+void PipeWireSoundManager::populateDeviceList(QList<SoundManagerDeviceInfo>& devices, int& recommended)
+{
+	pw_thread_loop_lock(m_loop);
+	updateDevices();
+	pw_thread_loop_unlock(m_loop);
+
+	recommended = 0;
+	for (int i = 0; i < m_devices.size(); i++) {
+		devices.append(SoundManagerDeviceInfo(m_devices[i].first, i));
+	}
+}
+
+void PipeWireSoundManager::start(bool isEnabled)
+{
+	if (m_isEnabled == isEnabled)
+		return;
+
+	m_isEnabled = isEnabled;
+
+	if (m_isEnabled)
+	{
+		if (!startCapture()) {
+			m_isEnabled = false;
+			return;
+		}
+		using namespace std::chrono_literals;
+		m_coreAliveTimer.start(1s);
+	}
+	else
+	{
+		m_coreAliveTimer.stop();
+		stopCapture();
+	}
+
+	if (m_visualizer == nullptr)
+		return;
+	if (m_isEnabled)
+		m_visualizer->start();
+	else
+		m_visualizer->stop();
+}
+
+bool PipeWireSoundManager::startCapture()
+{
+	if (!m_isInited && !init())
+		return false;
+
+	// the ring is emptied, so before the first samples come
+	m_analyzer.start(m_fftOverlap);
+
+	if (!connectStream()) {
+		m_analyzer.stop();
+		return false;
+	}
+
+	// as often as a new spectrum comes, 40hz at least
+	using namespace std::chrono_literals;
+	const std::chrono::milliseconds hop(m_analyzer.hopSamples() * 1000 / AssumedGraphRate);
+	m_timer.start(qBound(std::chrono::milliseconds(1ms), hop, std::chrono::milliseconds(25ms)));
+	return true;
+}
+
+void PipeWireSoundManager::stopCapture()
+{
+	m_timer.stop();
+	destroyStream();
+	m_analyzer.stop();
+}
+
+bool PipeWireSoundManager::connectStream()
+{
+	if (m_stream)
+		return true;
+
+	pw_thread_loop_lock(m_loop);
+
+	m_streamQuantum = m_captureQuantum;
+	m_streamRate = 0;
+
+	pw_properties *props = pw_properties_new(
+		PW_KEY_MEDIA_TYPE, "Audio",
+		PW_KEY_MEDIA_CATEGORY, "Capture",
+		PW_KEY_MEDIA_ROLE, "Music",
+		// the monitor of the sink, not a microphone
+		PW_KEY_STREAM_CAPTURE_SINK, "true",
+		nullptr);
+	pw_properties_setf(props, PW_KEY_NODE_LATENCY, "%u/%u", m_streamQuantum, AssumedGraphRate);
+
+	QString dev;
+	if (m_device > 0 && m_device < m_devices.size()) {
+		dev = m_devices[m_device].second;
+		pw_properties_set(props, PW_KEY_TARGET_OBJECT, dev.toUtf8().constData());
+		qInfo() << "PipeWire device:" << m_devices[m_device].first;
+	} else {
+		qInfo() << "PipeWire device: Default device";
+	}
+
+	m_stream = pw_stream_new(m_core, "Prismatik", props);
+	if (m_stream == nullptr) {
+		pw_thread_loop_unlock(m_loop);
+		qCritical() << Q_FUNC_INFO << "couldn't create PipeWire stream";
+		return false;
+	}
+
+	static const pw_stream_events streamEvents = []() {
+		pw_stream_events result;
+		spa_zero(result);
+		result.version = PW_VERSION_STREAM_EVENTS;
+		result.state_changed = onStreamStateChanged;
+		result.param_changed = onStreamParamChanged;
+		result.process = onStreamProcess;
+		return result;
+	}();
+	pw_stream_add_listener(m_stream, &m_streamListener, &streamEvents, this);
+
+	// no rate, the stream takes the graph's one and nothing gets resampled, channels are mixed down to mono
+	spa_audio_info_raw format;
+	spa_zero(format);
+	format.format = SPA_AUDIO_FORMAT_F32;
+	format.channels = 1;
+	format.position[0] = SPA_AUDIO_CHANNEL_MONO;
+
+	uint8_t buffer[1024];
+	spa_pod_builder builder = SPA_POD_BUILDER_INIT(buffer, sizeof(buffer));
+	const spa_pod *params[] = {
+		spa_format_audio_raw_build(&builder, SPA_PARAM_EnumFormat, &format)
+	};
+
+	if (pw_stream_connect(m_stream, PW_DIRECTION_INPUT, PW_ID_ANY,
+						  static_cast<pw_stream_flags>(PW_STREAM_FLAG_AUTOCONNECT | PW_STREAM_FLAG_MAP_BUFFERS | PW_STREAM_FLAG_RT_PROCESS),
+						  params, 1) < 0) {
+		qCritical() << "PipeWire failed to connect to device" << (!dev.isEmpty() ? dev : QStringLiteral("Default device"));
+		spa_hook_remove(&m_streamListener);
+		pw_stream_destroy(m_stream);
+		m_stream = nullptr;
+		pw_thread_loop_unlock(m_loop);
+		return false;
+	}
+
+	pw_thread_loop_unlock(m_loop);
+	return true;
+}
+
+void PipeWireSoundManager::destroyStream()
+{
+	if (m_stream == nullptr)
+		return;
+
+	pw_thread_loop_lock(m_loop);
+	spa_hook_remove(&m_streamListener);
+	pw_stream_destroy(m_stream);
+	m_stream = nullptr;
+	pw_thread_loop_unlock(m_loop);
+	m_streamRate = 0;
+}
+
+void PipeWireSoundManager::onStreamStateChanged(void *data, pw_stream_state old, pw_stream_state state, const char *error)
+{
+	Q_UNUSED(data);
+	Q_UNUSED(old);
+	DEBUG_LOW_LEVEL << Q_FUNC_INFO << pw_stream_state_as_string(state);
+	if (state == PW_STREAM_STATE_ERROR)
+		qWarning() << Q_FUNC_INFO << "stream failed:" << error;
+}
+
+void PipeWireSoundManager::onStreamParamChanged(void *data, uint32_t id, const spa_pod *param)
+{
+	PipeWireSoundManager *pw = static_cast<PipeWireSoundManager *>(data);
+	if (param == nullptr || id != SPA_PARAM_Format)
+		return;
+
+	uint32_t mediaType, mediaSubtype;
+	spa_audio_info_raw format;
+	spa_zero(format);
+	if (spa_format_parse(param, &mediaType, &mediaSubtype) < 0
+		|| mediaType != SPA_MEDIA_TYPE_audio || mediaSubtype != SPA_MEDIA_SUBTYPE_raw
+		|| spa_format_audio_raw_parse(param, &format) < 0 || format.rate == 0)
+		return;
+
+	pw->m_streamRate = format.rate;
+
+	// the latency is a fraction of a second, ask again in frames of the actual rate
+	char latency[32];
+	snprintf(latency, sizeof(latency), "%u/%u", pw->m_streamQuantum, format.rate);
+	const spa_dict_item items[] = { SPA_DICT_ITEM_INIT(PW_KEY_NODE_LATENCY, latency) };
+	const spa_dict dict = SPA_DICT_INIT_ARRAY(items);
+	pw_stream_update_properties(pw->m_stream, &dict);
+
+	DEBUG_LOW_LEVEL << Q_FUNC_INFO << "negotiated" << format.rate << "Hz" << format.channels << "channels, latency" << latency;
+}
+
+void PipeWireSoundManager::onStreamProcess(void *data)
+{
+	PipeWireSoundManager *pw = static_cast<PipeWireSoundManager *>(data);
+
+	pw_buffer *buffer = pw_stream_dequeue_buffer(pw->m_stream);
+	if (buffer == nullptr)
+		return;
+
+	// no locks and no FFT here, the analyzer's thread picks the samples up
+	const spa_data &samples = buffer->buffer->datas[0];
+	if (samples.data && samples.chunk) {
+		const uint32_t offset = std::min(samples.chunk->offset, samples.maxsize);
+		const uint32_t size = std::min(samples.chunk->size, samples.maxsize - offset);
+		pw->m_analyzer.write(reinterpret_cast<const float *>(static_cast<const uint8_t *>(samples.data) + offset), size / sizeof(float));
+	}
+
+	pw_stream_queue_buffer(pw->m_stream, buffer);
+}
+
+void PipeWireSoundManager::updateFft()
+{
+	if (m_streamRate)
+		m_sampleRate = m_streamRate;
+
+	// keep the last spectrum if the analysis didn't publish a new one yet
+	m_analyzer.takeSpectrum(m_fft);
+}
+
+void PipeWireSoundManager::checkCore()
+{
+	if (m_isInited && !m_isCoreBroken)
+		return;
+
+	// the daemon went away, tried again every second until it is back
+	if (m_isInited) {
+		qInfo() << "PipeWire disconnected, reconnecting";
+		stopCapture();
+		uninit();
+	}
+	startCapture();
+}
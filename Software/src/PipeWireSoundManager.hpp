@@ -0,0 +1,106 @@
+/*
+ * PipeWireSoundManager.hpp
+ *
+ *	Created on: 18.10.2026
+ *		Project: Prismatik
+ *
+ *	Prismatik is a free, open-source software: you can redistribute it and/or
+ *	modify it under the terms of the GNU General Public License as published
+ *	by the Free Software Foundation, either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	Prismatik and Lightpack files is distributed in the hope that it will be
+ *	useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.	See the GNU
+ *	General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with this program.	If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+
+#include <QTimer>
+#include <QList>
+#include <QPair>
+#include <atomic>
+#include "SoundManagerBase.hpp"
+#include "SpectrumAnalyzer.hpp"
+
+#include <pipewire/pipewire.h>
+
+/*!
+	Captures the monitor of a sink straight from the PipeWire graph: mono float samples at
+	the graph's own rate, so nothing is resampled, in periods of the capture quantum
+	(SoundVisualizer/CaptureQuantum frames). Smaller quanta make the spectrum follow the
+	audio sooner at the cost of more wakeups. Samples go to a \a SpectrumAnalyzer, the same
+	FFT the PulseAudio backend uses.
+*/
+class PipeWireSoundManager : public SoundManagerBase
+{
+	Q_OBJECT
+public:
+	PipeWireSoundManager(QObject *parent = 0);
+	virtual ~PipeWireSoundManager();
+
+public:
+	virtual void start(bool isEnabled);
+
+protected:
+	virtual bool init();
+	virtual void populateDeviceList(QList<SoundManagerDeviceInfo>& devices, int& recommended);
+	virtual void updateFft();
+
+private slots:
+	void checkCore();
+
+private:
+	struct Sink
+	{
+		uint32_t id;
+		QString description;
+		QString name;
+	};
+
+	void uninit();
+	bool startCapture();
+	void stopCapture();
+	bool connectStream();
+	void destroyStream();
+	bool syncCore();
+	void updateDevices();
+
+	// registry and core callbacks run in the loop thread with the loop locked
+	static void onRegistryGlobal(void *data, uint32_t id, uint32_t permissions, const char *type, uint32_t version, const spa_dict *props);
+	static void onRegistryGlobalRemove(void *data, uint32_t id);
+	static void onCoreDone(void *data, uint32_t id, int seq);
+	static void onCoreError(void *data, uint32_t id, int seq, int res, const char *message);
+	static void onStreamStateChanged(void *data, pw_stream_state old, pw_stream_state state, const char *error);
+	static void onStreamParamChanged(void *data, uint32_t id, const spa_pod *param);
+	// runs in PipeWire's realtime thread
+	static void onStreamProcess(void *data);
+
+	QTimer m_timer;
+	QTimer m_coreAliveTimer;
+
+	pw_thread_loop *m_loop{nullptr};
+	pw_context *m_context{nullptr};
+	pw_core *m_core{nullptr};
+	spa_hook m_coreListener;
+	pw_registry *m_registry{nullptr};
+	spa_hook m_registryListener;
+	pw_stream *m_stream{nullptr};
+	spa_hook m_streamListener;
+
+	int m_syncSeq{0};
+	bool m_isSynced{false};
+	std::atomic<bool> m_isCoreBroken{false}; // the daemon went away, checkCore() connects again
+	uint32_t m_streamQuantum{0}; // frames, fixed while the stream exists
+	std::atomic<uint32_t> m_streamRate{0}; // negotiated graph rate, 0 until the stream has a format
+
+	QList<Sink> m_sinks; // kept up to date by the registry, guarded by the loop lock
+	QList<QPair<QString, QString>> m_devices; // snapshot of m_sinks for index-to-name mapping, first is the default
+
+	SpectrumAnalyzer m_analyzer{fftSize()};
+};
@@ -26,56 +26,7 @@
 
 #include "PulseAudioSoundManager.hpp"
 #include "debug.h"
-
-static inline void weights_init(float *dest, int samples, enum w_type w)
-{
-	switch(w) {
-		case WINDOW_TRIANGLE:
-			for (int i = 0; i < samples; i++)
-				dest[i] = 1 - 2*fabsf((i - ((samples - 1)/2.0f))/(samples - 1));
-			break;
-		case WINDOW_HANNING:
-			for (int i = 0; i < samples; i++)
-				dest[i] = 0.5f*(1 - cos((2*M_PI*i)/(samples - 1)));
-			break;
-		case WINDOW_HAMMING:
-			for (int i = 0; i < samples; i++)
-				dest[i] = 0.54 - 0.46*cos((2*M_PI*i)/(samples - 1));
-			break;
-		case WINDOW_BLACKMAN:
-			for (int i = 0; i < samples; i++) {
-				const float c1 = cos((2*M_PI*i)/(samples - 1));
-				const float c2 = cos((4*M_PI*i)/(samples - 1));
-				dest[i] = 0.42659 - 0.49656*c1 + 0.076849*c2;
-			}
-			break;
-		case WINDOW_BLACKMAN_HARRIS:
-			for (int i = 0; i < samples; i++) {
-				const float c1 = cos((2*M_PI*i)/(samples - 1));
-				const float c2 = cos((4*M_PI*i)/(samples - 1));
-				const float c3 = cos((6*M_PI*i)/(samples - 1));
-				dest[i] = 0.35875 - 0.48829*c1 + 0.14128*c2 - 0.001168*c3;
-			}
-			break;
-		case WINDOW_FLAT:
-			for (int i = 0; i < samples; i++)
-				dest[i] = 1.0f;
-			break;
-		case WINDOW_WELCH:
-			for (int i = 0; i < samples; i++)
-				dest[i] = 1 - pow((i - ((samples - 1)/2.0f))/((samples - 1)/2.0f), 2.0f);
-			break;
-		default:
-			for (int i = 0; i < samples; i++)
-				dest[i] = 0.0f;
-			break;
-	}
-	float sum = 0.0f;
-	for (int i = 0; i < samples; i++)
-		sum += dest[i];
-	for (int i = 0; i < samples; i++)
-		dest[i] /= sum;
-}
+#include <chrono>
 
 static void pa_context_state_cb(pa_context *c, void *userdata)
 {
@@ -119,7 +70,7 @@ PulseAudioSoundManager::~PulseAudioSoundManager()
 
 void PulseAudioSoundManager::Uninit()
 {
-	std::lock_guard<std::mutex> l(m_mutex);
+	m_analyzer.stop();
 
 	if (m_stream) {
 		pa_stream_disconnect(m_stream);
@@ -137,28 +88,16 @@ void PulseAudioSoundManager::Uninit()
 		m_main_loop = nullptr;
 	}
 
-	if (m_plan) {
-		fftwf_destroy_plan(m_plan);
-		m_plan = nullptr;
-	}
-
-	if (m_output) {
-		fftwf_free(m_output);
-		m_output = nullptr;
-	}
-
 	m_isInited = false;
 }
 
 bool PulseAudioSoundManager::init() {
 	int ret = 0;
-	m_buffer_samples = fftSize() * 2;
 	m_cont = 1;
 	m_ss.format = PA_SAMPLE_FLOAT32LE;
 	m_ss.rate = 44100;
 	m_ss.channels = 1;
-
-	init_buffers();
+	m_sampleRate = m_ss.rate;
 
 	m_main_loop = pa_threaded_mainloop_new();
 	m_context = pa_context_new(pa_threaded_mainloop_get_api(m_main_loop), "Prismatik");
@@ -345,15 +284,19 @@ void PulseAudioSoundManager::start(bool isEnabled)
 			pa_threaded_mainloop_unlock(m_main_loop);
 		}
 
-		// setup update timer (40hz)
+		m_analyzer.start(m_fftOverlap);
+
+		// setup update timer, 40hz or as often as a new spectrum comes if that's more often
 		using namespace std::chrono_literals;
-		m_timer.start(25ms);
+		const std::chrono::milliseconds hop(m_analyzer.hopSamples() * 1000 / m_ss.rate);
+		m_timer.start(qBound(std::chrono::milliseconds(1ms), hop, std::chrono::milliseconds(25ms)));
 		m_pa_alive_timer.start(1s);
 	}
 	else
 	{
 		m_timer.stop();
 		m_pa_alive_timer.stop();
+		m_analyzer.stop();
 		if (m_stream) {
 			ret = pa_stream_disconnect(m_stream);
 			pa_stream_unref(m_stream);
@@ -382,6 +325,8 @@ unlock_and_fail:
 
 void PulseAudioSoundManager::updateFft()
 {
+	// keep the last spectrum if the analysis didn't publish a new one yet
+	m_analyzer.takeSpectrum(m_fft);
 }
 
 void PulseAudioSoundManager::checkPulse()
@@ -404,82 +349,23 @@ void PulseAudioSoundManager::checkPulse()
 	}
 }
 
-void PulseAudioSoundManager::init_buffers()
-{
-	// just in case, free old stuff
-	if (m_plan) {
-		fftwf_destroy_plan(m_plan);
-		m_plan = nullptr;
-	}
-
-	if (m_output) {
-		fftwf_free(m_output);
-		m_output = nullptr;
-	}
-
-	/* Pulse buffer */
-	m_pa_samples_read = 0;
-	m_pa_buf.resize(m_buffer_samples * m_ss.channels);
-
-	/* FFTW buffer */
-	m_output = (fftwf_complex*) fftwf_alloc_complex(fftSize() + 1);
-	m_input.resize(m_buffer_samples);
-	m_plan = fftwf_plan_dft_r2c_1d(m_input.size(), m_input.data(), m_output, 0);
-
-	m_weights.resize(fftSize() + 1);
-	weights_init(m_weights.data(), m_weights.size(), WINDOW_HANNING); // TODO: BASS does hanning?
-}
-
-void PulseAudioSoundManager::process_fft()
-{
-	for (size_t i = 0; i < m_pa_buf.size(); i += m_ss.channels /* Mono anyway but... */) {
-		m_input[i] = m_pa_buf[i];
-	}
-
-	fftwf_execute(m_plan);
-
-	for (size_t i = 0; i < fftSize(); i++ ) {
-		m_fft[i] = sqrtf( pow(m_output[i][0], 2) + pow(m_output[i][1], 2) ) * m_weights[i];
-	}
-}
-
 void PulseAudioSoundManager::stream_read_cb (pa_stream *p, size_t nbytes, void *userdata)
 {
-	constexpr size_t sizeof_sample = sizeof(decltype(PulseAudioSoundManager::m_pa_buf)::value_type); // int16_t or float or...
 	PulseAudioSoundManager *pa = reinterpret_cast<PulseAudioSoundManager *> (userdata);
 	const void* padata = nullptr;
 
 	if (!pa->m_cont)
 		return;
 
-	std::lock_guard<std::mutex> lock(pa->m_mutex);
-
 	int ret = pa_stream_peek(p, &padata, &nbytes);
 
-	if (ret != PA_OK)
+	if (ret != PA_OK || nbytes == 0)
 		return;
 
-	if ((!padata && nbytes /* hole */)) {
-		ret = pa_stream_drop(p);
-		return;
-	}
-
-	// read data until buffer is full
-	size_t n_read_bytes = std::min(nbytes, (pa->m_buffer_samples - pa->m_pa_samples_read) * sizeof_sample);
-	if (n_read_bytes > 0)
-		memcpy(&pa->m_pa_buf[pa->m_pa_samples_read], padata, n_read_bytes);
-
-	pa->m_pa_samples_read += nbytes / sizeof_sample;
-
-	// if buffer is full, process FFT and read rest of the data if any
-	if (pa->m_pa_samples_read >= pa->m_buffer_samples)
-	{
-		pa->process_fft();
-		pa->m_pa_samples_read = 0;
-		memcpy(&pa->m_pa_buf[0], (uint8_t *)padata + n_read_bytes, std::min(nbytes - n_read_bytes, pa->m_buffer_samples * sizeof_sample));
-	}
+	if (padata)
+		pa->m_analyzer.write(static_cast<const float *>(padata), nbytes / sizeof(float));
 
-	//if copy succeeded, drop samples at pulse's side
+	// drop the samples (or the hole) at pulse's side
 	ret = pa_stream_drop(p);
 	if (ret != PA_OK)
 		qCritical() << Q_FUNC_INFO << "pa_stream_drop:" << pa_strerror(ret);
@@ -28,23 +28,8 @@
 #include <QTime>
 #include "SoundManagerBase.hpp"
 #include <pulse/pulseaudio.h>
-#include <vector>
-#include <mutex>
-
-#include <complex.h>
-#include <tgmath.h>
-#include <fftw3.h>
-
-enum w_type
-{
-	WINDOW_TRIANGLE,
-	WINDOW_HANNING,
-	WINDOW_HAMMING,
-	WINDOW_BLACKMAN,
-	WINDOW_BLACKMAN_HARRIS,
-	WINDOW_FLAT,
-	WINDOW_WELCH,
-};
+#include <atomic>
+#include "SpectrumAnalyzer.hpp"
 
 class PulseAudioSoundManager : public SoundManagerBase
 {
@@ -65,11 +50,8 @@ protected:
 
 private:
 	void Uninit();
-	void init_buffers();
-	void process_fft();
 	void populatePulseaudioDeviceList();
 
-	static void *pa_fft_thread(void *arg);
 	static void context_state_cb(pa_context *c, void *userdata);
 	static void stream_state_cb(pa_stream *s, void *userdata);
 	static void stream_read_cb (pa_stream *p, size_t nbytes, void *userdata);
@@ -82,8 +64,7 @@ private:
 
 	QTimer m_timer;
 	QTimer m_pa_alive_timer;
-	std::mutex m_mutex;
-	int m_cont = 0;
+	std::atomic<int> m_cont{0};
 
 	/* Pulse */
 	int m_pa_ready = 0;
@@ -96,13 +77,7 @@ private:
 	int m_buffering = 50;
 	QList<QPair<QString, QString>> m_devices; // buffer devices for index-to-name mapping purposes
 
-	/* Buffer */
-	std::vector<float> m_pa_buf;
-	size_t m_pa_samples_read, m_buffer_samples;
-
 	/* FFT */
-	fftwf_complex *m_output = nullptr; //special buffer with proper SIMD alignments
-	std::vector<float> m_input;
-	fftwf_plan m_plan = nullptr;
-	std::vector<float> m_weights;
+	// the read callback only hands samples over, FFTs run on the analyzer's thread
+	SpectrumAnalyzer m_analyzer{fftSize()};
 };
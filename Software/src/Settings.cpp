@@ -156,6 +156,14 @@ static const QString Timeout = QStringLiteral("Warls/Timeout");
 static const QString LedMilliAmps = QStringLiteral("Warls/LedMilliAmps");
 static const QString PowerSupplyAmps = QStringLiteral("Warls/PowerSupplyAmps");
 }
+namespace UdpFanout
+{
+static const QString NumberOfLeds = QStringLiteral("UdpFanout/NumberOfLeds");
+static const QString Endpoints = QStringLiteral("UdpFanout/Endpoints");
+static const QString Timeout = QStringLiteral("UdpFanout/Timeout");
+static const QString LedMilliAmps = QStringLiteral("UdpFanout/LedMilliAmps");
+static const QString PowerSupplyAmps = QStringLiteral("UdpFanout/PowerSupplyAmps");
+}
 } /*Key*/
 
 namespace Value
@@ -172,6 +180,7 @@ static const QString VirtualDevice = QStringLiteral("Virtual");
 static const QString DrgbDevice = QStringLiteral("DRGB");
 static const QString DnrgbDevice = QStringLiteral("DNRGB");
 static const QString WarlsDevice = QStringLiteral("WARLS");
+static const QString UdpFanoutDevice = QStringLiteral("UdpFanout");
 }
 
 } /*Value*/
@@ -196,6 +205,13 @@ static const QString OverBrighten = QStringLiteral("Grab/OverBrighten");
 static const QString IsMinimumLuminosityEnabled = QStringLiteral("Grab/IsMinimumLuminosityEnabled");
 static const QString IsDx1011GrabberEnabled = QStringLiteral("Grab/IsDX1011GrabberEnabled");
 static const QString IsDx9GrabbingEnabled = QStringLiteral("Grab/IsDX9GrabbingEnabled");
+static const QString IsIntegralImageEnabled = QStringLiteral("Grab/IsIntegralImageEnabled");
+static const QString SamplingStride = QStringLiteral("Grab/SamplingStride");
+static const QString IsAlignToDisplayRefreshEnabled = QStringLiteral("Grab/IsAlignToDisplayRefreshEnabled");
+static const QString IsDownscaleOnCaptureEnabled = QStringLiteral("Grab/IsDownscaleOnCaptureEnabled");
+static const QString SyntheticSource = QStringLiteral("Grab/SyntheticSource");
+static const QString SyntheticResolution = QStringLiteral("Grab/SyntheticResolution");
+static const QString SyntheticFrameRate = QStringLiteral("Grab/SyntheticFrameRate");
 static const QString IsApplyBlueLightReductionEnabled = QStringLiteral("Grab/IsApplyGammaRampEnabled");
 static const QString IsApplyColorTemperatureEnabled = QStringLiteral("Grab/IsApplyColorTemperatureEnabled");
 static const QString ColorTemperature = QStringLiteral("Grab/ColorTemperature");
@@ -218,6 +234,8 @@ static const QString MinColor = QStringLiteral("SoundVisualizer/MinColor");
 static const QString MaxColor = QStringLiteral("SoundVisualizer/MaxColor");
 static const QString IsLiquidMode = QStringLiteral("SoundVisualizer/LiquidMode");
 static const QString LiquidSpeed = QStringLiteral("SoundVisualizer/LiquidSpeed");
+static const QString FftOverlap = QStringLiteral("SoundVisualizer/FftOverlap");
+static const QString CaptureQuantum = QStringLiteral("SoundVisualizer/CaptureQuantum");
 }
 // [Device]
 namespace Device
@@ -230,6 +248,10 @@ static const QString BrightnessCap = QStringLiteral("Device/BrightnessCap");
 static const QString ColorDepth = QStringLiteral("Device/ColorDepth");
 static const QString Gamma = QStringLiteral("Device/Gamma");
 static const QString IsDitheringEnabled = QStringLiteral("Device/IsDitheringEnabled");
+static const QString TemporalFilter = QStringLiteral("Device/TemporalFilter");
+static const QString TemporalFilterTime = QStringLiteral("Device/TemporalFilterTime");
+static const QString OutputFrameRate = QStringLiteral("Device/OutputFrameRate");
+static const QString TransmitFrameRate = QStringLiteral("Device/TransmitFrameRate");
 }
 // [LED_i]
 namespace Led
@@ -262,6 +284,8 @@ static const QString QtEachWidget = QStringLiteral("QtEachWidget");
 static const QString WinAPI = QStringLiteral("WinAPI");
 static const QString WinAPIEachWidget = QStringLiteral("WinAPIEachWidget");
 static const QString X11 = QStringLiteral("X11");
+static const QString PipeWire = QStringLiteral("PipeWire");
+static const QString Synthetic = QStringLiteral("Synthetic");
 static const QString D3D9 = QStringLiteral("D3D9");
 static const QString MacCoreGraphics = QStringLiteral("MacCoreGraphics");
 static const QString MacAVFoundation = QStringLiteral("MacAVFoundation");
@@ -349,6 +373,7 @@ bool Settings::Initialize( const QString & applicationDirPath, bool isDebugLevel
 	setNewOptionMain(Main::Key::Drgb::NumberOfLeds,			Main::Drgb::NumberOfLedsDefault);
 	setNewOptionMain(Main::Key::Dnrgb::NumberOfLeds,		Main::Dnrgb::NumberOfLedsDefault);
 	setNewOptionMain(Main::Key::Warls::NumberOfLeds,		Main::Warls::NumberOfLedsDefault);
+	setNewOptionMain(Main::Key::UdpFanout::NumberOfLeds,	Main::UdpFanout::NumberOfLedsDefault);
 
 	setNewOptionMain(Main::Key::Adalight::LedMilliAmps,		Main::Device::LedMilliAmpsDefault);
 	setNewOptionMain(Main::Key::Ardulight::LedMilliAmps,	Main::Device::LedMilliAmpsDefault);
@@ -358,6 +383,7 @@ bool Settings::Initialize( const QString & applicationDirPath, bool isDebugLevel
 	setNewOptionMain(Main::Key::Drgb::LedMilliAmps,			Main::Device::LedMilliAmpsDefault);
 	setNewOptionMain(Main::Key::Dnrgb::LedMilliAmps,		Main::Device::LedMilliAmpsDefault);
 	setNewOptionMain(Main::Key::Warls::LedMilliAmps,		Main::Device::LedMilliAmpsDefault);
+	setNewOptionMain(Main::Key::UdpFanout::LedMilliAmps,	Main::Device::LedMilliAmpsDefault);
 
 	setNewOptionMain(Main::Key::Adalight::PowerSupplyAmps,	Main::Device::PowerSupplyAmpsDefault);
 	setNewOptionMain(Main::Key::Ardulight::PowerSupplyAmps,	Main::Device::PowerSupplyAmpsDefault);
@@ -367,6 +393,7 @@ bool Settings::Initialize( const QString & applicationDirPath, bool isDebugLevel
 	setNewOptionMain(Main::Key::Drgb::PowerSupplyAmps,		Main::Device::PowerSupplyAmpsDefault);
 	setNewOptionMain(Main::Key::Dnrgb::PowerSupplyAmps,		Main::Device::PowerSupplyAmpsDefault);
 	setNewOptionMain(Main::Key::Warls::PowerSupplyAmps,		Main::Device::PowerSupplyAmpsDefault);
+	setNewOptionMain(Main::Key::UdpFanout::PowerSupplyAmps,	Main::Device::PowerSupplyAmpsDefault);
 
 	setNewOptionMain(Main::Key::Drgb::Address,              Main::Drgb::AddressDefault);
 	setNewOptionMain(Main::Key::Drgb::Port,                 Main::Drgb::PortDefault);
@@ -380,6 +407,9 @@ bool Settings::Initialize( const QString & applicationDirPath, bool isDebugLevel
 	setNewOptionMain(Main::Key::Warls::Port,                Main::Warls::PortDefault);
 	setNewOptionMain(Main::Key::Warls::Timeout,             Main::Warls::TimeoutDefault);
 
+	setNewOptionMain(Main::Key::UdpFanout::Endpoints,       Main::UdpFanout::EndpointsDefault);
+	setNewOptionMain(Main::Key::UdpFanout::Timeout,         Main::UdpFanout::TimeoutDefault);
+
 	setNewOptionMain(Main::Key::CheckForUpdates,			Main::CheckForUpdates);
 	setNewOptionMain(Main::Key::InstallUpdates,				Main::InstallUpdates);
 
@@ -1015,6 +1045,30 @@ void Settings::setWarlsTimeout(const int timeout)
 	emit m_this->warlsTimeoutChanged(timeout);
 }
 
+QString Settings::getUdpFanoutEndpoints()
+{
+	return valueMain(Main::Key::UdpFanout::Endpoints).toString();
+}
+
+void Settings::setUdpFanoutEndpoints(const QString& endpoints)
+{
+	DEBUG_LOW_LEVEL << Q_FUNC_INFO;
+	setValueMain(Main::Key::UdpFanout::Endpoints, endpoints);
+	emit m_this->udpFanoutEndpointsChanged(endpoints);
+}
+
+int Settings::getUdpFanoutTimeout()
+{
+	return valueMain(Main::Key::UdpFanout::Timeout).toInt();
+}
+
+void Settings::setUdpFanoutTimeout(const int timeout)
+{
+	DEBUG_LOW_LEVEL << Q_FUNC_INFO;
+	setValueMain(Main::Key::UdpFanout::Timeout, timeout);
+	emit m_this->udpFanoutTimeoutChanged(timeout);
+}
+
 QStringList Settings::getSupportedSerialPortBaudRates()
 {
 	QStringList list;
@@ -1097,6 +1151,10 @@ void Settings::setNumberOfLeds(SupportedDevices::DeviceType device, int numberOf
 			case DeviceTypeWarls:
 			emit m_this->warlsNumberOfLedsChanged(numberOfLeds);
 			break;
+
+			case DeviceTypeUdpFanout:
+			emit m_this->udpFanoutNumberOfLedsChanged(numberOfLeds);
+			break;
 		default:
 			qCritical() << Q_FUNC_INFO << "Device type not recognized, device ==" << device << "numberOfLeds ==" << numberOfLeds;
 		}
@@ -1164,6 +1222,10 @@ void Settings::setDeviceLedMilliAmps(const SupportedDevices::DeviceType device,
 			case DeviceTypeWarls:
 			emit m_this->warlsLedMilliAmpsChanged(mAmps);
 			break;
+
+			case DeviceTypeUdpFanout:
+			emit m_this->udpFanoutLedMilliAmpsChanged(mAmps);
+			break;
 		default:
 			qCritical() << Q_FUNC_INFO << "Device type not recognized, device ==" << device << "LedMilliAmps ==" << mAmps;
 		}
@@ -1232,6 +1294,10 @@ void Settings::setDevicePowerSupplyAmps(const SupportedDevices::DeviceType devic
 			case DeviceTypeWarls:
 			emit m_this->warlsPowerSupplyAmpsChanged(amps);
 			break;
+
+			case DeviceTypeUdpFanout:
+			emit m_this->udpFanoutPowerSupplyAmpsChanged(amps);
+			break;
 		default:
 			qCritical() << Q_FUNC_INFO << "Device type not recognized, device ==" << device << "PowerSupplyAmps ==" << amps;
 		}
@@ -1380,6 +1446,90 @@ void Settings::setGrabGamma(double gamma)
 	emit m_this->grabGammaChanged(gamma);
 }
 
+bool Settings::isGrabIntegralImageEnabled()
+{
+	return value(Profile::Key::Grab::IsIntegralImageEnabled).toBool();
+}
+
+void Settings::setGrabIntegralImageEnabled(bool isEnabled)
+{
+	DEBUG_LOW_LEVEL << Q_FUNC_INFO;
+	setValue(Profile::Key::Grab::IsIntegralImageEnabled, isEnabled);
+	emit m_this->grabIntegralImageEnabledChanged(isEnabled);
+}
+
+int Settings::getGrabSamplingStride()
+{
+	return getValidGrabSamplingStride(value(Profile::Key::Grab::SamplingStride).toInt());
+}
+
+void Settings::setGrabSamplingStride(int value)
+{
+	DEBUG_LOW_LEVEL << Q_FUNC_INFO;
+	setValue(Profile::Key::Grab::SamplingStride, getValidGrabSamplingStride(value));
+	emit m_this->grabSamplingStrideChanged(getValidGrabSamplingStride(value));
+}
+
+bool Settings::isGrabAlignToDisplayRefreshEnabled()
+{
+	return value(Profile::Key::Grab::IsAlignToDisplayRefreshEnabled).toBool();
+}
+
+void Settings::setGrabAlignToDisplayRefreshEnabled(bool isEnabled)
+{
+	DEBUG_LOW_LEVEL << Q_FUNC_INFO;
+	setValue(Profile::Key::Grab::IsAlignToDisplayRefreshEnabled, isEnabled);
+	emit m_this->grabAlignToDisplayRefreshEnabledChanged(isEnabled);
+}
+
+bool Settings::isGrabDownscaleOnCaptureEnabled()
+{
+	return value(Profile::Key::Grab::IsDownscaleOnCaptureEnabled).toBool();
+}
+
+void Settings::setGrabDownscaleOnCaptureEnabled(bool isEnabled)
+{
+	DEBUG_LOW_LEVEL << Q_FUNC_INFO << isEnabled;
+	setValue(Profile::Key::Grab::IsDownscaleOnCaptureEnabled, isEnabled);
+	emit m_this->grabDownscaleOnCaptureEnabledChanged(isEnabled);
+}
+
+QString Settings::getGrabSyntheticSource()
+{
+	return value(Profile::Key::Grab::SyntheticSource).toString();
+}
+
+void Settings::setGrabSyntheticSource(const QString &source)
+{
+	DEBUG_LOW_LEVEL << Q_FUNC_INFO << source;
+	setValue(Profile::Key::Grab::SyntheticSource, source);
+	emit m_this->grabSyntheticSourceChanged(source);
+}
+
+QSize Settings::getGrabSyntheticResolution()
+{
+	return value(Profile::Key::Grab::SyntheticResolution).toSize();
+}
+
+void Settings::setGrabSyntheticResolution(const QSize &resolution)
+{
+	DEBUG_LOW_LEVEL << Q_FUNC_INFO << resolution;
+	setValue(Profile::Key::Grab::SyntheticResolution, resolution);
+	emit m_this->grabSyntheticResolutionChanged(resolution);
+}
+
+int Settings::getGrabSyntheticFrameRate()
+{
+	return getValidGrabSyntheticFrameRate(value(Profile::Key::Grab::SyntheticFrameRate).toInt());
+}
+
+void Settings::setGrabSyntheticFrameRate(int frameRate)
+{
+	DEBUG_LOW_LEVEL << Q_FUNC_INFO << frameRate;
+	setValue(Profile::Key::Grab::SyntheticFrameRate, getValidGrabSyntheticFrameRate(frameRate));
+	emit m_this->grabSyntheticFrameRateChanged(getValidGrabSyntheticFrameRate(frameRate));
+}
+
 bool Settings::isSendDataOnlyIfColorsChanges()
 {
 	return value(Profile::Key::Grab::IsSendDataOnlyIfColorsChanges).toBool();
@@ -1510,6 +1660,54 @@ void Settings::setDeviceDitheringEnabled(bool isEnabled)
 	emit m_this->deviceDitheringEnabledChanged(isEnabled);
 }
 
+int Settings::getDeviceTemporalFilter()
+{
+	return getValidDeviceTemporalFilter(value(Profile::Key::Device::TemporalFilter).toInt());
+}
+
+void Settings::setDeviceTemporalFilter(int mode)
+{
+	DEBUG_LOW_LEVEL << Q_FUNC_INFO << mode;
+	setValue(Profile::Key::Device::TemporalFilter, getValidDeviceTemporalFilter(mode));
+	emit m_this->deviceTemporalFilterChanged(getValidDeviceTemporalFilter(mode));
+}
+
+int Settings::getDeviceTemporalFilterTime()
+{
+	return getValidDeviceTemporalFilterTime(value(Profile::Key::Device::TemporalFilterTime).toInt());
+}
+
+void Settings::setDeviceTemporalFilterTime(int ms)
+{
+	DEBUG_LOW_LEVEL << Q_FUNC_INFO << ms;
+	setValue(Profile::Key::Device::TemporalFilterTime, getValidDeviceTemporalFilterTime(ms));
+	emit m_this->deviceTemporalFilterTimeChanged(getValidDeviceTemporalFilterTime(ms));
+}
+
+int Settings::getDeviceOutputFrameRate()
+{
+	return getValidDeviceOutputFrameRate(value(Profile::Key::Device::OutputFrameRate).toInt());
+}
+
+void Settings::setDeviceOutputFrameRate(int hz)
+{
+	DEBUG_LOW_LEVEL << Q_FUNC_INFO << hz;
+	setValue(Profile::Key::Device::OutputFrameRate, getValidDeviceOutputFrameRate(hz));
+	emit m_this->deviceOutputFrameRateChanged(getValidDeviceOutputFrameRate(hz));
+}
+
+int Settings::getDeviceTransmitFrameRate()
+{
+	return getValidDeviceTransmitFrameRate(value(Profile::Key::Device::TransmitFrameRate).toInt());
+}
+
+void Settings::setDeviceTransmitFrameRate(int hz)
+{
+	DEBUG_LOW_LEVEL << Q_FUNC_INFO << hz;
+	setValue(Profile::Key::Device::TransmitFrameRate, getValidDeviceTransmitFrameRate(hz));
+	emit m_this->deviceTransmitFrameRateChanged(getValidDeviceTransmitFrameRate(hz));
+}
+
 Grab::GrabberType Settings::getGrabberType()
 {
 	DEBUG_LOW_LEVEL << Q_FUNC_INFO;
@@ -1547,6 +1745,16 @@ Grab::GrabberType Settings::getGrabberType()
 		return Grab::GrabberTypeX11;
 #endif
 
+#ifdef PIPEWIRE_GRAB_SUPPORT
+	if (strGrabber == Profile::Value::GrabberType::PipeWire)
+		return Grab::GrabberTypePipeWire;
+#endif
+
+#ifdef SYNTHETIC_GRAB_SUPPORT
+	if (strGrabber == Profile::Value::GrabberType::Synthetic)
+		return Grab::GrabberTypeSynthetic;
+#endif
+
 #ifdef MAC_OS_CG_GRAB_SUPPORT
 	if (strGrabber == Profile::Value::GrabberType::MacCoreGraphics)
 		return Grab::GrabberTypeMacCoreGraphics;
@@ -1605,6 +1813,18 @@ void Settings::setGrabberType(Grab::GrabberType grabberType)
 		break;
 #endif
 
+#ifdef PIPEWIRE_GRAB_SUPPORT
+	case Grab::GrabberTypePipeWire:
+		strGrabber = Profile::Value::GrabberType::PipeWire;
+		break;
+#endif
+
+#ifdef SYNTHETIC_GRAB_SUPPORT
+	case Grab::GrabberTypeSynthetic:
+		strGrabber = Profile::Value::GrabberType::Synthetic;
+		break;
+#endif
+
 #ifdef MAC_OS_CG_GRAB_SUPPORT
 	case Grab::GrabberTypeMacCoreGraphics:
 		strGrabber = Profile::Value::GrabberType::MacCoreGraphics;
@@ -1828,6 +2048,34 @@ void Settings::setSoundVisualizerLiquidSpeed(int value)
 	setValue(Profile::Key::SoundVisualizer::LiquidSpeed, getValidSoundVisualizerLiquidSpeed(value));
 	emit m_this->soundVisualizerLiquidSpeedChanged(value);
 }
+
+int Settings::getSoundVisualizerFftOverlap()
+{
+	DEBUG_LOW_LEVEL << Q_FUNC_INFO;
+	return getValidSoundVisualizerFftOverlap(value(Profile::Key::SoundVisualizer::FftOverlap).toInt());
+}
+
+void Settings::setSoundVisualizerFftOverlap(int value)
+{
+	DEBUG_LOW_LEVEL << Q_FUNC_INFO;
+	value = getValidSoundVisualizerFftOverlap(value);
+	setValue(Profile::Key::SoundVisualizer::FftOverlap, value);
+	emit m_this->soundVisualizerFftOverlapChanged(value);
+}
+
+int Settings::getSoundVisualizerCaptureQuantum()
+{
+	DEBUG_LOW_LEVEL << Q_FUNC_INFO;
+	return getValidSoundVisualizerCaptureQuantum(value(Profile::Key::SoundVisualizer::CaptureQuantum).toInt());
+}
+
+void Settings::setSoundVisualizerCaptureQuantum(int value)
+{
+	DEBUG_LOW_LEVEL << Q_FUNC_INFO;
+	value = getValidSoundVisualizerCaptureQuantum(value);
+	setValue(Profile::Key::SoundVisualizer::CaptureQuantum, value);
+	emit m_this->soundVisualizerCaptureQuantumChanged(value);
+}
 #endif
 
 QList<WBAdjustment> Settings::getLedCoefs()
@@ -1880,7 +2128,11 @@ void Settings::setLedCoefBlue(int ledIndex, double value)
 
 QSize Settings::getLedSize(int ledIndex)
 {
-	return value(QStringLiteral("%1%2/%3").arg(Profile::Key::Led::Prefix, QString::number(ledIndex + 1), Profile::Key::Led::Size)).toSize();
+	QVariant result = value(QStringLiteral("%1%2/%3").arg(Profile::Key::Led::Prefix, QString::number(ledIndex + 1), Profile::Key::Led::Size));
+	if (result.isNull())
+		return Profile::Led::SizeDefault;
+	else
+		return result.toSize();
 }
 
 void Settings::setLedSize(int ledIndex, QSize size)
@@ -1892,7 +2144,11 @@ void Settings::setLedSize(int ledIndex, QSize size)
 
 QPoint Settings::getLedPosition(int ledIndex)
 {
-	return value(QStringLiteral("%1%2/%3").arg(Profile::Key::Led::Prefix, QString::number(ledIndex + 1), Profile::Key::Led::Position)).toPoint();
+	QVariant result = value(QStringLiteral("%1%2/%3").arg(Profile::Key::Led::Prefix, QString::number(ledIndex + 1), Profile::Key::Led::Position));
+	if (result.isNull())
+		return getDefaultPosition(ledIndex);
+	else
+		return result.toPoint();
 }
 
 void Settings::setLedPosition(int ledIndex, QPoint position)
@@ -1955,6 +2211,42 @@ int Settings::getValidDeviceSmooth(int value)
 	return value;
 }
 
+int Settings::getValidDeviceTemporalFilter(int value)
+{
+	if (value < Profile::Device::TemporalFilterMin)
+		value = Profile::Device::TemporalFilterMin;
+	else if (value > Profile::Device::TemporalFilterMax)
+		value = Profile::Device::TemporalFilterMax;
+	return value;
+}
+
+int Settings::getValidDeviceTemporalFilterTime(int value)
+{
+	if (value < Profile::Device::TemporalFilterTimeMin)
+		value = Profile::Device::TemporalFilterTimeMin;
+	else if (value > Profile::Device::TemporalFilterTimeMax)
+		value = Profile::Device::TemporalFilterTimeMax;
+	return value;
+}
+
+int Settings::getValidDeviceOutputFrameRate(int value)
+{
+	if (value < Profile::Device::OutputFrameRateMin)
+		value = Profile::Device::OutputFrameRateMin;
+	else if (value > Profile::Device::OutputFrameRateMax)
+		value = Profile::Device::OutputFrameRateMax;
+	return value;
+}
+
+int Settings::getValidDeviceTransmitFrameRate(int value)
+{
+	if (value < Profile::Device::TransmitFrameRateMin)
+		value = Profile::Device::TransmitFrameRateMin;
+	else if (value > Profile::Device::TransmitFrameRateMax)
+		value = Profile::Device::TransmitFrameRateMax;
+	return value;
+}
+
 int Settings::getValidDeviceColorDepth(int value)
 {
 	if (value < Profile::Device::ColorDepthMin)
@@ -2000,6 +2292,24 @@ int Settings::getValidSoundVisualizerLiquidSpeed(int value)
 	return value;
 }
 
+int Settings::getValidSoundVisualizerFftOverlap(int value)
+{
+	if (value < Profile::SoundVisualizer::FftOverlapMin)
+		value = Profile::SoundVisualizer::FftOverlapMin;
+	else if (value > Profile::SoundVisualizer::FftOverlapMax)
+		value = Profile::SoundVisualizer::FftOverlapMax;
+	return value;
+}
+
+int Settings::getValidSoundVisualizerCaptureQuantum(int value)
+{
+	if (value < Profile::SoundVisualizer::CaptureQuantumMin)
+		value = Profile::SoundVisualizer::CaptureQuantumMin;
+	else if (value > Profile::SoundVisualizer::CaptureQuantumMax)
+		value = Profile::SoundVisualizer::CaptureQuantumMax;
+	return value;
+}
+
 int Settings::getValidLuminosityThreshold(int value)
 {
 	if (value < Profile::Grab::LuminosityThresholdMin)
@@ -2018,6 +2328,24 @@ int Settings::getValidGrabOverBrighten(int value)
 	return value;
 }
 
+int Settings::getValidGrabSyntheticFrameRate(int value)
+{
+	if (value < Profile::Grab::SyntheticFrameRateMin)
+		value = Profile::Grab::SyntheticFrameRateMin;
+	else if (value > Profile::Grab::SyntheticFrameRateMax)
+		value = Profile::Grab::SyntheticFrameRateMax;
+	return value;
+}
+
+int Settings::getValidGrabSamplingStride(int value)
+{
+	if (value < Profile::Grab::SamplingStrideMin)
+		value = Profile::Grab::SamplingStrideMin;
+	else if (value > Profile::Grab::SamplingStrideMax)
+		value = Profile::Grab::SamplingStrideMax;
+	return value;
+}
+
 void Settings::setValidLedCoef(int ledIndex, const QString & keyCoef, double coef)
 {
 	if (coef < Profile::Led::CoefMin || coef > Profile::Led::CoefMax){
@@ -2036,8 +2364,12 @@ void Settings::setValidLedCoef(int ledIndex, const QString & keyCoef, double coe
 
 double Settings::getValidLedCoef(int ledIndex, const QString & keyCoef)
 {
+	const QVariant stored = Settings::value(QStringLiteral("%1%2/%3").arg(Profile::Key::Led::Prefix, QString::number(ledIndex + 1), keyCoef));
+	if (stored.isNull())
+		return Profile::Led::CoefDefault; // LED past the ones the profile was initialized for
+
 	bool ok = false;
-	double coef = Settings::value(QStringLiteral("%1%2/%3").arg(Profile::Key::Led::Prefix, QString::number(ledIndex + 1), keyCoef)).toDouble(&ok);
+	double coef = stored.toDouble(&ok);
 	QString error;
 	if (ok == false){
 		error = QStringLiteral("Error: Convert to double.");
@@ -2109,6 +2441,13 @@ void Settings::initCurrentProfile(bool isResetDefault)
 	setNewOption(Profile::Key::Grab::IsMinimumLuminosityEnabled,	Profile::Grab::IsMinimumLuminosityEnabledDefault, isResetDefault);
 	setNewOption(Profile::Key::Grab::IsDx1011GrabberEnabled,		Profile::Grab::IsDx1011GrabberEnabledDefault, isResetDefault);
 	setNewOption(Profile::Key::Grab::IsDx9GrabbingEnabled,			Profile::Grab::IsDx9GrabbingEnabledDefault, isResetDefault);
+	setNewOption(Profile::Key::Grab::IsIntegralImageEnabled,		Profile::Grab::IsIntegralImageEnabledDefault, isResetDefault);
+	setNewOption(Profile::Key::Grab::SamplingStride,				Profile::Grab::SamplingStrideDefault, isResetDefault);
+	setNewOption(Profile::Key::Grab::IsAlignToDisplayRefreshEnabled,	Profile::Grab::IsAlignToDisplayRefreshEnabledDefault, isResetDefault);
+	setNewOption(Profile::Key::Grab::IsDownscaleOnCaptureEnabled,	Profile::Grab::IsDownscaleOnCaptureEnabledDefault, isResetDefault);
+	setNewOption(Profile::Key::Grab::SyntheticSource,				Profile::Grab::SyntheticSourceDefault, isResetDefault);
+	setNewOption(Profile::Key::Grab::SyntheticResolution,			Profile::Grab::SyntheticResolutionDefault, isResetDefault);
+	setNewOption(Profile::Key::Grab::SyntheticFrameRate,			Profile::Grab::SyntheticFrameRateDefault, isResetDefault);
 	setNewOption(Profile::Key::Grab::IsApplyBlueLightReductionEnabled,		Profile::Grab::IsApplyBlueLightReductionEnabledDefault, isResetDefault);
 	setNewOption(Profile::Key::Grab::IsApplyColorTemperatureEnabled,Profile::Grab::IsApplyColorTemperatureEnabledDefault, isResetDefault);
 	setNewOption(Profile::Key::Grab::ColorTemperature,              Profile::Grab::ColorTemperatureDefault, isResetDefault);
@@ -2126,6 +2465,8 @@ void Settings::initCurrentProfile(bool isResetDefault)
 	setNewOption(Profile::Key::SoundVisualizer::MaxColor,			Profile::SoundVisualizer::MaxColorDefault, isResetDefault);
 	setNewOption(Profile::Key::SoundVisualizer::IsLiquidMode,		Profile::SoundVisualizer::IsLiquidModeDefault, isResetDefault);
 	setNewOption(Profile::Key::SoundVisualizer::LiquidSpeed,		Profile::SoundVisualizer::LiquidSpeedDefault, isResetDefault);
+	setNewOption(Profile::Key::SoundVisualizer::FftOverlap,		Profile::SoundVisualizer::FftOverlapDefault, isResetDefault);
+	setNewOption(Profile::Key::SoundVisualizer::CaptureQuantum,	Profile::SoundVisualizer::CaptureQuantumDefault, isResetDefault);
 #endif
 	// [Device]
 	setNewOption(Profile::Key::Device::RefreshDelay,				Profile::Device::RefreshDelayDefault, isResetDefault);
@@ -2136,11 +2477,28 @@ void Settings::initCurrentProfile(bool isResetDefault)
 	setNewOption(Profile::Key::Device::Gamma,						Profile::Device::GammaDefault, isResetDefault);
 	setNewOption(Profile::Key::Device::ColorDepth,					Profile::Device::ColorDepthDefault, isResetDefault);
 	setNewOption(Profile::Key::Device::IsDitheringEnabled,			Profile::Device::IsDitheringEnabledDefault, isResetDefault);
+	setNewOption(Profile::Key::Device::TemporalFilter,				Profile::Device::TemporalFilterDefault, isResetDefault);
+	setNewOption(Profile::Key::Device::TemporalFilterTime,			Profile::Device::TemporalFilterTimeDefault, isResetDefault);
+	setNewOption(Profile::Key::Device::OutputFrameRate,				Profile::Device::OutputFrameRateDefault, isResetDefault);
+	setNewOption(Profile::Key::Device::TransmitFrameRate,			Profile::Device::TransmitFrameRateDefault, isResetDefault);
 
 
 	QPoint ledPosition;
 
-	for (int i = 0; i < MaximumNumberOfLeds::AbsoluteMaximum; i++)
+	// only LEDs the connected device uses get keys, so profiles don't grow with the largest
+	// device maximum, getters return the defaults for LEDs without keys
+	const int numberOfLeds = getNumberOfLeds(getConnectedDevice());
+
+	if (isResetDefault)
+	{
+		QMutexLocker locker(&m_mutex);
+		const QStringList groups = m_currentProfile->childGroups();
+		for (const QString &group : groups)
+			if (group.startsWith(Profile::Key::Led::Prefix) && group.mid(Profile::Key::Led::Prefix.size()).toInt() > numberOfLeds)
+				m_currentProfile->remove(group);
+	}
+
+	for (int i = 0; i < numberOfLeds; i++)
 	{
 		ledPosition = getDefaultPosition(i);
 
@@ -2266,6 +2624,7 @@ void Settings::initDevicesMap()
 	m_devicesTypeToNameMap[SupportedDevices::DeviceTypeDrgb] = Main::Value::ConnectedDevice::DrgbDevice;
 	m_devicesTypeToNameMap[SupportedDevices::DeviceTypeDnrgb] = Main::Value::ConnectedDevice::DnrgbDevice;
 	m_devicesTypeToNameMap[SupportedDevices::DeviceTypeWarls] = Main::Value::ConnectedDevice::WarlsDevice;
+	m_devicesTypeToNameMap[SupportedDevices::DeviceTypeUdpFanout] = Main::Value::ConnectedDevice::UdpFanoutDevice;
 
 	m_devicesTypeToKeyNumberOfLedsMap[SupportedDevices::DeviceTypeAdalight] = Main::Key::Adalight::NumberOfLeds;
 	m_devicesTypeToKeyNumberOfLedsMap[SupportedDevices::DeviceTypeArdulight] = Main::Key::Ardulight::NumberOfLeds;
@@ -2274,6 +2633,7 @@ void Settings::initDevicesMap()
 	m_devicesTypeToKeyNumberOfLedsMap[SupportedDevices::DeviceTypeDrgb] = Main::Key::Drgb::NumberOfLeds;
 	m_devicesTypeToKeyNumberOfLedsMap[SupportedDevices::DeviceTypeDnrgb] = Main::Key::Dnrgb::NumberOfLeds;
 	m_devicesTypeToKeyNumberOfLedsMap[SupportedDevices::DeviceTypeWarls] = Main::Key::Warls::NumberOfLeds;
+	m_devicesTypeToKeyNumberOfLedsMap[SupportedDevices::DeviceTypeUdpFanout] = Main::Key::UdpFanout::NumberOfLeds;
 
 	m_devicesTypeToKeyLedMilliAmpsMap[SupportedDevices::DeviceTypeAdalight] = Main::Key::Adalight::LedMilliAmps;
 	m_devicesTypeToKeyLedMilliAmpsMap[SupportedDevices::DeviceTypeArdulight] = Main::Key::Ardulight::LedMilliAmps;
@@ -2282,6 +2642,7 @@ void Settings::initDevicesMap()
 	m_devicesTypeToKeyLedMilliAmpsMap[SupportedDevices::DeviceTypeDrgb] = Main::Key::Drgb::LedMilliAmps;
 	m_devicesTypeToKeyLedMilliAmpsMap[SupportedDevices::DeviceTypeDnrgb] = Main::Key::Dnrgb::LedMilliAmps;
 	m_devicesTypeToKeyLedMilliAmpsMap[SupportedDevices::DeviceTypeWarls] = Main::Key::Warls::LedMilliAmps;
+	m_devicesTypeToKeyLedMilliAmpsMap[SupportedDevices::DeviceTypeUdpFanout] = Main::Key::UdpFanout::LedMilliAmps;
 
 	m_devicesTypeToKeyPowerSupplyAmpsMap[SupportedDevices::DeviceTypeAdalight] = Main::Key::Adalight::PowerSupplyAmps;
 	m_devicesTypeToKeyPowerSupplyAmpsMap[SupportedDevices::DeviceTypeArdulight] = Main::Key::Ardulight::PowerSupplyAmps;
@@ -2290,6 +2651,7 @@ void Settings::initDevicesMap()
 	m_devicesTypeToKeyPowerSupplyAmpsMap[SupportedDevices::DeviceTypeDrgb] = Main::Key::Drgb::PowerSupplyAmps;
 	m_devicesTypeToKeyPowerSupplyAmpsMap[SupportedDevices::DeviceTypeDnrgb] = Main::Key::Dnrgb::PowerSupplyAmps;
 	m_devicesTypeToKeyPowerSupplyAmpsMap[SupportedDevices::DeviceTypeWarls] = Main::Key::Warls::PowerSupplyAmps;
+	m_devicesTypeToKeyPowerSupplyAmpsMap[SupportedDevices::DeviceTypeUdpFanout] = Main::Key::UdpFanout::PowerSupplyAmps;
 #ifdef ALIEN_FX_SUPPORTED
 	m_devicesTypeToNameMap[SupportedDevices::DeviceTypeAlienFx] = Main::Value::ConnectedDevice::AlienFxDevice;
 	m_devicesTypeToKeyNumberOfLedsMap[SupportedDevices::DeviceTypeAlienFx] = Main::Key::AlienFx::NumberOfLeds;
@@ -148,6 +148,10 @@ public:
 	static void setWarlsPort(const QString& port);
 	static int getWarlsTimeout();
 	static void setWarlsTimeout(const int timeout);
+	static QString getUdpFanoutEndpoints();
+	static void setUdpFanoutEndpoints(const QString& endpoints);
+	static int getUdpFanoutTimeout();
+	static void setUdpFanoutTimeout(const int timeout);
 	static int getDeviceLedMilliAmps(const SupportedDevices::DeviceType device);
 	static void setDeviceLedMilliAmps(const SupportedDevices::DeviceType device, const int mamps);
 	static double getDevicePowerSupplyAmps(const SupportedDevices::DeviceType device);
@@ -178,6 +182,20 @@ public:
 	static void setGrabColorTemperature(int value);
 	static double getGrabGamma();
 	static void setGrabGamma(double gamma);
+	static bool isGrabIntegralImageEnabled();
+	static void setGrabIntegralImageEnabled(bool isEnabled);
+	static int getGrabSamplingStride();
+	static void setGrabSamplingStride(int value);
+	static bool isGrabAlignToDisplayRefreshEnabled();
+	static void setGrabAlignToDisplayRefreshEnabled(bool isEnabled);
+	static bool isGrabDownscaleOnCaptureEnabled();
+	static void setGrabDownscaleOnCaptureEnabled(bool isEnabled);
+	static QString getGrabSyntheticSource();
+	static void setGrabSyntheticSource(const QString &source);
+	static QSize getGrabSyntheticResolution();
+	static void setGrabSyntheticResolution(const QSize &resolution);
+	static int getGrabSyntheticFrameRate();
+	static void setGrabSyntheticFrameRate(int frameRate);
 	static bool isSendDataOnlyIfColorsChanges();
 	static void setSendDataOnlyIfColorsChanges(bool isEnabled);
 	static int getLuminosityThreshold();
@@ -201,6 +219,14 @@ public:
 	static void setDeviceGamma(double gamma);
 	static bool isDeviceDitheringEnabled();
 	static void setDeviceDitheringEnabled(bool isEnabled);
+	static int getDeviceTemporalFilter();
+	static void setDeviceTemporalFilter(int mode);
+	static int getDeviceTemporalFilterTime();
+	static void setDeviceTemporalFilterTime(int ms);
+	static int getDeviceOutputFrameRate();
+	static void setDeviceOutputFrameRate(int hz);
+	static int getDeviceTransmitFrameRate();
+	static void setDeviceTransmitFrameRate(int hz);
 
 	static Grab::GrabberType getGrabberType();
 	static void setGrabberType(Grab::GrabberType grabMode);
@@ -236,6 +262,10 @@ public:
 	static void setSoundVisualizerLiquidMode(bool isLiquidMode);
 	static int getSoundVisualizerLiquidSpeed();
 	static void setSoundVisualizerLiquidSpeed(int value);
+	static int getSoundVisualizerFftOverlap();
+	static void setSoundVisualizerFftOverlap(int value);
+	static int getSoundVisualizerCaptureQuantum();
+	static void setSoundVisualizerCaptureQuantum(int value);
 #endif
 
 	static QList<WBAdjustment> getLedCoefs();
@@ -269,11 +299,19 @@ private:
 	static int getValidDeviceSmooth(int value);
 	static int getValidDeviceColorDepth(int value);
 	static double getValidDeviceGamma(double value);
+	static int getValidDeviceTemporalFilter(int value);
+	static int getValidDeviceTemporalFilterTime(int value);
+	static int getValidDeviceOutputFrameRate(int value);
+	static int getValidDeviceTransmitFrameRate(int value);
 	static int getValidGrabSlowdown(int value);
 	static int getValidMoodLampSpeed(int value);
 	static int getValidSoundVisualizerLiquidSpeed(int value);
+	static int getValidSoundVisualizerFftOverlap(int value);
+	static int getValidSoundVisualizerCaptureQuantum(int value);
 	static int getValidLuminosityThreshold(int value);
 	static int getValidGrabOverBrighten(int value);
+	static int getValidGrabSamplingStride(int value);
+	static int getValidGrabSyntheticFrameRate(int value);
 	static void setValidLedCoef(int ledIndex, const QString & keyCoef, double coef);
 	static double getValidLedCoef(int ledIndex, const QString & keyCoef);
 
@@ -336,6 +374,10 @@ signals:
 	void warlsTimeoutChanged(const int timeout);
 	void warlsLedMilliAmpsChanged(const int mAmps);
 	void warlsPowerSupplyAmpsChanged(const double amps);
+	void udpFanoutEndpointsChanged(const QString& endpoints);
+	void udpFanoutTimeoutChanged(const int timeout);
+	void udpFanoutLedMilliAmpsChanged(const int mAmps);
+	void udpFanoutPowerSupplyAmpsChanged(const double amps);
 	void lightpackNumberOfLedsChanged(int numberOfLeds);
 	void lightpackLedMilliAmpsChanged(const int mAmps);
 	void lightpackPowerSupplyAmpsChanged(const double amps);
@@ -344,6 +386,7 @@ signals:
 	void drgbNumberOfLedsChanged(int numberOfLeds);
 	void dnrgbNumberOfLedsChanged(int numberOfLeds);
 	void warlsNumberOfLedsChanged(int numberOfLeds);
+	void udpFanoutNumberOfLedsChanged(int numberOfLeds);
 	void virtualNumberOfLedsChanged(int numberOfLeds);
 	void virtualLedMilliAmpsChanged(const int mAmps);
 	void virtualPowerSupplyAmpsChanged(const double amps);
@@ -355,6 +398,13 @@ signals:
 	void grabApplyColorTemperatureChanged(bool isEnabled);
 	void grabColorTemperatureChanged(int value);
 	void grabGammaChanged(double value);
+	void grabIntegralImageEnabledChanged(bool isEnabled);
+	void grabSamplingStrideChanged(int value);
+	void grabAlignToDisplayRefreshEnabledChanged(bool isEnabled);
+	void grabDownscaleOnCaptureEnabledChanged(bool isEnabled);
+	void grabSyntheticSourceChanged(const QString &source);
+	void grabSyntheticResolutionChanged(const QSize &resolution);
+	void grabSyntheticFrameRateChanged(int frameRate);
 	void sendDataOnlyIfColorsChangesChanged(bool isEnabled);
 	void luminosityThresholdChanged(int value);
 	void minimumLuminosityEnabledChanged(bool value);
@@ -366,6 +416,10 @@ signals:
 	void deviceColorDepthChanged(int value);
 	void deviceGammaChanged(double gamma);
 	void deviceDitheringEnabledChanged(bool isEnabled);
+	void deviceTemporalFilterChanged(int mode);
+	void deviceTemporalFilterTimeChanged(int ms);
+	void deviceOutputFrameRateChanged(int hz);
+	void deviceTransmitFrameRateChanged(int hz);
 	void deviceColorSequenceChanged(QString value);
 	void grabberTypeChanged(const Grab::GrabberType grabMode);
 #ifdef D3D10_GRAB_SUPPORT
@@ -384,6 +438,8 @@ signals:
 	void soundVisualizerMaxColorChanged(const QColor color);
 	void soundVisualizerLiquidModeChanged(bool isLiquidMode);
 	void soundVisualizerLiquidSpeedChanged(int value);
+	void soundVisualizerFftOverlapChanged(int value);
+	void soundVisualizerCaptureQuantumChanged(int value);
 #endif
 	void ledCoefRedChanged(int ledIndex, double value);
 	void ledCoefGreenChanged(int ledIndex, double value);
@@ -32,9 +32,9 @@
 #include "enums.hpp"
 
 #ifdef ALIEN_FX_SUPPORTED
-#	define SUPPORTED_DEVICES			"Lightpack,AlienFx,Adalight,Ardulight,Virtual,DRGB,DNRGB,WARLS"
+#	define SUPPORTED_DEVICES			"Lightpack,AlienFx,Adalight,Ardulight,Virtual,DRGB,DNRGB,WARLS,UdpFanout"
 #else
-#	define SUPPORTED_DEVICES			"Lightpack,Adalight,Ardulight,Virtual,DRGB,DNRGB,WARLS"
+#	define SUPPORTED_DEVICES			"Lightpack,Adalight,Ardulight,Virtual,DRGB,DNRGB,WARLS,UdpFanout"
 #endif
 
 #define _GRABMODE_ENUM(_name_)		::Grab::GrabberType##_name_
@@ -154,6 +154,12 @@ static const QString AddressDefault = QStringLiteral("127.0.0.1");
 static const QString PortDefault = QStringLiteral("21324");
 static const int TimeoutDefault = 255;
 }
+namespace UdpFanout
+{
+static const int NumberOfLedsDefault = 10;
+static const QString EndpointsDefault = QStringLiteral("127.0.0.1:21324=0-9"); /* ';' separated address:port=first-last */
+static const int TimeoutDefault = 255;
+}
 }
 
 // ProfileName.ini
@@ -173,6 +179,14 @@ static const bool IsSendDataOnlyIfColorsChangesDefault = false;
 static const bool IsMinimumLuminosityEnabledDefault = true;
 static const bool IsDx1011GrabberEnabledDefault = false;
 static const bool IsDx9GrabbingEnabledDefault = false;
+static const bool IsIntegralImageEnabledDefault = false;
+static const bool IsAlignToDisplayRefreshEnabledDefault = false;
+static const bool IsDownscaleOnCaptureEnabledDefault = false;
+static const QString SyntheticSourceDefault = QStringLiteral("gradient");
+static const QSize SyntheticResolutionDefault = QSize(640, 360);
+static const int SyntheticFrameRateMin = 0;
+static const int SyntheticFrameRateDefault = 0; // follow the grab interval
+static const int SyntheticFrameRateMax = 1000;
 static const int SlowdownMin = 1;
 static const int SlowdownDefault = 50;
 static const int SlowdownMax = 1000;
@@ -190,6 +204,9 @@ static const int ColorTemperatureMax = 10000;
 static const double GammaMin = 0.05;
 static const double GammaDefault = 1.2;
 static const double GammaMax = 10.0;
+static const int SamplingStrideMin = 1;
+static const int SamplingStrideDefault = 1;
+static const int SamplingStrideMax = 16;
 }
 // [MoodLamp]
 namespace MoodLamp
@@ -212,6 +229,13 @@ static const bool IsLiquidModeDefault = true;
 static const int LiquidSpeedMin = 1;
 static const int LiquidSpeedDefault = 10;
 static const int LiquidSpeedMax = 100;
+static const int FftOverlapMin = 0;
+static const int FftOverlapDefault = 75;
+static const int FftOverlapMax = 90;
+// frames per capture period, PipeWire's quantum
+static const int CaptureQuantumMin = 32;
+static const int CaptureQuantumDefault = 256;
+static const int CaptureQuantumMax = 8192;
 }
 // [Device]
 namespace Device
@@ -243,6 +267,24 @@ static const double GammaDefault = 2.0;
 static const double GammaMax = 10.0;
 
 static const bool IsDitheringEnabledDefault = false;
+
+// PrismatikMath::TemporalFilter::Mode
+static const int TemporalFilterMin = 0;
+static const int TemporalFilterDefault = 0;
+static const int TemporalFilterMax = 3;
+
+static const int TemporalFilterTimeMin = 1;
+static const int TemporalFilterTimeDefault = 100;
+static const int TemporalFilterTimeMax = 2000;
+
+static const int OutputFrameRateMin = 10;
+static const int OutputFrameRateDefault = 60;
+static const int OutputFrameRateMax = 240;
+
+// 0 sends as soon as the device is done with the previous frame; serial devices are limited by the baud rate as well
+static const int TransmitFrameRateMin = 0;
+static const int TransmitFrameRateDefault = 0;
+static const int TransmitFrameRateMax = 1000;
 }
 // [LED_i]
 namespace Led
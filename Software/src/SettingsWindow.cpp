@@ -120,12 +120,15 @@ SettingsWindow::SettingsWindow(QWidget *parent) :
 	labelProfile->setStyleSheet(QStringLiteral("margin-left:1em"));
 	labelDevice = new QLabel(statusBar());
 	labelFPS	= new QLabel(statusBar());
+	labelLatency = new QLabel(statusBar());
+	labelLatency->setVisible(false);
 
 	statusBar()->setStyleSheet(QStringLiteral("QStatusBar{border-top: 1px solid; border-color: palette(midlight);} QLabel{margin:0.2em}"));
 	statusBar()->setSizeGripEnabled(false);
 	statusBar()->addWidget(labelProfile, 4);
 	statusBar()->addWidget(labelDevice, 4);
 	statusBar()->addWidget(labelFPS, 4);
+	statusBar()->addWidget(labelLatency, 4);
 	statusBar()->addWidget(m_labelStatusIcon, 0);
 
 	ui->checkBox_DisableUsbPowerLed->setVisible(false);
@@ -320,6 +323,12 @@ void SettingsWindow::connectSignalsSlots()
 #ifdef X11_GRAB_SUPPORT
 	connect(ui->radioButton_GrabX11, &QRadioButton::toggled, this, &SettingsWindow::onGrabberChanged);
 #endif
+#ifdef PIPEWIRE_GRAB_SUPPORT
+	connect(ui->radioButton_GrabPipeWire, &QRadioButton::toggled, this, &SettingsWindow::onGrabberChanged);
+#endif
+#ifdef SYNTHETIC_GRAB_SUPPORT
+	connect(ui->radioButton_GrabSynthetic, &QRadioButton::toggled, this, &SettingsWindow::onGrabberChanged);
+#endif
 #ifdef MAC_OS_AV_GRAB_SUPPORT
 	connect(ui->radioButton_GrabMacAVFoundation, &QRadioButton::toggled, this, &SettingsWindow::onGrabberChanged);
 #endif
@@ -851,6 +860,12 @@ void SettingsWindow::initGrabbersRadioButtonsVisibility()
 #else
 	ui->radioButton_GrabX11->setChecked(true);
 #endif
+#ifndef PIPEWIRE_GRAB_SUPPORT
+	ui->radioButton_GrabPipeWire->setVisible(false);
+#endif
+#ifndef SYNTHETIC_GRAB_SUPPORT
+	ui->radioButton_GrabSynthetic->setVisible(false);
+#endif
 #ifndef MAC_OS_AV_GRAB_SUPPORT
 	ui->radioButton_GrabMacAVFoundation->setVisible(false);
 #else
@@ -1210,6 +1225,51 @@ void SettingsWindow::refreshAmbilightEvaluated(double updateResultMs)
 	this->labelFPS->setText(tr("FPS: ") + fpsText);
 }
 
+void SettingsWindow::refreshFramePacing(const Grab::FramePacingStats &stats)
+{
+	DEBUG_HIGH_LEVEL << Q_FUNC_INFO << stats.latencyMs << stats.jitterMs << stats.deadlineMisses;
+
+	if (stats.framesCount == 0) {
+		ui->label_GrabFrequency_value->setToolTip(QLatin1String(""));
+		return;
+	}
+
+	ui->label_GrabFrequency_value->setToolTip(
+		tr("Frame interval: %1 ms\nFrame time: %2 ms\nGrab and processing: %3 ms\nJitter: %4 ms\nMissed deadlines: %5")
+			.arg(QString::number(stats.intervalMs, 'f', 1))
+			.arg(QString::number(stats.frameTimeMs, 'f', 1))
+			.arg(QString::number(stats.latencyMs, 'f', 1))
+			.arg(QString::number(stats.jitterMs, 'f', 2))
+			.arg(stats.deadlineMisses));
+}
+
+void SettingsWindow::refreshFrameLatency(const FrameLatencyStats &stats)
+{
+	DEBUG_HIGH_LEVEL << Q_FUNC_INFO << stats.framesCount;
+
+	const bool isVisible = g_debugLevel >= Debug::MidLevel && stats.framesCount > 0;
+	labelLatency->setVisible(isVisible);
+	if (!isVisible)
+		return;
+
+	const FrameLatencyStats::Percentiles &total = stats.spans[FrameLatencyStats::SpanTotal];
+	labelLatency->setText(tr("Latency: %1 / %2 / %3 ms")
+		.arg(QString::number(total.p50Ms, 'f', 1))
+		.arg(QString::number(total.p95Ms, 'f', 1))
+		.arg(QString::number(total.p99Ms, 'f', 1)));
+
+	QString toolTip = tr("Frame latency p50 / p95 / p99, %1 frames").arg(stats.framesCount);
+	for (int span = 0; span < FrameLatencyStats::SpansCount; ++span) {
+		const FrameLatencyStats::Percentiles &percentiles = stats.spans[span];
+		toolTip += QStringLiteral("\n%1: %2 / %3 / %4 ms")
+			.arg(QLatin1String(FrameLatencyStats::spanName(static_cast<FrameLatencyStats::Span>(span))))
+			.arg(QString::number(percentiles.p50Ms, 'f', 2))
+			.arg(QString::number(percentiles.p95Ms, 'f', 2))
+			.arg(QString::number(percentiles.p99Ms, 'f', 2));
+	}
+	labelLatency->setToolTip(toolTip);
+}
+
 void SettingsWindow::clearBaudrateWarning()
 {
 	const QPalette& defaultPalette = ui->label_GrabFrequency_txt_fps->palette();
@@ -1990,6 +2050,16 @@ void SettingsWindow::updateUiFromSettings()
 		ui->radioButton_GrabX11->setChecked(true);
 		break;
 #endif
+#ifdef PIPEWIRE_GRAB_SUPPORT
+	case Grab::GrabberTypePipeWire:
+		ui->radioButton_GrabPipeWire->setChecked(true);
+		break;
+#endif
+#ifdef SYNTHETIC_GRAB_SUPPORT
+	case Grab::GrabberTypeSynthetic:
+		ui->radioButton_GrabSynthetic->setChecked(true);
+		break;
+#endif
 #ifdef MAC_OS_AV_GRAB_SUPPORT
 	case Grab::GrabberTypeMacAVFoundation:
 		ui->radioButton_GrabMacAVFoundation->setChecked(true);
@@ -2024,6 +2094,16 @@ Grab::GrabberType SettingsWindow::getSelectedGrabberType()
 		return Grab::GrabberTypeX11;
 	}
 #endif
+#ifdef PIPEWIRE_GRAB_SUPPORT
+	if (ui->radioButton_GrabPipeWire->isChecked()) {
+		return Grab::GrabberTypePipeWire;
+	}
+#endif
+#ifdef SYNTHETIC_GRAB_SUPPORT
+	if (ui->radioButton_GrabSynthetic->isChecked()) {
+		return Grab::GrabberTypeSynthetic;
+	}
+#endif
 #ifdef WINAPI_GRAB_SUPPORT
 	if (ui->radioButton_GrabWinAPI->isChecked()) {
 		return Grab::GrabberTypeWinAPI;
@@ -33,6 +33,7 @@
 #include <QLabel>
 #include "Settings.hpp"
 #include "GrabManager.hpp"
+#include "FrameLatency.hpp"
 #include "MoodLampManager.hpp"
 #ifdef SOUNDVIZ_SUPPORT
 #include "SoundManagerBase.hpp"
@@ -95,6 +96,8 @@ public slots:
 	void ledDeviceFirmwareVersionResult(const QString & fwVersion);
 	void ledDeviceFirmwareVersionUnofficialResult(const int version);
 	void refreshAmbilightEvaluated(double updateResultMs);
+	void refreshFramePacing(const Grab::FramePacingStats &stats);
+	void refreshFrameLatency(const FrameLatencyStats &stats);
 	void updateUiFromSettings();
 
 	void setDeviceLockViaAPI(const DeviceLocked::DeviceLockStatus status, const QList<QString>& modules);
@@ -299,6 +302,7 @@ private:
 	QLabel *labelProfile;
 	QLabel *labelDevice;
 	QLabel *labelFPS;
+	QLabel *labelLatency; // debug overlay, shown from Debug::MidLevel
 	double m_maxFPS{ 0 };
 	QTimer m_baudrateWarningClearTimer;
 
@@ -33,6 +33,8 @@
 #include "MacOSSoundManager.h"
 #elif defined(Q_OS_WIN) && defined(BASS_SOUND_SUPPORT)
 #include "WindowsSoundManager.hpp"
+#elif defined(Q_OS_LINUX) && defined(PIPEWIRE_AUDIO_SUPPORT)
+#include "PipeWireSoundManager.hpp"
 #elif defined(Q_OS_LINUX) && defined(PULSEAUDIO_SUPPORT)
 #include "PulseAudioSoundManager.hpp"
 #endif
@@ -46,6 +48,9 @@ SoundManagerBase* SoundManagerBase::create(int hWnd, QObject* parent)
 	return new MacOSSoundManager(parent);
 #elif defined(Q_OS_WIN) && defined(BASS_SOUND_SUPPORT)
 	return new WindowsSoundManager(hWnd, parent);
+#elif defined(Q_OS_LINUX) && defined(PIPEWIRE_AUDIO_SUPPORT)
+	Q_UNUSED(hWnd);
+	return new PipeWireSoundManager(parent);
 #elif defined(Q_OS_LINUX) && defined(PULSEAUDIO_SUPPORT)
 	Q_UNUSED(hWnd);
 	return new PulseAudioSoundManager(parent);
@@ -56,6 +61,7 @@ SoundManagerBase* SoundManagerBase::create(int hWnd, QObject* parent)
 SoundManagerBase::SoundManagerBase(QObject *parent) : QObject(parent)
 {
 	m_fft = (float *)calloc(fftSize(), sizeof(*m_fft));
+	m_beatClock.start();
 	initFromSettings();
 }
 
@@ -108,6 +114,26 @@ void SoundManagerBase::setDevice(int value)
 	if (enabled) start(true);
 }
 
+void SoundManagerBase::setFftOverlap(int percent)
+{
+	DEBUG_MID_LEVEL << Q_FUNC_INFO << percent;
+
+	bool enabled = m_isEnabled;
+	if (enabled) start(false);
+	m_fftOverlap = percent;
+	if (enabled) start(true);
+}
+
+void SoundManagerBase::setCaptureQuantum(int frames)
+{
+	DEBUG_MID_LEVEL << Q_FUNC_INFO << frames;
+
+	bool enabled = m_isEnabled;
+	if (enabled) start(false);
+	m_captureQuantum = frames;
+	if (enabled) start(true);
+}
+
 void SoundManagerBase::setMinColor(QColor color)
 {
 	DEBUG_MID_LEVEL << Q_FUNC_INFO << color;
@@ -165,6 +191,8 @@ void SoundManagerBase::settingsProfileChanged(const QString &profileName)
 void SoundManagerBase::initFromSettings()
 {
 	m_device = Settings::getSoundVisualizerDevice();
+	m_fftOverlap = Settings::getSoundVisualizerFftOverlap();
+	m_captureQuantum = Settings::getSoundVisualizerCaptureQuantum();
 
 	setVisualizer(Settings::getSoundVisualizerVisualizer());
 
@@ -176,6 +204,7 @@ void SoundManagerBase::initFromSettings()
 void SoundManagerBase::reset()
 {
 	initColors(m_colors.size());
+	m_beatTracker.reset();
 	if (m_visualizer)
 		m_visualizer->reset();
 }
@@ -185,6 +214,22 @@ void SoundManagerBase::updateColors()
 	DEBUG_HIGH_LEVEL << Q_FUNC_INFO;
 
 	updateFft();
+
+	// spectra the backend didn't renew in between are skipped by the tracker
+	const double time = m_beatClock.nsecsElapsed() / 1e9;
+	SoundBeat beat;
+	beat.isOnset = m_beatTracker.process(m_fft, fftSize(), time);
+	beat.strength = m_beatTracker.strength();
+	beat.tempo = m_beatTracker.tempo();
+	beat.confidence = m_beatTracker.confidence();
+	beat.phase = m_beatTracker.beatPhase(time);
+	beat.onsetsCount = m_beatTracker.onsetsCount();
+	emit beatEvaluated(beat);
+
+	if (m_visualizer) {
+		m_visualizer->setSampleRate(m_sampleRate);
+		m_visualizer->setBeat(beat);
+	}
 	bool colorsChanged = (m_visualizer ? m_visualizer->visualize(m_fft, fftSize(), m_colors) : false);
 	if (colorsChanged || !m_isSendDataOnlyIfColorsChanged) {
 		emit updateLedsColors(m_colors);
@@ -29,6 +29,7 @@
 #include <QColor>
 #include <QElapsedTimer>
 #include "SoundVisualizer.hpp"
+#include "BeatTracker.hpp"
 
 struct SoundManagerDeviceInfo {
 	SoundManagerDeviceInfo(){ this->name = QLatin1String(""); this->id = -1; }
@@ -52,6 +53,7 @@ signals:
 	void deviceList(const QList<SoundManagerDeviceInfo> & devices, int recommended);
 	void visualizerList(const QList<SoundManagerVisualizerInfo>& visualizers, int recommended);
 	void visualizerFrametime(const double);
+	void beatEvaluated(const SoundBeat & beat);
 
 public:
 	virtual void start(bool isEnabled) { Q_UNUSED(isEnabled); Q_ASSERT_X(false, "SoundManagerBase::start()", "not implemented"); };
@@ -66,6 +68,8 @@ public slots:
 	void settingsProfileChanged(const QString &profileName);
 	void setNumberOfLeds(int value);
 	void setDevice(int value);
+	void setFftOverlap(int percent);
+	void setCaptureQuantum(int frames);
 	void setVisualizer(int value);
 	void setMinColor(QColor color);
 	void setMaxColor(QColor color);
@@ -90,10 +94,16 @@ protected:
 	bool	m_isEnabled{false};
 	bool	m_isInited{false};
 	int		m_device{-1};
+	int		m_fftOverlap{0}; // % of the window the next FFT shares with the previous one
+	int		m_captureQuantum{256}; // frames per capture period, for backends which can choose it
 	bool	m_isSendDataOnlyIfColorsChanged{false};
 
 	float*	m_fft{nullptr};
+	double	m_sampleRate{44100.0}; // of the audio m_fft comes from, backends set the actual one
 
 	QElapsedTimer m_elapsedTimer;
 	size_t m_frames{ 1 };
+
+	PrismatikMath::BeatTracker m_beatTracker;
+	QElapsedTimer m_beatClock;
 };
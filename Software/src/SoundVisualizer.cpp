@@ -84,21 +84,23 @@ public:
 	void clear(const int numberOfLeds);
 private:
 	QList<int> m_peaks;
+	PrismatikMath::FilterBank m_bands;
 	const int SpecHeight = 1000;
+	// 9 octaves up from the first bin at 44.1 kHz, 10 were used but the last bucket rarely saw any action
+	const double BandsMinHz = 21.5;
+	const double BandsMaxHz = 21.5 * 512;
 );
 
 bool PrismatikSoundVisualizer::visualize(const float* const fftData, const size_t fftSize, QList<QRgb>& colors)
 {
-	size_t b0 = 0;
+	// one band per LED, each at least 1 FFT bin, the bank is only rebuilt on changes
+	m_bands.configure(PrismatikMath::FilterBank::ShapePeak, colors.size(), BandsMinHz, BandsMaxHz, fftSize, m_sampleRate);
+	const float *peaks = m_bands.apply(fftData);
+
 	bool changed = false;
 	for (int i = 0; i < colors.size(); i++)
 	{
-		float peak = 0;
-		size_t b1 = pow(2, i*9.0 / (colors.size() - 1)); // 9 was 10, but the last bucket rarely saw any action
-		if (b1 > fftSize - 1) b1 = fftSize - 1;
-		if (b1 <= b0) b1 = b0 + 1; // make sure it uses at least 1 FFT bin
-		for (; b0 < b1; b0++)
-			if (peak < fftData[1 + b0]) peak = fftData[1 + b0];
+		const float peak = peaks[i];
 		int val = sqrt(peak) * /* 3 * */ SpecHeight - 4; // scale it (sqrt to make low values more visible)
 		if (val > SpecHeight) val = SpecHeight; // cap it
 		if (val < 0) val = 0; // cap it
@@ -136,6 +138,8 @@ void PrismatikSoundVisualizer::clear(const int numberOfLeds) {
 DECLARE_VISUALIZER(TwinPeaks, "Twin Peaks",
 public:
 private:
+	PrismatikMath::FilterBank m_wholeBand;
+	PrismatikMath::FilterBank m_sensitiveBand;
 	float m_previousPeak{ 0.0f };
 	unsigned int m_prevThresholdLed{ 0 };
 	double m_speedCoef = 1.0;
@@ -147,18 +151,10 @@ bool TwinPeaksSoundVisualizer::visualize(const float* const fftData, const size_
 	bool changed = false;
 	const unsigned int middleLed = std::floor(colors.size() / 2);
 
-	// most sensitive Hz range for humans
-	// this assumes 44100Hz sample rate
-	const unsigned int optimalHzMin = 1950 / (44100 / 2 / (unsigned int)fftSize); // 2kHz
-	const unsigned int optimalHzMax = 5050 / (44100 / 2 / (unsigned int)fftSize); // 5kHz
-
-	float currentPeak = 0.0f;
-	for (size_t i = 0; i < fftSize; ++i) {
-		float mag = fftData[i];
-		if (i > optimalHzMin && i < optimalHzMax)// amplify sensitive range
-			mag *= 6.0f;
-		currentPeak += mag;
-	}
+	// the whole spectrum with the most sensitive Hz range for humans (2kHz - 5kHz) amplified 6 times
+	m_wholeBand.configure(PrismatikMath::FilterBank::ShapeSum, 1, 0.0, m_sampleRate / 2, fftSize, m_sampleRate);
+	m_sensitiveBand.configure(PrismatikMath::FilterBank::ShapeSum, 1, 1950.0, 5050.0, fftSize, m_sampleRate);
+	float currentPeak = m_wholeBand.apply(fftData)[0] + 5.0f * m_sensitiveBand.apply(fftData)[0];
 
 	if (m_previousPeak < currentPeak)
 		m_previousPeak = currentPeak;
@@ -209,3 +205,41 @@ bool TwinPeaksSoundVisualizer::visualize(const float* const fftData, const size_
 	return changed;
 }
 #pragma endregion TwinPeaks
+
+
+
+#pragma region BeatPulse
+DECLARE_VISUALIZER(BeatPulse, "Beat pulse",
+public:
+private:
+	double m_level{ 0.0 };
+	const double FadeOut = 0.85; // per update, after onsets off the beat
+);
+
+bool BeatPulseSoundVisualizer::visualize(const float* const fftData, const size_t fftSize, QList<QRgb>& colors)
+{
+	Q_UNUSED(fftData);
+	Q_UNUSED(fftSize);
+
+	// every onset flashes, on a steady beat the flash also follows the predicted beat,
+	// so it keeps the rhythm between the updates
+	m_level = m_beat.isOnset ? 1.0 : m_level * FadeOut;
+	double level = m_level;
+	if (m_beat.tempo > 0.0 && m_beat.confidence > 0.3)
+		level = std::max(level, std::pow(1.0 - m_beat.phase, 3.0) * m_beat.confidence);
+
+	bool changed = false;
+	for (int i = 0; i < colors.size(); i++) {
+		QRgb color = 0;
+		if (Settings::isLedEnabled(i)) {
+			QColor from = m_isLiquidMode ? QColor(0, 0, 0) : m_minColor;
+			QColor to = m_isLiquidMode ? m_generator.current() : m_maxColor;
+			interpolateColor(color, from, to, level, 1.0);
+		}
+
+		changed = changed || (colors[i] != color);
+		colors[i] = color;
+	}
+	return changed;
+}
+#pragma endregion BeatPulse
@@ -27,6 +27,7 @@
 
 #include <QColor>
 #include "LiquidColorGenerator.hpp"
+#include "FilterBank.hpp"
 
 class SoundVisualizerBase;
 
@@ -41,6 +42,16 @@ struct SoundManagerVisualizerInfo {
 };
 Q_DECLARE_METATYPE(SoundManagerVisualizerInfo);
 
+struct SoundBeat {
+	bool isOnset{ false }; // in the spectrum being visualized
+	double strength{ 0.0 }; // onset strength of the spectrum, 1 is the recent average
+	double tempo{ 0.0 }; // beats per minute, 0 while unknown
+	double confidence{ 0.0 }; // 0 to 1
+	double phase{ 0.0 }; // position within the beat, 0 on the beat up to 1 right before the next one
+	unsigned long long onsetsCount{ 0 };
+};
+Q_DECLARE_METATYPE(SoundBeat);
+
 class SoundVisualizerBase
 {
 public:
@@ -75,6 +86,21 @@ public:
 		m_generator.setSpeed(speed);
 	}
 
+	/*!
+		Sample rate of the audio the spectra come from, bin i of \a visualize() fftData is at
+		i * sampleRate / 2 / fftSize Hz
+	*/
+	void setSampleRate(const double sampleRate) {
+		m_sampleRate = sampleRate;
+	}
+
+	/*!
+		Beat of the spectrum passed to the next \a visualize()
+	*/
+	void setBeat(const SoundBeat& beat) {
+		m_beat = beat;
+	}
+
 	bool isRunning() const {
 		return m_isRunning;
 	}
@@ -115,4 +141,6 @@ protected:
 	bool	m_isLiquidMode{ false };
 	bool	m_isRunning{ false };
 	size_t  m_frames{ 0 };
+	SoundBeat m_beat;
+	double	m_sampleRate{ 44100.0 };
 };
@@ -0,0 +1,189 @@
+/*
+ * SpectrumAnalyzer.cpp
+ *
+ *	Created on: 18.10.2026
+ *		Project: Prismatik
+ *
+ *	Prismatik is a free, open-source software: you can redistribute it and/or
+ *	modify it under the terms of the GNU General Public License as published
+ *	by the Free Software Foundation, either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	Prismatik and Lightpack files is distributed in the hope that it will be
+ *	useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.	See the GNU
+ *	General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with this program.	If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "SpectrumAnalyzer.hpp"
+#include "debug.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+
+static inline void weights_init(float *dest, int samples, enum w_type w)
+{
+	switch(w) {
+		case WINDOW_TRIANGLE:
+			for (int i = 0; i < samples; i++)
+				dest[i] = 1 - 2*fabsf((i - ((samples - 1)/2.0f))/(samples - 1));
+			break;
+		case WINDOW_HANNING:
+			for (int i = 0; i < samples; i++)
+				dest[i] = 0.5f*(1 - cos((2*M_PI*i)/(samples - 1)));
+			break;
+		case WINDOW_HAMMING:
+			for (int i = 0; i < samples; i++)
+				dest[i] = 0.54 - 0.46*cos((2*M_PI*i)/(samples - 1));
+			break;
+		case WINDOW_BLACKMAN:
+			for (int i = 0; i < samples; i++) {
+				const float c1 = cos((2*M_PI*i)/(samples - 1));
+				const float c2 = cos((4*M_PI*i)/(samples - 1));
+				dest[i] = 0.42659 - 0.49656*c1 + 0.076849*c2;
+			}
+			break;
+		case WINDOW_BLACKMAN_HARRIS:
+			for (int i = 0; i < samples; i++) {
+				const float c1 = cos((2*M_PI*i)/(samples - 1));
+				const float c2 = cos((4*M_PI*i)/(samples - 1));
+				const float c3 = cos((6*M_PI*i)/(samples - 1));
+				dest[i] = 0.35875 - 0.48829*c1 + 0.14128*c2 - 0.001168*c3;
+			}
+			break;
+		case WINDOW_FLAT:
+			for (int i = 0; i < samples; i++)
+				dest[i] = 1.0f;
+			break;
+		case WINDOW_WELCH:
+			for (int i = 0; i < samples; i++)
+				dest[i] = 1 - pow((i - ((samples - 1)/2.0f))/((samples - 1)/2.0f), 2.0f);
+			break;
+		default:
+			for (int i = 0; i < samples; i++)
+				dest[i] = 0.0f;
+			break;
+	}
+	float sum = 0.0f;
+	for (int i = 0; i < samples; i++)
+		sum += dest[i];
+	for (int i = 0; i < samples; i++)
+		dest[i] /= sum;
+}
+
+SpectrumAnalyzer::SpectrumAnalyzer(size_t spectrumSize)
+	: m_spectrumSize(spectrumSize)
+{
+	// plans are created here, on the owner's thread, fftw's planner isn't thread safe
+	m_output = fftwf_alloc_complex(m_spectrumSize + 1);
+	m_input.resize(m_spectrumSize * 2);
+	m_plan = fftwf_plan_dft_r2c_1d(m_input.size(), m_input.data(), m_output, 0);
+
+	m_weights.resize(m_spectrumSize + 1);
+	weights_init(m_weights.data(), m_weights.size(), WINDOW_HANNING); // TODO: BASS does hanning?
+}
+
+SpectrumAnalyzer::~SpectrumAnalyzer()
+{
+	stop();
+	if (m_plan)
+		fftwf_destroy_plan(m_plan);
+	if (m_output)
+		fftwf_free(m_output);
+}
+
+void SpectrumAnalyzer::start(int overlapPercent)
+{
+	if (m_analysisThread.joinable())
+		return;
+
+	m_hopSamples = std::max<size_t>(1, windowSamples() * (100 - overlapPercent) / 100);
+	DEBUG_LOW_LEVEL << Q_FUNC_INFO << "window:" << windowSamples() << "hop:" << m_hopSamples;
+
+	m_spectrum.reset(std::vector<float>(m_spectrumSize, 0.0f));
+	// whatever is left from the last run is stale
+	m_ring.discard();
+
+	m_isAnalysing = true;
+	m_analysisThread = std::thread(&SpectrumAnalyzer::analysisLoop, this);
+}
+
+void SpectrumAnalyzer::stop()
+{
+	if (!m_analysisThread.joinable())
+		return;
+
+	m_isAnalysing = false;
+	m_samplesReady.notify_one();
+	m_analysisThread.join();
+}
+
+void SpectrumAnalyzer::write(const float *samples, size_t count)
+{
+	// no locks and no FFT here, the analysis thread picks the samples up from the ring
+	m_ring.write(samples, count);
+	m_samplesReady.notify_one();
+}
+
+bool SpectrumAnalyzer::takeSpectrum(float *dest)
+{
+	if (!m_spectrum.update())
+		return false;
+	memcpy(dest, m_spectrum.front().data(), m_spectrumSize * sizeof(*dest));
+	return true;
+}
+
+void SpectrumAnalyzer::analysisLoop()
+{
+	using namespace std::chrono_literals;
+	const std::chrono::nanoseconds ReportInterval = 5s;
+	const size_t window = windowSamples();
+
+	std::chrono::steady_clock::time_point reportTime = std::chrono::steady_clock::now();
+	size_t spectraCount = 0;
+
+	while (m_isAnalysing) {
+		{
+			std::unique_lock<std::mutex> lock(m_analysisMutex);
+			// the writer doesn't take the lock, a missed wakeup only costs the timeout
+			m_samplesReady.wait_for(lock, 10ms, [this, window] {
+				return !m_isAnalysing || m_ring.available() >= window;
+			});
+		}
+
+		// only the last spectrum is shown, don't fall behind after a burst of samples
+		if (m_ring.available() > 2 * window)
+			m_ring.skip(m_ring.available() - window);
+
+		while (m_isAnalysing && m_ring.peek(m_input.data(), window)) {
+			m_ring.skip(m_hopSamples);
+			processFft();
+			m_spectrum.publish();
+			spectraCount++;
+		}
+
+		const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+		if (now - reportTime >= ReportInterval) {
+			DEBUG_LOW_LEVEL << Q_FUNC_INFO << "spectra per second:" << spectraCount * 1000 / std::chrono::duration_cast<std::chrono::milliseconds>(now - reportTime).count()
+							<< "dropped samples:" << m_ring.droppedCount();
+			spectraCount = 0;
+			reportTime = now;
+		}
+	}
+}
+
+void SpectrumAnalyzer::processFft()
+{
+	// m_input holds the window (mono), results go to the back buffer of m_spectrum
+	fftwf_execute(m_plan);
+
+	std::vector<float> &spectrum = m_spectrum.back();
+	for (size_t i = 0; i < m_spectrumSize; i++) {
+		spectrum[i] = std::sqrt(m_output[i][0] * m_output[i][0] + m_output[i][1] * m_output[i][1]) * m_weights[i];
+	}
+}
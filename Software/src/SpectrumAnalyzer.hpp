@@ -0,0 +1,102 @@
+/*
+ * SpectrumAnalyzer.hpp
+ *
+ *	Created on: 18.10.2026
+ *		Project: Prismatik
+ *
+ *	Prismatik is a free, open-source software: you can redistribute it and/or
+ *	modify it under the terms of the GNU General Public License as published
+ *	by the Free Software Foundation, either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	Prismatik and Lightpack files is distributed in the hope that it will be
+ *	useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.	See the GNU
+ *	General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with this program.	If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+
+#include <vector>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include "SampleRing.hpp"
+#include "TripleBuffer.hpp"
+
+#include <fftw3.h>
+
+enum w_type
+{
+	WINDOW_TRIANGLE,
+	WINDOW_HANNING,
+	WINDOW_HAMMING,
+	WINDOW_BLACKMAN,
+	WINDOW_BLACKMAN_HARRIS,
+	WINDOW_FLAT,
+	WINDOW_WELCH,
+};
+
+/*!
+	FFT of captured mono float samples for the backends which don't get a spectrum from
+	the audio API. The capture callback only copies samples into a lock free ring with
+	\a write(), windows are taken from the ring and transformed on an own thread, the GUI
+	thread picks the last spectrum up with \a takeSpectrum().
+*/
+class SpectrumAnalyzer
+{
+public:
+	/*!
+		\param spectrumSize bins of a spectrum, the window is twice that many samples
+	*/
+	explicit SpectrumAnalyzer(size_t spectrumSize);
+	~SpectrumAnalyzer();
+
+	/*!
+		\param overlapPercent % of the window the next FFT shares with the previous one
+	*/
+	void start(int overlapPercent);
+	void stop();
+	bool isRunning() const { return m_analysisThread.joinable(); }
+
+	size_t windowSamples() const { return m_input.size(); }
+	/*!
+		Samples between two spectra, valid after \a start()
+	*/
+	size_t hopSamples() const { return m_hopSamples; }
+
+	/*!
+		Called from the capture thread, doesn't block
+	*/
+	void write(const float *samples, size_t count);
+	/*!
+		Copies the last spectrum to \a dest
+		\return false if there is no new spectrum since the last call, \a dest is left as it is
+	*/
+	bool takeSpectrum(float *dest);
+
+private:
+	void analysisLoop();
+	void processFft();
+
+	const size_t m_spectrumSize;
+	size_t m_hopSamples{0}; // window moves by that much, less than the window when windows overlap
+
+	PrismatikMath::SampleRing m_ring{1 << 16};
+
+	std::thread m_analysisThread;
+	std::atomic<bool> m_isAnalysing{false};
+	std::mutex m_analysisMutex;
+	std::condition_variable m_samplesReady;
+	PrismatikMath::TripleBuffer<std::vector<float>> m_spectrum; // analysis thread -> takeSpectrum()
+
+	fftwf_complex *m_output{nullptr}; // special buffer with proper SIMD alignments
+	std::vector<float> m_input;
+	fftwf_plan m_plan{nullptr};
+	std::vector<float> m_weights;
+};
@@ -0,0 +1,149 @@
+/*
+ * UdpFanoutSender.cpp
+ *
+ *	Created on: 18.10.2026
+ *		Project: Prismatik
+ *
+ *	Prismatik is a free, open-source software: you can redistribute it and/or
+ *	modify it under the terms of the GNU General Public License as published
+ *	by the Free Software Foundation, either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	Prismatik and Lightpack files is distributed in the hope that it will be
+ *	useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.	See the GNU
+ *	General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with this program.	If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "UdpFanoutSender.hpp"
+#include <QStringList>
+#include "ColorFrame.hpp"
+#include "debug.h"
+
+QList<UdpFanoutSender::Endpoint> UdpFanoutSender::parseEndpoints(const QString &endpoints, int maxLedsCount)
+{
+	QList<Endpoint> result;
+
+	const QStringList entries = endpoints.split(QLatin1Char(';'));
+	for (const QString &entry : entries) {
+		if (entry.trimmed().isEmpty())
+			continue;
+
+		const int rangeSeparator = entry.indexOf(QLatin1Char('='));
+		const int portSeparator = entry.lastIndexOf(QLatin1Char(':'), rangeSeparator);
+		const QStringList range = entry.mid(rangeSeparator + 1).split(QLatin1Char('-'));
+
+		bool isPortOk = false, isFirstOk = false, isLastOk = false;
+		const quint16 port = portSeparator > 0 ? entry.mid(portSeparator + 1, rangeSeparator - portSeparator - 1).trimmed().toUShort(&isPortOk) : 0;
+		const int firstLed = range.size() == 2 ? range[0].trimmed().toInt(&isFirstOk) : -1;
+		const int lastLed = range.size() == 2 ? range[1].trimmed().toInt(&isLastOk) : -1;
+
+		if (rangeSeparator < 0 || portSeparator <= 0 || !isPortOk || port == 0
+			|| !isFirstOk || !isLastOk || firstLed < 0 || lastLed < firstLed) {
+			qWarning() << Q_FUNC_INFO << "skipping invalid endpoint" << entry << "expected address:port=first-last";
+			continue;
+		}
+		if (lastLed >= maxLedsCount) {
+			qWarning() << Q_FUNC_INFO << "skipping endpoint" << entry << "LEDs are limited to" << maxLedsCount;
+			continue;
+		}
+
+		Endpoint endpoint;
+		endpoint.address = entry.left(portSeparator).trimmed();
+		endpoint.port = port;
+		endpoint.firstLed = firstLed;
+		endpoint.ledsCount = lastLed - firstLed + 1;
+		result.append(endpoint);
+	}
+
+	return result;
+}
+
+UdpFanoutSender::UdpFanoutSender(const QList<Endpoint> &endpoints, QObject * parent)
+	: QObject(parent)
+	, m_endpoints(endpoints)
+	, m_reportTimestamp(0)
+{
+	const Statistics empty = { 0, 0, 0, 0 };
+	for (int i = 0; i < m_endpoints.size(); i++) {
+		m_senders.append(new UdpPacketSender());
+		m_statistics.append(empty);
+	}
+}
+
+UdpFanoutSender::~UdpFanoutSender()
+{
+	close();
+	qDeleteAll(m_senders);
+}
+
+void UdpFanoutSender::open()
+{
+	DEBUG_LOW_LEVEL << Q_FUNC_INFO;
+
+	for (int i = 0; i < m_endpoints.size(); i++)
+		m_senders[i]->open(m_endpoints[i].address, m_endpoints[i].port, this);
+}
+
+void UdpFanoutSender::close()
+{
+	for (UdpPacketSender *sender : m_senders)
+		sender->close();
+}
+
+void UdpFanoutSender::writePackets()
+{
+	// a controller which is down doesn't stop the others
+	bool ok = false;
+	for (int i = 0; i < m_senders.size(); i++) {
+		if (m_senders[i]->packetsCount() == 0)
+			continue;
+
+		const qint64 sendStarted = ColorFrame::timestamp();
+		const bool isSent = m_senders[i]->writePackets();
+		const qint64 sendNs = ColorFrame::timestamp() - sendStarted;
+
+		Statistics &statistics = m_statistics[i];
+		statistics.framesCount++;
+		statistics.sendCallsNs += sendNs;
+		statistics.maxSendCallsNs = qMax(statistics.maxSendCallsNs, sendNs);
+		if (isSent)
+			ok = true;
+		else
+			statistics.failedSendsCount++;
+	}
+
+	reportEndpoints(ColorFrame::timestamp());
+
+	emit packetsWritten(ok);
+}
+
+void UdpFanoutSender::reportEndpoints(qint64 now)
+{
+	const qint64 ReportIntervalNs = 5000000000LL;
+
+	if (m_reportTimestamp == 0)
+		m_reportTimestamp = now;
+	if (now - m_reportTimestamp < ReportIntervalNs)
+		return;
+
+	for (int i = 0; i < m_endpoints.size(); i++) {
+		Statistics &statistics = m_statistics[i];
+		if (statistics.framesCount > 0) {
+			DEBUG_LOW_LEVEL << Q_FUNC_INFO << m_endpoints[i].address << m_endpoints[i].port
+							<< "frames:" << statistics.framesCount
+							<< "failed sends:" << statistics.failedSendsCount
+							<< "send calls us avg:" << statistics.sendCallsNs / statistics.framesCount / 1000
+							<< "max:" << statistics.maxSendCallsNs / 1000;
+		}
+		statistics.framesCount = 0;
+		statistics.failedSendsCount = 0;
+		statistics.sendCallsNs = 0;
+		statistics.maxSendCallsNs = 0;
+	}
+	m_reportTimestamp = now;
+}
@@ -0,0 +1,88 @@
+/*
+ * UdpFanoutSender.hpp
+ *
+ *	Created on: 18.10.2026
+ *		Project: Prismatik
+ *
+ *	Prismatik is a free, open-source software: you can redistribute it and/or
+ *	modify it under the terms of the GNU General Public License as published
+ *	by the Free Software Foundation, either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	Prismatik and Lightpack files is distributed in the hope that it will be
+ *	useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.	See the GNU
+ *	General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with this program.	If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+
+#include <QObject>
+#include <QList>
+#include <QString>
+#include "UdpPacketSender.hpp"
+
+/*!
+	Sockets of LedDeviceUdpFanout, living in the network thread of the device. Packets are
+	built by the device thread and the whole frame is sent by \a writePackets() in one burst,
+	endpoint after endpoint. The device mustn't touch the packets until \a packetsWritten().
+
+	Statistics are local only: a failed send is one the kernel refused (including ICMP port
+	unreachable reported on the connected socket), not a packet lost on the way, and the send
+	time is the time spent in the send calls, not the latency to the controller.
+*/
+class UdpFanoutSender : public QObject
+{
+	Q_OBJECT
+public:
+	struct Endpoint {
+		QString address;
+		quint16 port;
+		int firstLed;
+		int ledsCount;
+	};
+
+	/*!
+		Parses ';' separated "address:port=first-last" entries with zero based, inclusive LED
+		indexes. Invalid entries and ranges past \a maxLedsCount are skipped with a warning.
+	*/
+	static QList<Endpoint> parseEndpoints(const QString &endpoints, int maxLedsCount);
+
+	UdpFanoutSender(const QList<Endpoint> &endpoints, QObject * parent = 0);
+	virtual ~UdpFanoutSender();
+
+	const QList<Endpoint> & endpoints() const { return m_endpoints; }
+	UdpPacketSender & sender(int endpoint) { return *m_senders[endpoint]; }
+
+public slots:
+	void open();
+	void close();
+	void writePackets();
+
+signals:
+	/*!
+		\param ok at least one endpoint took the frame
+	*/
+	void packetsWritten(bool ok);
+
+private:
+	void reportEndpoints(qint64 now);
+
+private:
+	struct Statistics {
+		// since the last report
+		int framesCount;
+		int failedSendsCount;
+		qint64 sendCallsNs;
+		qint64 maxSendCallsNs;
+	};
+
+	QList<Endpoint> m_endpoints;
+	QList<UdpPacketSender *> m_senders;
+	QList<Statistics> m_statistics;
+	qint64 m_reportTimestamp;
+};
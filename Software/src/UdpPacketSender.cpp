@@ -0,0 +1,145 @@
+/*
+ * UdpPacketSender.cpp
+ *
+ *	Created on: 18.10.2026
+ *		Project: Prismatik
+ *
+ *	Prismatik is a free, open-source software: you can redistribute it and/or
+ *	modify it under the terms of the GNU General Public License as published
+ *	by the Free Software Foundation, either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	Prismatik and Lightpack files is distributed in the hope that it will be
+ *	useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.	See the GNU
+ *	General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with this program.	If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "UdpPacketSender.hpp"
+#include <QUdpSocket>
+#include <algorithm>
+#include "debug.h"
+
+#ifdef Q_OS_LINUX
+#include <sys/socket.h>
+#include <cerrno>
+#include <cstring>
+#endif
+
+UdpPacketSender::UdpPacketSender()
+	: m_socket(NULL)
+	, m_packetsCount(0)
+{
+}
+
+UdpPacketSender::~UdpPacketSender()
+{
+	close();
+}
+
+void UdpPacketSender::open(const QString &address, quint16 port, QObject *parent)
+{
+	if (m_socket != NULL)
+		m_socket->close();
+	else
+		m_socket = new QUdpSocket(parent);
+
+	m_socket->connectToHost(address, port, QIODevice::WriteOnly);
+	m_packetsCount = 0;
+}
+
+void UdpPacketSender::close()
+{
+	if (m_socket != NULL) {
+		m_socket->close();
+
+		delete m_socket;
+		m_socket = NULL;
+	}
+}
+
+QString UdpPacketSender::errorString() const
+{
+	return m_socket != NULL ? m_socket->errorString() : QString();
+}
+
+char * UdpPacketSender::beginPacket(const QByteArray &header)
+{
+	const int offset = m_packetsCount * MaxPacketSize;
+	// grows only when a frame needs more packets than any before
+	if (m_packetArena.size() < offset + MaxPacketSize)
+		m_packetArena.resize(offset + MaxPacketSize);
+
+	return std::copy(header.constBegin(), header.constEnd(), m_packetArena.data() + offset);
+}
+
+void UdpPacketSender::endPacket(const char *end)
+{
+	const int size = end - (m_packetArena.constData() + m_packetsCount * MaxPacketSize);
+	Q_ASSERT(size > 0 && size <= MaxPacketSize);
+
+	if (m_packetsCount < m_packetSizes.size())
+		m_packetSizes[m_packetsCount] = size;
+	else
+		m_packetSizes.append(size);
+	m_packetsCount++;
+}
+
+bool UdpPacketSender::writePackets()
+{
+	DEBUG_MID_LEVEL << Q_FUNC_INFO << "Packets:" << m_packetsCount;
+
+	const int packetsCount = m_packetsCount;
+	m_packetsCount = 0;
+
+	if (m_socket == NULL)
+		return false;
+
+#ifdef Q_OS_LINUX
+	const qintptr socketDescriptor = m_socket->socketDescriptor();
+	if (socketDescriptor == -1) {
+		qWarning() << Q_FUNC_INFO << "socket isn't connected:" << m_socket->errorString();
+		return false;
+	}
+
+	// the socket is connected, messages need no address
+	const int BatchSize = 32;
+	mmsghdr messages[BatchSize];
+	iovec vectors[BatchSize];
+	int packetsSent = 0;
+	while (packetsSent < packetsCount) {
+		const int batchSize = std::min(BatchSize, packetsCount - packetsSent);
+		for (int i = 0; i < batchSize; i++) {
+			vectors[i].iov_base = m_packetArena.data() + (packetsSent + i) * MaxPacketSize;
+			vectors[i].iov_len = m_packetSizes[packetsSent + i];
+			memset(&messages[i], 0, sizeof(messages[i]));
+			messages[i].msg_hdr.msg_iov = &vectors[i];
+			messages[i].msg_hdr.msg_iovlen = 1;
+		}
+
+		const int result = sendmmsg(socketDescriptor, messages, batchSize, 0);
+		if (result <= 0) {
+			qWarning() << Q_FUNC_INFO << "sendmmsg() failed:" << strerror(errno);
+			return false;
+		}
+		packetsSent += result;
+	}
+#else
+	for (int i = 0; i < packetsCount; i++) {
+		const char *packet = m_packetArena.constData() + i * MaxPacketSize;
+		const qint64 bytesWritten = m_socket->write(packet, m_packetSizes[i]);
+
+		if (bytesWritten != m_packetSizes[i])
+		{
+			qWarning() << Q_FUNC_INFO << "bytesWritten != packet size:" << bytesWritten << m_packetSizes[i] << " " << m_socket->errorString();
+			return false;
+		}
+	}
+#endif
+
+	return true;
+}
@@ -0,0 +1,72 @@
+/*
+ * UdpPacketSender.hpp
+ *
+ *	Created on: 18.10.2026
+ *		Project: Prismatik
+ *
+ *	Prismatik is a free, open-source software: you can redistribute it and/or
+ *	modify it under the terms of the GNU General Public License as published
+ *	by the Free Software Foundation, either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	Prismatik and Lightpack files is distributed in the hope that it will be
+ *	useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.	See the GNU
+ *	General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with this program.	If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+
+#include <QByteArray>
+#include <QString>
+#include <QVector>
+
+class QObject;
+class QUdpSocket;
+
+/*!
+	Packets for one UDP endpoint. They are built in place, in slots of an arena which is kept
+	between frames, and sent together by \a writePackets(), with one sendmmsg() on Linux.
+	A packet takes at most \a MaxPacketSize bytes.
+*/
+class UdpPacketSender
+{
+public:
+	UdpPacketSender();
+	~UdpPacketSender();
+
+	/*!
+		\param parent owner of the socket, packets have to be sent from its thread
+	*/
+	void open(const QString &address, quint16 port, QObject *parent);
+	void close();
+	QString errorString() const;
+
+	/*!
+		\return position right after \a header copied to the new packet
+	*/
+	char * beginPacket(const QByteArray &header);
+	/*!
+		\param end position right after the last byte of the packet
+	*/
+	void endPacket(const char *end);
+	int packetsCount() const { return m_packetsCount; }
+	/*!
+		Sends the packets built since the last call
+	*/
+	bool writePackets();
+
+	constexpr static const int MaxPacketSize = 1472; // UDP payload of a 1500 bytes Ethernet frame
+
+private:
+	Q_DISABLE_COPY(UdpPacketSender)
+
+	QUdpSocket *m_socket;
+	QByteArray m_packetArena; // a slot of MaxPacketSize per packet of the largest frame so far
+	QVector<int> m_packetSizes;
+	int m_packetsCount;
+};
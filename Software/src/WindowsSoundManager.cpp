@@ -143,6 +143,11 @@ void WindowsSoundManager::start(bool isEnabled)
 			return;
 		}
 
+		// WASAPI captures at the rate of the device mix format, often 48 kHz
+		BASS_WASAPI_INFO info;
+		if (BASS_WASAPI_GetInfo(&info))
+			m_sampleRate = info.freq;
+
 		BASS_WASAPI_Start();
 		// setup update timer (40hz)
 		//m_timer = timeSetEvent(25, 25, (LPTIMECALLBACK)&UpdateSpectrum, 0, TIME_PERIODIC);
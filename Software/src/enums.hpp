@@ -72,6 +72,8 @@ enum GrabberType {
 	GrabberTypeMacCoreGraphics,
 	GrabberTypeMacAVFoundation,
 	GrabberTypeDDupl,
+	GrabberTypePipeWire,
+	GrabberTypeSynthetic,
 
 	GrabbersCount,
 
@@ -90,6 +92,7 @@ enum DeviceType {
 	DeviceTypeDrgb,
 	DeviceTypeDnrgb,
 	DeviceTypeWarls,
+	DeviceTypeUdpFanout,
 
 	DeviceTypesCount,
 	DefaultDeviceType = DeviceTypeLightpack
@@ -108,6 +111,7 @@ enum Devices
 	Drgb        = 490,
 	Dnrgb       = 1500,
 	Warls       = 255,
+	UdpFanout   = 6000, // the whole strip over all controllers
 
 	Lightpack4	= 8,
 	Lightpack5	= 10,
@@ -115,7 +119,7 @@ enum Devices
 
 	Default		= Lightpack6,
 
-	AbsoluteMaximum = Dnrgb
+	AbsoluteMaximum = UdpFanout
 };
 }
 
@@ -164,7 +168,6 @@ namespace LedDeviceCommands
 {
 enum Cmd {
 	OffLeds,
-	SetColors,
 	SetUsbPowerLedDisabled,
 	SetRefreshDelay,
 	SetColorDepth,
@@ -183,7 +183,12 @@ unix:!macx{
     # Linux version using libusb and hidapi codes
     SOURCES += hidapi/linux/hid-libusb.c
     # For X11 grabber
-    LIBS +=-lXext -lX11
+    LIBS +=-lXext -lX11 -lXdamage -lXfixes -lXrender
+
+    contains(DEFINES, PIPEWIRE_GRAB_SUPPORT) {
+        QT += dbus
+        PKGCONFIG += libpipewire-0.3
+    }
 
     contains(DEFINES,PULSEAUDIO_SUPPORT) {
         INCLUDEPATH += $${PULSEAUDIO_INC_DIR} \
@@ -203,6 +208,15 @@ unix:!macx{
         LIBS += -lpulse -lfftw3f
         DEFINES += SOUNDVIZ_SUPPORT
     }
+
+    contains(DEFINES,PIPEWIRE_AUDIO_SUPPORT) {
+        INCLUDEPATH += $${FFTW3_INC_DIR}
+        defined(FFTW3_LIB_DIR, var):LIBS += -L$${FFTW3_LIB_DIR}
+
+        PKGCONFIG += libpipewire-0.3
+        LIBS += -lfftw3f
+        DEFINES += SOUNDVIZ_SUPPORT
+    }
 }
 
 macx{
@@ -284,6 +298,9 @@ SOURCES += \
     LedDeviceDrgb.cpp \
     LedDeviceDnrgb.cpp \
     LedDeviceWarls.cpp \
+    LedDeviceUdpFanout.cpp \
+    UdpFanoutSender.cpp \
+    UdpPacketSender.cpp \
     ColorButton.cpp \
     ApiServer.cpp \
     ApiServerSetColorTask.cpp \
@@ -293,6 +310,10 @@ SOURCES += \
     LedDeviceManager.cpp \
     SelectWidget.cpp \
     GrabManager.cpp \
+    GrabProcessor.cpp \
+    ColorFrame.cpp \
+    FrameLatency.cpp \
+    FrameSmoother.cpp \
     AbstractLedDevice.cpp \
     PluginsManager.cpp \
     Plugin.cpp \
@@ -323,6 +344,11 @@ HEADERS += \
     version.h \
     TimeEvaluations.hpp \
     GrabManager.hpp \
+    GrabProcessor.hpp \
+    ColorFrame.hpp \
+    ColorFrameSlot.hpp \
+    FrameLatency.hpp \
+    FrameSmoother.hpp \
     GrabWidget.hpp \
     GrabConfigWidget.hpp \
     debug.h \
@@ -336,6 +362,9 @@ HEADERS += \
     LedDeviceDrgb.hpp \
     LedDeviceDnrgb.hpp \
     LedDeviceWarls.hpp \
+    LedDeviceUdpFanout.hpp \
+    UdpFanoutSender.hpp \
+    UdpPacketSender.hpp \
     LedDeviceVirtual.hpp \
     ColorButton.hpp \
     ../common/defs.h \
@@ -393,6 +422,14 @@ win32 {
 
 unix:!macx {
     contains(DEFINES,SOUNDVIZ_SUPPORT) {
+        SOURCES += SpectrumAnalyzer.cpp
+        HEADERS += SpectrumAnalyzer.hpp
+    }
+    # PipeWire is preferred by SoundManagerBase::create() when both are enabled
+    contains(DEFINES,PIPEWIRE_AUDIO_SUPPORT) {
+        SOURCES += PipeWireSoundManager.cpp
+        HEADERS += PipeWireSoundManager.hpp
+    } else:contains(DEFINES,PULSEAUDIO_SUPPORT) {
         SOURCES += PulseAudioSoundManager.cpp
         HEADERS += PulseAudioSoundManager.hpp
     }
@@ -0,0 +1,146 @@
+/*
+ * AllocationCounter.cpp
+ *
+ *	Created on: 18.10.2026
+ *		Project: Prismatik
+ *
+ *	Lightpack is an open-source, USB content-driving ambient lighting
+ *	hardware.
+ *
+ *	Prismatik is a free, open-source software: you can redistribute it and/or
+ *	modify it under the terms of the GNU General Public License as published
+ *	by the Free Software Foundation, either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	Prismatik and Lightpack files is distributed in the hope that it will be
+ *	useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.	See the GNU
+ *	General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with this program.	If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "AllocationCounter.hpp"
+#include <cerrno>
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+	thread_local bool isCounting = false;
+	thread_local int allocationsCount = 0;
+}
+
+AllocationCounter::AllocationCounter()
+{
+	allocationsCount = 0;
+	isCounting = true;
+}
+
+AllocationCounter::~AllocationCounter()
+{
+	isCounting = false;
+}
+
+int AllocationCounter::count() const
+{
+	return allocationsCount;
+}
+
+#if defined(__GLIBC__)
+
+bool AllocationCounter::countsMalloc()
+{
+	return true;
+}
+
+// glibc exports its allocator under these names as well, the functions below forward to them
+extern "C" {
+	void * __libc_malloc(std::size_t size);
+	void * __libc_calloc(std::size_t count, std::size_t size);
+	void * __libc_realloc(void *p, std::size_t size);
+	void * __libc_memalign(std::size_t alignment, std::size_t size);
+
+	void * malloc(std::size_t size)
+	{
+		if (isCounting)
+			++allocationsCount;
+		return __libc_malloc(size);
+	}
+
+	void * calloc(std::size_t count, std::size_t size)
+	{
+		if (isCounting)
+			++allocationsCount;
+		return __libc_calloc(count, size);
+	}
+
+	void * realloc(void *p, std::size_t size)
+	{
+		if (isCounting)
+			++allocationsCount;
+		return __libc_realloc(p, size);
+	}
+
+	void * memalign(std::size_t alignment, std::size_t size)
+	{
+		if (isCounting)
+			++allocationsCount;
+		return __libc_memalign(alignment, size);
+	}
+
+	void * aligned_alloc(std::size_t alignment, std::size_t size)
+	{
+		return memalign(alignment, size);
+	}
+
+	int posix_memalign(void **p, std::size_t alignment, std::size_t size)
+	{
+		if (alignment % sizeof(void *) != 0 || (alignment & (alignment - 1)) != 0)
+			return EINVAL;
+		void *block = memalign(alignment, size);
+		if (!block)
+			return ENOMEM;
+		*p = block;
+		return 0;
+	}
+}
+
+// malloc() above counts the allocation
+void * operator new(std::size_t size)
+{
+	if (void *p = std::malloc(size > 0 ? size : 1))
+		return p;
+	throw std::bad_alloc();
+}
+
+#else
+
+bool AllocationCounter::countsMalloc()
+{
+	return false;
+}
+
+// array, nothrow and sized forms end up here and in operator delete(void *)
+void * operator new(std::size_t size)
+{
+	if (isCounting)
+		++allocationsCount;
+	if (void *p = std::malloc(size > 0 ? size : 1))
+		return p;
+	throw std::bad_alloc();
+}
+
+#endif
+
+void operator delete(void *p) noexcept
+{
+	std::free(p);
+}
+
+void operator delete(void *p, std::size_t) noexcept
+{
+	std::free(p);
+}
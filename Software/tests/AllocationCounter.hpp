@@ -0,0 +1,45 @@
+/*
+ * AllocationCounter.hpp
+ *
+ *	Created on: 18.10.2026
+ *		Project: Prismatik
+ *
+ *	Lightpack is an open-source, USB content-driving ambient lighting
+ *	hardware.
+ *
+ *	Prismatik is a free, open-source software: you can redistribute it and/or
+ *	modify it under the terms of the GNU General Public License as published
+ *	by the Free Software Foundation, either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	Prismatik and Lightpack files is distributed in the hope that it will be
+ *	useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.	See the GNU
+ *	General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with this program.	If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef ALLOCATIONCOUNTER_HPP
+#define ALLOCATIONCOUNTER_HPP
+
+/*!
+	Counts heap allocations of the current thread while it exists. The global operator new of the
+	test binary is replaced in AllocationCounter.cpp, with glibc malloc(), calloc(), realloc() and
+	the aligned allocation functions are interposed too, so containers Qt allocates with malloc()
+	(QArrayData, QListData) are counted as well.
+*/
+class AllocationCounter
+{
+public:
+	AllocationCounter();
+	~AllocationCounter();
+	int count() const;
+
+	// false where only operator new is counted
+	static bool countsMalloc();
+};
+
+#endif // ALLOCATIONCOUNTER_HPP
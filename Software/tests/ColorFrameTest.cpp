@@ -0,0 +1,241 @@
+/*
+ * ColorFrameTest.cpp
+ *
+ *	Created on: 18.10.2026
+ *		Project: Prismatik
+ *
+ *	Lightpack is an open-source, USB content-driving ambient lighting
+ *	hardware.
+ *
+ *	Prismatik is a free, open-source software: you can redistribute it and/or
+ *	modify it under the terms of the GNU General Public License as published
+ *	by the Free Software Foundation, either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	Prismatik and Lightpack files is distributed in the hope that it will be
+ *	useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.	See the GNU
+ *	General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with this program.	If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "ColorFrameTest.hpp"
+#include <QtTest>
+#include "../src/ColorFrame.hpp"
+#include "../src/ColorFrameSlot.hpp"
+#include "../src/FrameLatency.hpp"
+#include "AllocationCounter.hpp"
+
+ColorFrameTest::ColorFrameTest()
+{
+}
+
+void ColorFrameTest::testSharing()
+{
+	const QList<QRgb> colors = QList<QRgb>() << qRgb(1, 2, 3) << qRgb(4, 5, 6) << qRgb(7, 8, 9);
+
+	ColorFrame frame(colors);
+	QCOMPARE(frame.size(), colors.size());
+	QCOMPARE(frame.toList(), colors);
+
+	ColorFrame copy = frame;
+	QCOMPARE(copy.constData(), frame.constData());
+
+	copy.data()[1] = qRgb(10, 11, 12);
+	QVERIFY(copy.constData() != frame.constData());
+	QCOMPARE(frame.toList(), colors);
+	QCOMPARE(copy[1], qRgb(10, 11, 12));
+	QVERIFY(copy != frame);
+
+	copy.fill(0);
+	QCOMPARE(copy, ColorFrame(colors.size()));
+
+	ColorFrame empty;
+	QVERIFY(empty.isEmpty());
+	QVERIFY(empty.begin() == empty.end());
+	QVERIFY(empty.toList().isEmpty());
+}
+
+void ColorFrameTest::testMetadata()
+{
+	ColorFrame frame(10, qRgb(1, 1, 1));
+	frame.setSequence(42);
+	frame.setStageTimestamp(ColorFrame::StageGrabStarted, 1234);
+
+	const ColorFrame copy = frame;
+	QCOMPARE(copy.sequence(), quint64(42));
+	QCOMPARE(copy.stageTimestamp(ColorFrame::StageGrabStarted), qint64(1234));
+
+	frame.setSequence(43);
+	QCOMPARE(copy.sequence(), quint64(42));
+	QCOMPARE(frame.sequence(), quint64(43));
+	QCOMPARE(frame.stageTimestamp(ColorFrame::StageGrabStarted), qint64(1234));
+	QCOMPARE(frame.stageTimestamp(ColorFrame::StageWritten), qint64(0));
+
+	// stamps further down the pipeline are shared and set once
+	QVERIFY(copy.markStage(ColorFrame::StageWritten));
+	const qint64 written = copy.stageTimestamp(ColorFrame::StageWritten);
+	QVERIFY(written >= 1234);
+	QVERIFY(!copy.markStage(ColorFrame::StageWritten));
+	QCOMPARE(copy.stageTimestamp(ColorFrame::StageWritten), written);
+	QVERIFY(!ColorFrame().markStage(ColorFrame::StageWritten));
+}
+
+/*
+	Frames go the way grabbed frames do: built from the grabber's list, published through the slot,
+	taken by the consumer which keeps a copy of the previous frame and passes another one on.
+	Once the pool has as many buffers as are alive at once, no frame allocates, neither a buffer
+	of the pool nor anything else from the heap. Where AllocationCounter doesn't see malloc()
+	only operator new is checked.
+*/
+void ColorFrameTest::testSteadyStateAllocations()
+{
+	const int ledsCount = 300;
+	QList<QRgb> grabbed;
+	for (int i = 0; i < ledsCount; ++i)
+		grabbed << qRgb(i % 256, 0, 0);
+
+	ColorFrameSlot slot;
+	ColorFrame taken;
+	ColorFrame saved;
+	ColorFrame queued[2]; // the last frames handed to the device
+
+	auto runFrame = [&](int i) {
+		grabbed[i % ledsCount] = qRgb(0, i % 256, 0);
+
+		ColorFrame frame(grabbed);
+		frame.setSequence(i);
+		frame.setStageTimestamp(ColorFrame::StageProcessed, ColorFrame::timestamp());
+		slot.writeBuffer() = std::move(frame);
+		slot.publish();
+
+		// the consumer misses every third frame
+		if (i % 3 != 0 && slot.take(taken)) {
+			saved = taken;
+			queued[i % 2] = taken;
+		}
+	};
+
+	for (int i = 0; i < 30; ++i)
+		runFrame(i);
+
+	const int allocated = ColorFrame::allocatedBuffersCount();
+	int allocations;
+	{
+		AllocationCounter counter;
+		for (int i = 30; i < 1030; ++i)
+			runFrame(i);
+		allocations = counter.count();
+	}
+
+	if (!AllocationCounter::countsMalloc())
+		qDebug() << "malloc() isn't counted, only operator new is checked";
+	QCOMPARE(allocations, 0);
+	QCOMPARE(ColorFrame::allocatedBuffersCount(), allocated);
+	QCOMPARE(taken.size(), ledsCount);
+	QCOMPARE(taken[1029 % ledsCount], qRgb(0, 1029 % 256, 0));
+}
+
+/*
+	A queued connection copies its arguments into an event, so frames crossing threads can't get
+	by without the heap. Qt allocates the event and the copy of the frame, before Qt 5.14 also the
+	argument and type arrays of the event with malloc(), the colors are shared. The posted event
+	list grows now and then on top.
+*/
+void ColorFrameTest::testQueuedFrameAllocations()
+{
+	const int ledsCount = 300;
+	const int framesCount = 1000;
+	const int AllocationsPerFrameMax = 5;
+
+	QList<QRgb> grabbed;
+	for (int i = 0; i < ledsCount; ++i)
+		grabbed << qRgb(i % 256, 0, 0);
+
+	ColorFrameSender sender;
+	QObject receiver;
+	ColorFrame received;
+	connect(&sender, &ColorFrameSender::frameAvailable, &receiver, [&received](const ColorFrame &frame) {
+		received = frame;
+	}, Qt::QueuedConnection);
+
+	auto runFrame = [&](int i) {
+		ColorFrame frame(grabbed);
+		frame.setSequence(i);
+		emit sender.frameAvailable(frame);
+		QCoreApplication::sendPostedEvents(&receiver, QEvent::MetaCall);
+	};
+
+	for (int i = 0; i < 30; ++i)
+		runFrame(i);
+
+	const int allocated = ColorFrame::allocatedBuffersCount();
+	int allocations;
+	{
+		AllocationCounter counter;
+		for (int i = 30; i < 30 + framesCount; ++i)
+			runFrame(i);
+		allocations = counter.count();
+	}
+
+	qDebug() << "allocations per queued frame:" << (double)allocations / framesCount;
+	QVERIFY2(allocations <= AllocationsPerFrameMax * framesCount, qPrintable(QStringLiteral("%1 allocations for %2 frames").arg(allocations).arg(framesCount)));
+	QCOMPARE(ColorFrame::allocatedBuffersCount(), allocated);
+	QCOMPARE(received.sequence(), quint64(30 + framesCount - 1));
+	QCOMPARE(received.size(), ledsCount);
+}
+
+void ColorFrameTest::testLatencyHistogram()
+{
+	LatencyHistogram histogram;
+	QCOMPARE(histogram.percentileMs(0.5), 0.0);
+
+	// 1..100 ms
+	for (int i = 1; i <= 100; ++i)
+		histogram.add(i * 1000000LL);
+	QCOMPARE(histogram.count(), 100);
+
+	// buckets are 2^(1/8) wide, the result is within half a bucket
+	const double tolerance = 1.05;
+	QVERIFY(histogram.percentileMs(0.50) > 50.0 / tolerance && histogram.percentileMs(0.50) < 50.0 * tolerance);
+	QVERIFY(histogram.percentileMs(0.95) > 95.0 / tolerance && histogram.percentileMs(0.95) < 95.0 * tolerance);
+	QVERIFY(histogram.percentileMs(0.99) > 99.0 / tolerance && histogram.percentileMs(0.99) < 99.0 * tolerance);
+
+	histogram.clear();
+	QCOMPARE(histogram.count(), 0);
+}
+
+void ColorFrameTest::testLatencyTracer()
+{
+	FrameLatencyTracer tracer;
+
+	for (int i = 0; i < 10; ++i) {
+		ColorFrame frame(3);
+		const qint64 start = 1000000000LL * (i + 1);
+		frame.setStageTimestamp(ColorFrame::StageGrabStarted, start);
+		frame.setStageTimestamp(ColorFrame::StageGrabFinished, start + 4000000);
+		frame.setStageTimestamp(ColorFrame::StageProcessed, start + 5000000);
+		frame.setStageTimestamp(ColorFrame::StageEnqueued, start + 7000000);
+		frame.setStageTimestamp(ColorFrame::StageWritten, start + 10000000);
+		tracer.addFrame(frame);
+	}
+	// not grabbed, ignored
+	ColorFrame moodLamp(3);
+	moodLamp.markStage(ColorFrame::StageEnqueued);
+	moodLamp.markStage(ColorFrame::StageWritten);
+	tracer.addFrame(moodLamp);
+
+	FrameLatencyStats stats = tracer.takeStats();
+	QCOMPARE(stats.framesCount, 10);
+	const double expectedMs[FrameLatencyStats::SpansCount] = { 4.0, 1.0, 2.0, 3.0, 10.0 };
+	for (int span = 0; span < FrameLatencyStats::SpansCount; ++span) {
+		QVERIFY2(qAbs(stats.spans[span].p50Ms / expectedMs[span] - 1.0) < 0.05, FrameLatencyStats::spanName(static_cast<FrameLatencyStats::Span>(span)));
+		QCOMPARE(stats.spans[span].p99Ms, stats.spans[span].p50Ms);
+	}
+
+	stats = tracer.takeStats();
+	QCOMPARE(stats.framesCount, 0);
+}
@@ -0,0 +1,55 @@
+/*
+ * ColorFrameTest.hpp
+ *
+ *	Created on: 18.10.2026
+ *		Project: Prismatik
+ *
+ *	Lightpack is an open-source, USB content-driving ambient lighting
+ *	hardware.
+ *
+ *	Prismatik is a free, open-source software: you can redistribute it and/or
+ *	modify it under the terms of the GNU General Public License as published
+ *	by the Free Software Foundation, either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	Prismatik and Lightpack files is distributed in the hope that it will be
+ *	useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.	See the GNU
+ *	General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with this program.	If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef COLORFRAMETEST_HPP
+#define COLORFRAMETEST_HPP
+
+#include <QObject>
+#include "../src/ColorFrame.hpp"
+
+/*!
+	Passes frames on through a queued connection, the way GrabManager does
+*/
+class ColorFrameSender: public QObject
+{
+	Q_OBJECT
+signals:
+	void frameAvailable(const ColorFrame &frame);
+};
+
+class ColorFrameTest: public QObject
+{
+	Q_OBJECT
+public:
+	ColorFrameTest();
+private Q_SLOTS:
+	void testSharing();
+	void testMetadata();
+	void testSteadyStateAllocations();
+	void testQueuedFrameAllocations();
+	void testLatencyHistogram();
+	void testLatencyTracer();
+};
+
+#endif // COLORFRAMETEST_HPP
@@ -7,3 +7,323 @@ void GrabCalculationTest::testCase1()
 	QRgb result = Grab::Calculations::calculateAvgColor(buf, BufferFormatArgb, 16, QRect(0,0,4,1));
 	QVERIFY2(result == QColor(0xfa, 0xfa, 0xfa).rgb(), qPrintable(QString("Failure. calculateAvgColor returned wrong errorcode %1").arg(result, 1, 16)));
 }
+
+void GrabCalculationTest::testCase_IntegralImage_data()
+{
+	QTest::addColumn<int>("bufferFormat");
+
+	QTest::newRow("ARGB") << (int)BufferFormatArgb;
+	QTest::newRow("ABGR") << (int)BufferFormatAbgr;
+	QTest::newRow("RGBA") << (int)BufferFormatRgba;
+	QTest::newRow("BGRA") << (int)BufferFormatBgra;
+}
+
+void GrabCalculationTest::testCase_IntegralImage()
+{
+	QFETCH(int, bufferFormat);
+
+	const int width = 133, height = 71;
+	QByteArray buf(width * height * 4, Qt::Uninitialized);
+	QRandomGenerator rnd(42);
+	for (int i = 0; i < buf.size(); ++i)
+		buf[i] = (char)rnd.bounded(256);
+	const unsigned char *data = (const unsigned char *)buf.constData();
+
+	const QRect covered(3, 2, 121, 65);
+	Grab::Calculations::IntegralImage integralImage;
+	QVERIFY(Grab::Calculations::calculateIntegralImage(data, (BufferFormat)bufferFormat, width * 4, covered, integralImage));
+
+	for (int i = 0; i < 500; ++i) {
+		const int x = covered.x() + rnd.bounded(covered.width());
+		const int y = covered.y() + rnd.bounded(covered.height());
+		const QRect rect(x, y, 1 + rnd.bounded(covered.right() - x + 1), 1 + rnd.bounded(covered.bottom() - y + 1));
+
+		const QRgb expected = Grab::Calculations::calculateAvgColor(data, (BufferFormat)bufferFormat, width * 4, rect);
+		const QRgb result = Grab::Calculations::calculateAvgColor(integralImage, rect);
+		QVERIFY2(result == expected, qPrintable(QString("Failure. integral image average %1 != %2 for rect %3,%4 %5x%6")
+			.arg(result, 1, 16).arg(expected, 1, 16).arg(rect.x()).arg(rect.y()).arg(rect.width()).arg(rect.height())));
+	}
+}
+
+void GrabCalculationTest::benchmarkAvgColor_data()
+{
+	QTest::addColumn<bool>("isIntegralImage");
+
+	QTest::newRow("accumulate") << false;
+	QTest::newRow("integral image") << true;
+}
+
+void GrabCalculationTest::benchmarkAvgColor()
+{
+	QFETCH(bool, isIntegralImage);
+
+	// 4K screen with 320 overlapping zones, 40 along each edge and 160 across the middle
+	const int width = 3840, height = 2160;
+	QByteArray buf(width * height * 4, (char)0x7f);
+	const unsigned char *data = (const unsigned char *)buf.constData();
+
+	QList<QRect> zones;
+	for (int i = 0; i < 40; ++i) {
+		zones << QRect(i * 94, 0, 150, 300) << QRect(i * 94, height - 300, 150, 300);
+		zones << QRect(0, i * 50, 400, 80) << QRect(width - 400, i * 50, 400, 80);
+	}
+	for (int i = 0; i < 160; ++i)
+		zones << QRect((i % 16) * 220, (i / 16) * 190, 600, 400);
+
+	Grab::Calculations::IntegralImage integralImage;
+	QRgb result = 0;
+	QBENCHMARK {
+		if (isIntegralImage) {
+			Grab::Calculations::calculateIntegralImage(data, BufferFormatArgb, width * 4, QRect(0, 0, width, height), integralImage);
+			for (const QRect &zone : zones)
+				result ^= Grab::Calculations::calculateAvgColor(integralImage, zone);
+		} else {
+			for (const QRect &zone : zones)
+				result ^= Grab::Calculations::calculateAvgColor(data, BufferFormatArgb, width * 4, zone);
+		}
+	}
+	Q_UNUSED(result);
+}
+
+void GrabCalculationTest::testCase_SamplingStride_data()
+{
+	QTest::addColumn<int>("bufferFormat");
+	QTest::addColumn<int>("samplingStride");
+
+	const QList<int> formats = { BufferFormatArgb, BufferFormatAbgr, BufferFormatRgba, BufferFormatBgra };
+	const QList<int> strides = { 2, 3, 4, 8, 16 };
+	for (const int format : formats)
+		for (const int stride : strides)
+			QTest::newRow(qPrintable(QString("format %1 stride %2").arg(format).arg(stride))) << format << stride;
+}
+
+void GrabCalculationTest::testCase_SamplingStride()
+{
+	QFETCH(int, bufferFormat);
+	QFETCH(int, samplingStride);
+
+	// uniform color has to come out exact
+	QByteArray uniform(64 * 64 * 4, (char)0x5a);
+	QRgb result = Grab::Calculations::calculateAvgColor((const unsigned char *)uniform.constData(), (BufferFormat)bufferFormat, 64 * 4, QRect(1, 3, 61, 57), samplingStride);
+	QVERIFY2(result == qRgb(0x5a, 0x5a, 0x5a), qPrintable(QString("Failure. strided average of uniform buffer is %1").arg(result, 1, 16)));
+
+	// smooth gradient with noise, roughly what a video frame looks like at zone scale
+	const int width = 640, height = 360;
+	QByteArray buf(width * height * 4, Qt::Uninitialized);
+	QRandomGenerator rnd(42);
+	for (int y = 0; y < height; ++y)
+		for (int x = 0; x < width; ++x)
+			for (int c = 0; c < 4; ++c)
+				buf[(y * width + x) * 4 + c] = (char)qBound(0, 8 + (x * (c + 1) / 4 + y) / 5 + rnd.bounded(-8, 9), 255);
+	const unsigned char *data = (const unsigned char *)buf.constData();
+
+	const QList<QRect> zones = { QRect(0, 0, 150, 150), QRect(17, 200, 101, 33), QRect(400, 5, 213, 80), QRect(600, 300, 40, 60) };
+	for (const QRect &zone : zones) {
+		const QRgb full = Grab::Calculations::calculateAvgColor(data, (BufferFormat)bufferFormat, width * 4, zone);
+		const QRgb sampled = Grab::Calculations::calculateAvgColor(data, (BufferFormat)bufferFormat, width * 4, zone, samplingStride);
+		const int maxDiff = qMax(qAbs(qRed(full) - qRed(sampled)), qMax(qAbs(qGreen(full) - qGreen(sampled)), qAbs(qBlue(full) - qBlue(sampled))));
+		QVERIFY2(maxDiff <= 3, qPrintable(QString("Failure. sampled average %1 is too far from %2").arg(sampled, 1, 16).arg(full, 1, 16)));
+	}
+}
+
+void GrabCalculationTest::benchmarkSamplingStride_data()
+{
+	QTest::addColumn<int>("samplingStride");
+
+	QTest::newRow("stride 1") << 1;
+	QTest::newRow("stride 2") << 2;
+	QTest::newRow("stride 4") << 4;
+	QTest::newRow("stride 8") << 8;
+	QTest::newRow("stride 16") << 16;
+}
+
+void GrabCalculationTest::benchmarkSamplingStride()
+{
+	QFETCH(int, samplingStride);
+
+	// 4K screen with a 10% border band split into 100 zones
+	const int width = 3840, height = 2160;
+	QByteArray buf(width * height * 4, (char)0x7f);
+	const unsigned char *data = (const unsigned char *)buf.constData();
+
+	QList<QRect> zones;
+	for (int i = 0; i < 32; ++i)
+		zones << QRect(i * 120, 0, 120, 216) << QRect(i * 120, height - 216, 120, 216);
+	for (int i = 0; i < 18; ++i)
+		zones << QRect(0, i * 120, 384, 120) << QRect(width - 384, i * 120, 384, 120);
+
+	QRgb result = 0;
+	QBENCHMARK {
+		for (const QRect &zone : zones)
+			result ^= Grab::Calculations::calculateAvgColor(data, BufferFormatArgb, width * 4, zone, samplingStride);
+	}
+	Q_UNUSED(result);
+}
+
+void GrabCalculationTest::testCase_FramePacer()
+{
+	using namespace std::chrono;
+	typedef Grab::FramePacer::Clock Clock;
+	const Clock::time_point t0 = Clock::now();
+
+	Grab::FramePacer pacer;
+	pacer.setTargetInterval(milliseconds(20));
+	pacer.reset(t0);
+	QVERIFY(pacer.nextDeadline() == t0);
+
+	// frames started on time keep the schedule
+	for (int i = 0; i < 10; ++i) {
+		const Clock::time_point start = pacer.nextDeadline();
+		pacer.frameStarted(start);
+		pacer.frameFinished(start + milliseconds(2));
+		QVERIFY(pacer.nextDeadline() == t0 + milliseconds(20) * (i + 1));
+	}
+	Grab::FramePacingStats stats = pacer.takeStats();
+	QCOMPARE(stats.framesCount, 10);
+	QCOMPARE(stats.deadlineMisses, 0);
+	QCOMPARE(stats.intervalMs, 20.0);
+	QCOMPARE(stats.frameTimeMs, 20.0);
+	QCOMPARE(stats.latencyMs, 2.0);
+	QCOMPARE(stats.jitterMs, 0.0);
+
+	// a slow frame skips the passed deadlines but keeps the phase
+	const Clock::time_point start = pacer.nextDeadline();
+	pacer.frameStarted(start + milliseconds(1));
+	pacer.frameFinished(start + milliseconds(45));
+	QVERIFY(pacer.nextDeadline() == start + milliseconds(60));
+	stats = pacer.takeStats();
+	QCOMPARE(stats.deadlineMisses, 2);
+	QCOMPARE(stats.jitterMs, 1.0);
+
+	// a source which isn't ready still moves the schedule on, without frames or misses
+	const Clock::time_point skipped = pacer.nextDeadline();
+	pacer.skipFrame(skipped);
+	QVERIFY(pacer.nextDeadline() == skipped + milliseconds(20));
+	pacer.skipFrame(skipped + milliseconds(50));
+	QVERIFY(pacer.nextDeadline() == skipped + milliseconds(60));
+	stats = pacer.takeStats();
+	QCOMPARE(stats.framesCount, 0);
+	QCOMPARE(stats.deadlineMisses, 0);
+
+	// frames which don't fit into the target interval stretch it
+	Grab::FramePacer slowPacer;
+	slowPacer.setTargetInterval(milliseconds(10));
+	slowPacer.reset(t0);
+	slowPacer.frameStarted(t0);
+	slowPacer.frameFinished(t0 + milliseconds(20));
+	QVERIFY(slowPacer.interval() == microseconds(25000));
+	QVERIFY(slowPacer.targetInterval() == milliseconds(10));
+}
+
+void GrabCalculationTest::testCase_FramePacerRefreshAlignment()
+{
+	using namespace std::chrono;
+	typedef Grab::FramePacer::Clock Clock;
+
+	Grab::FramePacer pacer;
+	pacer.setDisplayRefreshRate(60.0);
+	pacer.setTargetInterval(milliseconds(30));
+	QVERIFY(pacer.interval() == milliseconds(30));
+
+	pacer.setAlignToDisplayRefresh(true);
+	QVERIFY(pacer.interval() == microseconds(2 * 16667));
+
+	pacer.setTargetInterval(milliseconds(20));
+	QVERIFY(pacer.interval() == microseconds(16667));
+
+	// never snaps below what the frames need
+	pacer.setTargetInterval(milliseconds(10));
+	const Clock::time_point t0 = Clock::now();
+	pacer.reset(t0);
+	pacer.frameStarted(t0);
+	pacer.frameFinished(t0 + milliseconds(15));
+	QVERIFY(pacer.interval() == microseconds(2 * 16667));
+
+	// unknown refresh rate disables the alignment
+	pacer.setDisplayRefreshRate(0.0);
+	QVERIFY(pacer.interval() == microseconds(18750));
+}
+
+void GrabCalculationTest::testCase_SyntheticGrabber()
+{
+	QList<QRgb> result;
+	GrabberContext context;
+	context.grabResult = &result;
+
+	// one zone in the middle of each bar, frame stretched over a desktop twice its size
+	QList<GrabbedArea> areas;
+	for (int i = 0; i < 8; ++i) {
+		GrabbedArea area;
+		area.rect = QRect(i * 40 + 10, 20, 20, 20);
+		areas.append(area);
+	}
+	context.setGrabAreas(areas);
+
+	SyntheticGrabber grabber(NULL, &context);
+	grabber.setSource(QStringLiteral("bars"), QSize(160, 30), 0, QRect(0, 0, 320, 60));
+	grabber.grab();
+	QCOMPARE(result.size(), 8);
+	QCOMPARE(result[0], qRgb(191, 191, 191));
+	QCOMPARE(result[2], qRgb(0, 191, 191));
+	QCOMPARE(result[5], qRgb(191, 0, 0));
+	QCOMPARE(result[7], qRgb(0, 0, 0));
+
+	// frames only depend on the frame number
+	grabber.setSource(QStringLiteral("noise"), QSize(160, 30), 0, QRect(0, 0, 320, 60));
+	grabber.grab();
+	const QList<QRgb> first = result;
+	grabber.grab();
+	QVERIFY(result != first);
+
+	SyntheticGrabber other(NULL, &context);
+	other.setSource(QStringLiteral("noise"), QSize(160, 30), 0, QRect(0, 0, 320, 60));
+	other.grab();
+	QCOMPARE(result.size(), first.size());
+	QVERIFY(result == first);
+
+	// flash alternates every frame
+	grabber.setSource(QStringLiteral("flash"), QSize(160, 30), 0, QRect());
+	grabber.grab();
+	QCOMPARE(result[0], qRgb(0, 0, 0));
+	grabber.grab();
+	QCOMPARE(result[0], qRgb(255, 255, 255));
+}
+
+#ifdef PIPEWIRE_GRAB_SUPPORT
+void GrabCalculationTest::testCase_PipeWireGrabber()
+{
+	// needs a local PipeWire daemon with a test source, the portal is bypassed
+	if (qEnvironmentVariableIsEmpty("PRISMATIK_PIPEWIRE_NODE"))
+		QSKIP("set PRISMATIK_PIPEWIRE_NODE to the node id of "
+			  "\"gst-launch-1.0 videotestsrc pattern=red ! video/x-raw,format=BGRx ! pipewiresink\" (see pw-cli ls Node)");
+
+	QList<QRgb> result;
+	GrabberContext context;
+	context.grabResult = &result;
+
+	// the node is mapped onto the first screen, the same way the grabber does it
+	const QList<QScreen *> screens = QGuiApplication::screens();
+	const QRect desktop = screens.isEmpty() ? QRect(0, 0, 1920, 1080) : screens.first()->geometry();
+
+	QList<GrabbedArea> areas;
+	GrabbedArea area;
+	area.rect = QRect(desktop.center() - QPoint(50, 50), QSize(100, 100));
+	areas.append(area);
+	context.setGrabAreas(areas);
+
+	PipeWireGrabber grabber(NULL, &context);
+	grabber.startGrabbing();
+
+	// the stream has to be linked and negotiated before the first frame comes
+	for (int i = 0; i < 250 && result.isEmpty(); ++i) {
+		QTest::qWait(20);
+		grabber.grab();
+	}
+	grabber.stopGrabbing();
+
+	QCOMPARE(result.size(), 1);
+	QVERIFY(qRed(result[0]) > 200);
+	QVERIFY(qGreen(result[0]) < 50);
+	QVERIFY(qBlue(result[0]) < 50);
+}
+#endif
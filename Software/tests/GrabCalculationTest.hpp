@@ -28,8 +28,14 @@
 #include <QtTest>
 #include <QRgb>
 #include <QRect>
+#include <QRandomGenerator>
+#include <QGuiApplication>
+#include <QScreen>
 #include "enums.hpp"
 #include "calculations.hpp"
+#include "FramePacer.hpp"
+#include "SyntheticGrabber.hpp"
+#include "PipeWireGrabber.hpp"
 
 class GrabCalculationTest : public QObject
 {
@@ -40,5 +46,19 @@ public:
 	
 private Q_SLOTS:
 	void testCase1();
+	void testCase_IntegralImage();
+	void testCase_IntegralImage_data();
+	void benchmarkAvgColor();
+	void benchmarkAvgColor_data();
+	void testCase_SamplingStride();
+	void testCase_SamplingStride_data();
+	void benchmarkSamplingStride();
+	void benchmarkSamplingStride_data();
+	void testCase_FramePacer();
+	void testCase_FramePacerRefreshAlignment();
+	void testCase_SyntheticGrabber();
+#ifdef PIPEWIRE_GRAB_SUPPORT
+	void testCase_PipeWireGrabber();
+#endif
 };
 
@@ -26,6 +26,7 @@
 #include <QString>
 #include <QApplication>
 #include <QTest>
+#include <QtEndian>
 
 #include "debug.h"
 #include "ApiServer.hpp"
@@ -439,6 +440,112 @@ void LightpackApiTest::testCase_SetColorInvalid_data()
 	QTest::newRow("17") << "1-1,1,1;;";
 }
 
+void LightpackApiTest::testCase_SetColorBinary()
+{
+	// LEDs 2 and 3
+	const QByteArray frame = binaryFrame(ApiServer::BinaryFrameSetColor, QByteArray::fromHex("0001" "170241" "ff0080"));
+
+	QVERIFY(setBinaryMode(m_socket));
+
+	// Test lock state in binary frames:
+	QVERIFY(writeFrameWithCheck(m_socket, frame, ApiServer::CmdSetResult_NotLocked));
+
+	// Text commands still work in binary mode
+	QVERIFY(lock(m_socket));
+
+	QVERIFY(writeFrameWithCheck(m_socket, frame, ApiServer::CmdSetResult_Ok));
+
+	processEventsFromLittle();
+
+	QVERIFY(m_little->m_colors[1] == qRgb(0x17, 0x02, 0x41));
+	QVERIFY(m_little->m_colors[2] == qRgb(0xff, 0x00, 0x80));
+
+	// Test frame which comes in pieces
+	m_socket->write(frame.left(4));
+	QVERIFY(m_socket->waitForBytesWritten(1000));
+	QTest::qWait(50);
+	QVERIFY(writeFrameWithCheck(m_socket, frame.mid(4), ApiServer::CmdSetResult_Ok));
+
+	QVERIFY(unlock(m_socket));
+}
+
+void LightpackApiTest::testCase_SetColorBinaryInvalid()
+{
+	QFETCH(int, type);
+	QFETCH(QByteArray, payload);
+
+	QVERIFY(setBinaryMode(m_socket));
+	QVERIFY(lock(m_socket));
+
+	QVERIFY(writeFrameWithCheck(m_socket, binaryFrame(type, payload), ApiServer::CmdSetResult_Error));
+
+	// The invalid frame is skipped as a whole, the next one is read from its start
+	QVERIFY(writeFrameWithCheck(m_socket, binaryFrame(ApiServer::BinaryFrameSetColor, QByteArray::fromHex("0000" "010101")), ApiServer::CmdSetResult_Ok));
+
+	QVERIFY(unlock(m_socket));
+}
+
+void LightpackApiTest::testCase_SetColorBinaryInvalid_data()
+{
+	QTest::addColumn<int>("type");
+	QTest::addColumn<QByteArray>("payload");
+
+	QTest::newRow("1") << (int)ApiServer::BinaryFrameSetColor << QByteArray::fromHex("0009" "010101" "010101"); // 11th LED
+	QTest::newRow("2") << (int)ApiServer::BinaryFrameSetColor << QByteArray::fromHex("0000");
+	QTest::newRow("3") << (int)ApiServer::BinaryFrameSetColor << QByteArray::fromHex("0000" "01010101");
+	QTest::newRow("4") << (int)ApiServer::BinaryFrameSetColor << QByteArray::fromHex("00");
+	QTest::newRow("5") << (int)ApiServer::BinaryFrameSetColor << QByteArray();
+	QTest::newRow("6") << 2 << QByteArray::fromHex("0000" "010101");
+}
+
+void LightpackApiTest::testCase_SetColorThroughput()
+{
+	QFETCH(bool, isBinary);
+
+	// Setcolor numbers LEDs with 3 digits at most
+	const int numberOfLeds = 999;
+	emit m_apiServer->updateApiDeviceNumberOfLeds(numberOfLeds);
+
+	QByteArray command;
+	if (isBinary)
+	{
+		QVERIFY(setBinaryMode(m_socket));
+
+		QByteArray payload = QByteArray::fromHex("0000");
+		for (int i = 0; i < numberOfLeds; i++)
+			payload.append(static_cast<char>(i)).append(static_cast<char>(i * 3)).append(static_cast<char>(i * 7));
+		command = binaryFrame(ApiServer::BinaryFrameSetColor, payload);
+	} else {
+		command = ApiServer::CmdSetColor;
+		for (int i = 0; i < numberOfLeds; i++)
+			command += QByteArray::number(i + 1) + '-' + QByteArray::number(i % 256) + ',' + QByteArray::number(i * 3 % 256) + ',' + QByteArray::number(i * 7 % 256) + ';';
+		command += '\n';
+	}
+
+	QVERIFY(lock(m_socket));
+
+	bool isOk = true;
+	QBENCHMARK {
+		isOk &= writeFrameWithCheck(m_socket, command, ApiServer::CmdSetResult_Ok);
+	}
+	QVERIFY(isOk);
+
+	QVERIFY(unlock(m_socket));
+
+	// Colors sent meanwhile aren't needed
+	QApplication::processEvents();
+
+	emit m_apiServer->updateApiDeviceNumberOfLeds(Settings::getNumberOfLeds(Settings::getConnectedDevice()));
+}
+
+void LightpackApiTest::testCase_SetColorThroughput_data()
+{
+	QTest::addColumn<bool>("isBinary");
+
+	QTest::newRow("text") << false;
+	QTest::newRow("binary") << true;
+}
+
 void LightpackApiTest::testCase_SetGammaValid()
 {
 	QVERIFY(lock(m_socket));
@@ -718,6 +825,32 @@ bool LightpackApiTest::writeCommandWithCheck(QTcpSocket * socket, const QByteArr
 	return (m_sockReadLineOk && read == result);
 }
 
+bool LightpackApiTest::writeFrameWithCheck(QTcpSocket * socket, const QByteArray & frame, const QByteArray & result)
+{
+	socket->write(frame);
+	QByteArray read = readResult(socket);
+
+	return (m_sockReadLineOk && read == result);
+}
+
+QByteArray LightpackApiTest::binaryFrame(int type, const QByteArray & payload)
+{
+	QByteArray frame(ApiServer::BinaryFrameHeaderSize, 0);
+	frame[0] = ApiServer::BinaryFrameMagic;
+	frame[1] = static_cast<char>(type);
+	qToBigEndian<quint32>(payload.size(), frame.data() + 2);
+
+	return frame + payload;
+}
+
+bool LightpackApiTest::setBinaryMode(QTcpSocket * socket)
+{
+	QByteArray setBinaryModeCmd = ApiServer::CmdSetBinaryMode;
+	setBinaryModeCmd += ApiServer::CmdSetBinaryMode_On;
+
+	return writeCommandWithCheck(socket, setBinaryModeCmd, ApiServer::CmdSetResult_Ok);
+}
+
 QString LightpackApiTest::getProfilesResultString()
 {
 	QStringList profiles = Settings::findAllProfiles();
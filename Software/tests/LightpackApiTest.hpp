@@ -12,6 +12,7 @@
 // lock - begin work with api (disable capture,backlight)
 // unlock - end work with api (enable capture,backlight)
 // setcolor:1-r,g,b;5-r,g,b;	numbering starts with 1
+// setbinarymode:on - accept binary setcolor frames besides text commands
 // setgamma:2.00 - set gamma for setcolor
 // setsmooth:100 - set smooth in device
 // setprofile:<name> - set profile
@@ -52,6 +53,12 @@ private Q_SLOTS:
 	void testCase_SetColorInvalid();
 	void testCase_SetColorInvalid_data();
 
+	void testCase_SetColorBinary();
+	void testCase_SetColorBinaryInvalid();
+	void testCase_SetColorBinaryInvalid_data();
+	void testCase_SetColorThroughput();
+	void testCase_SetColorThroughput_data();
+
 	void testCase_SetGammaValid();
 	void testCase_SetGammaValid_data();
 	void testCase_SetGammaInvalid();
@@ -76,6 +83,9 @@ private:
 	QByteArray readResult(QTcpSocket * socket);
 	void writeCommand(QTcpSocket * socket, const char * cmd);
 	bool writeCommandWithCheck(QTcpSocket * socket, const QByteArray & command, const QByteArray & result);
+	bool writeFrameWithCheck(QTcpSocket * socket, const QByteArray & frame, const QByteArray & result);
+	QByteArray binaryFrame(int type, const QByteArray & payload);
+	bool setBinaryMode(QTcpSocket * socket);
 
 	QString getProfilesResultString();
 	void processEventsFromLittle();
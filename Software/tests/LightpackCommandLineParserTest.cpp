@@ -102,3 +102,28 @@ void LightpackCommandLineParserTest::testCase_parseDebuglevel()
 		QCOMPARE(parser.debugLevel(), levelValues[i]);
 	}
 }
+
+void LightpackCommandLineParserTest::testCase_parseSyntheticGrab()
+{
+	LightpackCommandLineParser parser;
+	const QStringList arguments = QStringList() << "app.binary" << "--synthetic-grab=noise"
+		<< "--synthetic-grab-size=1920x1080" << "--synthetic-grab-fps=120";
+
+	QVERIFY(parser.parse(arguments));
+	QVERIFY(parser.isSetSyntheticGrab());
+	QCOMPARE(parser.syntheticGrabSource(), QString("noise"));
+	QCOMPARE(parser.syntheticGrabResolution(), QSize(1920, 1080));
+	QCOMPARE(parser.syntheticGrabFrameRate(), 120);
+
+	LightpackCommandLineParser parser2;
+	const QStringList arguments2 = QStringList() << "app.binary" << "--synthetic-grab=frames.bgra";
+	QVERIFY(parser2.parse(arguments2));
+	QCOMPARE(parser2.syntheticGrabSource(), QString("frames.bgra"));
+	QVERIFY(parser2.syntheticGrabResolution().isEmpty());
+	QCOMPARE(parser2.syntheticGrabFrameRate(), 0);
+
+	LightpackCommandLineParser parser3;
+	const QStringList arguments3 = QStringList() << "app.binary" << "--synthetic-grab=bars" << "--synthetic-grab-size=1920";
+	QVERIFY(!parser3.parse(arguments3));
+	QVERIFY(!parser3.errorText().isEmpty());
+}
@@ -47,6 +47,7 @@ private slots:
 	void testCase_parseBacklightOn();
 	void testCase_parseBacklightOnAndOff();
 	void testCase_parseDebuglevel();
+	void testCase_parseSyntheticGrab();
 };
 
 #endif // LIGHTPACKCOMMANDLINEPARSERTEST_H
@@ -3,6 +3,8 @@
 #include "GrabCalculationTest.hpp"
 #include "lightpackmathtest.hpp"
 #include "AppVersionTest.hpp"
+#include "ColorFrameTest.hpp"
+#include "UdpFanoutSenderTest.hpp"
 #ifdef Q_OS_WIN
 #include "HooksTest.h"
 #endif
@@ -32,6 +34,8 @@ int main(int argc, char *argv[])
 	tests.append(new LightpackMathTest());
 	tests.append(new LightpackApiTest());
 	tests.append(new AppVersionTest());
+	tests.append(new ColorFrameTest());
+	tests.append(new UdpFanoutSenderTest());
 	tests.append(new LightpackCommandLineParserTest());
 
 	for(int i=0; i < tests.size(); i++) {
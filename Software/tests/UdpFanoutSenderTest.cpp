@@ -0,0 +1,157 @@
+/*
+ * UdpFanoutSenderTest.cpp
+ *
+ *	Created on: 18.10.2026
+ *		Project: Prismatik
+ *
+ *	Lightpack is an open-source, USB content-driving ambient lighting
+ *	hardware.
+ *
+ *	Prismatik is a free, open-source software: you can redistribute it and/or
+ *	modify it under the terms of the GNU General Public License as published
+ *	by the Free Software Foundation, either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	Prismatik and Lightpack files is distributed in the hope that it will be
+ *	useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.	See the GNU
+ *	General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with this program.	If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "UdpFanoutSenderTest.hpp"
+#include <QtTest>
+#include <QThread>
+#include <QUdpSocket>
+#include "../src/UdpFanoutSender.hpp"
+
+Q_DECLARE_METATYPE(QList<UdpFanoutSender::Endpoint>)
+
+namespace
+{
+UdpFanoutSender::Endpoint endpoint(const QString &address, quint16 port, int firstLed, int ledsCount)
+{
+	UdpFanoutSender::Endpoint result;
+	result.address = address;
+	result.port = port;
+	result.firstLed = firstLed;
+	result.ledsCount = ledsCount;
+	return result;
+}
+}
+
+UdpFanoutSenderTest::UdpFanoutSenderTest()
+{
+}
+
+void UdpFanoutSenderTest::testParseEndpoints_data()
+{
+	typedef QList<UdpFanoutSender::Endpoint> Endpoints;
+
+	QTest::addColumn<QString>("endpoints");
+	QTest::addColumn<Endpoints>("expected");
+	QTest::addColumn<int>("skippedCount");
+
+	QTest::newRow("valid") << "192.168.1.10:21324=0-29;192.168.1.11:21325=30-99"
+		<< (Endpoints() << endpoint("192.168.1.10", 21324, 0, 30) << endpoint("192.168.1.11", 21325, 30, 70)) << 0;
+	QTest::newRow("spaces and empty entries") << " wled.local : 21324 = 5 - 5 ;;"
+		<< (Endpoints() << endpoint("wled.local", 21324, 5, 1)) << 0;
+
+	QTest::newRow("overlapping ranges are mirrored") << "10.0.0.1:21324=0-49;10.0.0.2:21324=25-74"
+		<< (Endpoints() << endpoint("10.0.0.1", 21324, 0, 50) << endpoint("10.0.0.2", 21324, 25, 50)) << 0;
+	QTest::newRow("same range twice") << "10.0.0.1:21324=0-9;10.0.0.2:21324=0-9"
+		<< (Endpoints() << endpoint("10.0.0.1", 21324, 0, 10) << endpoint("10.0.0.2", 21324, 0, 10)) << 0;
+
+	QTest::newRow("no range") << "10.0.0.1:21324" << Endpoints() << 1;
+	QTest::newRow("no port") << "10.0.0.1=0-9" << Endpoints() << 1;
+	QTest::newRow("no address") << ":21324=0-9" << Endpoints() << 1;
+	QTest::newRow("port 0") << "10.0.0.1:0=0-9" << Endpoints() << 1;
+	QTest::newRow("port out of range") << "10.0.0.1:70000=0-9" << Endpoints() << 1;
+	QTest::newRow("single LED index") << "10.0.0.1:21324=5" << Endpoints() << 1;
+	QTest::newRow("reversed range") << "10.0.0.1:21324=9-0" << Endpoints() << 1;
+	QTest::newRow("negative index") << "10.0.0.1:21324=-1-9" << Endpoints() << 1;
+	QTest::newRow("not a number") << "10.0.0.1:21324=a-b" << Endpoints() << 1;
+	QTest::newRow("malformed one skipped") << "10.0.0.1:21324=0-9;garbage;10.0.0.2:21324=10-19"
+		<< (Endpoints() << endpoint("10.0.0.1", 21324, 0, 10) << endpoint("10.0.0.2", 21324, 10, 10)) << 1;
+
+	// the LED count is 100
+	QTest::newRow("last LED") << "10.0.0.1:21324=90-99"
+		<< (Endpoints() << endpoint("10.0.0.1", 21324, 90, 10)) << 0;
+	QTest::newRow("ending beyond the LED count") << "10.0.0.1:21324=0-49;10.0.0.2:21324=50-100"
+		<< (Endpoints() << endpoint("10.0.0.1", 21324, 0, 50)) << 1;
+	QTest::newRow("starting beyond the LED count") << "10.0.0.1:21324=100-109" << Endpoints() << 1;
+}
+
+void UdpFanoutSenderTest::testParseEndpoints()
+{
+	QFETCH(QString, endpoints);
+	QFETCH(QList<UdpFanoutSender::Endpoint>, expected);
+	QFETCH(int, skippedCount);
+
+	// every skipped entry is reported
+	for (int i = 0; i < skippedCount; i++)
+		QTest::ignoreMessage(QtWarningMsg, QRegularExpression(QStringLiteral("skipping")));
+
+	const QList<UdpFanoutSender::Endpoint> result = UdpFanoutSender::parseEndpoints(endpoints, 100);
+
+	QCOMPARE(result.size(), expected.size());
+	for (int i = 0; i < result.size(); i++) {
+		QCOMPARE(result[i].address, expected[i].address);
+		QCOMPARE(result[i].port, expected[i].port);
+		QCOMPARE(result[i].firstLed, expected[i].firstLed);
+		QCOMPARE(result[i].ledsCount, expected[i].ledsCount);
+	}
+}
+
+void UdpFanoutSenderTest::testWritePackets()
+{
+	QUdpSocket controllers[2];
+	QVERIFY(controllers[0].bind(QHostAddress::LocalHost, 0));
+	QVERIFY(controllers[1].bind(QHostAddress::LocalHost, 0));
+
+	const QList<UdpFanoutSender::Endpoint> endpoints = QList<UdpFanoutSender::Endpoint>()
+		<< endpoint(QStringLiteral("127.0.0.1"), controllers[0].localPort(), 0, 10)
+		<< endpoint(QStringLiteral("127.0.0.1"), controllers[1].localPort(), 10, 10);
+
+	QThread networkThread;
+	UdpFanoutSender sender(endpoints);
+	sender.moveToThread(&networkThread);
+	networkThread.start();
+
+	QMetaObject::invokeMethod(&sender, "open", Qt::BlockingQueuedConnection);
+
+	// packets are built here, as by the device thread
+	const QByteArray packets[2] = { QByteArrayLiteral("\x04\xff\x00\x00first"), QByteArrayLiteral("\x04\xff\x00\x00second") };
+	for (int i = 0; i < 2; i++) {
+		char *out = sender.sender(i).beginPacket(packets[i]);
+		sender.sender(i).endPacket(out);
+	}
+
+	// the result comes back queued, like to the device thread
+	bool isWritten = false, ok = false;
+	QEventLoop loop;
+	connect(&sender, &UdpFanoutSender::packetsWritten, &loop, [&](bool result) {
+		isWritten = true;
+		ok = result;
+		loop.quit();
+	});
+	QTimer::singleShot(1000, &loop, &QEventLoop::quit);
+	QMetaObject::invokeMethod(&sender, "writePackets", Qt::QueuedConnection);
+	loop.exec();
+	QVERIFY(isWritten);
+	QVERIFY(ok);
+
+	for (int i = 0; i < 2; i++) {
+		QVERIFY(controllers[i].hasPendingDatagrams() || controllers[i].waitForReadyRead(1000));
+		QByteArray datagram(controllers[i].pendingDatagramSize(), Qt::Uninitialized);
+		controllers[i].readDatagram(datagram.data(), datagram.size());
+		QCOMPARE(datagram, packets[i]);
+	}
+
+	QMetaObject::invokeMethod(&sender, "close", Qt::BlockingQueuedConnection);
+	networkThread.quit();
+	networkThread.wait();
+}
@@ -0,0 +1,41 @@
+/*
+ * UdpFanoutSenderTest.hpp
+ *
+ *	Created on: 18.10.2026
+ *		Project: Prismatik
+ *
+ *	Lightpack is an open-source, USB content-driving ambient lighting
+ *	hardware.
+ *
+ *	Prismatik is a free, open-source software: you can redistribute it and/or
+ *	modify it under the terms of the GNU General Public License as published
+ *	by the Free Software Foundation, either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	Prismatik and Lightpack files is distributed in the hope that it will be
+ *	useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.	See the GNU
+ *	General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with this program.	If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef UDPFANOUTSENDERTEST_HPP
+#define UDPFANOUTSENDERTEST_HPP
+
+#include <QObject>
+
+class UdpFanoutSenderTest: public QObject
+{
+	Q_OBJECT
+public:
+	UdpFanoutSenderTest();
+private Q_SLOTS:
+	void testParseEndpoints_data();
+	void testParseEndpoints();
+	void testWritePackets();
+};
+
+#endif // UDPFANOUTSENDERTEST_HPP
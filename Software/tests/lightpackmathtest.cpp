@@ -1,6 +1,20 @@
 #include "lightpackmathtest.hpp"
 #include "PrismatikMath.hpp"
+#include "ColorCorrectionLut.hpp"
+#include "ColorBatch.hpp"
+#include "TemporalFilter.hpp"
+#include "ColorSequence.hpp"
+#include "SampleRing.hpp"
+#include "TripleBuffer.hpp"
+#include "BeatTracker.hpp"
+#include "FilterBank.hpp"
+#if defined(PULSEAUDIO_SUPPORT) || defined(PIPEWIRE_AUDIO_SUPPORT)
+#include "SpectrumAnalyzer.hpp"
+#endif
 #include <QtTest>
+#include <algorithm>
+#include <cmath>
+#include <vector>
 
 LightpackMathTest::LightpackMathTest(QObject *parent) :
 	QObject(parent)
@@ -15,3 +29,464 @@ void LightpackMathTest::testCase1()
 
 	QVERIFY2( PrismatikMath::withChromaHSV(testRgb, PrismatikMath::getChromaHSV(testRgb)) == testRgb, "getChromaHSV() is incorrect");
 }
+
+void LightpackMathTest::testColorCorrectionLut()
+{
+	PrismatikMath::ColorCorrectionLut lut;
+	const double gammas[] = { 1.0, 2.2, 0.6 };
+	for (const double gamma : gammas) {
+		lut.setGamma(gamma);
+		lut.setBrightness(73);
+		lut.setLuminosityThreshold(20);
+		for (int i = 0; i < 256; ++i) {
+			// gray and single channel colors
+			const QRgb colors[] = { qRgb(i, i, i), qRgb(i, 0, 0), qRgb(0, i, 0), qRgb(0, 0, i), qRgb(i, 255 - i, i / 2) };
+			for (const QRgb color : colors) {
+				const double k = 4095/255.0;
+				StructRgb expected;
+				expected.r = qRed(color) * k;
+				expected.g = qGreen(color) * k;
+				expected.b = qBlue(color) * k;
+				PrismatikMath::gammaCorrection(gamma, expected);
+				const StructLab lab = PrismatikMath::toLab(expected);
+
+				StructRgb actual = lut.gammaCorrected(color);
+				QCOMPARE(actual.r, expected.r);
+				QCOMPARE(actual.g, expected.g);
+				QCOMPARE(actual.b, expected.b);
+				QCOMPARE(PrismatikMath::ColorCorrectionLut::lightness(lut.luminance(color)), static_cast<int>(lab.l));
+				QCOMPARE(lut.isBelowThreshold(color), lab.l < 20);
+
+				PrismatikMath::brightnessCorrection(73, expected);
+				actual = lut.corrected(color);
+				QCOMPARE(actual.r, expected.r);
+				QCOMPARE(actual.g, expected.g);
+				QCOMPARE(actual.b, expected.b);
+			}
+		}
+	}
+}
+
+namespace
+{
+	// 1500 LEDs, about what a long DNRGB strip has
+	QList<QRgb> batchColors()
+	{
+		QList<QRgb> colors;
+		QRandomGenerator rnd(7);
+		for (int i = 0; i < 1500; ++i)
+			colors << (rnd.generate() | 0xff000000);
+		// gray ramp and saturated corners
+		for (int i = 0; i < 256; ++i)
+			colors[i] = qRgb(i, i, i);
+		colors[256] = qRgb(255, 0, 0);
+		colors[257] = qRgb(0, 255, 0);
+		colors[258] = qRgb(0, 0, 255);
+		return colors;
+	}
+}
+
+void LightpackMathTest::testColorBatch()
+{
+	const QList<QRgb> colors = batchColors();
+
+	// odd sizes go through the tail of the kernels
+	const QList<int> sizes = { 0, 1, 7, 9, 17, colors.size() };
+	for (const int size : sizes) {
+		const QList<QRgb> input = colors.mid(0, size);
+		PrismatikMath::LabBatch lab;
+		PrismatikMath::rgbToLab(input, lab);
+		QCOMPARE(static_cast<int>(lab.size()), size);
+
+		QList<QRgb> output = input;
+		PrismatikMath::labToRgb(lab, output);
+
+		for (int i = 0; i < size; ++i) {
+			StructRgb rgb;
+			rgb.r = qRed(input[i]);
+			rgb.g = qGreen(input[i]);
+			rgb.b = qBlue(input[i]);
+			StructXyz xyz;
+			StructLabF expectedLab;
+			PrismatikMath::RgbToXyz(rgb, xyz);
+			PrismatikMath::XyzToLab(xyz, expectedLab);
+			const double tolerance = PrismatikMath::LabBatchTolerance;
+			QVERIFY2(qAbs(lab.l[i] - expectedLab.l) < tolerance && qAbs(lab.a[i] - expectedLab.a) < tolerance && qAbs(lab.b[i] - expectedLab.b) < tolerance,
+				qPrintable(QString("Failure. Lab of %1 is off").arg(input[i], 1, 16)));
+
+			PrismatikMath::LabToXyz(expectedLab, xyz);
+			PrismatikMath::XyzToRgb(xyz, rgb);
+			const int maxDiff = qMax(qAbs(qRed(output[i]) - (int)rgb.r), qMax(qAbs(qGreen(output[i]) - (int)rgb.g), qAbs(qBlue(output[i]) - (int)rgb.b)));
+			QVERIFY2(maxDiff <= PrismatikMath::RgbBatchTolerance, qPrintable(QString("Failure. RGB %1 is too far from %2").arg(output[i], 1, 16).arg(qRgb(rgb.r, rgb.g, rgb.b), 1, 16)));
+		}
+	}
+}
+
+void LightpackMathTest::benchmarkRgbToLab_data()
+{
+	QTest::addColumn<bool>("isBatch");
+
+	QTest::newRow("scalar") << false;
+	QTest::newRow("batch") << true;
+}
+
+void LightpackMathTest::benchmarkRgbToLab()
+{
+	QFETCH(bool, isBatch);
+
+	const QList<QRgb> colors = batchColors();
+	PrismatikMath::LabBatch lab;
+	lab.resize(colors.size());
+	QBENCHMARK {
+		if (isBatch) {
+			PrismatikMath::rgbToLab(colors, lab);
+		} else {
+			for (int i = 0; i < colors.size(); ++i) {
+				StructRgb rgb;
+				rgb.r = qRed(colors[i]);
+				rgb.g = qGreen(colors[i]);
+				rgb.b = qBlue(colors[i]);
+				StructXyz xyz;
+				StructLabF labF;
+				PrismatikMath::RgbToXyz(rgb, xyz);
+				PrismatikMath::XyzToLab(xyz, labF);
+				lab.l[i] = labF.l;
+				lab.a[i] = labF.a;
+				lab.b[i] = labF.b;
+			}
+		}
+	}
+}
+
+void LightpackMathTest::benchmarkLabToRgb_data()
+{
+	QTest::addColumn<bool>("isBatch");
+
+	QTest::newRow("scalar") << false;
+	QTest::newRow("batch") << true;
+}
+
+void LightpackMathTest::benchmarkLabToRgb()
+{
+	QFETCH(bool, isBatch);
+
+	QList<QRgb> colors = batchColors();
+	PrismatikMath::LabBatch lab;
+	PrismatikMath::rgbToLab(colors, lab);
+	QBENCHMARK {
+		if (isBatch) {
+			PrismatikMath::labToRgb(lab, colors);
+		} else {
+			for (size_t i = 0; i < lab.size(); ++i) {
+				StructLabF labF;
+				labF.l = lab.l[i];
+				labF.a = lab.a[i];
+				labF.b = lab.b[i];
+				StructXyz xyz;
+				StructRgb rgb;
+				PrismatikMath::LabToXyz(labF, xyz);
+				PrismatikMath::XyzToRgb(xyz, rgb);
+				colors[i] = qRgb(rgb.r, rgb.g, rgb.b);
+			}
+		}
+	}
+}
+
+void LightpackMathTest::testTemporalFilter_data()
+{
+	QTest::addColumn<int>("mode");
+
+	QTest::newRow("exponential") << static_cast<int>(PrismatikMath::TemporalFilter::ModeExponential);
+	QTest::newRow("spring") << static_cast<int>(PrismatikMath::TemporalFilter::ModeSpring);
+	QTest::newRow("linear") << static_cast<int>(PrismatikMath::TemporalFilter::ModeLinear);
+}
+
+void LightpackMathTest::testTemporalFilter()
+{
+	QFETCH(int, mode);
+
+	const QRgb black = qRgb(0, 0, 0);
+	const QRgb target[2] = { qRgb(255, 128, 0), qRgb(10, 200, 90) };
+
+	// the same time in steps of 120 Hz and 30 Hz
+	PrismatikMath::TemporalFilter fast, slow;
+	for (PrismatikMath::TemporalFilter *filter : { &fast, &slow }) {
+		filter->setMode(static_cast<PrismatikMath::TemporalFilter::Mode>(mode));
+		filter->setTimeConstant(0.1);
+		const QRgb start[2] = { black, black };
+		filter->setTarget(start, 2);
+		filter->setTarget(target, 2);
+		QVERIFY(!filter->isSettled());
+	}
+
+	QRgb fastColors[2], slowColors[2], previous[2] = { black, black };
+	for (int step = 0; step < 6; ++step) {
+		for (int i = 0; i < 4; ++i)
+			fast.advance(1.0 / 120);
+		slow.advance(1.0 / 30);
+		fast.values(fastColors);
+		slow.values(slowColors);
+		for (int led = 0; led < 2; ++led) {
+			QVERIFY(qAbs(qRed(fastColors[led]) - qRed(slowColors[led])) <= 1);
+			QVERIFY(qAbs(qGreen(fastColors[led]) - qGreen(slowColors[led])) <= 1);
+			QVERIFY(qAbs(qBlue(fastColors[led]) - qBlue(slowColors[led])) <= 1);
+			// moves towards the target without overshooting it
+			QVERIFY(qRed(fastColors[led]) >= qRed(previous[led]) && qRed(fastColors[led]) <= qRed(target[led]));
+			previous[led] = fastColors[led];
+		}
+	}
+
+	for (int i = 0; i < 100 && !fast.isSettled(); ++i)
+		fast.advance(1.0 / 120);
+	QVERIFY(fast.isSettled());
+	fast.values(fastColors);
+	QCOMPARE(fastColors[0], target[0]);
+	QCOMPARE(fastColors[1], target[1]);
+
+	// a different number of LEDs starts from the target
+	fast.setTarget(target, 1);
+	QVERIFY(fast.isSettled());
+	QCOMPARE(fast.size(), 1);
+}
+
+void LightpackMathTest::testColorSequence_data()
+{
+	QTest::addColumn<QString>("sequence");
+	QTest::addColumn<QByteArray>("expected");
+
+	// red 0x10, green 0x20, blue 0x30
+	QTest::newRow("RGB") << QStringLiteral("RGB") << QByteArray("\x10\x20\x30", 3);
+	QTest::newRow("RBG") << QStringLiteral("RBG") << QByteArray("\x10\x30\x20", 3);
+	QTest::newRow("BRG") << QStringLiteral("BRG") << QByteArray("\x30\x10\x20", 3);
+	QTest::newRow("BGR") << QStringLiteral("BGR") << QByteArray("\x30\x20\x10", 3);
+	QTest::newRow("GRB") << QStringLiteral("GRB") << QByteArray("\x20\x10\x30", 3);
+	QTest::newRow("GBR") << QStringLiteral("GBR") << QByteArray("\x20\x30\x10", 3);
+	QTest::newRow("unknown") << QStringLiteral("RRG") << QByteArray("\x10\x20\x30", 3);
+	QTest::newRow("empty") << QString() << QByteArray("\x10\x20\x30", 3);
+}
+
+void LightpackMathTest::testColorSequence()
+{
+	QFETCH(QString, sequence);
+	QFETCH(QByteArray, expected);
+
+	const PrismatikMath::ColorSequence order(sequence);
+
+	StructRgb color;
+	color.r = 0x10;
+	color.g = 0x20;
+	color.b = 0x30;
+	QList<StructRgb> colors;
+	colors << StructRgb() << color << color;
+
+	QByteArray buffer(colors.count() * 3, '\xff');
+	char *end = order.write(colors, 1, 2, buffer.data());
+	QCOMPARE(end - buffer.constData(), 6);
+	QCOMPARE(buffer.left(3), expected);
+	QCOMPARE(buffer.mid(3), expected);
+
+	// 12 bit colors shifted down to 8 bits
+	StructRgb wide;
+	wide.r = 0x100;
+	wide.g = 0x200;
+	wide.b = 0x300;
+	order.write(wide, buffer.data(), 4);
+	QCOMPARE(buffer.left(3), expected);
+}
+
+void LightpackMathTest::testSampleRing()
+{
+	PrismatikMath::SampleRing ring(6);
+	QCOMPARE(ring.capacity(), size_t(8));
+
+	float samples[10];
+	for (int i = 0; i < 10; ++i)
+		samples[i] = i;
+
+	// overlapping reads: look at 4 samples, consume 2
+	QCOMPARE(ring.write(samples, 5), size_t(5));
+	float window[4];
+	QVERIFY(ring.peek(window, 4));
+	QCOMPARE(window[0], 0.0f);
+	QCOMPARE(window[3], 3.0f);
+	ring.skip(2);
+	QCOMPARE(ring.available(), size_t(3));
+	QVERIFY(!ring.peek(window, 4));
+
+	// wraps around the end, the samples which don't fit are dropped
+	QCOMPARE(ring.write(samples + 5, 5), size_t(5));
+	QCOMPARE(ring.available(), size_t(8));
+	QCOMPARE(ring.write(samples, 3), size_t(0));
+	QCOMPARE(ring.droppedCount(), size_t(3));
+	QVERIFY(ring.peek(window, 4));
+	QCOMPARE(window[0], 2.0f);
+	QCOMPARE(window[3], 5.0f);
+
+	ring.discard();
+	QCOMPARE(ring.available(), size_t(0));
+}
+
+void LightpackMathTest::testTripleBuffer()
+{
+	PrismatikMath::TripleBuffer<int> buffer;
+	buffer.reset(0);
+	QVERIFY(!buffer.update());
+
+	// only the last published value is seen
+	buffer.back() = 1;
+	buffer.publish();
+	buffer.back() = 2;
+	buffer.publish();
+	QVERIFY(buffer.update());
+	QCOMPARE(buffer.front(), 2);
+	QVERIFY(!buffer.update());
+	QCOMPARE(buffer.front(), 2);
+
+	// the writer doesn't get the buffer the reader holds
+	buffer.back() = 3;
+	QCOMPARE(buffer.front(), 2);
+	buffer.publish();
+	QVERIFY(buffer.update());
+	QCOMPARE(buffer.front(), 3);
+}
+
+void LightpackMathTest::testBeatTracker_data()
+{
+	QTest::addColumn<double>("bpm");
+	QTest::addColumn<double>("spectrumRate");
+
+	QTest::newRow("90 bpm, 75% overlap") << 90.0 << 86.13;
+	QTest::newRow("128 bpm, 75% overlap") << 128.0 << 86.13;
+	QTest::newRow("150 bpm, 75% overlap") << 150.0 << 86.13;
+	QTest::newRow("90 bpm, 40 Hz") << 90.0 << 40.0;
+	QTest::newRow("128 bpm, 40 Hz") << 128.0 << 40.0;
+}
+
+void LightpackMathTest::testBeatTracker()
+{
+	QFETCH(double, bpm);
+	QFETCH(double, spectrumRate);
+
+	const double period = 60.0 / bpm;
+	const double startTime = 0.3;
+	const int framesCount = 20 * spectrumRate;
+
+	PrismatikMath::BeatTracker tracker;
+	std::vector<float> spectrum(1024);
+	quint32 noise = 2463534242u;
+	int onsetsCount = 0;
+	double time = startTime;
+	for (int frame = 0; frame < framesCount; ++frame) {
+		time = startTime + frame / spectrumRate;
+		// low noise and a decaying kick on every beat
+		const float kick = std::exp(-std::fmod(time, period) * 12.0);
+		for (size_t i = 0; i < spectrum.size(); ++i) {
+			noise ^= noise << 13;
+			noise ^= noise >> 17;
+			noise ^= noise << 5;
+			spectrum[i] = 0.0002f * (noise & 0xffff) / 0xffff + 0.003f * kick * (i < 200 ? 1.0f : 0.2f);
+		}
+		if (tracker.process(spectrum.data(), spectrum.size(), time))
+			++onsetsCount;
+	}
+
+	// an onset on every beat but the ones of the first second, while the average settles
+	const int beatsCount = (time - startTime) / period;
+	QVERIFY(onsetsCount <= beatsCount && onsetsCount >= beatsCount - bpm / 60 - 1);
+	QCOMPARE(tracker.onsetsCount(), static_cast<unsigned long long>(onsetsCount));
+
+	QVERIFY2(qAbs(tracker.tempo() - bpm) < bpm * 0.02, qPrintable(QString::number(tracker.tempo())));
+	QVERIFY(tracker.confidence() > 0.5);
+
+	const double nextBeat = (std::floor(time / period) + 1.0) * period;
+	QVERIFY2(qAbs(tracker.nextBeatTime(time) - nextBeat) < period * 0.1, qPrintable(QString::number(tracker.nextBeatTime(time))));
+
+	// the same spectrum again isn't new
+	QVERIFY(!tracker.process(spectrum.data(), spectrum.size(), time + 1.0 / spectrumRate));
+	QCOMPARE(tracker.onsetsCount(), static_cast<unsigned long long>(onsetsCount));
+
+	tracker.reset();
+	QCOMPARE(tracker.tempo(), 0.0);
+	QCOMPARE(tracker.nextBeatTime(time), 0.0);
+}
+
+void LightpackMathTest::testFilterBank_data()
+{
+	QTest::addColumn<double>("sampleRate");
+
+	QTest::newRow("44.1 kHz") << 44100.0;
+	QTest::newRow("48 kHz") << 48000.0;
+}
+
+void LightpackMathTest::testFilterBank()
+{
+	QFETCH(double, sampleRate);
+
+	const size_t spectrumSize = 1024;
+	const double binHz = sampleRate / 2 / spectrumSize;
+	std::vector<float> spectrum(spectrumSize, 0.0f);
+
+	PrismatikMath::FilterBank bank;
+	QVERIFY(bank.configure(PrismatikMath::FilterBank::ShapePeak, 10, 20.0, 20000.0, spectrumSize, sampleRate));
+	QVERIFY(!bank.configure(PrismatikMath::FilterBank::ShapePeak, 10, 20.0, 20000.0, spectrumSize, sampleRate));
+	QCOMPARE(bank.bandsCount(), 10);
+
+	// a 1 kHz tone is in the same band whatever the rate, 20 Hz * 1000^(5/10) < 1 kHz < 20 Hz * 1000^(6/10)
+	spectrum[qRound(1000.0 / binHz)] = 0.5f;
+	const float *bands = bank.apply(spectrum.data());
+	for (int band = 0; band < bank.bandsCount(); ++band)
+		QCOMPARE(bands[band], band == 5 ? 0.5f : 0.0f);
+
+	// sums match a plain loop over the bins of the range
+	for (size_t bin = 0; bin < spectrumSize; ++bin)
+		spectrum[bin] = (bin * 37 % 101) / 101.0f;
+	QVERIFY(bank.configure(PrismatikMath::FilterBank::ShapeSum, 1, 1950.0, 5050.0, spectrumSize, sampleRate));
+	double expected = 0.0;
+	for (size_t bin = 0; bin < spectrumSize; ++bin)
+		if (bin * binHz >= 1950.0 && bin * binHz < 5050.0)
+			expected += spectrum[bin];
+	QVERIFY(qAbs(bank.apply(spectrum.data())[0] - expected) < expected * 1e-5);
+
+	// triangles are averages, also the ones narrower than a bin
+	std::fill(spectrum.begin(), spectrum.end(), 0.25f);
+	QVERIFY(bank.configure(PrismatikMath::FilterBank::ShapeTriangle, 24, 40.0, 16000.0, spectrumSize, sampleRate));
+	bands = bank.apply(spectrum.data());
+	for (int band = 0; band < bank.bandsCount(); ++band)
+		QVERIFY(qAbs(bands[band] - 0.25f) < 1e-5f);
+}
+
+#if defined(PULSEAUDIO_SUPPORT) || defined(PIPEWIRE_AUDIO_SUPPORT)
+void LightpackMathTest::testSpectrumAnalyzer_data()
+{
+	QTest::addColumn<double>("sampleRate");
+
+	QTest::newRow("44.1 kHz") << 44100.0;
+	QTest::newRow("48 kHz") << 48000.0;
+}
+
+void LightpackMathTest::testSpectrumAnalyzer()
+{
+	QFETCH(double, sampleRate);
+
+	const size_t spectrumSize = 1024;
+	const double toneHz = 1000.0;
+
+	SpectrumAnalyzer analyzer(spectrumSize);
+	analyzer.start(50);
+
+	std::vector<float> samples(analyzer.windowSamples() * 4);
+	for (size_t i = 0; i < samples.size(); ++i)
+		samples[i] = 0.5f * std::sin(2 * M_PI * toneHz * i / sampleRate);
+	analyzer.write(samples.data(), samples.size());
+
+	// the FFT runs on the analysis thread
+	std::vector<float> spectrum(spectrumSize, 0.0f);
+	QTRY_VERIFY_WITH_TIMEOUT(analyzer.takeSpectrum(spectrum.data()), 2000);
+	analyzer.stop();
+
+	// bins are sampleRate / window wide
+	const int expectedBin = qRound(toneHz * analyzer.windowSamples() / sampleRate);
+	const int peakBin = std::max_element(spectrum.begin(), spectrum.end()) - spectrum.begin();
+	QCOMPARE(peakBin, expectedBin);
+}
+#endif
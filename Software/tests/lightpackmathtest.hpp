@@ -11,6 +11,26 @@ public:
 	
 private slots:
 	void testCase1();
+	void testColorCorrectionLut();
+	void testColorBatch();
+	void testTemporalFilter_data();
+	void testTemporalFilter();
+	void testColorSequence_data();
+	void testColorSequence();
+	void testSampleRing();
+	void testTripleBuffer();
+	void testBeatTracker_data();
+	void testBeatTracker();
+	void testFilterBank_data();
+	void testFilterBank();
+#if defined(PULSEAUDIO_SUPPORT) || defined(PIPEWIRE_AUDIO_SUPPORT)
+	void testSpectrumAnalyzer_data();
+	void testSpectrumAnalyzer();
+#endif
+	void benchmarkRgbToLab_data();
+	void benchmarkRgbToLab();
+	void benchmarkLabToRgb_data();
+	void benchmarkLabToRgb();
 };
 
 #endif // LIGHTPACKMATHTEST_HPP
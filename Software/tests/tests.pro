@@ -28,7 +28,30 @@ RCC_DIR     = stuff
 
 DEFINES += SRCDIR=\\\"$$PWD/\\\"
 
-LIBS += -L../lib -lprismatik-math -lgrab
+LIBS += -L../lib -lgrab -lprismatik-math
+
+# built into the grab library on every platform
+DEFINES += SYNTHETIC_GRAB_SUPPORT
+
+# tested against a local PipeWire node, see GrabCalculationTest::testCase_PipeWireGrabber()
+include(../grab/configure-grabbers.prf)
+contains(SUPPORTED_GRABBERS, PIPEWIRE_GRAB_SUPPORT) {
+    DEFINES += PIPEWIRE_GRAB_SUPPORT
+    QT += dbus
+    PKGCONFIG += libpipewire-0.3
+}
+
+# FFT of the Linux sound visualizer backends
+unix:!macx {
+    contains(DEFINES,PULSEAUDIO_SUPPORT)|contains(DEFINES,PIPEWIRE_AUDIO_SUPPORT) {
+        INCLUDEPATH += $${FFTW3_INC_DIR}
+        defined(FFTW3_LIB_DIR, var):LIBS += -L$${FFTW3_LIB_DIR}
+        LIBS += -lfftw3f
+
+        HEADERS += ../src/SpectrumAnalyzer.hpp
+        SOURCES += ../src/SpectrumAnalyzer.cpp
+    }
+}
 
 win32 {
     CONFIG(msvc):DEFINES += _CRT_SECURE_NO_WARNINGS _CRT_NONSTDC_NO_DEPRECATE
@@ -53,6 +76,11 @@ HEADERS += \
     ../src/Plugin.hpp \
     ../src/LightpackPluginInterface.hpp \
     ../src/LightpackCommandLineParser.hpp \
+    ../src/ColorFrame.hpp \
+    ../src/ColorFrameSlot.hpp \
+    ../src/FrameLatency.hpp \
+    ../src/UdpFanoutSender.hpp \
+    ../src/UdpPacketSender.hpp \
     ../grab/include/calculations.hpp \
     ../math/include/PrismatikMath.hpp \
     SettingsWindowMockup.hpp \
@@ -60,6 +88,9 @@ HEADERS += \
     LightpackApiTest.hpp \
     lightpackmathtest.hpp \
     AppVersionTest.hpp \
+    ColorFrameTest.hpp \
+    AllocationCounter.hpp \
+    UdpFanoutSenderTest.hpp \
     ../src/UpdatesProcessor.hpp \
     LightpackCommandLineParserTest.hpp
 
@@ -70,12 +101,19 @@ SOURCES += \
     ../src/Plugin.cpp \
     ../src/LightpackPluginInterface.cpp \
     ../src/LightpackCommandLineParser.cpp \
+    ../src/ColorFrame.cpp \
+    ../src/FrameLatency.cpp \
+    ../src/UdpFanoutSender.cpp \
+    ../src/UdpPacketSender.cpp \
     LightpackApiTest.cpp \
     SettingsWindowMockup.cpp \
     GrabCalculationTest.cpp \
     lightpackmathtest.cpp \
     TestsMain.cpp \
     AppVersionTest.cpp \
+    ColorFrameTest.cpp \
+    AllocationCounter.cpp \
+    UdpFanoutSenderTest.cpp \
     ../src/UpdatesProcessor.cpp \
     LightpackCommandLineParserTest.cpp
 